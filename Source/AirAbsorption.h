@@ -1,39 +1,291 @@
 #pragma once
 
+#include "SharedPtrAtomicContract.h"
+
 #include <cmath>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+//==============================================================================
+/**
+ * AirAbsorptionIsoTable - ISO 9613-1 atmospheric attenuation LUT
+ *
+ * Evaluates the ISO 9613-1 pure-tone absorption coefficient (dB/m) at
+ * 250 Hz, 2 kHz, 8 kHz and 16 kHz for a given temperature / relative
+ * humidity (standard pressure), one target per stage of a fixed low-order
+ * shelving cascade:
+ *
+ *   broadband gain      <- attenuation at 250 Hz
+ *   shelf 0 (1 kHz)     <- extra attenuation up to 2 kHz
+ *   shelf 1 (4 kHz)     <- extra attenuation up to 8 kHz
+ *   shelf 2 (10 kHz)    <- extra attenuation up to 16 kHz
+ *
+ * Attenuation is linear in distance, so the per-stage linear gains are
+ * tabulated over [0, kMaxDistanceMetres] when the table is built. A table is
+ * immutable once constructed; condition changes build a new one off the audio
+ * thread (see AirAbsorptionIsoTablePublisher). Lookup is a clamped linear
+ * interpolation with no transcendental calls.
+ */
+class AirAbsorptionIsoTable
+{
+public:
+    static constexpr int kNumShelfStages = 3;
+    static constexpr int kNumGains = kNumShelfStages + 1; // [0] = broadband
+    static constexpr int kNumLutEntries = 129;
+    static constexpr float kMaxDistanceMetres = 100.0f;
+    static constexpr std::array<float, kNumShelfStages> kShelfCornerHz { 1000.0f, 4000.0f, 10000.0f };
+
+    using Gains = std::array<float, kNumGains>;
+
+    // Conditions are quantised to kTemperatureStepC / kHumidityStepPercent
+    // before a table is built, so slow automation only rebuilds on a step.
+    static constexpr float kMinTemperatureC = -20.0f;
+    static constexpr float kMaxTemperatureC = 50.0f;
+    static constexpr float kTemperatureStepC = 0.5f;
+    static constexpr float kHumidityStepPercent = 1.0f;
+
+    AirAbsorptionIsoTable()
+        : AirAbsorptionIsoTable (conditionsKey (20.0f, 50.0f))
+    {
+    }
+
+    explicit AirAbsorptionIsoTable (uint32_t key)
+    {
+        rebuild (key);
+    }
+
+    //--------------------------------------------------------------------------
+    // Packs quantised (temperature, humidity) into one comparable word.
+    static uint32_t conditionsKey (float newTemperatureC, float newHumidityPercent) noexcept
+    {
+        const auto t = std::isfinite (newTemperatureC)
+                           ? std::max (kMinTemperatureC, std::min (kMaxTemperatureC, newTemperatureC))
+                           : 20.0f;
+        const auto h = std::isfinite (newHumidityPercent)
+                           ? std::max (0.0f, std::min (100.0f, newHumidityPercent))
+                           : 50.0f;
+        const auto tSteps = static_cast<uint32_t> (std::lround ((t - kMinTemperatureC) / kTemperatureStepC));
+        const auto hSteps = static_cast<uint32_t> (std::lround (h / kHumidityStepPercent));
+        return (tSteps << 16) | hSteps;
+    }
+
+    uint32_t getConditionsKey() const noexcept { return key; }
+
+    float getTemperatureC() const noexcept { return temperatureC; }
+    float getHumidityPercent() const noexcept { return humidityPercent; }
+
+    //--------------------------------------------------------------------------
+    Gains lookup (float distance) const noexcept
+    {
+        if (! std::isfinite (distance) || distance <= 0.0f)
+            return lut.front();
+
+        const float position = std::min (distance, kMaxDistanceMetres) * kEntriesPerMetre;
+        const int index = std::min (static_cast<int> (position), kNumLutEntries - 2);
+        const float frac = position - static_cast<float> (index);
+
+        const auto& lo = lut[static_cast<size_t> (index)];
+        const auto& hi = lut[static_cast<size_t> (index + 1)];
+        Gains out {};
+        for (size_t g = 0; g < out.size(); ++g)
+            out[g] = lo[g] + frac * (hi[g] - lo[g]);
+        return out;
+    }
+
+    //--------------------------------------------------------------------------
+    // ISO 9613-1 absorption coefficient in dB/m at standard atmospheric pressure.
+    static double absorptionDbPerMetre (double frequencyHz, double temperatureCelsius, double humidityPercent)
+    {
+        constexpr double kT0 = 293.15;   // reference temperature (K)
+        constexpr double kT01 = 273.16;  // triple-point isotherm (K)
+        const double T = temperatureCelsius + 273.15;
+        const double tRatio = T / kT0;
+
+        const double c = -6.8346 * std::pow (kT01 / T, 1.261) + 4.6151;
+        const double h = humidityPercent * std::pow (10.0, c); // molar concentration of water vapour (%)
+
+        const double frO = 24.0 + 4.04e4 * h * (0.02 + h) / (0.391 + h);
+        const double frN = std::pow (tRatio, -0.5)
+                         * (9.0 + 280.0 * h * std::exp (-4.170 * (std::pow (tRatio, -1.0 / 3.0) - 1.0)));
+
+        const double f2 = frequencyHz * frequencyHz;
+        return 8.686 * f2
+             * (1.84e-11 * std::sqrt (tRatio)
+                + std::pow (tRatio, -2.5)
+                      * (0.01275 * std::exp (-2239.1 / T) / (frO + f2 / frO)
+                         + 0.1068 * std::exp (-3352.0 / T) / (frN + f2 / frN)));
+    }
+
+private:
+    static constexpr float kEntriesPerMetre = static_cast<float> (kNumLutEntries - 1) / kMaxDistanceMetres;
+
+    void rebuild (uint32_t newKey)
+    {
+        key = newKey;
+        temperatureC = kMinTemperatureC + static_cast<float> (key >> 16) * kTemperatureStepC;
+        humidityPercent = static_cast<float> (key & 0xffffu) * kHumidityStepPercent;
+
+        // Cumulative target attenuation (dB/m) handed to each stage.
+        constexpr std::array<double, kNumGains> kTargetHz { 250.0, 2000.0, 8000.0, 16000.0 };
+        std::array<double, kNumGains> stageDbPerMetre {};
+        double previous = 0.0;
+        for (size_t g = 0; g < kTargetHz.size(); ++g)
+        {
+            const double cumulative = std::max (previous,
+                                                absorptionDbPerMetre (kTargetHz[g], temperatureC, humidityPercent));
+            stageDbPerMetre[g] = cumulative - previous;
+            previous = cumulative;
+        }
+
+        for (int i = 0; i < kNumLutEntries; ++i)
+        {
+            const double distance = static_cast<double> (i) / static_cast<double> (kEntriesPerMetre);
+            auto& entry = lut[static_cast<size_t> (i)];
+            for (size_t g = 0; g < entry.size(); ++g)
+                entry[g] = static_cast<float> (std::pow (10.0, -0.05 * stageDbPerMetre[g] * distance));
+        }
+    }
+
+    uint32_t key = 0;
+    float temperatureC = 20.0f;
+    float humidityPercent = 50.0f;
+    std::array<Gains, kNumLutEntries> lut {};
+};
+
+//==============================================================================
+/**
+ * AirAbsorptionIsoTablePublisher - builds ISO 9613-1 tables off the audio thread
+ *
+ * The audio thread only posts the quantised conditions key. A non-RT caller
+ * (the processor's message-thread timer, prepare, or an offline render loop)
+ * builds the matching table on demand in buildPendingTable() and publishes it
+ * through RetainingSharedPtrPublisher; the audio thread adopts it at its next
+ * block. Superseded tables are freed by a later build call, never in process().
+ */
+class AirAbsorptionIsoTablePublisher
+{
+public:
+    AirAbsorptionIsoTablePublisher()
+    {
+        publish (std::make_shared<const AirAbsorptionIsoTable>());
+    }
+
+    // Non-RT. Builds the table for the newest requested conditions if it is
+    // not the published one, and frees tables the audio thread has dropped.
+    void buildPendingTable()
+    {
+        const std::lock_guard<std::mutex> lock (buildMutex);
+        const auto key = requestedKey.load (std::memory_order_acquire);
+        if (key != builtKey)
+            publish (std::make_shared<const AirAbsorptionIsoTable> (key));
+        else
+            published.releaseRetired();
+    }
+
+    // Audio thread. Posts the conditions; no table work happens here.
+    void requestConditions (float temperatureC, float humidityPercent) noexcept
+    {
+        requestedKey.store (AirAbsorptionIsoTable::conditionsKey (temperatureC, humidityPercent),
+                            std::memory_order_release);
+    }
+
+    // Audio thread, block boundary. Swaps in the newest table when one was
+    // published since the last call; otherwise leaves `active` untouched.
+    void adoptLatest (std::shared_ptr<const AirAbsorptionIsoTable>& active) noexcept
+    {
+        const auto serial = publishedSerial.load (std::memory_order_acquire);
+        if (active != nullptr && serial == adoptedSerial)
+            return;
+
+        active = published.load();
+        adoptedSerial = serial;
+    }
+
+private:
+    void publish (std::shared_ptr<const AirAbsorptionIsoTable> table)
+    {
+        builtKey = table->getConditionsKey();
+        published.publish (std::move (table));
+        publishedSerial.fetch_add (1, std::memory_order_release);
+    }
+
+    RetainingSharedPtrPublisher<const AirAbsorptionIsoTable> published;
+    std::atomic<uint32_t> publishedSerial { 0 };
+    uint32_t adoptedSerial = 0; // audio thread
+    std::atomic<uint32_t> requestedKey { AirAbsorptionIsoTable::conditionsKey (20.0f, 50.0f) };
+
+    std::mutex buildMutex; // serialises non-RT builders
+    uint32_t builtKey = 0; // guarded by buildMutex
+};
 
 //==============================================================================
 /**
- * AirAbsorption - Distance-driven one-pole low-pass filter
+ * AirAbsorption - Distance-driven high-frequency rolloff
+ *
+ * Two models:
  *
- * Simulates high-frequency rolloff with distance.
- * Cutoff = maxCutoff / (1 + distance * absorptionFactor)
+ *   Simple (legacy): one-pole low-pass filter
+ *     Cutoff = maxCutoff / (1 + distance * absorptionFactor)
+ *     y[n] = a0 * x[n] + b1 * y[n-1]
+ *     where a0 = 1 - b1, b1 = exp(-2*pi*cutoff/sampleRate)
  *
- * Uses a simple one-pole IIR filter for efficiency:
- *   y[n] = a0 * x[n] + b1 * y[n-1]
- *   where a0 = 1 - b1, b1 = exp(-2*pi*cutoff/sampleRate)
+ *   Iso9613: broadband gain plus a cascade of first-order high shelves with
+ *   fixed corners (see AirAbsorptionIsoTable). Shelf gains come from the shared
+ *   distance LUT and are ramped linearly across each block, so a distance
+ *   change costs one table lookup instead of a transcendental call.
  */
 class AirAbsorption
 {
 public:
+    enum class Model
+    {
+        Simple = 0,
+        Iso9613
+    };
+
     AirAbsorption() = default;
 
     //--------------------------------------------------------------------------
     void prepare (double sampleRate)
     {
         currentSampleRate = sampleRate;
-        z1_L = 0.0f;
-        z1_R = 0.0f;
+
+        const auto nyquistGuard = 0.45f * static_cast<float> (sampleRate);
+        for (int s = 0; s < AirAbsorptionIsoTable::kNumShelfStages; ++s)
+        {
+            const auto cornerHz = std::min (AirAbsorptionIsoTable::kShelfCornerHz[static_cast<size_t> (s)], nyquistGuard);
+            const auto w = 2.0f * 3.14159265358979323846f * cornerHz / static_cast<float> (sampleRate);
+            shelfPole[static_cast<size_t> (s)] = std::exp (-w);
+        }
+
+        reset();
     }
 
     void reset()
     {
         z1_L = 0.0f;
         z1_R = 0.0f;
+        shelfState.fill (0.0f);
+        isoGains.fill (1.0f);
+        isoGainsTarget.fill (1.0f);
     }
 
     //--------------------------------------------------------------------------
+    void setModel (Model newModel)
+    {
+        if (model == newModel)
+            return;
+
+        model = newModel;
+        reset();
+    }
+
+    Model getModel() const noexcept { return model; }
+
     void setAbsorptionFactor (float factor)
     {
         absorptionFactor = std::max (0.0f, factor);
@@ -53,6 +305,12 @@ public:
         }
     }
 
+    // Iso9613 model: fetch the next block's stage gains from the shared LUT.
+    void updateForDistance (float distance, const AirAbsorptionIsoTable& table) noexcept
+    {
+        isoGainsTarget = table.lookup (distance);
+    }
+
     //--------------------------------------------------------------------------
     // Process a single sample (mono)
     float processSample (float input)
@@ -75,6 +333,12 @@ public:
     // Process a buffer (mono, in-place)
     void processBlock (float* data, int numSamples)
     {
+        if (model == Model::Iso9613)
+        {
+            processIsoBlock (data, numSamples);
+            return;
+        }
+
         float a0 = 1.0f - coefficient;
         for (int i = 0; i < numSamples; ++i)
         {
@@ -84,10 +348,47 @@ public:
     }
 
 private:
+    void processIsoBlock (float* data, int numSamples) noexcept
+    {
+        if (numSamples <= 0)
+            return;
+
+        const float invNumSamples = 1.0f / static_cast<float> (numSamples);
+        AirAbsorptionIsoTable::Gains step {};
+        for (size_t g = 0; g < step.size(); ++g)
+            step[g] = (isoGainsTarget[g] - isoGains[g]) * invNumSamples;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (size_t g = 0; g < isoGains.size(); ++g)
+                isoGains[g] += step[g];
+
+            float y = data[i] * isoGains[0];
+            for (size_t s = 0; s < shelfState.size(); ++s)
+            {
+                // First-order high shelf: lp + g * (x - lp), fixed corner.
+                auto& lp = shelfState[s];
+                lp = y + shelfPole[s] * (lp - y);
+                y = lp + isoGains[s + 1] * (y - lp);
+            }
+
+            data[i] = y;
+        }
+
+        isoGains = isoGainsTarget;
+    }
+
     double currentSampleRate = 44100.0;
+    Model model = Model::Simple;
     float absorptionFactor = 0.3f;
     float maxCutoff = 20000.0f;    // Hz
     float coefficient = 0.0f;       // One-pole feedback coefficient (b1)
     float z1_L = 0.0f;             // Filter state left
     float z1_R = 0.0f;             // Filter state right
+
+    // Iso9613 shelving cascade
+    std::array<float, AirAbsorptionIsoTable::kNumShelfStages> shelfPole {};
+    std::array<float, AirAbsorptionIsoTable::kNumShelfStages> shelfState {};
+    AirAbsorptionIsoTable::Gains isoGains { 1.0f, 1.0f, 1.0f, 1.0f };
+    AirAbsorptionIsoTable::Gains isoGainsTarget { 1.0f, 1.0f, 1.0f, 1.0f };
 };
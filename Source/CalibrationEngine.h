@@ -28,10 +28,22 @@
  *        → ...
  *        → Playing (speaker 3) → Recording → Analyzing → Complete
  *
+ * MeasurementMode::Simultaneous (log sweeps only) measures all speakers in one
+ * pass using the multiple exponential sweep method: every speaker plays the
+ * same sweep, speaker i delayed by i × sweep offset, while the mic records
+ * throughout. One deconvolution then yields the speakers' IRs at successive
+ * offsets. The offset covers the IR window plus the lead of the first few
+ * harmonic distortion products, so those fall outside the previous
+ * speaker's window:
+ *
+ *   Idle → Playing (all speakers, staggered) → Recording (tail)
+ *        → Analyzing (one deconvolution, 4 analyses) → Complete
+ *
  * Audio-thread interface (processBlock) is real-time safe:
  *   - No heap allocation during Playing / Recording states.
  *   - Atomic state reads/writes with acquire-release ordering.
- *   - Background thread handles FFT-based IR analysis.
+ *   - Background thread streams the FFT deconvolution while recording,
+ *     then finishes it and runs the IR analysis.
  *
  * Usage:
  *   // From prepareToPlay (non-RT):
@@ -56,19 +68,26 @@ public:
     enum class State
     {
         Idle      = 0,
-        Playing   = 1,   // Generating test signal → output channel
+        Playing   = 1,   // Generating test signal → output channel (mic recorded)
         Recording = 2,   // Recording mic input (sweep + reverb tail)
         Analyzing = 3,   // Background FFT deconvolution + analysis
         Complete  = 4,   // All 4 speakers measured; RoomProfile ready
         Error     = 5
     };
 
+    enum class MeasurementMode
+    {
+        Sequential   = 0,   // One sweep per speaker
+        Simultaneous = 1    // Interleaved sweeps, one deconvolution (LogSweep only)
+    };
+
     struct Progress
     {
         State        state           = State::Idle;
         int          currentSpeaker  = 0;   // 0-based
         float        playPercent     = 0.0f;
         float        recordPercent   = 0.0f;
+        bool         simultaneous    = false; // all speakers share one play/record pass
         juce::String message         = "Idle";
     };
 
@@ -118,13 +137,16 @@ public:
         @param sweepDurationSecs Duration of the sweep signal.
         @param tailSeconds      Extra recording time for the reverb tail.
         @param speakerOutputCh  0-indexed output channel for each of the 4 speakers.
-        @param micInputChannel  0-indexed input channel for the measurement mic. */
+        @param micInputChannel  0-indexed input channel for the measurement mic.
+        @param measurementMode  Simultaneous falls back to Sequential for
+                                signal types other than LogSweep. */
     bool startCalibration (TestSignalGenerator::Type type,
                            float testLevelDb,
                            float sweepDurationSecs,
                            float tailSeconds,
                            const int speakerOutputCh[4],
-                           int micInputChannel)
+                           int micInputChannel,
+                           MeasurementMode measurementMode = MeasurementMode::Sequential)
     {
         const auto stateAtRequest = state_.load (std::memory_order_acquire);
         if (stateAtRequest != State::Idle)
@@ -190,6 +212,8 @@ public:
         sweepDuration_ = sweepDurationSecs;
         tailSeconds_   = tailSeconds;
         micChannel_    = micInputChannel;
+        measurementMode_ = type == TestSignalGenerator::Type::LogSweep ? measurementMode
+                                                                       : MeasurementMode::Sequential;
         for (int i = 0; i < 4; ++i)
         {
             speakerOutputCh_[i] = speakerOutputCh[i];
@@ -200,7 +224,10 @@ public:
             const juce::SpinLock::ScopedLockType lock (resultProfileLock_);
             resultProfile_ = RoomProfile {};
         }
-        startSpeaker (0, runGeneration);
+        if (measurementMode_ == MeasurementMode::Simultaneous)
+            startInterleavedSweeps (runGeneration);
+        else
+            startSpeaker (0, runGeneration);
         const bool started = state_.load (std::memory_order_acquire) == State::Playing;
         if (started)
             recordStartAttempt (true, "accepted", "Calibration run started.", stateAtRequest);
@@ -240,8 +267,16 @@ public:
         const int  numSamps = buffer.getNumSamples();
         const int  numCh    = buffer.getNumChannels();
 
-        if (state == State::Playing)
+        if (state == State::Playing && measurementMode_ == MeasurementMode::Simultaneous)
+        {
+            processInterleavedSweepBlock (buffer, micInputChannel);
+        }
+        else if (state == State::Playing)
         {
+            // Record from the first sweep sample so the capture holds the
+            // whole response (read mic input BEFORE clearing, see below).
+            int micCh = juce::jlimit (0, numCh - 1, micInputChannel);
+            capture_.recordBlock (buffer.getReadPointer (micCh), numSamps);
             buffer.clear();
 
             int outCh = juce::jlimit (0, numCh - 1,
@@ -259,8 +294,7 @@ public:
 
             if (! stillPlaying)
             {
-                // Sweep ended → begin recording the reverb tail
-                capture_.startRecording (generator_.getTotalSamples(), tailSeconds_);
+                // Sweep ended → keep recording the reverb tail
                 state_.store (State::Recording, std::memory_order_release);
             }
         }
@@ -303,6 +337,11 @@ public:
         Progress p;
         p.state          = state_.load (std::memory_order_acquire);
         p.currentSpeaker = currentSpeaker_.load (std::memory_order_acquire);
+        p.simultaneous   = measurementMode_ == MeasurementMode::Simultaneous;
+
+        const auto speakerLabel = p.simultaneous
+            ? juce::String ("All 4 speakers")
+            : "Speaker " + juce::String (p.currentSpeaker + 1) + " of 4";
 
         switch (p.state)
         {
@@ -316,8 +355,7 @@ public:
                     0.0f,
                     1.0f,
                     playPercentAtomic_.load (std::memory_order_acquire));
-                p.message = "Playing test signal - Speaker "
-                          + juce::String (p.currentSpeaker + 1) + " of 4";
+                p.message = "Playing test signal - " + speakerLabel;
                 break;
             }
 
@@ -327,14 +365,12 @@ public:
                     0.0f,
                     1.0f,
                     recordPercentAtomic_.load (std::memory_order_acquire));
-                p.message = "Recording room response - Speaker "
-                          + juce::String (p.currentSpeaker + 1) + " of 4";
+                p.message = "Recording room response - " + speakerLabel;
                 break;
             }
 
             case State::Analyzing:
-                p.message = "Analysing impulse response - Speaker "
-                          + juce::String (p.currentSpeaker + 1) + " of 4";
+                p.message = "Analysing impulse response - " + speakerLabel;
                 break;
 
             case State::Complete:
@@ -435,9 +471,233 @@ private:
 
         currentSpeaker_.store (speakerIdx, std::memory_order_release);
         generator_.prepare (sampleRate_, type_, sweepDuration_, testLevelDb_);
+        capture_.startRecording (generator_.getTotalSamples(), tailSeconds_);
+        capture_.prepareDeconvolution (generator_.getInverseFilter());
         state_.store (State::Playing, std::memory_order_release);
     }
 
+    // Prepare one sweep shared by all speakers and start the staggered
+    // playback. Recording starts with playback so the capture holds every
+    // sweep from its first sample. Called from the UI thread.
+    void startInterleavedSweeps (std::uint64_t runGeneration)
+    {
+        if (runGeneration == 0u
+            || runGeneration != activeRunGeneration_.load (std::memory_order_acquire)
+            || abortRequested_.load (std::memory_order_acquire))
+        {
+            state_.store (State::Idle, std::memory_order_release);
+            return;
+        }
+
+        generator_.prepare (sampleRate_, type_, sweepDuration_, testLevelDb_);
+
+        const auto irWindowSecs = std::max (static_cast<double> (tailSeconds_),
+                                            static_cast<double> (IRCapture::DEFAULT_IR_SECS));
+        const auto offsetSecs = irWindowSecs
+                              + TestSignalGenerator::harmonicLeadSeconds (sweepDuration_, MESM_GUARD_HARMONIC);
+        sweepOffsetSamples_   = static_cast<int> (std::ceil (offsetSecs * sampleRate_));
+        interleavedPlaySamples_ = generator_.getTotalSamples() + 3 * sweepOffsetSamples_;
+        interleavedPlayPos_   = 0;
+
+        capture_.startRecording (interleavedPlaySamples_, tailSeconds_);
+        capture_.prepareDeconvolution (generator_.getInverseFilter(), 4, sweepOffsetSamples_);
+        currentSpeaker_.store (0, std::memory_order_release);
+        state_.store (State::Playing, std::memory_order_release);
+    }
+
+    // Audio thread, Simultaneous mode Playing state: record the mic, then write
+    // each speaker's sweep window at its offset. Speakers routed to the same
+    // output channel are summed.
+    void processInterleavedSweepBlock (juce::AudioBuffer<float>& buffer, int micInputChannel)
+    {
+        const int numSamps = buffer.getNumSamples();
+        const int numCh    = buffer.getNumChannels();
+
+        // Read mic input BEFORE clearing (in-place buffer).
+        const int micCh = juce::jlimit (0, numCh - 1, micInputChannel);
+        capture_.recordBlock (buffer.getReadPointer (micCh), numSamps);
+        buffer.clear();
+
+        for (int spk = 0; spk < 4; ++spk)
+        {
+            const int outCh = juce::jlimit (0, numCh - 1, speakerOutputCh_[spk]);
+            generator_.addSweepWindow (buffer.getWritePointer (outCh),
+                                       numSamps,
+                                       interleavedPlayPos_ - spk * sweepOffsetSamples_);
+        }
+
+        interleavedPlayPos_ = std::min (interleavedPlayPos_ + numSamps, interleavedPlaySamples_);
+        const float playPercent = interleavedPlaySamples_ > 0
+            ? static_cast<float> (interleavedPlayPos_) / static_cast<float> (interleavedPlaySamples_)
+            : 1.0f;
+        playPercentAtomic_.store (juce::jlimit (0.0f, 1.0f, playPercent), std::memory_order_release);
+
+        if (interleavedPlayPos_ < interleavedPlaySamples_)
+            return;
+
+        if (! capture_.isComplete())
+        {
+            // Last sweep ended → keep recording the reverb tail
+            state_.store (State::Recording, std::memory_order_release);
+            return;
+        }
+
+        state_.store (State::Analyzing, std::memory_order_release);
+        pendingAnalysisGeneration_.store (
+            activeRunGeneration_.load (std::memory_order_acquire),
+            std::memory_order_release);
+        analysisRequested_.store (true, std::memory_order_release);
+    }
+
+    bool isRunStale (std::uint64_t requestGeneration) const
+    {
+        return requestGeneration != activeRunGeneration_.load (std::memory_order_acquire)
+            || abortRequested_.load (std::memory_order_acquire)
+            || state_.load (std::memory_order_acquire) == State::Idle;
+    }
+
+    // Background thread, while a sweep plays or its tail records: advance the
+    // streaming deconvolution so little is left once the capture completes.
+    void streamRecordedBlocks()
+    {
+        const auto state = state_.load (std::memory_order_acquire);
+        if (state != State::Playing && state != State::Recording)
+            return;
+
+        analysisInFlight_.store (true, std::memory_order_release);
+        if (! abortRequested_.load (std::memory_order_acquire)
+            && state_.load (std::memory_order_acquire) == state)
+        {
+            capture_.processRecordedBlocks();
+        }
+        analysisInFlight_.store (false, std::memory_order_release);
+    }
+
+    // Background thread, Simultaneous mode: one deconvolution separates the
+    // interleaved sweeps, then every speaker's IR is analysed as in the
+    // sequential path and the run completes (or errors) in one step.
+    void analyseInterleavedRun (std::uint64_t requestGeneration)
+    {
+        capture_.finishDeconvolution();
+
+        if (isRunStale (requestGeneration))
+        {
+            state_.store (State::Idle, std::memory_order_release);
+            return;
+        }
+
+        if (! capture_.isIRReady() || capture_.getNumInterleavedIRs() < 4)
+        {
+            publishRunError ("ir_not_ready", "IR capture was incomplete before analysis.");
+            failRun();
+            return;
+        }
+
+        for (int spk = 0; spk < 4; ++spk)
+        {
+            currentSpeaker_.store (spk, std::memory_order_release);
+            const auto res = analyzer_.analyze (capture_.getInterleavedIR (spk));
+
+            if (isRunStale (requestGeneration))
+            {
+                state_.store (State::Idle, std::memory_order_release);
+                return;
+            }
+
+            speakerAnalysisValid_[static_cast<size_t> (spk)].store (res.valid, std::memory_order_release);
+            if (! res.valid)
+            {
+                publishRunError ("analysis_invalid", "Analysis result invalid for speaker "
+                                                     + juce::String (spk + 1) + ".");
+                failRun();
+                return;
+            }
+
+            storeSpeakerResult (spk, res);
+        }
+
+        completeRun();
+    }
+
+    // Serialize multi-field speaker writes so UI snapshots never observe
+    // partially updated profile state.
+    void storeSpeakerResult (int spk, const RoomAnalyzer::AnalysisResult& res)
+    {
+        {
+            const juce::SpinLock::ScopedLockType lock (resultProfileLock_);
+            auto& spkProfile = resultProfile_.speakers[spk];
+            spkProfile.delayComp = res.delayMs;
+            spkProfile.gainTrim  = res.gainTrimDb;
+
+            for (int b = 0; b < SpeakerProfile::NUM_FREQ_BINS; ++b)
+                spkProfile.frequencyResponse[b] = res.frequencyResponse[b];
+
+            // Estimate speaker distance from time-of-arrival
+            // (speed of sound ≈ 343 m/s)
+            spkProfile.distance = (res.delayMs / 1000.0f) * 343.0f;
+        }
+
+        DBG ("CalibrationEngine: Speaker " << (spk + 1)
+             << "  delay=" << res.delayMs  << " ms"
+             << "  gain="  << res.gainTrimDb << " dB"
+             << "  RT60="  << res.estimatedRT60 << " s"
+             << "  reflections=" << res.numReflections);
+    }
+
+    void failRun()
+    {
+        {
+            const juce::SpinLock::ScopedLockType lock (resultProfileLock_);
+            resultProfile_.valid = false;
+        }
+        state_.store (State::Error, std::memory_order_release);
+    }
+
+    // All 4 speakers analysed: validate, assemble the final profile and
+    // publish it to the SceneGraph.
+    void completeRun()
+    {
+        bool allSpeakersValid = true;
+        for (int i = 0; i < 4; ++i)
+        {
+            if (! speakerAnalysisValid_[static_cast<size_t> (i)].load (std::memory_order_acquire))
+            {
+                allSpeakersValid = false;
+                break;
+            }
+        }
+
+        if (! allSpeakersValid)
+        {
+            publishRunError ("speaker_validation_incomplete",
+                             "Calibration did not produce valid analysis for all speakers.");
+            failRun();
+            return;
+        }
+
+        RoomProfile completedProfile;
+        {
+            const juce::SpinLock::ScopedLockType lock (resultProfileLock_);
+            // All 4 speakers measured — assemble final profile
+            resultProfile_.valid = true;
+            resultProfile_.estimatedRT60 = 0.0f;
+            for (int i = 0; i < 4; ++i)
+            {
+                resultProfile_.estimatedRT60 =
+                    std::max (resultProfile_.estimatedRT60,
+                              resultProfile_.speakers[i].distance / 343.0f);
+            }
+            completedProfile = resultProfile_;
+        }
+
+        // Publish to SceneGraph so Renderer mode picks it up.
+        SceneGraph::getInstance().setRoomProfile (completedProfile);
+        state_.store (State::Complete, std::memory_order_release);
+
+        DBG ("CalibrationEngine: Calibration complete — "
+             "Room Profile published to SceneGraph");
+    }
+
     //==========================================================================
     // Background worker: waits for analysisRequested_, runs FFT deconvolution
     // + analysis, stores results, then advances the state machine.
@@ -458,11 +718,18 @@ private:
                     continue;
                 }
 
+                if (measurementMode_ == MeasurementMode::Simultaneous)
+                {
+                    analyseInterleavedRun (requestGeneration);
+                    analysisInFlight_.store (false, std::memory_order_release);
+                    continue;
+                }
+
                 int spk = currentSpeaker_.load (std::memory_order_acquire);
                 bool speakerAnalysisValid = false;
 
-                // --- IR deconvolution (expensive) ---
-                capture_.computeIR (generator_.getInverseFilter());
+                // --- IR deconvolution (remaining blocks after streaming) ---
+                capture_.finishDeconvolution();
 
                 if (requestGeneration != activeRunGeneration_.load (std::memory_order_acquire)
                     || abortRequested_.load (std::memory_order_acquire)
@@ -488,28 +755,8 @@ private:
                             continue;
                         }
 
-                        {
-                            // Serialize multi-field speaker writes so UI snapshots
-                            // never observe partially updated profile state.
-                            const juce::SpinLock::ScopedLockType lock (resultProfileLock_);
-                            auto& spkProfile = resultProfile_.speakers[spk];
-                            spkProfile.delayComp = res.delayMs;
-                            spkProfile.gainTrim  = res.gainTrimDb;
-
-                            for (int b = 0; b < SpeakerProfile::NUM_FREQ_BINS; ++b)
-                                spkProfile.frequencyResponse[b] = res.frequencyResponse[b];
-
-                            // Estimate speaker distance from time-of-arrival
-                            // (speed of sound ≈ 343 m/s)
-                            spkProfile.distance = (res.delayMs / 1000.0f) * 343.0f;
-                        }
+                        storeSpeakerResult (spk, res);
                         speakerAnalysisValid = true;
-
-                        DBG ("CalibrationEngine: Speaker " << (spk + 1)
-                             << "  delay=" << res.delayMs  << " ms"
-                             << "  gain="  << res.gainTrimDb << " dB"
-                             << "  RT60="  << res.estimatedRT60 << " s"
-                             << "  reflections=" << res.numReflections);
                     }
                 }
                 else
@@ -524,11 +771,7 @@ private:
                     if (runErrorSeq_.load (std::memory_order_acquire) == 0u)
                         publishRunError ("analysis_invalid", "Analysis result invalid for current speaker.");
 
-                    {
-                        const juce::SpinLock::ScopedLockType lock (resultProfileLock_);
-                        resultProfile_.valid = false;
-                    }
-                    state_.store (State::Error, std::memory_order_release);
+                    failRun();
                     analysisInFlight_.store (false, std::memory_order_release);
                     continue;
                 }
@@ -550,54 +793,16 @@ private:
                 }
                 else
                 {
-                    bool allSpeakersValid = true;
-                    for (int i = 0; i < 4; ++i)
-                    {
-                        if (! speakerAnalysisValid_[static_cast<size_t> (i)].load (std::memory_order_acquire))
-                        {
-                            allSpeakersValid = false;
-                            break;
-                        }
-                    }
-
-                    if (! allSpeakersValid)
-                    {
-                        publishRunError ("speaker_validation_incomplete",
-                                         "Calibration did not produce valid analysis for all speakers.");
-                        {
-                            const juce::SpinLock::ScopedLockType lock (resultProfileLock_);
-                            resultProfile_.valid = false;
-                        }
-                        state_.store (State::Error, std::memory_order_release);
-                        analysisInFlight_.store (false, std::memory_order_release);
-                        continue;
-                    }
-
-                    RoomProfile completedProfile;
-                    {
-                        const juce::SpinLock::ScopedLockType lock (resultProfileLock_);
-                        // All 4 speakers measured — assemble final profile
-                        resultProfile_.valid = true;
-                        resultProfile_.estimatedRT60 = 0.0f;
-                        for (int i = 0; i < 4; ++i)
-                        {
-                            resultProfile_.estimatedRT60 =
-                                std::max (resultProfile_.estimatedRT60,
-                                          resultProfile_.speakers[i].distance / 343.0f);
-                        }
-                        completedProfile = resultProfile_;
-                    }
-
-                    // Publish to SceneGraph so Renderer mode picks it up.
-                    SceneGraph::getInstance().setRoomProfile (completedProfile);
-                    state_.store (State::Complete, std::memory_order_release);
+                    completeRun();
                     analysisInFlight_.store (false, std::memory_order_release);
-
-                    DBG ("CalibrationEngine: Calibration complete — "
-                         "Room Profile published to SceneGraph");
                 }
             }
 
+            else
+            {
+                streamRecordedBlocks();
+            }
+
             // Poll every 5 ms to avoid busy-spinning
             std::this_thread::sleep_for (std::chrono::milliseconds (5));
         }
@@ -605,6 +810,7 @@ private:
 
     //==========================================================================
     static constexpr float DEFAULT_TAIL_SECS = 1.5f;
+    static constexpr int   MESM_GUARD_HARMONIC = 5; // harmonics 2..5 land outside the previous IR window
 
     // Atomic state
     std::atomic<State> state_             { State::Idle };
@@ -647,6 +853,12 @@ private:
     float  tailSeconds_  = DEFAULT_TAIL_SECS;
     int    micChannel_   = 0;
     int    speakerOutputCh_[4] = { 0, 1, 0, 1 };
+    MeasurementMode measurementMode_ = MeasurementMode::Sequential;
+
+    // Simultaneous mode (set at start; position advanced on the audio thread)
+    int    sweepOffsetSamples_     = 0;
+    int    interleavedPlaySamples_ = 0;
+    int    interleavedPlayPos_     = 0;
 
     // Subsystems
     TestSignalGenerator generator_;
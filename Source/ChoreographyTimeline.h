@@ -0,0 +1,389 @@
+#pragma once
+
+#include "KeyframeTimeline.h"
+#include "SceneGraph.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+//==============================================================================
+/**
+ * ChoreographyTimeline - scene-level keyframe animation for many emitter slots.
+ *
+ * Owned by the renderer instance. A track animates one slot, either one
+ * position axis or the full 3D path; its keyframes are compiled to cubic
+ * pieces (KeyframeTimeline::buildSegmentPolynomials) held in packed arrays,
+ * so a block resolves all choreographed slots in one pass against one clock
+ * instead of each emitter instance advancing its own KeyframeTimeline.
+ *
+ * Built on the message thread, then shared immutably with the audio thread;
+ * the clock and per-track segment cursors live in a caller-owned Playhead.
+ * Axes use the emitter parameter convention (pos_x right, pos_y front,
+ * pos_z up) and results are mapped to scene coordinates.
+ */
+class ChoreographyTimeline
+{
+public:
+    static constexpr int MAX_SLOTS = SceneGraph::MAX_EMITTERS;
+    static constexpr int NUM_AXES = 3;
+    static constexpr int MAX_TRACKS = MAX_SLOTS * NUM_AXES;
+    static constexpr int MAX_LANES = MAX_SLOTS * NUM_AXES;
+
+    enum class Axis : uint8_t
+    {
+        x = 0, // pos_x, scene x
+        y,     // pos_y, scene z (front)
+        z      // pos_z, scene y (height)
+    };
+
+    // One keyframe of a 3D path track. value and the Bezier handles use the
+    // parameter axes (x = pos_x, y = pos_y, z = pos_z); the curve applies to
+    // all three axes so they share segment boundaries.
+    struct PathKeyframe
+    {
+        double timeSeconds = 0.0;
+        Vec3 value;
+        KeyframeCurve curve = KeyframeCurve::linear;
+        Vec3 outHandle;
+        Vec3 inHandle;
+    };
+
+    struct Playhead
+    {
+        double timeSeconds = 0.0;
+        std::array<uint32_t, MAX_TRACKS> cursors {};
+
+        // Per-block scratch, one entry per lane (one animated axis of a track).
+        std::array<float, MAX_LANES> laneU {};
+        std::array<float, MAX_LANES> laneA {};
+        std::array<float, MAX_LANES> laneB {};
+        std::array<float, MAX_LANES> laneC {};
+        std::array<float, MAX_LANES> laneD {};
+        std::array<float, MAX_LANES> laneValues {};
+    };
+
+    struct Result
+    {
+        std::array<Vec3, MAX_SLOTS> positions {};
+        std::array<uint8_t, MAX_SLOTS> sceneAxisMask {}; // bit0=scene x, bit1=scene y, bit2=scene z
+    };
+
+    static std::optional<Axis> axisFromTrackId (const juce::String& parameterId)
+    {
+        if (parameterId == "pos_x") return Axis::x;
+        if (parameterId == "pos_y") return Axis::y;
+        if (parameterId == "pos_z") return Axis::z;
+        return std::nullopt;
+    }
+
+    //--------------------------------------------------------------------------
+    // Message thread (building).
+
+    // Replaces any existing track for (slot, axis), and any path track on the
+    // slot. Keyframes are sorted here.
+    bool setTrack (int slot, Axis axis, std::vector<Keyframe> keyframes)
+    {
+        if (slot < 0 || slot >= MAX_SLOTS)
+            return false;
+
+        removeTracks (slot, [axis] (const TrackRange& range) { return range.laneCount > 1 || range.axis == axis; });
+        if (keyframes.empty())
+            return true;
+
+        if (tracks.size() >= static_cast<size_t> (MAX_TRACKS) || lanes.size() >= static_cast<size_t> (MAX_LANES))
+            return false;
+
+        sortByTime (keyframes);
+
+        std::vector<double> pieceTimes;
+        std::vector<KeyframeSegmentPolynomial> trackPieces;
+        KeyframeTimeline::buildSegmentPolynomials (keyframes, pieceTimes, trackPieces);
+
+        appendTrack (slot, axis, 1, pieceTimes, keyframes.back().timeSeconds);
+        appendLane (slot, axis, keyframes.front().value, keyframes.back().value);
+        pieces.insert (pieces.end(), trackPieces.begin(), trackPieces.end());
+        return true;
+    }
+
+    // Replaces every track on the slot with one 3D path track.
+    bool setPathTrack (int slot, std::vector<PathKeyframe> keyframes)
+    {
+        if (slot < 0 || slot >= MAX_SLOTS)
+            return false;
+
+        removeTracks (slot, [] (const TrackRange&) { return true; });
+        if (keyframes.empty())
+            return true;
+
+        if (tracks.size() >= static_cast<size_t> (MAX_TRACKS)
+            || lanes.size() + static_cast<size_t> (NUM_AXES) > static_cast<size_t> (MAX_LANES))
+            return false;
+
+        sortByTime (keyframes);
+
+        std::array<std::vector<double>, NUM_AXES> pieceTimes;
+        std::array<std::vector<KeyframeSegmentPolynomial>, NUM_AXES> axisPieces;
+        std::vector<Keyframe> axisKeyframes (keyframes.size());
+        for (int axis = 0; axis < NUM_AXES; ++axis)
+        {
+            for (size_t i = 0; i < keyframes.size(); ++i)
+            {
+                const auto& keyframe = keyframes[i];
+                auto& axisKeyframe = axisKeyframes[i];
+                axisKeyframe.timeSeconds = keyframe.timeSeconds;
+                axisKeyframe.value = component (keyframe.value, axis);
+                axisKeyframe.curve = keyframe.curve;
+                axisKeyframe.outHandle = component (keyframe.outHandle, axis);
+                axisKeyframe.inHandle = component (keyframe.inHandle, axis);
+            }
+
+            KeyframeTimeline::buildSegmentPolynomials (axisKeyframes,
+                                                       pieceTimes[static_cast<size_t> (axis)],
+                                                       axisPieces[static_cast<size_t> (axis)]);
+        }
+
+        // Boundaries depend only on times and curves, so the axes agree.
+        const auto numPieces = axisPieces[0].size();
+        appendTrack (slot, Axis::x, NUM_AXES, pieceTimes[0], keyframes.back().timeSeconds);
+        for (int axis = 0; axis < NUM_AXES; ++axis)
+        {
+            appendLane (slot,
+                        static_cast<Axis> (axis),
+                        component (keyframes.front().value, axis),
+                        component (keyframes.back().value, axis));
+        }
+
+        for (size_t piece = 0; piece < numPieces; ++piece)
+        {
+            for (const auto& axisPiece : axisPieces)
+                pieces.push_back (axisPiece[piece]);
+        }
+
+        return true;
+    }
+
+    void setDurationSeconds (double newDurationSeconds) noexcept { durationSeconds = juce::jmax (0.0, newDurationSeconds); }
+    double getDurationSeconds() const noexcept { return durationSeconds; }
+
+    void setLooping (bool shouldLoop) noexcept { looping = shouldLoop; }
+    bool isLooping() const noexcept { return looping; }
+
+    bool empty() const noexcept { return tracks.empty(); }
+    int getNumTracks() const noexcept { return static_cast<int> (tracks.size()); }
+    int getNumLanes() const noexcept { return static_cast<int> (lanes.size()); }
+    int getNumPieces() const noexcept { return static_cast<int> (pieces.size()); }
+
+    //--------------------------------------------------------------------------
+    // Audio thread (const on the shared timeline).
+
+    void seek (Playhead& playhead, double timeSeconds) const noexcept
+    {
+        if (! std::isfinite (timeSeconds))
+            timeSeconds = 0.0;
+
+        if (durationSeconds <= 0.0)
+        {
+            playhead.timeSeconds = juce::jmax (0.0, timeSeconds);
+        }
+        else if (looping)
+        {
+            auto wrapped = std::fmod (timeSeconds, durationSeconds);
+            playhead.timeSeconds = wrapped < 0.0 ? wrapped + durationSeconds : wrapped;
+        }
+        else
+        {
+            playhead.timeSeconds = juce::jlimit (0.0, durationSeconds, timeSeconds);
+        }
+    }
+
+    void advance (Playhead& playhead, double blockDurationSeconds) const noexcept
+    {
+        seek (playhead, playhead.timeSeconds + juce::jmax (0.0, blockDurationSeconds));
+    }
+
+    // Evaluates every track at the playhead time. Returns the number of tracks
+    // written; result entries for slots without tracks have a zero mask.
+    int evaluate (Playhead& playhead, Result& result) const noexcept
+    {
+        const auto numTracks = tracks.size();
+        const auto numLanes = lanes.size();
+        const auto timeSeconds = playhead.timeSeconds;
+
+        // Pass 1: locate each track's piece from its cursor and gather the
+        // piece coefficients of its lanes. Outside the keyframe range a lane
+        // holds its end value as a constant.
+        for (size_t i = 0; i < numTracks; ++i)
+        {
+            const auto& track = tracks[i];
+            const auto* trackTimes = times.data() + track.timeBegin;
+            const auto numPieces = static_cast<size_t> (track.numPieces);
+            const auto laneBegin = static_cast<size_t> (track.laneBegin);
+            const auto laneCount = static_cast<size_t> (track.laneCount);
+
+            if (numPieces == 0 || timeSeconds <= trackTimes[0] || timeSeconds >= trackTimes[numPieces])
+            {
+                const auto atEnd = numPieces > 0 && timeSeconds >= trackTimes[numPieces];
+                for (size_t lane = laneBegin; lane < laneBegin + laneCount; ++lane)
+                {
+                    playhead.laneU[lane] = 0.0f;
+                    playhead.laneA[lane] = playhead.laneB[lane] = playhead.laneC[lane] = 0.0f;
+                    playhead.laneD[lane] = atEnd ? lanes[lane].lastValue : lanes[lane].firstValue;
+                }
+
+                playhead.cursors[i] = atEnd ? static_cast<uint32_t> (numPieces - 1) : 0u;
+                continue;
+            }
+
+            const auto piece = KeyframeTimeline::locateSegment (trackTimes, numPieces + 1, playhead.cursors[i], timeSeconds);
+            playhead.cursors[i] = static_cast<uint32_t> (piece);
+
+            const auto pieceDuration = trackTimes[piece + 1] - trackTimes[piece];
+            const auto u = pieceDuration > kMinSegmentDuration
+                               ? juce::jlimit (0.0f, 1.0f, static_cast<float> ((timeSeconds - trackTimes[piece]) / pieceDuration))
+                               : 1.0f;
+
+            const auto* coefficients = pieces.data() + track.pieceBegin + piece * laneCount;
+            for (size_t lane = 0; lane < laneCount; ++lane)
+            {
+                const auto& coefficient = coefficients[lane];
+                playhead.laneU[laneBegin + lane] = u;
+                playhead.laneA[laneBegin + lane] = coefficient.a;
+                playhead.laneB[laneBegin + lane] = coefficient.b;
+                playhead.laneC[laneBegin + lane] = coefficient.c;
+                playhead.laneD[laneBegin + lane] = coefficient.d;
+            }
+        }
+
+        // Pass 2: Horner evaluation over all lanes, branch-free so it vectorises.
+        const auto* u = playhead.laneU.data();
+        const auto* a = playhead.laneA.data();
+        const auto* b = playhead.laneB.data();
+        const auto* c = playhead.laneC.data();
+        const auto* d = playhead.laneD.data();
+        auto* out = playhead.laneValues.data();
+        for (size_t i = 0; i < numLanes; ++i)
+            out[i] = ((a[i] * u[i] + b[i]) * u[i] + c[i]) * u[i] + d[i];
+
+        // Pass 3: scatter into per-slot scene positions.
+        std::fill (result.sceneAxisMask.begin(), result.sceneAxisMask.end(), uint8_t { 0 });
+        for (size_t i = 0; i < numLanes; ++i)
+        {
+            const auto& lane = lanes[i];
+            auto& position = result.positions[lane.slot];
+            auto& mask = result.sceneAxisMask[lane.slot];
+            switch (lane.axis)
+            {
+                case Axis::x: position.x = out[i]; mask |= 0x1; break;
+                case Axis::z: position.y = out[i]; mask |= 0x2; break;
+                case Axis::y: position.z = out[i]; mask |= 0x4; break;
+            }
+        }
+
+        return static_cast<int> (numTracks);
+    }
+
+private:
+    static constexpr double kMinSegmentDuration = 1.0e-9;
+
+    // A track owns numPieces + 1 entries of times (none for a single keyframe)
+    // and numPieces * laneCount entries of pieces, interleaved by lane.
+    struct TrackRange
+    {
+        uint16_t slot = 0;
+        Axis axis = Axis::x; // single-axis tracks only
+        uint32_t laneCount = 1;
+        uint32_t laneBegin = 0;
+        uint32_t timeBegin = 0;
+        uint32_t pieceBegin = 0;
+        uint32_t numPieces = 0;
+    };
+
+    struct Lane
+    {
+        uint16_t slot = 0;
+        Axis axis = Axis::x;
+        float firstValue = 0.0f;
+        float lastValue = 0.0f;
+    };
+
+    template <typename KeyframeType>
+    static void sortByTime (std::vector<KeyframeType>& keyframes)
+    {
+        std::stable_sort (keyframes.begin(),
+                          keyframes.end(),
+                          [] (const KeyframeType& lhs, const KeyframeType& rhs) { return lhs.timeSeconds < rhs.timeSeconds; });
+    }
+
+    static float component (const Vec3& value, int axis) noexcept
+    {
+        return axis == 0 ? value.x : (axis == 1 ? value.y : value.z);
+    }
+
+    void appendTrack (int slot, Axis axis, int laneCount, const std::vector<double>& pieceTimes, double lastKeyframeSeconds)
+    {
+        TrackRange range;
+        range.slot = static_cast<uint16_t> (slot);
+        range.axis = axis;
+        range.laneCount = static_cast<uint32_t> (laneCount);
+        range.laneBegin = static_cast<uint32_t> (lanes.size());
+        range.timeBegin = static_cast<uint32_t> (times.size());
+        range.pieceBegin = static_cast<uint32_t> (pieces.size());
+        range.numPieces = static_cast<uint32_t> (pieceTimes.empty() ? 0 : pieceTimes.size() - 1);
+
+        times.insert (times.end(), pieceTimes.begin(), pieceTimes.end());
+        tracks.push_back (range);
+        durationSeconds = juce::jmax (durationSeconds, lastKeyframeSeconds);
+    }
+
+    void appendLane (int slot, Axis axis, float firstValue, float lastValue)
+    {
+        Lane lane;
+        lane.slot = static_cast<uint16_t> (slot);
+        lane.axis = axis;
+        lane.firstValue = firstValue;
+        lane.lastValue = lastValue;
+        lanes.push_back (lane);
+    }
+
+    template <typename Predicate>
+    void removeTracks (int slot, Predicate shouldRemove)
+    {
+        for (size_t i = tracks.size(); i-- > 0;)
+        {
+            const auto range = tracks[i];
+            if (range.slot != slot || ! shouldRemove (range))
+                continue;
+
+            const auto numTimes = range.numPieces > 0 ? range.numPieces + 1 : 0u;
+            const auto numPieceEntries = range.numPieces * range.laneCount;
+            times.erase (times.begin() + static_cast<std::ptrdiff_t> (range.timeBegin),
+                         times.begin() + static_cast<std::ptrdiff_t> (range.timeBegin + numTimes));
+            pieces.erase (pieces.begin() + static_cast<std::ptrdiff_t> (range.pieceBegin),
+                          pieces.begin() + static_cast<std::ptrdiff_t> (range.pieceBegin + numPieceEntries));
+            lanes.erase (lanes.begin() + static_cast<std::ptrdiff_t> (range.laneBegin),
+                         lanes.begin() + static_cast<std::ptrdiff_t> (range.laneBegin + range.laneCount));
+
+            tracks.erase (tracks.begin() + static_cast<std::ptrdiff_t> (i));
+            for (auto& other : tracks)
+            {
+                if (other.timeBegin > range.timeBegin)
+                    other.timeBegin -= numTimes;
+                if (other.pieceBegin > range.pieceBegin)
+                    other.pieceBegin -= numPieceEntries;
+                if (other.laneBegin > range.laneBegin)
+                    other.laneBegin -= range.laneCount;
+            }
+        }
+    }
+
+    std::vector<TrackRange> tracks;
+    std::vector<Lane> lanes;
+    std::vector<double> times;
+    std::vector<KeyframeSegmentPolynomial> pieces;
+    double durationSeconds = 0.0;
+    bool looping = true;
+};
@@ -2,6 +2,7 @@
 
 #include "SceneGraph.h"
 
+#include <optional>
 #include <vector>
 
 //==============================================================================
@@ -41,26 +42,34 @@ public:
                        const Vec3& velocity,
                        bool enabled)
     {
-        if (! enabled || dopplerScale <= 0.0f || delayLine.empty())
-            return;
-
-        const float distance = std::sqrt (position.x * position.x
-                                        + position.y * position.y
-                                        + position.z * position.z);
+        processBlock (monoData, numSamples, position, position, velocity, enabled);
+    }
 
-        if (distance < 1.0e-4f)
+    // Block trajectory variant: the playback ratio ramps from the radial
+    // velocity seen at startPosition to the one seen at endPosition, so a
+    // fly-by sweeps through the pitch change instead of jumping per block.
+    void processBlock (float* monoData,
+                       int numSamples,
+                       const Vec3& startPosition,
+                       const Vec3& endPosition,
+                       const Vec3& velocity,
+                       bool enabled)
+    {
+        if (! enabled || dopplerScale <= 0.0f || delayLine.empty() || numSamples <= 0)
             return;
 
-        const float radialVelocity = (velocity.x * position.x
-                                    + velocity.y * position.y
-                                    + velocity.z * position.z) / distance;
+        const auto startRatio = playbackRatio (startPosition, velocity);
+        const auto endRatio = playbackRatio (endPosition, velocity);
+        if (! startRatio.has_value() && ! endRatio.has_value())
+            return;
 
-        // Positive radial velocity means moving away from listener.
-        const float c = 343.0f;
-        const float ratio = juce::jlimit (0.5f, 2.0f, c / (c + radialVelocity * dopplerScale));
+        const float ratioStart = startRatio.value_or (*endRatio);
+        const float ratioStep = (endRatio.value_or (ratioStart) - ratioStart) / static_cast<float> (numSamples);
 
         for (int i = 0; i < numSamples; ++i)
         {
+            const float ratio = ratioStart + ratioStep * static_cast<float> (i + 1);
+
             delayLine[static_cast<size_t> (writePos)] = monoData[i];
 
             // Delay trajectory that approximates variable playback rate.
@@ -84,6 +93,26 @@ public:
     }
 
 private:
+    // Playback-rate ratio for a source at position moving with velocity;
+    // empty at the listener where the radial direction is undefined.
+    std::optional<float> playbackRatio (const Vec3& position, const Vec3& velocity) const
+    {
+        const float distance = std::sqrt (position.x * position.x
+                                        + position.y * position.y
+                                        + position.z * position.z);
+
+        if (distance < 1.0e-4f)
+            return std::nullopt;
+
+        const float radialVelocity = (velocity.x * position.x
+                                    + velocity.y * position.y
+                                    + velocity.z * position.z) / distance;
+
+        // Positive radial velocity means moving away from listener.
+        const float c = 343.0f;
+        return juce::jlimit (0.5f, 2.0f, c / (c + radialVelocity * dopplerScale));
+    }
+
     double currentSampleRate = 44100.0;
     int delayLineSize = 8192;
     int writePos = 0;
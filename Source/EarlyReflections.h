@@ -12,22 +12,29 @@
  * EarlyReflections
  *
  * Multi-tap delay network that adds room-dependent early reflections.
+ * Each channel runs its own delay line through the shared tap table, so the
+ * same instance serves the quad bed and the up-to-16-channel AtmosBed bus.
  */
 class EarlyReflections
 {
 public:
     static constexpr int NUM_SPEAKERS = 4;
+    static constexpr int MAX_CHANNELS = 16;
     static constexpr int MAX_TAPS = 16;
 
-    void prepare (double sampleRate, int maxBlockSize)
+    void prepare (double sampleRate, int maxBlockSize, int numChannelsToPrepare = NUM_SPEAKERS)
     {
         currentSampleRate = sampleRate;
+        preparedChannels = juce::jlimit (0, MAX_CHANNELS, numChannelsToPrepare);
         const int minSamples = juce::jmax (maxBlockSize * 8, static_cast<int> (sampleRate * 2.0));
 
-        for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+        for (int ch = 0; ch < MAX_CHANNELS; ++ch)
         {
-            delayLines[static_cast<size_t> (spk)].assign (static_cast<size_t> (minSamples), 0.0f);
-            writePos[static_cast<size_t> (spk)] = 0;
+            if (ch < preparedChannels)
+                delayLines[static_cast<size_t> (ch)].assign (static_cast<size_t> (minSamples), 0.0f);
+            else
+                delayLines[static_cast<size_t> (ch)].clear();
+            writePos[static_cast<size_t> (ch)] = 0;
         }
 
         updateTapTable();
@@ -49,12 +56,18 @@ public:
     void setHighQuality (bool highQuality)   { qualityHigh = highQuality; updateTapTable(); }
 
     void process (juce::AudioBuffer<float>& buffer)
+    {
+        process (buffer, buffer.getNumChannels());
+    }
+
+    // Processes the first numChannelsToProcess channels (capped at the prepared count).
+    void process (juce::AudioBuffer<float>& buffer, int numChannelsToProcess)
     {
         if (! enabled || mix <= 0.0f)
             return;
 
         const int numSamples = buffer.getNumSamples();
-        const int numChannels = juce::jmin (NUM_SPEAKERS, buffer.getNumChannels());
+        const int numChannels = juce::jmin (preparedChannels, buffer.getNumChannels(), numChannelsToProcess);
 
         for (int ch = 0; ch < numChannels; ++ch)
         {
@@ -121,6 +134,7 @@ private:
     std::array<int, MAX_TAPS> tapDelaySamples {};
     std::array<float, MAX_TAPS> tapGains {};
 
-    std::array<std::vector<float>, NUM_SPEAKERS> delayLines;
-    std::array<int, NUM_SPEAKERS> writePos {};
+    int preparedChannels = 0;
+    std::array<std::vector<float>, MAX_CHANNELS> delayLines;
+    std::array<int, MAX_CHANNELS> writePos {};
 };
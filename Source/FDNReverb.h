@@ -11,7 +11,8 @@
 /**
  * FDNReverb
  *
- * Late-reverb feedback delay network for quad output.
+ * Late-reverb feedback delay network for quad output; larger beds share the
+ * same network through per-channel quad zones (see the zoned process()).
  *
  * Draft quality: 4-line static FDN (legacy-compatible CPU profile).
  * Final quality: 8-line modulated FDN with higher diffusion.
@@ -25,6 +26,7 @@ class FDNReverb
 {
 public:
     static constexpr int NUM_CHANNELS = 4;
+    static constexpr int MAX_CHANNELS = 16;
 
     void prepare (double sampleRate, int /*maxBlockSize*/)
     {
@@ -105,80 +107,87 @@ public:
             return;
 
         const float dryMix = 1.0f - mix;
-        const int activeLines = getActiveLineCount();
 
         for (int i = 0; i < numSamples; ++i)
         {
             std::array<float, NUM_CHANNELS> dry {};
-            std::array<float, NUM_LINES> delayed {};
-            std::array<float, NUM_LINES> lineInput {};
+            std::array<float, NUM_CHANNELS> wet {};
+            std::array<float, NUM_CHANNELS> wetAlternate {};
 
             for (int ch = 0; ch < NUM_CHANNELS; ++ch)
                 dry[static_cast<size_t> (ch)] = buffer.getSample (ch, i);
 
-            // Deterministic input projection (4ch -> N lines).
-            lineInput[0] = dry[0];
-            lineInput[1] = dry[1];
-            lineInput[2] = dry[2];
-            lineInput[3] = dry[3];
-            if (activeLines == NUM_LINES)
+            tickNetwork (dry, wet, wetAlternate);
+
+            for (int ch = 0; ch < NUM_CHANNELS; ++ch)
             {
-                constexpr float kNorm = 0.70710678f;
-                lineInput[4] = (dry[0] + dry[2]) * kNorm;
-                lineInput[5] = (dry[1] + dry[3]) * kNorm;
-                lineInput[6] = (dry[0] - dry[2]) * kNorm;
-                lineInput[7] = (dry[1] - dry[3]) * kNorm;
+                const auto idx = static_cast<size_t> (ch);
+                const float wetSample = std::isfinite (wet[idx]) ? wet[idx] : 0.0f;
+                buffer.setSample (ch, i, dry[idx] * dryMix + wetSample * mix);
             }
+        }
+    }
 
-            for (int lineIdx = 0; lineIdx < activeLines; ++lineIdx)
-                delayed[static_cast<size_t> (lineIdx)] = readDelaySample (lineIdx);
+    // Multichannel beds (up to MAX_CHANNELS): each channel names the quad zone
+    // (0 FL, 1 FR, 2 RR, 3 RL) it feeds and is fed from, or -1 to bypass. Zone
+    // inputs are summed; each zone's wet output is shared at equal power by its
+    // channels, alternating between two decorrelated line mixes, so the network
+    // cost stays that of the quad bed.
+    void process (juce::AudioBuffer<float>& buffer, const std::array<int, MAX_CHANNELS>& zoneForChannel, int numChannelsToProcess)
+    {
+        if (! enabled || earlyReflectionsOnly || mix <= 0.0f)
+            return;
 
-            std::array<float, NUM_CHANNELS> wet {};
-            if (activeLines == NUM_LINES)
-            {
-                const auto mixed = hadamard8 (delayed);
+        const int numSamples = buffer.getNumSamples();
+        const int numChannels = juce::jmin (MAX_CHANNELS, buffer.getNumChannels(), numChannelsToProcess);
 
-                for (int lineIdx = 0; lineIdx < NUM_LINES; ++lineIdx)
-                {
-                    const auto idx = static_cast<size_t> (lineIdx);
-                    const float damped = dampingState[idx]
-                                       + dampingCoefficient * (mixed[idx] - dampingState[idx]);
-                    dampingState[idx] = damped;
-
-                    const float writeSample = lineInput[idx] * inputInjectionGain
-                                            + damped * feedbackGain[idx];
-                    writeDelaySample (lineIdx, writeSample);
-                    advanceLineState (lineIdx);
-                }
+        std::array<int, NUM_CHANNELS> zoneSize {};
+        std::array<int, MAX_CHANNELS> zoneRank {};
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const int zone = zoneForChannel[static_cast<size_t> (ch)];
+            if (zone < 0 || zone >= NUM_CHANNELS)
+                continue;
 
-                wet[0] = 0.5f * (delayed[0] + delayed[4]);
-                wet[1] = 0.5f * (delayed[1] + delayed[5]);
-                wet[2] = 0.5f * (delayed[2] + delayed[6]);
-                wet[3] = 0.5f * (delayed[3] + delayed[7]);
-            }
-            else
+            zoneRank[static_cast<size_t> (ch)] = zoneSize[static_cast<size_t> (zone)]++;
+        }
+
+        std::array<float, MAX_CHANNELS> wetWeight {};
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const int zone = zoneForChannel[static_cast<size_t> (ch)];
+            if (zone >= 0 && zone < NUM_CHANNELS)
+                wetWeight[static_cast<size_t> (ch)] = mix / std::sqrt (static_cast<float> (zoneSize[static_cast<size_t> (zone)]));
+        }
+
+        const float dryMix = 1.0f - mix;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            std::array<float, NUM_CHANNELS> zoneInput {};
+            std::array<float, NUM_CHANNELS> wet {};
+            std::array<float, NUM_CHANNELS> wetAlternate {};
+
+            for (int ch = 0; ch < numChannels; ++ch)
             {
-                const auto mixed = hadamard4 (delayed);
-                for (int lineIdx = 0; lineIdx < NUM_CHANNELS; ++lineIdx)
-                {
-                    const auto idx = static_cast<size_t> (lineIdx);
-                    const float damped = dampingState[idx]
-                                       + dampingCoefficient * (mixed[idx] - dampingState[idx]);
-                    dampingState[idx] = damped;
-
-                    const float writeSample = lineInput[idx] * inputInjectionGain
-                                            + damped * feedbackGain[idx];
-                    writeDelaySample (lineIdx, writeSample);
-                    advanceLineState (lineIdx);
-                    wet[idx] = delayed[idx];
-                }
+                const int zone = zoneForChannel[static_cast<size_t> (ch)];
+                if (zone >= 0 && zone < NUM_CHANNELS)
+                    zoneInput[static_cast<size_t> (zone)] += buffer.getSample (ch, i);
             }
 
-            for (int ch = 0; ch < NUM_CHANNELS; ++ch)
+            tickNetwork (zoneInput, wet, wetAlternate);
+
+            for (int ch = 0; ch < numChannels; ++ch)
             {
                 const auto idx = static_cast<size_t> (ch);
-                const float wetSample = std::isfinite (wet[idx]) ? wet[idx] : 0.0f;
-                buffer.setSample (ch, i, dry[idx] * dryMix + wetSample * mix);
+                const int zone = zoneForChannel[idx];
+                if (zone < 0 || zone >= NUM_CHANNELS)
+                    continue;
+
+                const auto zoneIdx = static_cast<size_t> (zone);
+                const float wetSample = (zoneRank[idx] % 2 == 0) ? wet[zoneIdx] : wetAlternate[zoneIdx];
+                buffer.setSample (ch, i, buffer.getSample (ch, i) * dryMix
+                                             + (std::isfinite (wetSample) ? wetSample : 0.0f) * wetWeight[idx]);
             }
         }
     }
@@ -196,6 +205,77 @@ private:
     // Modulation depth cap at REFERENCE_SAMPLE_RATE; scaled by srScale in updateCoefficients().
     static constexpr float MAX_MOD_DEPTH_SAMPLES_REF = 48.0f;
 
+    // One network frame. wet[z] is the quad-zone output; wetAlternate[z] has
+    // the same power from an orthogonal line mix (sign-flipped pair in 8-line
+    // mode, adjacent-line difference in 4-line mode).
+    void tickNetwork (const std::array<float, NUM_CHANNELS>& dry,
+                      std::array<float, NUM_CHANNELS>& wet,
+                      std::array<float, NUM_CHANNELS>& wetAlternate) noexcept
+    {
+        const int activeLines = getActiveLineCount();
+        std::array<float, NUM_LINES> delayed {};
+        std::array<float, NUM_LINES> lineInput {};
+
+        // Deterministic input projection (4ch -> N lines).
+        lineInput[0] = dry[0];
+        lineInput[1] = dry[1];
+        lineInput[2] = dry[2];
+        lineInput[3] = dry[3];
+        if (activeLines == NUM_LINES)
+        {
+            constexpr float kNorm = 0.70710678f;
+            lineInput[4] = (dry[0] + dry[2]) * kNorm;
+            lineInput[5] = (dry[1] + dry[3]) * kNorm;
+            lineInput[6] = (dry[0] - dry[2]) * kNorm;
+            lineInput[7] = (dry[1] - dry[3]) * kNorm;
+        }
+
+        for (int lineIdx = 0; lineIdx < activeLines; ++lineIdx)
+            delayed[static_cast<size_t> (lineIdx)] = readDelaySample (lineIdx);
+
+        if (activeLines == NUM_LINES)
+        {
+            const auto mixed = hadamard8 (delayed);
+
+            for (int lineIdx = 0; lineIdx < NUM_LINES; ++lineIdx)
+            {
+                const auto idx = static_cast<size_t> (lineIdx);
+                const float damped = dampingState[idx]
+                                   + dampingCoefficient * (mixed[idx] - dampingState[idx]);
+                dampingState[idx] = damped;
+
+                const float writeSample = lineInput[idx] * inputInjectionGain
+                                        + damped * feedbackGain[idx];
+                writeDelaySample (lineIdx, writeSample);
+                advanceLineState (lineIdx);
+            }
+
+            for (size_t zone = 0; zone < static_cast<size_t> (NUM_CHANNELS); ++zone)
+            {
+                wet[zone] = 0.5f * (delayed[zone] + delayed[zone + 4]);
+                wetAlternate[zone] = 0.5f * (delayed[zone] - delayed[zone + 4]);
+            }
+        }
+        else
+        {
+            const auto mixed = hadamard4 (delayed);
+            for (int lineIdx = 0; lineIdx < NUM_CHANNELS; ++lineIdx)
+            {
+                const auto idx = static_cast<size_t> (lineIdx);
+                const float damped = dampingState[idx]
+                                   + dampingCoefficient * (mixed[idx] - dampingState[idx]);
+                dampingState[idx] = damped;
+
+                const float writeSample = lineInput[idx] * inputInjectionGain
+                                        + damped * feedbackGain[idx];
+                writeDelaySample (lineIdx, writeSample);
+                advanceLineState (lineIdx);
+                wet[idx] = delayed[idx];
+                wetAlternate[idx] = 0.70710678f * (delayed[idx] - delayed[(idx + 1) % static_cast<size_t> (NUM_CHANNELS)]);
+            }
+        }
+    }
+
     static std::array<float, NUM_LINES> hadamard8 (const std::array<float, NUM_LINES>& input) noexcept
     {
         auto output = input;
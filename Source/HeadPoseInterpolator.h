@@ -7,31 +7,363 @@
 //   - Quaternion slerp interpolation between the two most recent snapshots.
 //   - Bounded angular-velocity prediction (max extrapolation min(50ms, π/4/‖angV‖)).
 //   - Sensor-switch crossfade (50ms blend on earbud location change).
+//   - Optional predictive mode: error-state Kalman filter on the quaternion with
+//     gyro input, online sender-clock/jitter estimation, and prediction to the
+//     audio output time (now + configurable lookahead).
 //
 // Usage (processBlock):
 //   if (const auto* pose = bridge.currentPose())
 //   {
-//       const float nowMs = static_cast<float>(juce::Time::getMillisecondCounterHiRes());
+//       const double nowMs = juce::Time::getMillisecondCounterHiRes();
+//       headPoseInterpolator.setPredictionLookaheadMs(outputLatencyMs);
 //       headPoseInterpolator.ingest(*pose, nowMs);
-//       const auto interpolated = headPoseInterpolator.interpolatedAt(nowMs);
-//       ... apply interpolated to renderer ...
+//       for each key k across the block (renderer.getHeadPoseKeyInterval):
+//           keys[k] = headPoseInterpolator.interpolatedAt(nowMs + keyOffsetMs(k));
+//       renderer.applyHeadPoseTrajectory(keys, numKeys, keyInterval);
 //   }
 
 #include "HeadTrackingBridge.h"
 
+#include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 
+//==============================================================================
+// Error-state Kalman filter for head orientation. Nominal state is the
+// quaternion q plus body-frame angular velocity ω; the 6-dim error state is
+// (δθ, δω) with a constant-angular-velocity model driven by angular-
+// acceleration noise. Orientation packets correct δθ, gyro rates (v2
+// packets) correct δω. Measurement times are sender timestamps, so network
+// jitter does not bend the trajectory; the arrival-delay spread is tracked
+// online and inflates the orientation noise at high angular rates.
+class HeadPoseKalmanFilter
+{
+public:
+    void reset() noexcept
+    {
+        initialised = false;
+        clockInitialised = false;
+        jitterMeanMs = 0.0;
+        jitterVarMs2 = 0.0;
+    }
+
+    bool isInitialised() const noexcept { return initialised; }
+
+    // Spread (1σ) of packet arrival delay beyond the fastest recent packet.
+    double getJitterMs() const noexcept { return std::sqrt (std::max (0.0, jitterVarMs2)); }
+
+    void update (const HeadTrackingPoseSnapshot& snap, double localNowMs) noexcept
+    {
+        const double senderMs = trackSenderClock (snap, localNowMs);
+
+        Quat measured { snap.qw, snap.qx, snap.qy, snap.qz };
+        if (! normalise (measured))
+            return;
+
+        if (! initialised || senderMs - stateTimeMs > kReinitialiseGapMs)
+        {
+            initialise (measured, snap, senderMs);
+            return;
+        }
+
+        const double dtSec = std::max (0.0, senderMs - stateTimeMs) / 1000.0;
+        if (dtSec > 0.0)
+        {
+            predictCovariance (dtSec);
+            q = multiply (q, expMap ({ omega[0] * dtSec, omega[1] * dtSec, omega[2] * dtSec }));
+            normalise (q);
+            stateTimeMs = senderMs;
+        }
+
+        // Orientation: residual is the small rotation from the estimate to the measurement.
+        Quat delta = multiply (conjugate (q), measured);
+        if (delta.w < 0.0)
+            delta = { -delta.w, -delta.x, -delta.y, -delta.z };
+
+        const double omegaMag = std::sqrt (omega[0] * omega[0] + omega[1] * omega[1] + omega[2] * omega[2]);
+        const double timingSigmaRad = omegaMag * getJitterMs() / 1000.0 * kJitterTimingFraction;
+        const double orientationVar = kOrientationSigmaRad * kOrientationSigmaRad + timingSigmaRad * timingSigmaRad;
+        correct (0, { 2.0 * delta.x, 2.0 * delta.y, 2.0 * delta.z }, orientationVar);
+
+        if ((snap.sensorLocationFlags & 0x4u) != 0
+            && std::isfinite (snap.angVx) && std::isfinite (snap.angVy) && std::isfinite (snap.angVz))
+        {
+            correct (3,
+                     { snap.angVx - omega[0], snap.angVy - omega[1], snap.angVz - omega[2] },
+                     kGyroSigmaRadPerSec * kGyroSigmaRadPerSec);
+        }
+    }
+
+    // Orientation predicted to a local time, capped like the interpolating path
+    // (horizon and π/4 of rotation).
+    void predictAt (double localMs, double maxHorizonMs, float& qx, float& qy, float& qz, float& qw) const noexcept
+    {
+        const double omegaMag = std::sqrt (omega[0] * omega[0] + omega[1] * omega[1] + omega[2] * omega[2]);
+        const double capMs = std::min (maxHorizonMs, 1000.0 * kPiOver4 / std::max (omegaMag, 1.0e-6));
+        const double dtSec = std::clamp (localMs - senderClockOffsetMs - stateTimeMs, 0.0, capMs) / 1000.0;
+
+        auto predicted = multiply (q, expMap ({ omega[0] * dtSec, omega[1] * dtSec, omega[2] * dtSec }));
+        normalise (predicted);
+        qw = static_cast<float> (predicted.w);
+        qx = static_cast<float> (predicted.x);
+        qy = static_cast<float> (predicted.y);
+        qz = static_cast<float> (predicted.z);
+    }
+
+private:
+    struct Quat { double w = 1.0, x = 0.0, y = 0.0, z = 0.0; };
+    using Vec3 = std::array<double, 3>;
+    using Mat6 = std::array<double, 36>;
+
+    static constexpr double kAngularAccelSigma = 40.0;        // rad/s², head motion
+    static constexpr double kOrientationSigmaRad = 0.01;      // ≈0.6° sensor noise
+    static constexpr double kGyroSigmaRadPerSec = 0.05;
+    static constexpr double kJitterTimingFraction = 0.5;      // share of arrival jitter seen as stamp error
+    static constexpr double kReinitialiseGapMs = 500.0;       // stream restart / dropout
+    static constexpr double kBaselineLeakMsPerSec = 0.5;      // lets the min-delay baseline follow drift
+    static constexpr double kJitterSmoothing = 0.05;
+    static constexpr double kPiOver4 = 0.78539816339744830;
+
+    static Quat multiply (const Quat& a, const Quat& b) noexcept
+    {
+        return { a.w * b.w - a.x * b.x - a.y * b.y - a.z * b.z,
+                 a.w * b.x + a.x * b.w + a.y * b.z - a.z * b.y,
+                 a.w * b.y - a.x * b.z + a.y * b.w + a.z * b.x,
+                 a.w * b.z + a.x * b.y - a.y * b.x + a.z * b.w };
+    }
+
+    static Quat conjugate (const Quat& a) noexcept { return { a.w, -a.x, -a.y, -a.z }; }
+
+    static bool normalise (Quat& a) noexcept
+    {
+        const double normSq = a.w * a.w + a.x * a.x + a.y * a.y + a.z * a.z;
+        if (! std::isfinite (normSq) || normSq < 1.0e-12)
+            return false;
+        const double inv = 1.0 / std::sqrt (normSq);
+        a = { a.w * inv, a.x * inv, a.y * inv, a.z * inv };
+        return true;
+    }
+
+    static Quat expMap (const Vec3& rotation) noexcept
+    {
+        const double angle = std::sqrt (rotation[0] * rotation[0] + rotation[1] * rotation[1] + rotation[2] * rotation[2]);
+        if (angle < 1.0e-9)
+            return { 1.0, 0.5 * rotation[0], 0.5 * rotation[1], 0.5 * rotation[2] };
+        const double s = std::sin (0.5 * angle) / angle;
+        return { std::cos (0.5 * angle), rotation[0] * s, rotation[1] * s, rotation[2] * s };
+    }
+
+    // Maps the sender's clock onto the caller's. The offset baseline tracks the
+    // fastest recent packet (slowly leaking upward for drift); the excess over
+    // it is the arrival jitter.
+    double trackSenderClock (const HeadTrackingPoseSnapshot& snap, double localNowMs) noexcept
+    {
+        if (snap.timestampMs == 0)
+            return localNowMs - senderClockOffsetMs; // unstamped: assume on-time arrival
+
+        const double senderMs = static_cast<double> (snap.timestampMs);
+        const double offsetMs = localNowMs - senderMs;
+
+        if (! clockInitialised)
+        {
+            senderClockOffsetMs = offsetMs;
+            lastClockUpdateLocalMs = localNowMs;
+            clockInitialised = true;
+            return senderMs;
+        }
+
+        const double elapsedSec = std::max (0.0, localNowMs - lastClockUpdateLocalMs) / 1000.0;
+        lastClockUpdateLocalMs = localNowMs;
+        senderClockOffsetMs = std::min (senderClockOffsetMs + kBaselineLeakMsPerSec * elapsedSec, offsetMs);
+
+        const double excessMs = offsetMs - senderClockOffsetMs;
+        const double deviation = excessMs - jitterMeanMs;
+        jitterMeanMs += kJitterSmoothing * deviation;
+        jitterVarMs2 += kJitterSmoothing * (deviation * deviation - jitterVarMs2);
+        return senderMs;
+    }
+
+    void initialise (const Quat& measured, const HeadTrackingPoseSnapshot& snap, double senderMs) noexcept
+    {
+        q = measured;
+        const bool hasRate = (snap.sensorLocationFlags & 0x4u) != 0;
+        omega = hasRate ? Vec3 { snap.angVx, snap.angVy, snap.angVz } : Vec3 { 0.0, 0.0, 0.0 };
+        P.fill (0.0);
+        for (int i = 0; i < 3; ++i)
+        {
+            P[static_cast<size_t> (i * 6 + i)] = kOrientationSigmaRad * kOrientationSigmaRad;
+            P[static_cast<size_t> ((i + 3) * 6 + i + 3)] = hasRate ? kGyroSigmaRadPerSec * kGyroSigmaRadPerSec : 4.0;
+        }
+        stateTimeMs = senderMs;
+        initialised = true;
+    }
+
+    // P <- F P Fᵀ + Q with F = [[I - [ωdt]×, I dt], [0, I]].
+    void predictCovariance (double dt) noexcept
+    {
+        Mat6 F {};
+        for (int i = 0; i < 6; ++i)
+            F[static_cast<size_t> (i * 6 + i)] = 1.0;
+        const double wx = omega[0] * dt, wy = omega[1] * dt, wz = omega[2] * dt;
+        F[1] = wz;  F[2] = -wy;
+        F[6] = -wz; F[8] = wx;
+        F[12] = wy; F[13] = -wx;
+        for (int i = 0; i < 3; ++i)
+            F[static_cast<size_t> (i * 6 + i + 3)] = dt;
+
+        Mat6 FP {};
+        for (int r = 0; r < 6; ++r)
+            for (int c = 0; c < 6; ++c)
+            {
+                double sum = 0.0;
+                for (int k = 0; k < 6; ++k)
+                    sum += F[static_cast<size_t> (r * 6 + k)] * P[static_cast<size_t> (k * 6 + c)];
+                FP[static_cast<size_t> (r * 6 + c)] = sum;
+            }
+
+        const double qa = kAngularAccelSigma * kAngularAccelSigma;
+        for (int r = 0; r < 6; ++r)
+            for (int c = 0; c < 6; ++c)
+            {
+                double sum = 0.0;
+                for (int k = 0; k < 6; ++k)
+                    sum += FP[static_cast<size_t> (r * 6 + k)] * F[static_cast<size_t> (c * 6 + k)];
+                P[static_cast<size_t> (r * 6 + c)] = sum;
+            }
+
+        for (int i = 0; i < 3; ++i)
+        {
+            P[static_cast<size_t> (i * 6 + i)] += qa * dt * dt * dt / 3.0;
+            P[static_cast<size_t> (i * 6 + i + 3)] += qa * dt * dt / 2.0;
+            P[static_cast<size_t> ((i + 3) * 6 + i)] += qa * dt * dt / 2.0;
+            P[static_cast<size_t> ((i + 3) * 6 + i + 3)] += qa * dt;
+        }
+    }
+
+    // Kalman update for a 3-dim measurement of the error-state block starting
+    // at `offset` (0 = δθ, 3 = δω) with isotropic variance, then injection
+    // into the nominal state.
+    void correct (int offset, const Vec3& residual, double variance) noexcept
+    {
+        std::array<double, 9> S {};
+        for (int r = 0; r < 3; ++r)
+            for (int c = 0; c < 3; ++c)
+                S[static_cast<size_t> (r * 3 + c)] = P[static_cast<size_t> ((offset + r) * 6 + offset + c)]
+                                                     + (r == c ? variance : 0.0);
+
+        std::array<double, 9> Sinv {};
+        if (! invert3 (S, Sinv))
+            return;
+
+        std::array<double, 18> K {}; // 6x3 = P Hᵀ S⁻¹
+        for (int r = 0; r < 6; ++r)
+            for (int c = 0; c < 3; ++c)
+            {
+                double sum = 0.0;
+                for (int k = 0; k < 3; ++k)
+                    sum += P[static_cast<size_t> (r * 6 + offset + k)] * Sinv[static_cast<size_t> (k * 3 + c)];
+                K[static_cast<size_t> (r * 3 + c)] = sum;
+            }
+
+        std::array<double, 6> dx {};
+        for (int r = 0; r < 6; ++r)
+            dx[static_cast<size_t> (r)] = K[static_cast<size_t> (r * 3)] * residual[0]
+                                        + K[static_cast<size_t> (r * 3 + 1)] * residual[1]
+                                        + K[static_cast<size_t> (r * 3 + 2)] * residual[2];
+
+        // P <- (I - K H) P, then re-symmetrise.
+        Mat6 updated = P;
+        for (int r = 0; r < 6; ++r)
+            for (int c = 0; c < 6; ++c)
+            {
+                double sum = 0.0;
+                for (int k = 0; k < 3; ++k)
+                    sum += K[static_cast<size_t> (r * 3 + k)] * P[static_cast<size_t> ((offset + k) * 6 + c)];
+                updated[static_cast<size_t> (r * 6 + c)] -= sum;
+            }
+        for (int r = 0; r < 6; ++r)
+            for (int c = r + 1; c < 6; ++c)
+            {
+                const double mean = 0.5 * (updated[static_cast<size_t> (r * 6 + c)] + updated[static_cast<size_t> (c * 6 + r)]);
+                updated[static_cast<size_t> (r * 6 + c)] = mean;
+                updated[static_cast<size_t> (c * 6 + r)] = mean;
+            }
+        P = updated;
+
+        q = multiply (q, expMap ({ dx[0], dx[1], dx[2] }));
+        normalise (q);
+        for (size_t i = 0; i < 3; ++i)
+            omega[i] += dx[i + 3];
+    }
+
+    static bool invert3 (const std::array<double, 9>& m, std::array<double, 9>& inv) noexcept
+    {
+        const double c00 = m[4] * m[8] - m[5] * m[7];
+        const double c01 = m[5] * m[6] - m[3] * m[8];
+        const double c02 = m[3] * m[7] - m[4] * m[6];
+        const double det = m[0] * c00 + m[1] * c01 + m[2] * c02;
+        if (! std::isfinite (det) || std::abs (det) < 1.0e-18)
+            return false;
+
+        const double invDet = 1.0 / det;
+        inv = { c00 * invDet, (m[2] * m[7] - m[1] * m[8]) * invDet, (m[1] * m[5] - m[2] * m[4]) * invDet,
+                c01 * invDet, (m[0] * m[8] - m[2] * m[6]) * invDet, (m[2] * m[3] - m[0] * m[5]) * invDet,
+                c02 * invDet, (m[1] * m[6] - m[0] * m[7]) * invDet, (m[0] * m[4] - m[1] * m[3]) * invDet };
+        return true;
+    }
+
+    Quat q {};
+    Vec3 omega { 0.0, 0.0, 0.0 };
+    Mat6 P {};
+    double stateTimeMs = 0.0;          // sender clock
+    double senderClockOffsetMs = 0.0;  // local - sender, fastest-packet baseline
+    double lastClockUpdateLocalMs = 0.0;
+    double jitterMeanMs = 0.0;
+    double jitterVarMs2 = 0.0;
+    bool initialised = false;
+    bool clockInitialised = false;
+};
+
+//==============================================================================
 class HeadPoseInterpolator
 {
 public:
+    enum class FilterMode : int
+    {
+        Interpolate = 0,      // slerp between the last two snapshots + bounded prediction
+        PredictiveKalman = 1  // error-state Kalman filter predicted to output time
+    };
+
     HeadPoseInterpolator() = default;
 
+    void setFilterMode (FilterMode newMode) noexcept
+    {
+        if (newMode == filterMode)
+            return;
+
+        filterMode = newMode;
+        kalman.reset();
+    }
+
+    FilterMode getFilterMode() const noexcept { return filterMode; }
+
+    // Predictive mode only: how far past the query time the pose is predicted,
+    // normally the measured output latency (block + plugin + device).
+    void setPredictionLookaheadMs (double lookaheadMs) noexcept
+    {
+        predictionLookaheadMs = std::isfinite (lookaheadMs) ? std::clamp (lookaheadMs, 0.0, kMaxLookaheadMs) : 0.0;
+    }
+
+    double getPredictionLookaheadMs() const noexcept { return predictionLookaheadMs; }
+
+    double getEstimatedJitterMs() const noexcept { return kalman.getJitterMs(); }
+
     // Ingest a new snapshot. Safe to call on the audio thread.
     // Duplicate snapshots (same seq) are silently ignored.
     // On earbud sensor-location change: captures the current interpolation as the
     // blend-out pose and starts a 50ms crossfade to the new sensor's orientation.
-    void ingest (const HeadTrackingPoseSnapshot& snap, float nowMs) noexcept
+    void ingest (const HeadTrackingPoseSnapshot& snap, double nowMs) noexcept
     {
         // Skip if same snapshot (bridge has not published a new one since last call)
         if (hasPrev && snap.seq == currSnapshot.seq)
@@ -50,20 +382,51 @@ public:
         currSnapshot = snap;
         hasPrev     = true;
         prevSensorLocation = newLoc;
+
+        if (filterMode == FilterMode::PredictiveKalman)
+            kalman.update (snap, nowMs);
     }
 
     // Return the best-estimate pose at nowMs.
     // Applies slerp, optional angular-velocity prediction, and crossfade if active.
     // Const + allocation-free; safe on the audio thread.
-    HeadTrackingPoseSnapshot interpolatedAt (float nowMs) const noexcept
+    HeadTrackingPoseSnapshot interpolatedAt (double nowMsPrecise) const noexcept
     {
-        // Track block dt for blend countdown
-        const float blockDt = (lastInterpolatedMs > 0.0f) ? (nowMs - lastInterpolatedMs) : 0.0f;
-        lastInterpolatedMs = nowMs;
+        const auto nowMs = static_cast<float> (nowMsPrecise);
+
+        // Track dt for blend countdown. Callers sample ahead across a block, so the
+        // next block's first call can land slightly before the last one.
+        const float blockDt = (lastInterpolatedMs > 0.0f) ? std::max (0.0f, nowMs - lastInterpolatedMs) : 0.0f;
+        lastInterpolatedMs = std::max (lastInterpolatedMs, nowMs);
 
         if (!hasPrev)
             return currSnapshot; // identity quaternion until first snapshot
 
+        HeadTrackingPoseSnapshot result = currSnapshot;
+
+        if (filterMode == FilterMode::PredictiveKalman && kalman.isInitialised())
+            kalman.predictAt (nowMsPrecise + predictionLookaheadMs,
+                              predictionLookaheadMs + kMaxPredictionMs,
+                              result.qx, result.qy, result.qz, result.qw);
+        else
+            result = interpolateSnapshots (nowMs);
+
+        // ── Sensor-switch crossfade ────────────────────────────────────────
+        if (sensorSwitchBlendRemaining > 0.0f)
+        {
+            // alpha: 0 = fully blendOut (old sensor), 1 = fully result (new sensor)
+            const float alpha = 1.0f - (sensorSwitchBlendRemaining / kSensorSwitchBlendMs);
+            result = slerpSnapshots (blendOutSnapshot, result, clamp01 (alpha));
+            sensorSwitchBlendRemaining = std::max (0.0f, sensorSwitchBlendRemaining - blockDt);
+        }
+
+        return result;
+    }
+
+private:
+    // Slerp between the last two snapshots plus bounded angular-velocity prediction.
+    HeadTrackingPoseSnapshot interpolateSnapshots (float nowMs) const noexcept
+    {
         const float prevTs = static_cast<float> (prevSnapshot.timestampMs);
         const float currTs = static_cast<float> (currSnapshot.timestampMs);
 
@@ -119,22 +482,13 @@ public:
             }
         }
 
-        // ── Sensor-switch crossfade ────────────────────────────────────────
-        if (sensorSwitchBlendRemaining > 0.0f)
-        {
-            // alpha: 0 = fully blendOut (old sensor), 1 = fully result (new sensor)
-            const float alpha = 1.0f - (sensorSwitchBlendRemaining / kSensorSwitchBlendMs);
-            result = slerpSnapshots (blendOutSnapshot, result, clamp01 (alpha));
-            sensorSwitchBlendRemaining = std::max (0.0f, sensorSwitchBlendRemaining - blockDt);
-        }
-
         return result;
     }
 
-private:
     static constexpr float kMaxPredictionMs    = 50.0f;
     static constexpr float kSensorSwitchBlendMs = 50.0f;
     static constexpr float kPiOver4            = 0.78539816339744830f; // π/4
+    static constexpr double kMaxLookaheadMs    = 200.0;
 
     static float clamp01 (float v) noexcept
     {
@@ -205,6 +559,10 @@ private:
     bool         hasPrev           = false;
     std::uint8_t prevSensorLocation = 0;
 
+    FilterMode          filterMode            = FilterMode::Interpolate;
+    HeadPoseKalmanFilter kalman;
+    double              predictionLookaheadMs = 0.0;
+
     mutable float sensorSwitchBlendRemaining = 0.0f; // ms remaining in crossfade
     mutable float lastInterpolatedMs         = 0.0f; // for blockDt computation
 };
@@ -2,8 +2,10 @@
 
 #include <juce_core/juce_core.h>
 
+#include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
@@ -13,6 +15,14 @@
  #include <pthread.h>
 #endif
 
+#if JUCE_LINUX
+ #include <arpa/inet.h>
+ #include <netinet/in.h>
+ #include <sys/socket.h>
+ #include <sys/uio.h>
+ #include <time.h>
+#endif
+
 #ifndef LOCUS_HEAD_TRACKING
  #define LOCUS_HEAD_TRACKING 0
 #endif
@@ -29,16 +39,122 @@ struct alignas(16) HeadTrackingPoseSnapshot
     float angVx = 0.0f;           // +32  rad/s body frame; 0 for v1 packets
     float angVy = 0.0f;           // +36
     float angVz = 0.0f;           // +40
-    std::uint32_t sensorLocationFlags = 0; // +44  bits[1:0]=location, bit[2]=hasRotationRate
+    std::uint32_t sensorLocationFlags = 0; // +44  bits[1:0]=location, bit[2]=hasRotationRate, bits[15:8]=listenerId
 };                                // = 48 bytes
 
 static_assert (sizeof (HeadTrackingPoseSnapshot) == 48, "HeadTrackingPoseSnapshot size contract");
 
+// Lock-free latency histogram for head-tracking diagnostics. Any thread may
+// record; bins are log2-spaced milliseconds so sub-ms loopback transit and
+// multi-block stalls both stay readable.
+class HeadTrackingLatencyHistogram final
+{
+public:
+    static constexpr int kNumBins = 12;
+    // Upper bin edges in ms; the last bin is open-ended.
+    static constexpr std::array<double, kNumBins - 1> kBinUpperEdgesMs
+    {
+        0.25, 0.5, 1.0, 2.0, 4.0, 8.0, 16.0, 32.0, 64.0, 128.0, 256.0
+    };
+
+    struct Snapshot
+    {
+        std::array<std::uint32_t, kNumBins> counts {};
+        std::uint32_t count = 0;
+        double meanMs = 0.0;
+        double maxMs = 0.0;
+        double p50Ms = 0.0; // upper edge of the bin holding the percentile
+        double p95Ms = 0.0;
+    };
+
+    void record (double latencyMs) noexcept
+    {
+        if (! std::isfinite (latencyMs))
+            return;
+
+        const auto clampedMs = std::max (0.0, latencyMs);
+        size_t bin = 0;
+        while (bin < kBinUpperEdgesMs.size() && clampedMs > kBinUpperEdgesMs[bin])
+            ++bin;
+
+        counts[bin].fetch_add (1, std::memory_order_relaxed);
+        total.fetch_add (1, std::memory_order_relaxed);
+
+        const auto micros = static_cast<std::uint64_t> (clampedMs * 1000.0);
+        sumMicros.fetch_add (micros, std::memory_order_relaxed);
+        auto currentMax = maxMicros.load (std::memory_order_relaxed);
+        while (micros > currentMax
+               && ! maxMicros.compare_exchange_weak (currentMax, micros, std::memory_order_relaxed))
+        {
+        }
+    }
+
+    Snapshot snapshot() const noexcept
+    {
+        Snapshot result;
+        for (size_t bin = 0; bin < counts.size(); ++bin)
+        {
+            result.counts[bin] = counts[bin].load (std::memory_order_relaxed);
+            result.count += result.counts[bin];
+        }
+
+        if (result.count == 0)
+            return result;
+
+        result.meanMs = static_cast<double> (sumMicros.load (std::memory_order_relaxed))
+                        / (1000.0 * static_cast<double> (result.count));
+        result.maxMs = static_cast<double> (maxMicros.load (std::memory_order_relaxed)) / 1000.0;
+        result.p50Ms = percentileMs (result, 0.50);
+        result.p95Ms = percentileMs (result, 0.95);
+        return result;
+    }
+
+private:
+    static double percentileMs (const Snapshot& s, double fraction) noexcept
+    {
+        const auto target = static_cast<std::uint64_t> (std::ceil (fraction * static_cast<double> (s.count)));
+        std::uint64_t cumulative = 0;
+        for (size_t bin = 0; bin < s.counts.size(); ++bin)
+        {
+            cumulative += s.counts[bin];
+            if (cumulative >= target)
+                return bin < kBinUpperEdgesMs.size() ? std::min (kBinUpperEdgesMs[bin], s.maxMs) : s.maxMs;
+        }
+        return s.maxMs;
+    }
+
+    std::array<std::atomic<std::uint32_t>, kNumBins> counts {};
+    std::atomic<std::uint32_t> total { 0 };
+    std::atomic<std::uint64_t> sumMicros { 0 };
+    std::atomic<std::uint64_t> maxMicros { 0 };
+};
+
+// Sender timestamp -> socket arrival -> audio-thread consumption, all on the
+// wall clock (the companion stamps epoch milliseconds).
+struct HeadTrackingLatencyDiagnostics
+{
+    HeadTrackingLatencyHistogram::Snapshot transit;   // sender -> arrival
+    HeadTrackingLatencyHistogram::Snapshot consume;   // arrival -> audio thread
+    HeadTrackingLatencyHistogram::Snapshot endToEnd;  // sender -> audio thread
+    std::uint32_t receiveBatches = 0;
+    std::uint32_t packetsReceived = 0;
+    std::uint32_t packetsCoalesced = 0; // valid packets superseded by a fresher one in the same batch
+    bool kernelTimestamps = false;      // SO_TIMESTAMPNS arrival stamps (Linux)
+    bool batchedReceive = false;        // recvmmsg fast path (Linux)
+};
+
+inline std::uint64_t headTrackingWallClockMicros() noexcept
+{
+    return static_cast<std::uint64_t> (std::chrono::duration_cast<std::chrono::microseconds> (
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
 #if LOCUS_HEAD_TRACKING
 class HeadTrackingBridge final
 {
 public:
     using PoseSnapshot = HeadTrackingPoseSnapshot;
+    static constexpr int kMaxListeners = 8;
 
     struct Config
     {
@@ -89,13 +205,36 @@ public:
         core.reset();
     }
 
+    // Pose of the subscribed listener stream (see subscribeListener).
     const PoseSnapshot* currentPose() const noexcept
     {
         if (const auto* sharedCore = corePtr.load (std::memory_order_acquire))
-            return sharedCore->currentPose();
+            return sharedCore->currentPose (listenerId.load (std::memory_order_relaxed));
         return nullptr;
     }
 
+    // Each bridge instance follows one listener stream. Senders tag packets
+    // with a listener ID (v2 sensorLocationFlags bits[15:8]; v1 packets and
+    // untagged senders are listener 0), so several people can monitor their
+    // own binaural mix off one receiver. Cheap enough to call every block.
+    void subscribeListener (int newListenerId) noexcept
+    {
+        listenerId.store (juce::jlimit (0, kMaxListeners - 1, newListenerId), std::memory_order_relaxed);
+    }
+
+    int getListenerId() const noexcept
+    {
+        return listenerId.load (std::memory_order_relaxed);
+    }
+
+    // Bit n set once listener n has published a pose.
+    std::uint32_t getActiveListenerMask() const noexcept
+    {
+        if (const auto* sharedCore = corePtr.load (std::memory_order_acquire))
+            return sharedCore->getActiveListenerMask();
+        return 0;
+    }
+
     std::uint32_t getInvalidPacketCount() const noexcept
     {
         if (const auto* sharedCore = corePtr.load (std::memory_order_acquire))
@@ -110,6 +249,41 @@ public:
         return 0;
     }
 
+    // Audio thread: records arrival -> consumption and sender -> consumption
+    // latency the first time a published pose is picked up by this instance.
+    // Pass the copy of currentPose() that was actually used; its arrival
+    // stamp is matched by sequence number, so a pose republished into the
+    // same slot meanwhile is never paired with the wrong arrival.
+    void notePoseConsumed (const PoseSnapshot& pose) noexcept
+    {
+        auto* sharedCore = corePtr.load (std::memory_order_acquire);
+        if (sharedCore == nullptr)
+            return;
+
+        // Sequence numbers are per sender stream, so a listener switch starts
+        // the duplicate check over.
+        const auto listener = listenerId.load (std::memory_order_relaxed);
+        if (listener != lastConsumedListener)
+        {
+            lastConsumedListener = listener;
+            hasConsumedPose = false;
+        }
+
+        if (hasConsumedPose && pose.seq == lastConsumedSeq)
+            return;
+
+        hasConsumedPose = true;
+        lastConsumedSeq = pose.seq;
+        sharedCore->recordConsumption (listener, pose, headTrackingWallClockMicros());
+    }
+
+    HeadTrackingLatencyDiagnostics getLatencyDiagnostics() const noexcept
+    {
+        if (const auto* sharedCore = corePtr.load (std::memory_order_acquire))
+            return sharedCore->getLatencyDiagnostics();
+        return {};
+    }
+
 private:
     class SharedCore final : private juce::Thread
     {
@@ -121,8 +295,6 @@ private:
                   static_cast<std::uint64_t> (juce::Time::currentTimeMillis())
                   ^ static_cast<std::uint64_t> (juce::Time::getMillisecondCounter())))
         {
-            slots[0] = PoseSnapshot {};
-            slots[1] = PoseSnapshot {};
         }
 
         ~SharedCore() override
@@ -153,9 +325,30 @@ private:
                 return false;
             }
 
+           #if JUCE_LINUX
+            {
+                const int enable = 1;
+                kernelTimestamps.store (::setsockopt (socket->getRawSocketHandle(),
+                                                      SOL_SOCKET,
+                                                      SO_TIMESTAMPNS,
+                                                      &enable,
+                                                      static_cast<socklen_t> (sizeof (enable))) == 0,
+                                        std::memory_order_relaxed);
+            }
+           #endif
+
             ackSocket = std::make_unique<juce::DatagramSocket> (false);
             ackSocket->setEnablePortReuse (true);
 
+           #if JUCE_LINUX
+            // Numeric IPv4 ack addresses take the sendmmsg batch path; anything
+            // else falls back to DatagramSocket::write per ack.
+            ackDestination = {};
+            ackDestination.sin_family = AF_INET;
+            ackDestination.sin_port = htons (static_cast<std::uint16_t> (config.ackPort));
+            ackDestinationResolved = ::inet_pton (AF_INET, config.ackAddress.toRawUTF8(), &ackDestination.sin_addr) == 1;
+           #endif
+
             if (! startThread (juce::Thread::Priority::normal))
             {
                 socket->shutdown();
@@ -184,9 +377,18 @@ private:
             ackSocket.reset();
         }
 
-        const PoseSnapshot* currentPose() const noexcept
+        const PoseSnapshot* currentPose (int listener) const noexcept
+        {
+            return streams[static_cast<size_t> (listener)].activePose.load (std::memory_order_acquire);
+        }
+
+        std::uint32_t getActiveListenerMask() const noexcept
         {
-            return activePose.load (std::memory_order_acquire);
+            std::uint32_t mask = 0;
+            for (size_t listener = 0; listener < streams.size(); ++listener)
+                if (streams[listener].hasPose.load (std::memory_order_acquire))
+                    mask |= (1u << listener);
+            return mask;
         }
 
         std::uint32_t getInvalidPacketCount() const noexcept
@@ -204,6 +406,33 @@ private:
             consumerCount.store (count, std::memory_order_relaxed);
         }
 
+        void recordConsumption (int listener, const PoseSnapshot& pose, std::uint64_t consumedMicros) noexcept
+        {
+            const auto arrivalMicros = arrivalMicrosFor (listener, pose.seq);
+            if (arrivalMicros > 0 && consumedMicros >= arrivalMicros)
+                consumeLatency.record (static_cast<double> (consumedMicros - arrivalMicros) / 1000.0);
+
+            if (pose.timestampMs > 0)
+                endToEndLatency.record (static_cast<double> (consumedMicros) / 1000.0
+                                        - static_cast<double> (pose.timestampMs));
+        }
+
+        HeadTrackingLatencyDiagnostics getLatencyDiagnostics() const noexcept
+        {
+            HeadTrackingLatencyDiagnostics diagnostics;
+            diagnostics.transit = transitLatency.snapshot();
+            diagnostics.consume = consumeLatency.snapshot();
+            diagnostics.endToEnd = endToEndLatency.snapshot();
+            diagnostics.receiveBatches = receiveBatches.load (std::memory_order_relaxed);
+            diagnostics.packetsReceived = packetsReceived.load (std::memory_order_relaxed);
+            diagnostics.packetsCoalesced = packetsCoalesced.load (std::memory_order_relaxed);
+            diagnostics.kernelTimestamps = kernelTimestamps.load (std::memory_order_relaxed);
+           #if JUCE_LINUX
+            diagnostics.batchedReceive = true;
+           #endif
+            return diagnostics;
+        }
+
     private:
        #if JUCE_MAC
         static void applySchedulingHint() noexcept
@@ -223,6 +452,10 @@ private:
         static constexpr std::uint32_t ackFlagPoseAvailable = 1u << 0;
         static constexpr std::uint32_t ackFlagPoseStale = 1u << 1;
         static constexpr std::uint64_t staleThresholdMs = 500;
+        static constexpr int receiveBatchSize = 32;
+        static constexpr std::uint32_t listenerIdShift = 8;
+        static constexpr std::uint32_t listenerIdMask = 0xFFu;
+        static constexpr int packetBufferBytes = 64; // headroom: v1=36, v2=52
 
         static std::uint32_t readU32LE (const std::uint8_t* bytes) noexcept
         {
@@ -336,35 +569,126 @@ private:
             return true;
         }
 
-        void publishSnapshot (const PoseSnapshot& snapshot) noexcept
+        static int listenerIdOf (const PoseSnapshot& snapshot) noexcept
+        {
+            return static_cast<int> ((snapshot.sensorLocationFlags >> listenerIdShift) & listenerIdMask);
+        }
+
+        // Arrival stamp of the pose with this sequence number on a listener
+        // stream; 0 once both slots have moved on. Each slot's stamp is
+        // guarded by its sequence number (seqlock), so a stamp read while the
+        // receiver rewrites the slot is rejected rather than misattributed.
+        std::uint64_t arrivalMicrosFor (int listener, std::uint32_t seq) const noexcept
         {
-            const auto slot = writeSlot.load (std::memory_order_relaxed);
-            slots[slot] = snapshot;
-            activePose.store (&slots[slot], std::memory_order_release);
-            writeSlot.store (slot ^ 1, std::memory_order_relaxed);
-            hasPose.store (true, std::memory_order_release);
-            lastSeq.store (snapshot.seq, std::memory_order_relaxed);
+            if (listener < 0 || listener >= kMaxListeners)
+                return 0;
+
+            const auto& stream = streams[static_cast<size_t> (listener)];
+            for (size_t slot = 0; slot < 2; ++slot)
+            {
+                const auto stampSeqBefore = stream.slotArrivalSeq[slot].load (std::memory_order_acquire);
+                if ((stampSeqBefore & 1u) != 0u || (stampSeqBefore >> 1) != seq)
+                    continue;
+
+                const auto arrivalMicros = stream.slotArrivalMicros[slot].load (std::memory_order_relaxed);
+                std::atomic_thread_fence (std::memory_order_acquire);
+                if (stream.slotArrivalSeq[slot].load (std::memory_order_relaxed) == stampSeqBefore)
+                    return arrivalMicros;
+            }
+            return 0;
         }
 
-        void sendAckPacket (std::uint64_t nowMs) noexcept
+        // Single writer (receiver thread) per stream; readers only ever load
+        // activePose, so listeners never contend with each other.
+        void publishSnapshot (int listener, const PoseSnapshot& snapshot, std::uint64_t arrivalMicros) noexcept
+        {
+            auto& stream = streams[static_cast<size_t> (listener)];
+            const auto slot = stream.writeSlot.load (std::memory_order_relaxed);
+            stream.slots[slot] = snapshot;
+            auto& stampSeq = stream.slotArrivalSeq[static_cast<size_t> (slot)];
+            stampSeq.store ((static_cast<std::uint64_t> (snapshot.seq) << 1) | 1u, std::memory_order_relaxed);
+            std::atomic_thread_fence (std::memory_order_release);
+            stream.slotArrivalMicros[static_cast<size_t> (slot)].store (arrivalMicros, std::memory_order_relaxed);
+            stampSeq.store (static_cast<std::uint64_t> (snapshot.seq) << 1, std::memory_order_release);
+            stream.activePose.store (&stream.slots[slot], std::memory_order_release);
+            stream.writeSlot.store (slot ^ 1, std::memory_order_relaxed);
+            stream.hasPose.store (true, std::memory_order_release);
+            stream.lastSeq.store (snapshot.seq, std::memory_order_relaxed);
+        }
+
+        // One ack per listener stream that has a pose, plus listener 0 so an
+        // untagged sender still sees the receiver while it waits. The
+        // listener ID rides in flags bits[15:8], as in the pose packets.
+        // Acks stay on the receiver thread, after the drain and publish: it is
+        // the only writer of the pose slots, so the stream state read here
+        // needs no further synchronisation. They go out as one non-blocking
+        // batch so a full send buffer never holds up the next drain.
+        void sendAckPackets (std::uint64_t nowMs) noexcept
         {
             auto* txSocket = ackSocket.get();
             if (txSocket == nullptr || config.ackPort <= 0 || config.ackAddress.isEmpty())
                 return;
 
-            std::array<std::uint8_t, ackPacketSizeBytes> bytes {};
-            writeU32LE (bytes.data() + 0, ackMagic);
-            writeU32LE (bytes.data() + 4, ackVersion);
-            writeU32LE (bytes.data() + 8, sourceToken);
-            writeU32LE (bytes.data() + 12, consumerCount.load (std::memory_order_relaxed));
-            writeU32LE (bytes.data() + 16, lastSeq.load (std::memory_order_relaxed));
-            writeU32LE (bytes.data() + 20, invalidPacketCount.load (std::memory_order_relaxed));
+            int numAcks = 0;
+            for (int listener = 0; listener < kMaxListeners; ++listener)
+                if (listener == 0 || streams[static_cast<size_t> (listener)].hasPose.load (std::memory_order_acquire))
+                    writeAckPacket (ackPackets[static_cast<size_t> (numAcks++)].data(), listener, nowMs);
+
+           #if JUCE_LINUX
+            if (ackDestinationResolved)
+            {
+                for (int i = 0; i < numAcks; ++i)
+                {
+                    auto& iov = ackIovecs[static_cast<size_t> (i)];
+                    iov.iov_base = ackPackets[static_cast<size_t> (i)].data();
+                    iov.iov_len = ackPackets[static_cast<size_t> (i)].size();
+
+                    auto& header = ackHeaders[static_cast<size_t> (i)];
+                    header = {};
+                    header.msg_hdr.msg_name = &ackDestination;
+                    header.msg_hdr.msg_namelen = static_cast<socklen_t> (sizeof (ackDestination));
+                    header.msg_hdr.msg_iov = &iov;
+                    header.msg_hdr.msg_iovlen = 1;
+                }
+
+                const int sent = ::sendmmsg (txSocket->getRawSocketHandle(),
+                                             ackHeaders.data(),
+                                             static_cast<unsigned int> (numAcks),
+                                             MSG_DONTWAIT);
+                const int unsent = numAcks - juce::jmax (0, sent);
+                if (unsent > 0)
+                    ackSendErrors.fetch_add (static_cast<std::uint32_t> (unsent), std::memory_order_relaxed);
+                return;
+            }
+           #endif
+
+            for (int i = 0; i < numAcks; ++i)
+            {
+                const auto bytesWritten = txSocket->write (
+                    config.ackAddress,
+                    config.ackPort,
+                    ackPackets[static_cast<size_t> (i)].data(),
+                    ackPacketSizeBytes);
+                if (bytesWritten <= 0)
+                    ackSendErrors.fetch_add (1, std::memory_order_relaxed);
+            }
+        }
 
-            const auto* pose = activePose.load (std::memory_order_acquire);
+        void writeAckPacket (std::uint8_t* bytes, int listener, std::uint64_t nowMs) noexcept
+        {
+            writeU32LE (bytes + 0, ackMagic);
+            writeU32LE (bytes + 4, ackVersion);
+            writeU32LE (bytes + 8, sourceToken);
+            writeU32LE (bytes + 12, consumerCount.load (std::memory_order_relaxed));
+            const auto& stream = streams[static_cast<size_t> (listener)];
+            writeU32LE (bytes + 16, stream.lastSeq.load (std::memory_order_relaxed));
+            writeU32LE (bytes + 20, invalidPacketCount.load (std::memory_order_relaxed));
+
+            const auto* pose = stream.activePose.load (std::memory_order_acquire);
             const auto poseTimestampMs = (pose != nullptr ? pose->timestampMs : 0u);
-            writeU64LE (bytes.data() + 24, poseTimestampMs);
+            writeU64LE (bytes + 24, poseTimestampMs);
 
-            std::uint32_t flags = 0;
+            auto flags = static_cast<std::uint32_t> (listener) << listenerIdShift;
             float ageMs = 0.0f;
             if (pose != nullptr)
             {
@@ -379,20 +703,157 @@ private:
                 flags |= ackFlagPoseStale;
             }
 
-            writeF32LE (bytes.data() + 32, ageMs);
-            writeU32LE (bytes.data() + 36, flags);
-            writeU32LE (bytes.data() + 40, static_cast<std::uint32_t> (config.port));
-            writeU32LE (bytes.data() + 44, ackCounter.fetch_add (1, std::memory_order_relaxed) + 1);
+            writeF32LE (bytes + 32, ageMs);
+            writeU32LE (bytes + 36, flags);
+            writeU32LE (bytes + 40, static_cast<std::uint32_t> (config.port));
+            writeU32LE (bytes + 44, ackCounter.fetch_add (1, std::memory_order_relaxed) + 1);
+        }
+
+        // Sequence gate for a decoded pose against the currently published one.
+        bool shouldAcceptSnapshot (int listener, const PoseSnapshot& snapshot) const noexcept
+        {
+            const auto& stream = streams[static_cast<size_t> (listener)];
+            if (! stream.hasPose.load (std::memory_order_acquire))
+                return true;
 
-            const auto bytesWritten = txSocket->write (
-                config.ackAddress,
-                config.ackPort,
-                bytes.data(),
-                static_cast<int> (bytes.size()));
-            if (bytesWritten <= 0)
-                ackSendErrors.fetch_add (1, std::memory_order_relaxed);
+            const auto previousSeq = stream.lastSeq.load (std::memory_order_relaxed);
+            if (snapshot.seq > previousSeq)
+                return true;
+
+            const auto* currentPose = stream.activePose.load (std::memory_order_acquire);
+            if (currentPose == nullptr)
+                return true;
+
+            const auto currentTimestampMs = currentPose->timestampMs;
+            const auto nowMs = static_cast<std::uint64_t> (juce::Time::currentTimeMillis());
+            const bool currentPoseStale = currentTimestampMs == 0
+                || (nowMs >= (currentTimestampMs + staleThresholdMs));
+            const bool incomingTimestampAdvanced = snapshot.timestampMs > currentTimestampMs;
+            // Accept sequence restarts only when the prior
+            // stream is stale and the sender timestamp has
+            // moved forward (process restarts).
+            return currentPoseStale && incomingTimestampAdvanced;
         }
 
+        struct BatchCandidate
+        {
+            PoseSnapshot snapshot {};
+            std::uint64_t arrivalMicros = 0;
+            int validPackets = 0;
+        };
+
+        using BatchCandidates = std::array<BatchCandidate, kMaxListeners>;
+
+        // Decodes one datagram into the batch; only the freshest valid pose
+        // per listener survives, older ones are counted as coalesced.
+        void considerPacket (const std::uint8_t* bytes, int numBytes, std::uint64_t arrivalMicros, BatchCandidates& candidates) noexcept
+        {
+            PoseSnapshot snapshot {};
+            if (! decodePacket (bytes, numBytes, snapshot) || listenerIdOf (snapshot) >= kMaxListeners)
+            {
+                invalidPacketCount.fetch_add (1, std::memory_order_relaxed);
+                return;
+            }
+
+            auto& candidate = candidates[static_cast<size_t> (listenerIdOf (snapshot))];
+
+            if (snapshot.timestampMs > 0)
+                transitLatency.record (static_cast<double> (arrivalMicros) / 1000.0
+                                       - static_cast<double> (snapshot.timestampMs));
+
+            const bool fresher = candidate.validPackets == 0
+                || snapshot.seq > candidate.snapshot.seq
+                || snapshot.timestampMs > candidate.snapshot.timestampMs;
+            if (fresher)
+            {
+                candidate.snapshot = snapshot;
+                candidate.arrivalMicros = arrivalMicros;
+            }
+
+            ++candidate.validPackets;
+        }
+
+       #if JUCE_LINUX
+        // Linux fast path: one recvmmsg per batch of up to receiveBatchSize
+        // datagrams, arrival stamped by the kernel (SO_TIMESTAMPNS).
+        int receiveBatch (juce::DatagramSocket& udpSocket, BatchCandidates& candidates) noexcept
+        {
+            const int fd = udpSocket.getRawSocketHandle();
+            if (fd < 0)
+                return 0;
+
+            for (int i = 0; i < receiveBatchSize; ++i)
+            {
+                auto& iov = batchIovecs[static_cast<size_t> (i)];
+                iov.iov_base = batchPackets[static_cast<size_t> (i)].data();
+                iov.iov_len = batchPackets[static_cast<size_t> (i)].size();
+
+                auto& header = batchHeaders[static_cast<size_t> (i)];
+                header = {};
+                header.msg_hdr.msg_iov = &iov;
+                header.msg_hdr.msg_iovlen = 1;
+                header.msg_hdr.msg_control = batchControl[static_cast<size_t> (i)].data();
+                header.msg_hdr.msg_controllen = batchControl[static_cast<size_t> (i)].size();
+            }
+
+            const int received = ::recvmmsg (fd, batchHeaders.data(), static_cast<unsigned int> (receiveBatchSize), MSG_DONTWAIT, nullptr);
+            if (received <= 0)
+                return 0;
+
+            const auto fallbackArrivalMicros = headTrackingWallClockMicros();
+            for (int i = 0; i < received; ++i)
+            {
+                auto& header = batchHeaders[static_cast<size_t> (i)];
+                auto arrivalMicros = fallbackArrivalMicros;
+                for (auto* cmsg = CMSG_FIRSTHDR (&header.msg_hdr); cmsg != nullptr; cmsg = CMSG_NXTHDR (&header.msg_hdr, cmsg))
+                {
+                    if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+                    {
+                        timespec stamp {};
+                        std::memcpy (&stamp, CMSG_DATA (cmsg), sizeof (stamp));
+                        arrivalMicros = static_cast<std::uint64_t> (stamp.tv_sec) * 1000000u
+                                        + static_cast<std::uint64_t> (stamp.tv_nsec / 1000);
+                    }
+                }
+
+                if ((header.msg_hdr.msg_flags & MSG_TRUNC) != 0)
+                {
+                    invalidPacketCount.fetch_add (1, std::memory_order_relaxed);
+                    continue;
+                }
+
+                considerPacket (batchPackets[static_cast<size_t> (i)].data(),
+                                static_cast<int> (header.msg_len),
+                                arrivalMicros,
+                                candidates);
+            }
+
+            return received;
+        }
+       #else
+        // Portable path: drain whatever is queued without blocking, up to one
+        // batch, stamping arrival in user space.
+        int receiveBatch (juce::DatagramSocket& udpSocket, BatchCandidates& candidates) noexcept
+        {
+            int received = 0;
+            while (received < receiveBatchSize)
+            {
+                if (received > 0 && udpSocket.waitUntilReady (true, 0) <= 0)
+                    break;
+
+                auto& packet = batchPackets[static_cast<size_t> (received)];
+                const auto bytesRead = udpSocket.read (packet.data(), static_cast<int> (packet.size()), false);
+                if (bytesRead <= 0)
+                    break;
+
+                considerPacket (packet.data(), bytesRead, headTrackingWallClockMicros(), candidates);
+                ++received;
+            }
+
+            return received;
+        }
+       #endif
+
         void run() override
         {
             applySchedulingHint();
@@ -401,7 +862,6 @@ private:
             if (udpSocket == nullptr)
                 return;
 
-            std::array<std::uint8_t, 64> packetBytes {}; // 64B headroom: v1=36, v2=52
             const auto ackIntervalMs = juce::jmax (20, config.ackIntervalMs);
             auto nextAckTick = juce::Time::getMillisecondCounterHiRes();
 
@@ -410,59 +870,37 @@ private:
                 const auto ready = udpSocket->waitUntilReady (true, 50);
                 if (ready > 0)
                 {
-                    const auto bytesRead = udpSocket->read (
-                        packetBytes.data(),
-                        static_cast<int> (packetBytes.size()),
-                        false);
+                    // Drain everything queued since the last wakeup, then publish
+                    // only the freshest pose per listener: the audio thread never
+                    // wants a stale one, and each publish is a cache-line handoff.
+                    BatchCandidates candidates {};
+                    int receivedTotal = 0;
+                    for (;;)
+                    {
+                        const int received = receiveBatch (*udpSocket, candidates);
+                        receivedTotal += received;
+                        if (received > 0)
+                            receiveBatches.fetch_add (1, std::memory_order_relaxed);
+                        if (received < receiveBatchSize)
+                            break;
+                    }
 
-                    if (bytesRead > 0)
+                    packetsReceived.fetch_add (static_cast<std::uint32_t> (receivedTotal), std::memory_order_relaxed);
+                    for (int listener = 0; listener < kMaxListeners; ++listener)
                     {
-                        bool shouldPublish = true;
-                        PoseSnapshot snapshot {};
-                        if (! decodePacket (packetBytes.data(), bytesRead, snapshot))
-                        {
-                            invalidPacketCount.fetch_add (1, std::memory_order_relaxed);
-                            shouldPublish = false;
-                        }
-
-                        if (shouldPublish && hasPose.load (std::memory_order_acquire))
-                        {
-                            const auto previousSeq = lastSeq.load (std::memory_order_relaxed);
-                            if (snapshot.seq <= previousSeq)
-                            {
-                                bool acceptSequenceRestart = false;
-                                const auto* currentPose = activePose.load (std::memory_order_acquire);
-                                if (currentPose != nullptr)
-                                {
-                                    const auto currentTimestampMs = currentPose->timestampMs;
-                                    const auto nowMs = static_cast<std::uint64_t> (juce::Time::currentTimeMillis());
-                                    const bool currentPoseStale = currentTimestampMs == 0
-                                        || (nowMs >= (currentTimestampMs + staleThresholdMs));
-                                    const bool incomingTimestampAdvanced = snapshot.timestampMs > currentTimestampMs;
-                                    // Accept sequence restarts only when the prior
-                                    // stream is stale and the sender timestamp has
-                                    // moved forward (process restarts).
-                                    acceptSequenceRestart = currentPoseStale && incomingTimestampAdvanced;
-                                }
-                                else
-                                {
-                                    acceptSequenceRestart = true;
-                                }
-
-                                if (! acceptSequenceRestart)
-                                    shouldPublish = false;
-                            }
-                        }
-
-                        if (shouldPublish)
-                            publishSnapshot (snapshot);
+                        const auto& candidate = candidates[static_cast<size_t> (listener)];
+                        if (candidate.validPackets > 1)
+                            packetsCoalesced.fetch_add (static_cast<std::uint32_t> (candidate.validPackets - 1), std::memory_order_relaxed);
+
+                        if (candidate.validPackets > 0 && shouldAcceptSnapshot (listener, candidate.snapshot))
+                            publishSnapshot (listener, candidate.snapshot, candidate.arrivalMicros);
                     }
                 }
 
                 const auto nowTick = juce::Time::getMillisecondCounterHiRes();
                 if (nowTick >= nextAckTick)
                 {
-                    sendAckPacket (static_cast<std::uint64_t> (juce::Time::currentTimeMillis()));
+                    sendAckPackets (static_cast<std::uint64_t> (juce::Time::currentTimeMillis()));
                     nextAckTick = nowTick + static_cast<double> (ackIntervalMs);
                 }
             }
@@ -471,16 +909,49 @@ private:
         Config config;
         std::unique_ptr<juce::DatagramSocket> socket;
         std::unique_ptr<juce::DatagramSocket> ackSocket;
-        PoseSnapshot slots[2] {};
-        std::atomic<const PoseSnapshot*> activePose { nullptr };
-        std::atomic<int> writeSlot { 0 };
-        std::atomic<bool> hasPose { false };
-        std::atomic<std::uint32_t> lastSeq { 0 };
+        // One double-buffered pose per listener ID.
+        struct PoseStream
+        {
+            PoseSnapshot slots[2] {};
+            std::array<std::atomic<std::uint64_t>, 2> slotArrivalMicros {};
+            std::array<std::atomic<std::uint64_t>, 2> slotArrivalSeq {}; // seq << 1, low bit set while writing
+            std::atomic<const PoseSnapshot*> activePose { nullptr };
+            std::atomic<int> writeSlot { 0 };
+            std::atomic<bool> hasPose { false };
+            std::atomic<std::uint32_t> lastSeq { 0 };
+        };
+
+        std::array<PoseStream, kMaxListeners> streams;
         std::atomic<std::uint32_t> invalidPacketCount { 0 };
         std::atomic<std::uint32_t> consumerCount { 0 };
         std::atomic<std::uint32_t> ackCounter { 0 };
         std::atomic<std::uint32_t> ackSendErrors { 0 };
         std::uint32_t sourceToken = 0;
+
+        HeadTrackingLatencyHistogram transitLatency;
+        HeadTrackingLatencyHistogram consumeLatency;
+        HeadTrackingLatencyHistogram endToEndLatency;
+        std::atomic<std::uint32_t> receiveBatches { 0 };
+        std::atomic<std::uint32_t> packetsReceived { 0 };
+        std::atomic<std::uint32_t> packetsCoalesced { 0 };
+        std::atomic<bool> kernelTimestamps { false };
+
+        // Receiver-thread scratch for one batch.
+        std::array<std::array<std::uint8_t, packetBufferBytes>, receiveBatchSize> batchPackets {};
+       #if JUCE_LINUX
+        std::array<mmsghdr, receiveBatchSize> batchHeaders {};
+        std::array<iovec, receiveBatchSize> batchIovecs {};
+        std::array<std::array<std::uint8_t, CMSG_SPACE (sizeof (timespec))>, receiveBatchSize> batchControl {};
+       #endif
+
+        // Receiver-thread scratch for one round of acks.
+        std::array<std::array<std::uint8_t, ackPacketSizeBytes>, kMaxListeners> ackPackets {};
+       #if JUCE_LINUX
+        std::array<mmsghdr, kMaxListeners> ackHeaders {};
+        std::array<iovec, kMaxListeners> ackIovecs {};
+        sockaddr_in ackDestination {};
+        bool ackDestinationResolved = false;
+       #endif
     };
 
     struct SharedRegistry
@@ -571,12 +1042,17 @@ private:
     std::shared_ptr<SharedCore> core;
     std::atomic<SharedCore*> corePtr { nullptr };
     std::atomic<bool> started { false };
+    std::atomic<int> listenerId { 0 };
+    std::uint32_t lastConsumedSeq = 0; // audio thread only
+    int lastConsumedListener = 0;
+    bool hasConsumedPose = false;
 };
 #else
 class HeadTrackingBridge final
 {
 public:
     using PoseSnapshot = HeadTrackingPoseSnapshot;
+    static constexpr int kMaxListeners = 8;
 
     struct Config
     {
@@ -613,6 +1089,25 @@ public:
         return 0;
     }
 
+    void subscribeListener (int) noexcept {}
+
+    int getListenerId() const noexcept
+    {
+        return 0;
+    }
+
+    std::uint32_t getActiveListenerMask() const noexcept
+    {
+        return 0;
+    }
+
+    void notePoseConsumed (const PoseSnapshot&) noexcept {}
+
+    HeadTrackingLatencyDiagnostics getLatencyDiagnostics() const noexcept
+    {
+        return {};
+    }
+
 private:
     Config config;
 };
@@ -1,10 +1,12 @@
 #pragma once
 
 #include <juce_dsp/juce_dsp.h>
+#include <atomic>
 #include <vector>
 #include <cmath>
 #include <algorithm>
 #include <cstring>
+#include <memory>
 
 //==============================================================================
 /**
@@ -12,21 +14,35 @@
  *
  * Records microphone input during a calibration sweep and deconvolves it
  * with the inverse filter (from TestSignalGenerator) to extract the room
- * impulse response (IR) for one speaker.
+ * impulse response (IR) for one speaker, or, for interleaved sweeps played
+ * by several speakers at staggered offsets, one IR per speaker from a single
+ * deconvolution.
  *
- * All heap allocation happens in prepare() / startRecording().
- * recordBlock() is real-time safe (no allocation, no locks).
- * computeIR() is expensive — call from a background thread.
+ * Deconvolution is uniformly partitioned overlap-save: the inverse filter is
+ * split into PARTITION_SIZE blocks whose spectra are kept, each recorded
+ * block is transformed once into a frequency-domain delay line, and output
+ * blocks are only synthesised where they overlap a requested IR window.
+ * A background thread can feed blocks while recording is still running
+ * (processRecordedBlocks), so finishDeconvolution() after the tail only has
+ * the last few blocks left.
+ *
+ * All heap allocation happens in prepare() / startRecording() /
+ * prepareDeconvolution(). recordBlock() is real-time safe (no allocation,
+ * no locks). The deconvolution calls are expensive — call from a background
+ * thread, and not concurrently with startRecording().
  *
  * Usage:
  *   IRCapture cap;
  *   cap.prepare (sampleRate);
  *   cap.startRecording (sweepSamples, tailSeconds);
- *   // audio thread:
+ *   cap.prepareDeconvolution (gen.getInverseFilter());
+ *   // audio thread (playing + tail):
  *   while (!cap.isComplete())
  *       cap.recordBlock (micInput, numSamples);
- *   // background thread:
- *   cap.computeIR (gen.getInverseFilter());
+ *   // background thread, while recording:
+ *   cap.processRecordedBlocks();
+ *   // background thread, once isComplete():
+ *   cap.finishDeconvolution();
  *   const auto& ir = cap.getIR();
  */
 class IRCapture
@@ -34,6 +50,8 @@ class IRCapture
 public:
     static constexpr int   DEFAULT_IR_SECS  = 1;    // Extract first 1 s of IR
     static constexpr int   MAX_RECORD_SECS  = 15;   // Maximum recording length
+    static constexpr int   PARTITION_ORDER  = 12;   // 4096-sample partitions
+    static constexpr int   PARTITION_SIZE   = 1 << PARTITION_ORDER;
 
     //==========================================================================
     /** Initialise; call once from prepareToPlay.
@@ -43,7 +61,7 @@ public:
     {
         sampleRate_     = sampleRate;
         tailSeconds_    = tailSeconds;
-        recordPos_      = 0;
+        recordPos_.store (0, std::memory_order_release);
         expectedLength_ = 0;
         computeDone_    = false;
 
@@ -57,7 +75,7 @@ public:
         @param tailSeconds   Additional tail to record after signal ends. */
     void startRecording (int sweepSamples, float tailSeconds = 1.5f)
     {
-        recordPos_   = 0;
+        recordPos_.store (0, std::memory_order_release);
         computeDone_ = false;
         int tailSamp = static_cast<int> (tailSeconds * sampleRate_);
         expectedLength_ = sweepSamples + tailSamp;
@@ -74,99 +92,269 @@ public:
     /** Feed microphone input into the recording buffer (audio-thread safe). */
     void recordBlock (const float* micInput, int numSamples)
     {
-        if (recordPos_ >= expectedLength_) return;
+        const int pos = recordPos_.load (std::memory_order_relaxed);
+        if (pos >= expectedLength_) return;
 
-        int toWrite = std::min (numSamples, expectedLength_ - recordPos_);
-        std::memcpy (recordBuffer_.data() + recordPos_, micInput,
+        int toWrite = std::min (numSamples, expectedLength_ - pos);
+        std::memcpy (recordBuffer_.data() + pos, micInput,
                      static_cast<size_t> (toWrite) * sizeof (float));
-        recordPos_ += toWrite;
+        recordPos_.store (pos + toWrite, std::memory_order_release);
     }
 
-    bool isComplete()       const { return recordPos_ >= expectedLength_; }
+    bool isComplete()       const { return getRecordedSamples() >= expectedLength_; }
     int  getExpectedLength() const { return expectedLength_; }
-    int  getRecordedSamples() const { return recordPos_; }
+    int  getRecordedSamples() const { return recordPos_.load (std::memory_order_acquire); }
 
     //==========================================================================
-    /** Deconvolve recording with inverse filter via overlap-save FFT.
-        Call on a background thread AFTER isComplete() returns true.
-        @param inverseFilter  Time-domain inverse filter from TestSignalGenerator. */
-    void computeIR (const std::vector<float>& inverseFilter)
+    /** Arm a streaming deconvolution for the current recording. Background
+        thread; allocates. Requests numWindows IRs, window i starting at
+        (inverse filter length - 1) + i * windowSpacingSamples in the
+        deconvolved signal — where the linear IR of a sweep started at
+        recording sample i * spacing lands. Each window is DEFAULT_IR_SECS
+        long, capped to the spacing when several windows are requested. */
+    void prepareDeconvolution (const std::vector<float>& inverseFilter,
+                               int numWindows = 1,
+                               int windowSpacingSamples = 0)
     {
         computeDone_ = false;
+        deconvolutionArmed_ = false;
         impulseResponse_.clear();
+        windowResponses_.clear();
+        nextInputBlock_ = 0;
 
-        if (inverseFilter.empty() || recordPos_ == 0) return;
+        if (inverseFilter.empty() || numWindows <= 0 || (numWindows > 1 && windowSpacingSamples <= 0))
+            return;
 
-        const int recLen = recordPos_;
-        const int invLen = static_cast<int> (inverseFilter.size());
-        const int outLen = recLen + invLen - 1; // linear convolution length
+        const int fftSize = 2 * PARTITION_SIZE;
+        if (fft_ == nullptr)
+            fft_ = std::make_unique<juce::dsp::FFT> (PARTITION_ORDER + 1);
 
-        // Choose smallest FFT order that fits
-        int fftOrder = 1;
-        while ((1 << fftOrder) < outLen) ++fftOrder;
-        const int fftSize = 1 << fftOrder;
+        inverseLength_  = static_cast<int> (inverseFilter.size());
+        numPartitions_  = (inverseLength_ + PARTITION_SIZE - 1) / PARTITION_SIZE;
+        windowStart_    = inverseLength_ - 1;
+        windowSpacing_  = windowSpacingSamples;
+        windowLength_   = static_cast<int> (DEFAULT_IR_SECS * sampleRate_);
+        if (numWindows > 1)
+            windowLength_ = std::min (windowLength_, windowSpacingSamples);
 
-        juce::dsp::FFT fft (fftOrder);
+        const auto spectrumFloats = static_cast<size_t> (2 * NUM_BINS);
+        filterSpectra_.assign (static_cast<size_t> (numPartitions_) * spectrumFloats, 0.0f);
+        delayLine_.assign (static_cast<size_t> (numPartitions_) * spectrumFloats, 0.0f);
+        accumulator_.assign (spectrumFloats, 0.0f);
+        fftBuffer_.assign (static_cast<size_t> (2 * fftSize), 0.0f);
 
-        // Allocate interleaved complex buffers (size = 2 × fftSize)
-        std::vector<float> recFFT (static_cast<size_t> (2 * fftSize), 0.0f);
-        std::vector<float> invFFT (static_cast<size_t> (2 * fftSize), 0.0f);
+        // Partition p of the filter, zero-padded to fftSize, keeps bins 0..B.
+        for (int p = 0; p < numPartitions_; ++p)
+        {
+            std::fill (fftBuffer_.begin(), fftBuffer_.end(), 0.0f);
+            const int begin = p * PARTITION_SIZE;
+            const int count = std::min (PARTITION_SIZE, inverseLength_ - begin);
+            std::memcpy (fftBuffer_.data(), inverseFilter.data() + begin,
+                         static_cast<size_t> (count) * sizeof (float));
+            fft_->performRealOnlyForwardTransform (fftBuffer_.data());
+            std::memcpy (filterSpectra_.data() + static_cast<size_t> (p) * spectrumFloats,
+                         fftBuffer_.data(), spectrumFloats * sizeof (float));
+        }
 
-        // Copy real signals into first-half of each buffer
-        std::memcpy (recFFT.data(), recordBuffer_.data(),
-                     static_cast<size_t> (recLen) * sizeof (float));
-        std::memcpy (invFFT.data(), inverseFilter.data(),
-                     static_cast<size_t> (invLen) * sizeof (float));
+        windowResponses_.assign (static_cast<size_t> (numWindows),
+                                 std::vector<float> (static_cast<size_t> (windowLength_), 0.0f));
+        deconvolutionArmed_ = true;
+    }
 
-        // Forward FFT
-        fft.performRealOnlyForwardTransform (recFFT.data());
-        fft.performRealOnlyForwardTransform (invFFT.data());
+    /** Deconvolve the recorded blocks that are complete so far, at most
+        maxBlocks of them. Background thread. Returns the number processed. */
+    int processRecordedBlocks (int maxBlocks = 16)
+    {
+        if (! deconvolutionArmed_) return 0;
 
-        // Complex multiply in frequency domain (convolution = deconvolution
-        // because inverseFilter already encodes 1/H(w))
-        // JUCE interleaved layout: [re0, im0, re1, im1, ...]
-        for (int k = 0; k < fftSize; ++k)
+        const int available = getRecordedSamples() / PARTITION_SIZE;
+        int processed = 0;
+        while (nextInputBlock_ < available && processed < maxBlocks)
         {
-            float re1 = recFFT[2 * k],     im1 = recFFT[2 * k + 1];
-            float re2 = invFFT[2 * k],     im2 = invFFT[2 * k + 1];
-            recFFT[2 * k]     = re1 * re2 - im1 * im2;
-            recFFT[2 * k + 1] = re1 * im2 + im1 * re2;
+            processInputBlock (nextInputBlock_++);
+            ++processed;
         }
+        return processed;
+    }
 
-        // Inverse FFT — real output is in first fftSize elements
-        fft.performRealOnlyInverseTransform (recFFT.data());
+    /** Complete the armed deconvolution once isComplete() returns true: the
+        remaining (zero-padded) blocks run and each window is peak-normalised.
+        Background thread. */
+    void finishDeconvolution()
+    {
+        computeDone_ = false;
+        impulseResponse_.clear();
 
-        // Extract the causal IR (first DEFAULT_IR_SECS worth of samples).
-        // In the Farina method the direct-sound IR peak appears near t = 0.
-        int irLen = std::min (
-            static_cast<int> (DEFAULT_IR_SECS * sampleRate_), fftSize);
-        impulseResponse_.resize (static_cast<size_t> (irLen));
-        std::memcpy (impulseResponse_.data(), recFFT.data(),
-                     static_cast<size_t> (irLen) * sizeof (float));
+        const int recLen = getRecordedSamples();
+        if (! deconvolutionArmed_ || recLen == 0) return;
 
-        // Normalise to peak magnitude
-        float peak = 0.0f;
-        for (float s : impulseResponse_) peak = std::max (peak, std::abs (s));
-        if (peak > 1e-10f)
-        {
-            float norm = 1.0f / peak;
-            for (float& s : impulseResponse_) s *= norm;
-        }
+        // Output past recLen + inverse length - 1 is silence; so is anything
+        // beyond the last window.
+        const int outLen  = recLen + inverseLength_ - 1;
+        const int lastWindowEnd = windowStart_
+                                + static_cast<int> (windowResponses_.size() - 1) * windowSpacing_
+                                + windowLength_;
+        const int endSample = std::min (outLen, lastWindowEnd);
+        const int numBlocks = (endSample + PARTITION_SIZE - 1) / PARTITION_SIZE;
 
+        while (nextInputBlock_ < numBlocks)
+            processInputBlock (nextInputBlock_++);
+
+        for (auto& ir : windowResponses_)
+            normaliseToPeak (ir);
+
+        deconvolutionArmed_ = false;
+        impulseResponse_ = windowResponses_.front();
         computeDone_ = true;
     }
 
+    /** One-shot deconvolution of a completed recording into a single IR.
+        Call on a background thread AFTER isComplete() returns true.
+        @param inverseFilter  Time-domain inverse filter from TestSignalGenerator. */
+    void computeIR (const std::vector<float>& inverseFilter)
+    {
+        prepareDeconvolution (inverseFilter);
+        finishDeconvolution();
+    }
+
+    /** One-shot deconvolution of numSweeps identical sweeps, sweep i started
+        i * sweepOffsetSamples after sweep 0 (multiple exponential sweep method).
+        Call on a background thread AFTER isComplete() returns true. */
+    void computeInterleavedIRs (const std::vector<float>& inverseFilter,
+                                int numSweeps,
+                                int sweepOffsetSamples)
+    {
+        prepareDeconvolution (inverseFilter, numSweeps, sweepOffsetSamples);
+        finishDeconvolution();
+    }
+
     bool isIRReady()                         const { return computeDone_; }
     const std::vector<float>& getIR()        const { return impulseResponse_; }
     double getSampleRate()                   const { return sampleRate_; }
 
+    /** Per-window IRs from the last deconvolution (window 0 is getIR()). */
+    int getNumInterleavedIRs()               const { return computeDone_ ? static_cast<int> (windowResponses_.size()) : 0; }
+    const std::vector<float>& getInterleavedIR (int index) const
+    {
+        return windowResponses_[static_cast<size_t> (index)];
+    }
+
 private:
+    static constexpr int NUM_BINS = PARTITION_SIZE + 1; // non-negative bins of a 2B-point FFT
+
+    //==========================================================================
+    // Overlap-save step for input block j (recording samples [jB, jB + B)):
+    // transform [previous block | block j] into the delay line, then, if
+    // output block j touches a requested window, sum the partition products
+    // and write its B valid output samples into the windows.
+    void processInputBlock (int block)
+    {
+        const int fftSize = 2 * PARTITION_SIZE;
+        const auto spectrumFloats = static_cast<size_t> (2 * NUM_BINS);
+        const int recLen = getRecordedSamples();
+
+        std::fill (fftBuffer_.begin(), fftBuffer_.end(), 0.0f);
+        for (int half = 0; half < 2; ++half)
+        {
+            const int begin = (block - 1 + half) * PARTITION_SIZE;
+            const int from  = std::max (0, begin);
+            const int to    = std::min (recLen, begin + PARTITION_SIZE);
+            if (to > from)
+                std::memcpy (fftBuffer_.data() + half * PARTITION_SIZE + (from - begin),
+                             recordBuffer_.data() + from,
+                             static_cast<size_t> (to - from) * sizeof (float));
+        }
+
+        fft_->performRealOnlyForwardTransform (fftBuffer_.data());
+        const auto slot = static_cast<size_t> (block % numPartitions_);
+        std::memcpy (delayLine_.data() + slot * spectrumFloats, fftBuffer_.data(), spectrumFloats * sizeof (float));
+
+        const int outBegin = block * PARTITION_SIZE;
+        if (! overlapsWindow (outBegin, outBegin + PARTITION_SIZE))
+            return;
+
+        // Y_j = sum_p X_{j-p} H_p (JUCE interleaved layout: [re0, im0, re1, im1, ...])
+        std::fill (accumulator_.begin(), accumulator_.end(), 0.0f);
+        const int partitions = std::min (numPartitions_, block + 1);
+        for (int p = 0; p < partitions; ++p)
+        {
+            const float* x = delayLine_.data() + static_cast<size_t> ((block - p) % numPartitions_) * spectrumFloats;
+            const float* h = filterSpectra_.data() + static_cast<size_t> (p) * spectrumFloats;
+            for (int k = 0; k < NUM_BINS; ++k)
+            {
+                const float xr = x[2 * k], xi = x[2 * k + 1];
+                const float hr = h[2 * k], hi = h[2 * k + 1];
+                accumulator_[static_cast<size_t> (2 * k)]     += xr * hr - xi * hi;
+                accumulator_[static_cast<size_t> (2 * k + 1)] += xr * hi + xi * hr;
+            }
+        }
+
+        // Rebuild the full Hermitian spectrum for the real inverse transform.
+        std::memcpy (fftBuffer_.data(), accumulator_.data(), spectrumFloats * sizeof (float));
+        for (int k = NUM_BINS; k < fftSize; ++k)
+        {
+            fftBuffer_[static_cast<size_t> (2 * k)]     =  accumulator_[static_cast<size_t> (2 * (fftSize - k))];
+            fftBuffer_[static_cast<size_t> (2 * k + 1)] = -accumulator_[static_cast<size_t> (2 * (fftSize - k) + 1)];
+        }
+        fft_->performRealOnlyInverseTransform (fftBuffer_.data());
+
+        // Second half of the circular result is the valid linear output.
+        for (size_t w = 0; w < windowResponses_.size(); ++w)
+        {
+            auto& ir = windowResponses_[w];
+            const int start = windowStart_ + static_cast<int> (w) * windowSpacing_;
+            const int from  = std::max (outBegin, start);
+            const int to    = std::min (outBegin + PARTITION_SIZE, start + windowLength_);
+            for (int n = from; n < to; ++n)
+                ir[static_cast<size_t> (n - start)] = fftBuffer_[static_cast<size_t> (PARTITION_SIZE + n - outBegin)];
+        }
+    }
+
+    bool overlapsWindow (int begin, int end) const
+    {
+        for (size_t w = 0; w < windowResponses_.size(); ++w)
+        {
+            const int start = windowStart_ + static_cast<int> (w) * windowSpacing_;
+            if (begin < start + windowLength_ && start < end)
+                return true;
+        }
+        return false;
+    }
+
+    // Normalise to peak magnitude
+    static void normaliseToPeak (std::vector<float>& ir)
+    {
+        float peak = 0.0f;
+        for (float s : ir) peak = std::max (peak, std::abs (s));
+        if (peak > 1e-10f)
+        {
+            float norm = 1.0f / peak;
+            for (float& s : ir) s *= norm;
+        }
+    }
+
+    //==========================================================================
     double sampleRate_     = 44100.0;
     float  tailSeconds_    = 1.5f;
-    int    recordPos_      = 0;
+    std::atomic<int> recordPos_ { 0 };   // audio thread writes, analysis thread reads
     int    expectedLength_ = 0;
     bool   computeDone_    = false;
 
     std::vector<float> recordBuffer_;
     std::vector<float> impulseResponse_;
+
+    // Streaming deconvolution state (background thread only)
+    std::unique_ptr<juce::dsp::FFT> fft_;
+    bool   deconvolutionArmed_ = false;
+    int    inverseLength_  = 0;
+    int    numPartitions_  = 0;
+    int    nextInputBlock_ = 0;
+    int    windowStart_    = 0;
+    int    windowSpacing_  = 0;
+    int    windowLength_   = 0;
+    std::vector<float> filterSpectra_;   // numPartitions × NUM_BINS complex
+    std::vector<float> delayLine_;       // numPartitions × NUM_BINS complex (ring)
+    std::vector<float> accumulator_;
+    std::vector<float> fftBuffer_;
+    std::vector<std::vector<float>> windowResponses_;
 };
@@ -1,12 +1,26 @@
 #include "KeyframeTimeline.h"
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <memory>
 
 namespace
 {
 constexpr double kMinSegmentDuration = 1.0e-9;
+constexpr size_t kMaxCursorSteps = 4; // forward steps tried before falling back to a binary search
+
+constexpr std::array<const char*, 7> kCurveNames
+{
+    "linear",
+    "easeIn",
+    "easeOut",
+    "easeInOut",
+    "step",
+    "catmullRom",
+    "bezier"
+};
+
 }
 
 //==============================================================================
@@ -28,6 +42,7 @@ const juce::String& KeyframeTrack::getParameterId() const noexcept
 void KeyframeTrack::clear()
 {
     keyframes.clear();
+    rebuildPieces();
 }
 
 bool KeyframeTrack::empty() const noexcept
@@ -44,6 +59,7 @@ void KeyframeTrack::setKeyframes (std::vector<Keyframe> newKeyframes)
                {
                    return lhs.timeSeconds < rhs.timeSeconds;
                });
+    rebuildPieces();
 }
 
 void KeyframeTrack::addKeyframe (const Keyframe& keyframe)
@@ -55,6 +71,7 @@ void KeyframeTrack::addKeyframe (const Keyframe& keyframe)
                {
                    return lhs.timeSeconds < rhs.timeSeconds;
                });
+    rebuildPieces();
 }
 
 std::optional<float> KeyframeTrack::evaluate (double timeSeconds) const
@@ -62,43 +79,34 @@ std::optional<float> KeyframeTrack::evaluate (double timeSeconds) const
     if (keyframes.empty())
         return std::nullopt;
 
-    if (keyframes.size() == 1)
-        return keyframes.front().value;
-
-    if (timeSeconds <= keyframes.front().timeSeconds)
-        return keyframes.front().value;
-
-    if (timeSeconds >= keyframes.back().timeSeconds)
-        return keyframes.back().value;
-
-    const auto upper = std::upper_bound (keyframes.begin(),
-                                         keyframes.end(),
-                                         timeSeconds,
-                                         [] (double value, const Keyframe& keyframe)
-                                         {
-                                             return value < keyframe.timeSeconds;
-                                         });
-
-    if (upper == keyframes.begin() || upper == keyframes.end())
-        return keyframes.back().value;
+    size_t cursor = 0;
+    return KeyframeTimeline::evaluatePieces (pieceTimes.data(),
+                                             pieces.data(),
+                                             pieces.size(),
+                                             keyframes.front().value,
+                                             keyframes.back().value,
+                                             cursor,
+                                             timeSeconds);
+}
 
-    const auto& right = *upper;
-    const auto& left = *std::prev (upper);
+const std::vector<Keyframe>& KeyframeTrack::getKeyframes() const noexcept
+{
+    return keyframes;
+}
 
-    const auto segmentDuration = right.timeSeconds - left.timeSeconds;
-    if (segmentDuration <= kMinSegmentDuration)
-        return right.value;
+const std::vector<double>& KeyframeTrack::getPieceTimes() const noexcept
+{
+    return pieceTimes;
+}
 
-    const auto t = juce::jlimit (0.0f,
-                                 1.0f,
-                                 static_cast<float> ((timeSeconds - left.timeSeconds) / segmentDuration));
-    const auto curveT = KeyframeTimeline::applyCurve (left.curve, t);
-    return juce::jmap (curveT, left.value, right.value);
+const std::vector<KeyframeSegmentPolynomial>& KeyframeTrack::getPieces() const noexcept
+{
+    return pieces;
 }
 
-const std::vector<Keyframe>& KeyframeTrack::getKeyframes() const noexcept
+void KeyframeTrack::rebuildPieces()
 {
-    return keyframes;
+    KeyframeTimeline::buildSegmentPolynomials (keyframes, pieceTimes, pieces);
 }
 
 //==============================================================================
@@ -116,6 +124,9 @@ void KeyframeTimeline::reset() noexcept
 void KeyframeTimeline::clearTracks()
 {
     tracks.clear();
+    for (auto& compiled : compiledTracks)
+        compiled = {};
+
     durationSeconds = 0.0;
     currentTimeSeconds = 0.0;
 }
@@ -132,6 +143,9 @@ void KeyframeTimeline::addOrReplaceTrack (KeyframeTrack track)
                                 return existing.getParameterId() == track.getParameterId();
                             });
 
+    internTrackId (track.getParameterId());
+    compileTrack (track);
+
     if (it != tracks.end())
         *it = std::move (track);
     else
@@ -163,6 +177,119 @@ std::optional<float> KeyframeTimeline::evaluateTrackAtCurrentTime (const juce::S
     return evaluateTrack (parameterId, currentTimeSeconds);
 }
 
+KeyframeTimeline::TrackHandle KeyframeTimeline::internTrackId (const juce::String& parameterId)
+{
+    if (parameterId.isEmpty())
+        return invalidTrackHandle;
+
+    if (const auto existing = findTrackHandle (parameterId); existing != invalidTrackHandle)
+        return existing;
+
+    if (static_cast<int> (internedTrackIds.size()) >= maxTrackHandles)
+        return invalidTrackHandle;
+
+    internedTrackIds.push_back (parameterId);
+    compiledTracks.emplace_back();
+
+    if (const auto* track = findTrack (parameterId))
+        compileTrack (*track);
+
+    return static_cast<TrackHandle> (internedTrackIds.size()) - 1;
+}
+
+KeyframeTimeline::TrackHandle KeyframeTimeline::findTrackHandle (const juce::String& parameterId) const noexcept
+{
+    for (size_t i = 0; i < internedTrackIds.size(); ++i)
+    {
+        if (internedTrackIds[i] == parameterId)
+            return static_cast<TrackHandle> (i);
+    }
+
+    return invalidTrackHandle;
+}
+
+int KeyframeTimeline::getNumTrackHandles() const noexcept
+{
+    return static_cast<int> (compiledTracks.size());
+}
+
+std::optional<float> KeyframeTimeline::evaluateHandle (TrackHandle handle, double timeSeconds) noexcept
+{
+    if (handle < 0 || handle >= getNumTrackHandles())
+        return std::nullopt;
+
+    const auto& compiled = compiledTracks[static_cast<size_t> (handle)];
+    if (! compiled.hasKeyframes)
+        return std::nullopt;
+
+    return evaluateCompiled (compiled,
+                             compiledCursors[static_cast<size_t> (handle)],
+                             normalizeTime (timeSeconds, durationSeconds, looping));
+}
+
+std::optional<float> KeyframeTimeline::evaluateHandleAtCurrentTime (TrackHandle handle) noexcept
+{
+    return evaluateHandle (handle, currentTimeSeconds);
+}
+
+int KeyframeTimeline::evaluateAll (double timeSeconds, float* out) noexcept
+{
+    if (out == nullptr)
+        return 0;
+
+    const auto normalizedTime = normalizeTime (timeSeconds, durationSeconds, looping);
+    int written = 0;
+
+    for (size_t i = 0; i < compiledTracks.size(); ++i)
+    {
+        const auto& compiled = compiledTracks[i];
+        if (! compiled.hasKeyframes)
+            continue;
+
+        out[i] = evaluateCompiled (compiled, compiledCursors[i], normalizedTime);
+        ++written;
+    }
+
+    return written;
+}
+
+int KeyframeTimeline::evaluateAllAtCurrentTime (float* out) noexcept
+{
+    return evaluateAll (currentTimeSeconds, out);
+}
+
+void KeyframeTimeline::seekPlayhead (Playhead& playhead, double timeSeconds, bool loop) const noexcept
+{
+    playhead.timeSeconds = normalizeTime (std::isfinite (timeSeconds) ? timeSeconds : 0.0, durationSeconds, loop);
+}
+
+void KeyframeTimeline::advancePlayhead (Playhead& playhead, double blockDurationSeconds, float rate, bool loop) const noexcept
+{
+    const auto safeDuration = juce::jmax (0.0, blockDurationSeconds);
+    const auto safeRate = juce::jlimit (0.1f, 10.0f, rate);
+    seekPlayhead (playhead, playhead.timeSeconds + safeDuration * static_cast<double> (safeRate), loop);
+}
+
+int KeyframeTimeline::evaluateAll (Playhead& playhead, float* out) const noexcept
+{
+    if (out == nullptr)
+        return 0;
+
+    int written = 0;
+
+    for (size_t i = 0; i < compiledTracks.size(); ++i)
+    {
+        const auto& compiled = compiledTracks[i];
+        if (! compiled.hasKeyframes)
+            continue;
+
+        out[i] = evaluateCompiled (compiled, playhead.cursors[i], playhead.timeSeconds);
+        ++written;
+    }
+
+    return written;
+}
+
 void KeyframeTimeline::advance (double blockDurationSeconds) noexcept
 {
     const auto safeDuration = juce::jmax (0.0, blockDurationSeconds);
@@ -224,6 +351,8 @@ float KeyframeTimeline::applyCurve (KeyframeCurve curve, float t) noexcept
         case KeyframeCurve::easeInOut: return (x < 0.5f) ? (2.0f * x * x)
                                                           : (1.0f - std::pow (-2.0f * x + 2.0f, 2.0f) * 0.5f);
         case KeyframeCurve::step:      return 0.0f;
+        case KeyframeCurve::catmullRom:
+        case KeyframeCurve::bezier:    return x; // neighbour-dependent, see buildSegmentPolynomials
     }
 
     return x;
@@ -234,6 +363,184 @@ const std::vector<KeyframeTrack>& KeyframeTimeline::getTracks() const noexcept
     return tracks;
 }
 
+float KeyframeTimeline::evaluateCompiled (const CompiledTrack& track, size_t& cursor, double timeSeconds) noexcept
+{
+    return evaluatePieces (track.pieceTimes.data(),
+                           track.pieces.data(),
+                           track.pieces.size(),
+                           track.firstValue,
+                           track.lastValue,
+                           cursor,
+                           timeSeconds);
+}
+
+float KeyframeTimeline::evaluatePieces (const double* pieceTimes,
+                                        const KeyframeSegmentPolynomial* pieces,
+                                        size_t numPieces,
+                                        float firstValue,
+                                        float lastValue,
+                                        size_t& cursor,
+                                        double timeSeconds) noexcept
+{
+    if (numPieces == 0 || timeSeconds <= pieceTimes[0])
+    {
+        cursor = 0;
+        return firstValue;
+    }
+
+    if (timeSeconds >= pieceTimes[numPieces])
+    {
+        cursor = numPieces - 1;
+        return lastValue;
+    }
+
+    const auto piece = locateSegment (pieceTimes, numPieces + 1, cursor, timeSeconds);
+    cursor = piece;
+
+    const auto pieceDuration = pieceTimes[piece + 1] - pieceTimes[piece];
+    const auto u = pieceDuration > kMinSegmentDuration
+                       ? juce::jlimit (0.0f, 1.0f, static_cast<float> ((timeSeconds - pieceTimes[piece]) / pieceDuration))
+                       : 1.0f;
+    return pieces[piece].evaluate (u);
+}
+
+void KeyframeTimeline::buildSegmentPolynomials (const std::vector<Keyframe>& keyframes,
+                                                std::vector<double>& pieceTimes,
+                                                std::vector<KeyframeSegmentPolynomial>& pieces)
+{
+    pieceTimes.clear();
+    pieces.clear();
+    if (keyframes.size() < 2)
+        return;
+
+    const auto count = keyframes.size();
+
+    // Catmull-Rom tangent (value per second) at keyframe i, one-sided at the ends.
+    const auto slopeAt = [&keyframes, count] (size_t i)
+    {
+        const auto& before = keyframes[i > 0 ? i - 1 : i];
+        const auto& after = keyframes[i + 1 < count ? i + 1 : i];
+        const auto span = after.timeSeconds - before.timeSeconds;
+        return span > kMinSegmentDuration ? static_cast<float> ((after.value - before.value) / span) : 0.0f;
+    };
+
+    pieceTimes.reserve (count + 1);
+    pieces.reserve (count);
+    pieceTimes.push_back (keyframes.front().timeSeconds);
+
+    for (size_t i = 0; i + 1 < count; ++i)
+    {
+        const auto& left = keyframes[i];
+        const auto& right = keyframes[i + 1];
+        const auto from = left.value;
+        const auto to = right.value;
+        const auto delta = to - from;
+        const auto segmentDuration = right.timeSeconds - left.timeSeconds;
+
+        KeyframeSegmentPolynomial piece;
+        piece.d = from;
+
+        if (segmentDuration <= kMinSegmentDuration)
+        {
+            piece.d = to;
+        }
+        else
+        {
+            switch (left.curve)
+            {
+                case KeyframeCurve::linear:
+                    piece.c = delta;
+                    break;
+
+                case KeyframeCurve::easeIn:
+                    piece.b = delta;
+                    break;
+
+                case KeyframeCurve::easeOut:
+                    piece.b = -delta;
+                    piece.c = 2.0f * delta;
+                    break;
+
+                case KeyframeCurve::easeInOut:
+                {
+                    // Two quadratic halves: u^2 / 2, then 1 - (1 - u)^2 / 2.
+                    piece.b = 0.5f * delta;
+                    pieces.push_back (piece);
+                    pieceTimes.push_back (left.timeSeconds + 0.5 * segmentDuration);
+
+                    piece.b = -0.5f * delta;
+                    piece.c = delta;
+                    piece.d = from + 0.5f * delta;
+                    break;
+                }
+
+                case KeyframeCurve::step:
+                    break;
+
+                case KeyframeCurve::catmullRom:
+                {
+                    const auto scale = static_cast<float> (segmentDuration);
+                    const auto m0 = slopeAt (i) * scale;
+                    const auto m1 = slopeAt (i + 1) * scale;
+                    piece.a = 2.0f * from + m0 - 2.0f * to + m1;
+                    piece.b = -3.0f * from - 2.0f * m0 + 3.0f * to - m1;
+                    piece.c = m0;
+                    break;
+                }
+
+                case KeyframeCurve::bezier:
+                {
+                    const auto p1 = from + left.outHandle;
+                    const auto p2 = to + right.inHandle;
+                    piece.a = -from + 3.0f * p1 - 3.0f * p2 + to;
+                    piece.b = 3.0f * (from - 2.0f * p1 + p2);
+                    piece.c = 3.0f * (p1 - from);
+                    break;
+                }
+            }
+        }
+
+        pieces.push_back (piece);
+        pieceTimes.push_back (right.timeSeconds);
+    }
+}
+
+size_t KeyframeTimeline::locateSegment (const double* times, size_t count, size_t cursor, double timeSeconds) noexcept
+{
+    // cursor indexes the left boundary of the active piece. Forward playback
+    // usually stays in it or steps to a neighbour; seeks and loop wraps fall
+    // back to a binary search.
+    auto left = juce::jmin (cursor, count - 2);
+    if (timeSeconds >= times[left])
+    {
+        for (size_t step = 0; step < kMaxCursorSteps && timeSeconds >= times[left + 1]; ++step)
+            ++left;
+
+        if (timeSeconds < times[left + 1])
+            return left;
+    }
+
+    const auto* upper = std::upper_bound (times, times + count, timeSeconds);
+    return static_cast<size_t> (upper - times) - 1;
+}
+
+void KeyframeTimeline::compileTrack (const KeyframeTrack& track)
+{
+    const auto handle = findTrackHandle (track.getParameterId());
+    if (handle == invalidTrackHandle)
+        return;
+
+    auto& compiled = compiledTracks[static_cast<size_t> (handle)];
+    const auto& keyframes = track.getKeyframes();
+
+    compiled.pieceTimes = track.getPieceTimes();
+    compiled.pieces = track.getPieces();
+    compiled.hasKeyframes = ! keyframes.empty();
+    compiled.firstValue = compiled.hasKeyframes ? keyframes.front().value : 0.0f;
+    compiled.lastValue = compiled.hasKeyframes ? keyframes.back().value : 0.0f;
+    compiledCursors[static_cast<size_t> (handle)] = 0;
+}
+
 double KeyframeTimeline::normalizeTime (double timeSeconds, double durationSeconds, bool loop) noexcept
 {
     if (durationSeconds <= 0.0)
@@ -275,3 +582,68 @@ void KeyframeTimeline::refreshDurationFromTracks() noexcept
     durationSeconds = longestTrack;
     currentTimeSeconds = normalizeTime (currentTimeSeconds, durationSeconds, looping);
 }
+
+//==============================================================================
+juce::String keyframeCurveToString (KeyframeCurve curve)
+{
+    const auto index = static_cast<size_t> (juce::jlimit (0, static_cast<int> (kCurveNames.size()) - 1, static_cast<int> (curve)));
+    return juce::String (kCurveNames[index]);
+}
+
+KeyframeCurve keyframeCurveFromVar (const juce::var& value)
+{
+    if (value.isInt() || value.isInt64() || value.isDouble())
+        return static_cast<KeyframeCurve> (juce::jlimit (0, static_cast<int> (kCurveNames.size()) - 1, static_cast<int> (value)));
+
+    const auto text = value.toString().trim();
+    for (size_t i = 0; i < kCurveNames.size(); ++i)
+    {
+        if (text.equalsIgnoreCase (kCurveNames[i]))
+            return static_cast<KeyframeCurve> (i);
+    }
+
+    return KeyframeCurve::linear;
+}
+
+double keyframeNumberFromVar (const juce::var& value)
+{
+    const auto number = static_cast<double> (value);
+    return std::isfinite (number) ? number : 0.0;
+}
+
+std::vector<Keyframe> parseKeyframeTrack (const juce::var& keyframesVar)
+{
+    return parseKeyframeTrack<Keyframe> (keyframesVar, [] (const juce::var& value)
+    {
+        return static_cast<float> (keyframeNumberFromVar (value));
+    });
+}
+
+std::vector<KeyframeTrack> parseKeyframeTracks (const juce::var& tracksVar)
+{
+    std::vector<KeyframeTrack> tracks;
+    auto* trackArray = tracksVar.getArray();
+    if (trackArray == nullptr)
+        return tracks;
+
+    for (const auto& trackValue : *trackArray)
+    {
+        auto* trackObject = trackValue.getDynamicObject();
+        if (trackObject == nullptr)
+            continue;
+
+        const auto parameterId = trackObject->getProperty ("parameterId").toString().trim();
+        if (parameterId.isEmpty())
+            continue;
+
+        auto keyframes = parseKeyframeTrack (trackObject->getProperty ("keyframes"));
+        if (keyframes.empty())
+            continue;
+
+        KeyframeTrack track { parameterId };
+        track.setKeyframes (std::move (keyframes));
+        tracks.push_back (std::move (track));
+    }
+
+    return tracks;
+}
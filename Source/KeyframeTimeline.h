@@ -2,12 +2,14 @@
 
 #include <juce_core/juce_core.h>
 
+#include <array>
 #include <optional>
 #include <vector>
 
 //==============================================================================
 /**
- * Supported interpolation curves between keyframes.
+ * Supported interpolation curves between keyframes. The curve of a keyframe
+ * shapes the segment that starts at it.
  */
 enum class KeyframeCurve : uint8_t
 {
@@ -15,7 +17,9 @@ enum class KeyframeCurve : uint8_t
     easeIn,
     easeOut,
     easeInOut,
-    step
+    step,
+    catmullRom, // C1 spline through the neighbouring keyframes (time-aware tangents)
+    bezier      // cubic Bezier shaped by outHandle / next keyframe's inHandle
 };
 
 //==============================================================================
@@ -27,6 +31,28 @@ struct Keyframe
     double timeSeconds = 0.0;
     float value = 0.0f;
     KeyframeCurve curve = KeyframeCurve::linear;
+
+    // Bezier handles as value offsets: outHandle places the control point one
+    // third into the segment this keyframe starts, inHandle the one two thirds
+    // into the segment it ends.
+    float outHandle = 0.0f;
+    float inHandle = 0.0f;
+};
+
+//==============================================================================
+/**
+ * One compiled segment piece: a cubic in local time u in [0, 1],
+ * ((a * u + b) * u + c) * u + d. Every curve compiles to one piece per
+ * segment, except easeInOut which is split into two at its midpoint.
+ */
+struct KeyframeSegmentPolynomial
+{
+    float a = 0.0f;
+    float b = 0.0f;
+    float c = 0.0f;
+    float d = 0.0f;
+
+    float evaluate (float u) const noexcept { return ((a * u + b) * u + c) * u + d; }
 };
 
 //==============================================================================
@@ -50,18 +76,47 @@ public:
     std::optional<float> evaluate (double timeSeconds) const;
     const std::vector<Keyframe>& getKeyframes() const noexcept;
 
+    // Compiled form, rebuilt whenever the keyframes change: getPieceTimes()
+    // holds getPieces().size() + 1 boundaries (a single keyframe has none).
+    const std::vector<double>& getPieceTimes() const noexcept;
+    const std::vector<KeyframeSegmentPolynomial>& getPieces() const noexcept;
+
 private:
+    void rebuildPieces();
+
     juce::String parameterId;
     std::vector<Keyframe> keyframes;
+    std::vector<double> pieceTimes;
+    std::vector<KeyframeSegmentPolynomial> pieces;
 };
 
 //==============================================================================
 /**
  * Multi-track animation timeline with internal clocking.
+ *
+ * Track ids are interned into integer handles on the message thread. Each
+ * interned track is also compiled (buildSegmentPolynomials) into N cubic
+ * pieces with N + 1 boundary times. evaluatePieces finds the active piece
+ * with locateSegment, which steps forward from the per-track cursor and
+ * binary-searches the boundaries only on seeks and loop wraps, then runs
+ * one Horner evaluation, so forward playback costs O(1) amortized without
+ * string compares or curve switches.
  */
 class KeyframeTimeline
 {
 public:
+    using TrackHandle = int;
+    static constexpr TrackHandle invalidTrackHandle = -1;
+    static constexpr int maxTrackHandles = 32;
+
+    // Caller-owned clock and segment cursors, so one immutable timeline can be
+    // shared with the audio thread while the playback position lives there.
+    struct Playhead
+    {
+        double timeSeconds = 0.0;
+        std::array<size_t, maxTrackHandles> cursors {};
+    };
+
     void prepare (double sampleRateHz) noexcept;
     void reset() noexcept;
 
@@ -74,6 +129,28 @@ public:
     std::optional<float> evaluateTrack (const juce::String& parameterId, double timeSeconds) const;
     std::optional<float> evaluateTrackAtCurrentTime (const juce::String& parameterId) const;
 
+    // Handles are stable for the lifetime of the timeline (clearTracks keeps
+    // them). Interning allocates, so call it off the audio thread.
+    TrackHandle internTrackId (const juce::String& parameterId);
+    TrackHandle findTrackHandle (const juce::String& parameterId) const noexcept;
+    int getNumTrackHandles() const noexcept;
+
+    // Cursor-cached evaluation; mutates only the per-track segment cursor.
+    std::optional<float> evaluateHandle (TrackHandle handle, double timeSeconds) noexcept;
+    std::optional<float> evaluateHandleAtCurrentTime (TrackHandle handle) noexcept;
+
+    // Writes out[handle] for every handle whose track has keyframes and leaves
+    // the other entries untouched, so callers can prefill fallbacks. out must
+    // hold getNumTrackHandles() floats. Returns the number of values written.
+    int evaluateAll (double timeSeconds, float* out) noexcept;
+    int evaluateAllAtCurrentTime (float* out) noexcept;
+
+    // Const playback against an external playhead (same rate clamp and wrap
+    // rules as advance/setCurrentTimeSeconds, with the loop flag supplied).
+    void seekPlayhead (Playhead& playhead, double timeSeconds, bool loop) const noexcept;
+    void advancePlayhead (Playhead& playhead, double blockDurationSeconds, float rate, bool loop) const noexcept;
+    int evaluateAll (Playhead& playhead, float* out) const noexcept;
+
     void advance (double blockDurationSeconds) noexcept;
     void setCurrentTimeSeconds (double timeSeconds) noexcept;
     double getCurrentTimeSeconds() const noexcept;
@@ -87,10 +164,46 @@ public:
     void setPlaybackRate (float newRate) noexcept;
     float getPlaybackRate() const noexcept;
 
+    // Easing shape for the fixed curves; the spline curves depend on their
+    // neighbours and are only available through buildSegmentPolynomials.
     static float applyCurve (KeyframeCurve curve, float t) noexcept;
+
+    // Index of the left boundary of the interval of times containing
+    // timeSeconds (a piece, for compiled tracks), starting the search from
+    // cursor. Requires count >= 2 and times[0] < timeSeconds < times[count - 1].
+    static size_t locateSegment (const double* times, size_t count, size_t cursor, double timeSeconds) noexcept;
+
+    // Compiles time-sorted keyframes into polynomial pieces (see
+    // KeyframeSegmentPolynomial); pieceTimes receives pieces.size() + 1 boundaries.
+    static void buildSegmentPolynomials (const std::vector<Keyframe>& keyframes,
+                                         std::vector<double>& pieceTimes,
+                                         std::vector<KeyframeSegmentPolynomial>& pieces);
+
+    // Branch-free evaluation of compiled pieces; before the first boundary it
+    // holds firstValue, after the last lastValue.
+    static float evaluatePieces (const double* pieceTimes,
+                                 const KeyframeSegmentPolynomial* pieces,
+                                 size_t numPieces,
+                                 float firstValue,
+                                 float lastValue,
+                                 size_t& cursor,
+                                 double timeSeconds) noexcept;
+
     const std::vector<KeyframeTrack>& getTracks() const noexcept;
 
 private:
+    struct CompiledTrack
+    {
+        std::vector<double> pieceTimes;
+        std::vector<KeyframeSegmentPolynomial> pieces;
+        float firstValue = 0.0f;
+        float lastValue = 0.0f;
+        bool hasKeyframes = false;
+    };
+
+    static float evaluateCompiled (const CompiledTrack& track, size_t& cursor, double timeSeconds) noexcept;
+    void compileTrack (const KeyframeTrack& track);
+
     static double normalizeTime (double timeSeconds, double durationSeconds, bool loop) noexcept;
 
     const KeyframeTrack* findTrack (const juce::String& parameterId) const;
@@ -103,4 +216,52 @@ private:
     bool looping = false;
 
     std::vector<KeyframeTrack> tracks;
+    std::vector<juce::String> internedTrackIds;
+    std::vector<CompiledTrack> compiledTracks;
+    std::array<size_t, maxTrackHandles> compiledCursors {};
 };
+
+//==============================================================================
+// JSON interchange shared by the plugin's state/UI bridge and the offline
+// scene renderer. Curves are written as names and read as names or indices.
+juce::String keyframeCurveToString (KeyframeCurve curve);
+KeyframeCurve keyframeCurveFromVar (const juce::var& value);
+
+// Missing or non-finite numbers read as 0.
+double keyframeNumberFromVar (const juce::var& value);
+
+// Reads [{ timeSeconds, value, curve, outHandle, inHandle }] into any keyframe
+// type with those members; readValue converts value and both handles, so
+// scalar and path tracks share one loop. Entries that are not objects are skipped.
+template <typename KeyframeType, typename ValueReader>
+std::vector<KeyframeType> parseKeyframeTrack (const juce::var& keyframesVar, ValueReader&& readValue)
+{
+    std::vector<KeyframeType> keyframes;
+    auto* keyframeArray = keyframesVar.getArray();
+    if (keyframeArray == nullptr)
+        return keyframes;
+
+    keyframes.reserve (static_cast<size_t> (keyframeArray->size()));
+    for (const auto& keyframeValue : *keyframeArray)
+    {
+        auto* keyframeObject = keyframeValue.getDynamicObject();
+        if (keyframeObject == nullptr)
+            continue;
+
+        KeyframeType keyframe;
+        keyframe.timeSeconds = keyframeNumberFromVar (keyframeObject->getProperty ("timeSeconds"));
+        keyframe.value = readValue (keyframeObject->getProperty ("value"));
+        keyframe.curve = keyframeCurveFromVar (keyframeObject->getProperty ("curve"));
+        keyframe.outHandle = readValue (keyframeObject->getProperty ("outHandle"));
+        keyframe.inHandle = readValue (keyframeObject->getProperty ("inHandle"));
+        keyframes.push_back (keyframe);
+    }
+
+    return keyframes;
+}
+
+// Scalar tracks.
+std::vector<Keyframe> parseKeyframeTrack (const juce::var& keyframesVar);
+
+// Reads [{ parameterId, keyframes }]; tracks without an id or keyframes are dropped.
+std::vector<KeyframeTrack> parseKeyframeTracks (const juce::var& tracksVar);
@@ -0,0 +1,518 @@
+#pragma once
+
+#include "SceneGraph.h"
+#include "SpatialRenderer.h"
+#include "KeyframeTimeline.h"
+#include "RoomProfileSerializer.h"
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+/**
+ * OfflineSceneRenderer
+ *
+ * Faster-than-realtime scene bounce. Loads a saved scene (emitter audio files,
+ * per-emitter keyframe timelines, optional RoomProfile), drives
+ * SpatialRenderer::process as fast as the CPU allows on a private SceneGraph
+ * and writes the multichannel result to a WAV file.
+ *
+ * Differences from the host path:
+ *   - Internal blocks default to 2048 samples (up to the SceneGraph handoff
+ *     limit); emitter positions/timelines are sampled once per block.
+ *   - The per-block emitter budget is raised to every tracked emitter.
+ *   - No head tracking, physics or audition; the scene is rendered as saved.
+ *
+ * Scene JSON (paths are relative to the scene file):
+ * {
+ *   "sampleRate": 48000,
+ *   "outputChannels": 4,
+ *   "spatialProfile": "quad_4_0",          // id or index, see spatialOutputProfileToString
+ *   "durationSeconds": 0,                  // 0 = longest emitter + tailSeconds
+ *   "tailSeconds": 2.0,
+ *   "renderer": { "qualityTier": 1, "masterGainDb": 0, "distanceModel": 0,
+ *                 "referenceDistance": 1, "maxDistance": 50,
+ *                 "dopplerEnabled": false, "dopplerScale": 1,
+ *                 "airAbsorptionEnabled": true,
+ *                 "roomEnabled": true, "roomMix": 0.3, "roomSize": 1, "roomDamping": 0.5,
+ *                 "earlyReflectionsOnly": false },
+ *   "roomProfile": "room.json",            // RoomProfileSerializer file, or inline object
+ *   "emitters": [
+ *     { "label": "Vox", "audio": "vox.wav", "gainDb": 0, "spread": 0, "directivity": 0.5,
+ *       "muted": false, "coordMode": "spherical",
+ *       "position": { "azimuth": 0, "elevation": 0, "distance": 2 },   // or { "x", "y", "z" }
+ *       "timeline": { ... same schema as the plugin keyframe timeline ... } }
+ *   ]
+ * }
+ */
+class OfflineSceneRenderer
+{
+public:
+    static constexpr int DEFAULT_BLOCK_SIZE = 2048;
+    static constexpr int MAX_BLOCK_SIZE = EmitterSlot::MAX_SHARED_AUDIO_SAMPLES;
+
+    struct Emitter
+    {
+        juce::String label { "Emitter" };
+        juce::File audioFile;
+        bool spherical = true;
+        float azimuthDeg = 0.0f;
+        float elevationDeg = 0.0f;
+        float distance = 2.0f;
+        Vec3 cartesian { 0.0f, 0.0f, 2.0f }; // parameter axes: x right, y front, z up
+        float sizeUniform = 0.5f;
+        float gainDb = 0.0f;
+        float spread = 0.0f;
+        float directivity = 0.5f;
+        bool muted = false;
+        KeyframeTimeline timeline;
+    };
+
+    struct RendererSettings
+    {
+        int qualityTier = 1;
+        float masterGainDb = 0.0f;
+        int distanceModel = 0;
+        float referenceDistance = 1.0f;
+        float maxDistance = 50.0f;
+        bool dopplerEnabled = false;
+        float dopplerScale = 1.0f;
+        bool airAbsorptionEnabled = true;
+        bool roomEnabled = true;
+        float roomMix = 0.3f;
+        float roomSize = 1.0f;
+        float roomDamping = 0.5f;
+        bool earlyReflectionsOnly = false;
+    };
+
+    struct Scene
+    {
+        double sampleRate = 48000.0;
+        int outputChannels = 2;
+        int spatialProfileIndex = 0;
+        double durationSeconds = 0.0;
+        double tailSeconds = 2.0;
+        RendererSettings renderer;
+        RoomProfile roomProfile;
+        std::vector<Emitter> emitters;
+    };
+
+    struct Options
+    {
+        int blockSize = DEFAULT_BLOCK_SIZE;
+        int bitDepth = 24;
+        bool uncappedEmitterBudget = true;
+    };
+
+    struct Result
+    {
+        bool ok = false;
+        juce::String message;
+        juce::int64 samplesRendered = 0;
+        double renderedSeconds = 0.0;
+        double wallSeconds = 0.0;
+        double realtimeFactor = 0.0;
+    };
+
+    // Returning false from the progress callback cancels the bounce.
+    using ProgressCallback = std::function<bool (double fraction)>;
+
+    //==========================================================================
+    static bool loadScene (const juce::File& sceneFile, Scene& scene, juce::String& error)
+    {
+        if (! sceneFile.existsAsFile())
+        {
+            error = "scene file not found: " + sceneFile.getFullPathName();
+            return false;
+        }
+
+        const auto rootVar = juce::JSON::parse (sceneFile);
+        auto* root = rootVar.getDynamicObject();
+        if (root == nullptr)
+        {
+            error = "scene file is not a JSON object";
+            return false;
+        }
+
+        const auto baseDir = sceneFile.getParentDirectory();
+        scene = Scene {};
+        scene.sampleRate = juce::jlimit (8000.0, 192000.0, getDouble (rootVar, "sampleRate", scene.sampleRate));
+        scene.outputChannels = juce::jlimit (1, SpatialRenderer::MAX_BED_CHANNELS,
+                                             getInt (rootVar, "outputChannels", scene.outputChannels));
+        scene.spatialProfileIndex = parseSpatialProfile (root->getProperty ("spatialProfile"));
+        scene.durationSeconds = juce::jmax (0.0, getDouble (rootVar, "durationSeconds", 0.0));
+        scene.tailSeconds = juce::jmax (0.0, getDouble (rootVar, "tailSeconds", scene.tailSeconds));
+
+        const auto rendererVar = root->getProperty ("renderer");
+        auto& settings = scene.renderer;
+        settings.qualityTier = getInt (rendererVar, "qualityTier", settings.qualityTier);
+        settings.masterGainDb = getFloat (rendererVar, "masterGainDb", settings.masterGainDb);
+        settings.distanceModel = getInt (rendererVar, "distanceModel", settings.distanceModel);
+        settings.referenceDistance = getFloat (rendererVar, "referenceDistance", settings.referenceDistance);
+        settings.maxDistance = getFloat (rendererVar, "maxDistance", settings.maxDistance);
+        settings.dopplerEnabled = getBool (rendererVar, "dopplerEnabled", settings.dopplerEnabled);
+        settings.dopplerScale = getFloat (rendererVar, "dopplerScale", settings.dopplerScale);
+        settings.airAbsorptionEnabled = getBool (rendererVar, "airAbsorptionEnabled", settings.airAbsorptionEnabled);
+        settings.roomEnabled = getBool (rendererVar, "roomEnabled", settings.roomEnabled);
+        settings.roomMix = getFloat (rendererVar, "roomMix", settings.roomMix);
+        settings.roomSize = getFloat (rendererVar, "roomSize", settings.roomSize);
+        settings.roomDamping = getFloat (rendererVar, "roomDamping", settings.roomDamping);
+        settings.earlyReflectionsOnly = getBool (rendererVar, "earlyReflectionsOnly", settings.earlyReflectionsOnly);
+
+        const auto roomVar = root->getProperty ("roomProfile");
+        if (roomVar.isString())
+        {
+            const auto roomFile = baseDir.getChildFile (roomVar.toString());
+            if (! RoomProfileSerializer::loadFromFile (scene.roomProfile, roomFile))
+            {
+                error = "room profile could not be loaded: " + roomFile.getFullPathName();
+                return false;
+            }
+        }
+        else if (roomVar.isObject())
+        {
+            if (! RoomProfileSerializer::fromJSON (scene.roomProfile, juce::JSON::toString (roomVar)))
+            {
+                error = "inline room profile is invalid";
+                return false;
+            }
+        }
+
+        auto* emitterArray = root->getProperty ("emitters").getArray();
+        if (emitterArray == nullptr || emitterArray->isEmpty())
+        {
+            error = "scene has no emitters";
+            return false;
+        }
+
+        if (emitterArray->size() > SpatialRenderer::getMaxRenderEmitterBudget())
+        {
+            error = "scene has " + juce::String (emitterArray->size()) + " emitters; offline bounce supports "
+                    + juce::String (SpatialRenderer::getMaxRenderEmitterBudget());
+            return false;
+        }
+
+        for (const auto& emitterVar : *emitterArray)
+        {
+            auto* emitterObject = emitterVar.getDynamicObject();
+            if (emitterObject == nullptr)
+                continue;
+
+            Emitter emitter;
+            emitter.label = emitterObject->getProperty ("label").toString();
+            if (emitter.label.isEmpty())
+                emitter.label = "Emitter " + juce::String (static_cast<int> (scene.emitters.size()) + 1);
+
+            emitter.audioFile = baseDir.getChildFile (emitterObject->getProperty ("audio").toString());
+            if (! emitter.audioFile.existsAsFile())
+            {
+                error = "emitter '" + emitter.label + "' audio not found: " + emitter.audioFile.getFullPathName();
+                return false;
+            }
+
+            emitter.spherical = ! emitterObject->getProperty ("coordMode").toString().equalsIgnoreCase ("cartesian");
+            const auto positionVar = emitterObject->getProperty ("position");
+            emitter.azimuthDeg = getFloat (positionVar, "azimuth", emitter.azimuthDeg);
+            emitter.elevationDeg = getFloat (positionVar, "elevation", emitter.elevationDeg);
+            emitter.distance = getFloat (positionVar, "distance", emitter.distance);
+            emitter.cartesian.x = getFloat (positionVar, "x", emitter.cartesian.x);
+            emitter.cartesian.y = getFloat (positionVar, "y", emitter.cartesian.y);
+            emitter.cartesian.z = getFloat (positionVar, "z", emitter.cartesian.z);
+            emitter.sizeUniform = getFloat (emitterVar, "size", emitter.sizeUniform);
+            emitter.gainDb = getFloat (emitterVar, "gainDb", emitter.gainDb);
+            emitter.spread = getFloat (emitterVar, "spread", emitter.spread);
+            emitter.directivity = getFloat (emitterVar, "directivity", emitter.directivity);
+            emitter.muted = getBool (emitterVar, "muted", emitter.muted);
+            parseTimeline (emitterObject->getProperty ("timeline"), emitter.timeline);
+
+            scene.emitters.push_back (std::move (emitter));
+        }
+
+        return true;
+    }
+
+    //==========================================================================
+    Result render (Scene& scene,
+                   const juce::File& outputFile,
+                   const Options& options,
+                   const ProgressCallback& progress = {})
+    {
+        Result result;
+        const int blockSize = juce::jlimit (64, MAX_BLOCK_SIZE, options.blockSize);
+        const double sampleRate = scene.sampleRate;
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+
+        // Per-emitter streaming sources, resampled to the scene rate.
+        std::vector<std::unique_ptr<EmitterSource>> sources;
+        double longestSourceSeconds = 0.0;
+        for (const auto& emitter : scene.emitters)
+        {
+            auto source = std::make_unique<EmitterSource>();
+            auto* reader = formatManager.createReaderFor (emitter.audioFile);
+            if (reader == nullptr)
+            {
+                result.message = "unsupported audio file: " + emitter.audioFile.getFullPathName();
+                return result;
+            }
+
+            const int sourceChannels = juce::jlimit (1, 2, static_cast<int> (reader->numChannels));
+            const double sourceSeconds = static_cast<double> (reader->lengthInSamples) / juce::jmax (1.0, reader->sampleRate);
+            longestSourceSeconds = juce::jmax (longestSourceSeconds, sourceSeconds);
+
+            source->readerSource = std::make_unique<juce::AudioFormatReaderSource> (reader, true);
+            source->resampler = std::make_unique<juce::ResamplingAudioSource> (source->readerSource.get(), false, sourceChannels);
+            source->resampler->setResamplingRatio (reader->sampleRate / sampleRate);
+            source->resampler->prepareToPlay (blockSize, sampleRate);
+            source->buffer.setSize (sourceChannels, blockSize);
+            sources.push_back (std::move (source));
+        }
+
+        const double durationSeconds = scene.durationSeconds > 0.0 ? scene.durationSeconds
+                                                                   : longestSourceSeconds + scene.tailSeconds;
+        const auto totalSamples = static_cast<juce::int64> (std::ceil (durationSeconds * sampleRate));
+        if (totalSamples <= 0)
+        {
+            result.message = "scene has zero duration";
+            return result;
+        }
+
+        outputFile.deleteFile();
+        auto fileStream = std::make_unique<juce::FileOutputStream> (outputFile);
+        if (fileStream->failedToOpen())
+        {
+            result.message = "cannot open output file: " + outputFile.getFullPathName();
+            return result;
+        }
+
+        juce::WavAudioFormat wavFormat;
+        std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (fileStream.get(),
+                                                                                    sampleRate,
+                                                                                    static_cast<unsigned int> (scene.outputChannels),
+                                                                                    options.bitDepth,
+                                                                                    {},
+                                                                                    0));
+        if (writer == nullptr)
+        {
+            result.message = "cannot create WAV writer for " + juce::String (scene.outputChannels) + " channels";
+            return result;
+        }
+        fileStream.release(); // owned by the writer now
+
+        // Private scene + renderer: never touches the host-shared singleton.
+        std::unique_ptr<SceneGraph> sceneGraph (new SceneGraph());
+        auto renderer = std::make_unique<SpatialRenderer>();
+        configureRenderer (*renderer, scene, options);
+        renderer->prepare (sampleRate, blockSize);
+        if (scene.roomProfile.valid)
+            sceneGraph->setRoomProfile (scene.roomProfile);
+
+        std::vector<int> slots;
+        for (auto& emitter : scene.emitters)
+        {
+            const int slot = sceneGraph->registerEmitter();
+            if (slot < 0)
+            {
+                result.message = "scene graph is full";
+                return result;
+            }
+
+            emitter.timeline.prepare (sampleRate);
+            emitter.timeline.reset();
+            slots.push_back (slot);
+        }
+
+        juce::AudioBuffer<float> outputBuffer (scene.outputChannels, blockSize);
+        const auto startMs = juce::Time::getMillisecondCounterHiRes();
+        juce::int64 renderedSamples = 0;
+
+        while (renderedSamples < totalSamples)
+        {
+            const int numSamples = static_cast<int> (juce::jmin<juce::int64> (blockSize, totalSamples - renderedSamples));
+            const double blockSeconds = static_cast<double> (numSamples) / sampleRate;
+
+            for (size_t i = 0; i < scene.emitters.size(); ++i)
+            {
+                auto& emitter = scene.emitters[i];
+                auto& source = *sources[i];
+                auto& slot = sceneGraph->getSlot (slots[i]);
+
+                slot.write (evaluateEmitter (emitter));
+                emitter.timeline.advance (blockSeconds);
+
+                source.buffer.setSize (source.buffer.getNumChannels(), numSamples, false, false, true);
+                source.resampler->getNextAudioBlock (juce::AudioSourceChannelInfo (source.buffer));
+                slot.setAudioBuffer (source.buffer.getArrayOfReadPointers(), source.buffer.getNumChannels(), numSamples);
+            }
+
+            outputBuffer.setSize (scene.outputChannels, numSamples, false, false, true);
+            outputBuffer.clear();
+            renderer->process (outputBuffer, *sceneGraph);
+            sceneGraph->advanceSampleCounter (numSamples);
+
+            if (! writer->writeFromAudioSampleBuffer (outputBuffer, 0, numSamples))
+            {
+                result.message = "write failed after " + juce::String (renderedSamples) + " samples";
+                return result;
+            }
+
+            renderedSamples += numSamples;
+            if (progress && ! progress (static_cast<double> (renderedSamples) / static_cast<double> (totalSamples)))
+            {
+                result.message = "cancelled";
+                break;
+            }
+        }
+
+        writer.reset();
+        renderer->shutdown();
+
+        result.samplesRendered = renderedSamples;
+        result.renderedSeconds = static_cast<double> (renderedSamples) / sampleRate;
+        result.wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startMs) * 0.001;
+        result.realtimeFactor = result.wallSeconds > 0.0 ? result.renderedSeconds / result.wallSeconds : 0.0;
+        result.ok = renderedSamples == totalSamples;
+        if (result.ok)
+            result.message = "ok";
+        return result;
+    }
+
+private:
+    struct EmitterSource
+    {
+        std::unique_ptr<juce::AudioFormatReaderSource> readerSource;
+        std::unique_ptr<juce::ResamplingAudioSource> resampler;
+        juce::AudioBuffer<float> buffer;
+    };
+
+    static void configureRenderer (SpatialRenderer& renderer, const Scene& scene, const Options& options)
+    {
+        const auto& settings = scene.renderer;
+        renderer.setSpatialOutputProfile (scene.spatialProfileIndex);
+        renderer.setQualityTier (settings.qualityTier);
+        renderer.setMasterGain (settings.masterGainDb);
+        renderer.setDistanceModel (settings.distanceModel);
+        renderer.setReferenceDistance (settings.referenceDistance);
+        renderer.setMaxDistance (settings.maxDistance);
+        renderer.setDopplerEnabled (settings.dopplerEnabled);
+        renderer.setDopplerScale (settings.dopplerScale);
+        renderer.setAirAbsorptionEnabled (settings.airAbsorptionEnabled);
+        renderer.setRoomEnabled (settings.roomEnabled);
+        renderer.setRoomMix (settings.roomMix);
+        renderer.setRoomSize (settings.roomSize);
+        renderer.setRoomDamping (settings.roomDamping);
+        renderer.setEarlyReflectionsOnly (settings.earlyReflectionsOnly);
+        renderer.setRenderEmitterBudget (options.uncappedEmitterBudget ? SpatialRenderer::getMaxRenderEmitterBudget()
+                                                                       : SpatialRenderer::getDefaultRenderEmitterBudget());
+
+        if (scene.roomProfile.valid)
+        {
+            for (int spk = 0; spk < SpatialRenderer::NUM_SPEAKERS; ++spk)
+            {
+                const auto& speaker = scene.roomProfile.speakers[static_cast<size_t> (spk)];
+                renderer.setSpeakerTrim (spk, speaker.gainTrim);
+                renderer.setSpeakerDelay (spk, speaker.delayComp);
+            }
+        }
+    }
+
+    // Same track ids and coordinate mapping as the plugin's emitter path.
+    static EmitterData evaluateEmitter (const Emitter& emitter)
+    {
+        EmitterData data;
+        data.active = true;
+        emitter.label.copyToUTF8 (data.label, sizeof (data.label));
+
+        const auto& timeline = emitter.timeline;
+        const auto evaluate = [&timeline] (const char* trackId, float fallback)
+        {
+            const auto value = timeline.evaluateTrackAtCurrentTime (trackId);
+            return value.has_value() ? *value : fallback;
+        };
+
+        data.position = emitter.spherical
+                            ? emitterPositionFromSpherical (evaluate ("pos_azimuth", emitter.azimuthDeg),
+                                                            evaluate ("pos_elevation", emitter.elevationDeg),
+                                                            evaluate ("pos_distance", emitter.distance))
+                            : emitterPositionFromCartesian (evaluate ("pos_x", emitter.cartesian.x),
+                                                            evaluate ("pos_y", emitter.cartesian.y),
+                                                            evaluate ("pos_z", emitter.cartesian.z));
+
+        const float size = juce::jlimit (0.01f, 20.0f, evaluate ("size_uniform", emitter.sizeUniform));
+        data.size = { size, size, size };
+        data.gain = emitter.gainDb;
+        data.spread = emitter.spread;
+        data.directivity = emitter.directivity;
+        data.muted = emitter.muted;
+        return data;
+    }
+
+    static void parseTimeline (const juce::var& timelineVar, KeyframeTimeline& timeline)
+    {
+        auto* timelineObject = timelineVar.getDynamicObject();
+        if (timelineObject == nullptr)
+            return;
+
+        for (auto& track : parseKeyframeTracks (timelineObject->getProperty ("tracks")))
+            timeline.addOrReplaceTrack (std::move (track));
+
+        if (timelineObject->hasProperty ("durationSeconds"))
+            timeline.setDurationSeconds (getDouble (timelineVar, "durationSeconds", 0.0));
+        timeline.setLooping (getBool (timelineVar, "looping", false));
+        timeline.setPlaybackRate (getFloat (timelineVar, "playbackRate", 1.0f));
+    }
+
+    static int parseSpatialProfile (const juce::var& value)
+    {
+        if (value.isInt() || value.isInt64() || value.isDouble())
+            return juce::jlimit (0, static_cast<int> (SpatialRenderer::SpatialOutputProfile::CodecADM), static_cast<int> (value));
+
+        const auto text = value.toString().trim();
+        for (int i = 0; i <= static_cast<int> (SpatialRenderer::SpatialOutputProfile::CodecADM); ++i)
+            if (text.equalsIgnoreCase (SpatialRenderer::spatialOutputProfileToString (i)))
+                return i;
+
+        return static_cast<int> (SpatialRenderer::SpatialOutputProfile::Auto);
+    }
+
+    static double getDouble (const juce::var& objectVar, const char* key, double fallback)
+    {
+        if (auto* object = objectVar.getDynamicObject(); object != nullptr && object->hasProperty (key))
+        {
+            const auto value = static_cast<double> (object->getProperty (key));
+            return std::isfinite (value) ? value : fallback;
+        }
+
+        return fallback;
+    }
+
+    static float getFloat (const juce::var& objectVar, const char* key, float fallback)
+    {
+        return static_cast<float> (getDouble (objectVar, key, static_cast<double> (fallback)));
+    }
+
+    static int getInt (const juce::var& objectVar, const char* key, int fallback)
+    {
+        if (auto* object = objectVar.getDynamicObject(); object != nullptr && object->hasProperty (key))
+            return static_cast<int> (object->getProperty (key));
+
+        return fallback;
+    }
+
+    static bool getBool (const juce::var& objectVar, const char* key, bool fallback)
+    {
+        if (auto* object = objectVar.getDynamicObject(); object != nullptr && object->hasProperty (key))
+            return static_cast<bool> (object->getProperty (key));
+
+        return fallback;
+    }
+};
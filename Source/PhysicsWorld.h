@@ -0,0 +1,839 @@
+#pragma once
+
+#include "SceneGraph.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <mutex>
+#include <semaphore>
+#include <thread>
+
+//==============================================================================
+/**
+ * PhysicsBodyState - published simulation result for one body.
+ */
+struct PhysicsBodyState
+{
+    Vec3 position { 0.0f, 0.0f, 0.0f };
+    Vec3 velocity { 0.0f, 0.0f, 0.0f };
+    Vec3 force { 0.0f, 0.0f, 0.0f };
+    std::uint8_t collisionMask = 0; // bit0=X wall, bit1=Y floor/ceiling, bit2=Z wall, bit3=another body
+    float collisionEnergy = 0.0f;
+    bool initialized = false;
+};
+
+//==============================================================================
+/**
+ * PhysicsBodyControl - per-body control block and result buffer.
+ *
+ * Owned by the emitter instance (via PhysicsEngine). The owner writes the
+ * atomics from any thread; PhysicsWorld reads them once per tick and writes
+ * results into the double-buffered state, which the owner reads lock-free.
+ */
+struct PhysicsBodyControl
+{
+    PhysicsBodyState readState() const
+    {
+        const int idx = readIndex.load (std::memory_order_acquire);
+        return stateBuffers[static_cast<size_t> (idx)];
+    }
+
+    void writeState (const PhysicsBodyState& state)
+    {
+        const int nextWrite = 1 - readIndex.load (std::memory_order_acquire);
+        stateBuffers[static_cast<size_t> (nextWrite)] = state;
+        readIndex.store (nextWrite, std::memory_order_release);
+    }
+
+    std::array<PhysicsBodyState, 2> stateBuffers {};
+    std::atomic<int> readIndex { 0 };
+
+    std::atomic<int> updateRateIndex { 1 };
+    std::atomic<bool> simulationPaused { false };
+    std::atomic<bool> wallCollisionEnabled { true };
+
+    std::atomic<bool> bodyEnabled { false };
+    std::atomic<float> mass { 1.0f };
+    std::atomic<float> drag { 0.5f };
+    std::atomic<float> elasticity { 0.7f };
+    std::atomic<float> friction { 0.3f };
+
+    std::atomic<float> gravityMagnitude { 0.0f };
+    std::atomic<int> gravityDirection { 0 };
+    std::atomic<float> interactionForceX { 0.0f };
+    std::atomic<float> interactionForceY { 0.0f };
+    std::atomic<float> interactionForceZ { 0.0f };
+
+    std::atomic<float> restX { 0.0f };
+    std::atomic<float> restY { 0.0f };
+    std::atomic<float> restZ { 0.0f };
+
+    std::atomic<bool> bodyCollisionEnabled { false };
+    std::atomic<float> collisionRadius { 0.25f };
+
+    std::atomic<float> roomWidth { 6.0f };
+    std::atomic<float> roomDepth { 4.0f };
+    std::atomic<float> roomHeight { 3.0f };
+
+    std::atomic<float> throwVelocityX { 0.0f };
+    std::atomic<float> throwVelocityY { 0.0f };
+    std::atomic<float> throwVelocityZ { 0.0f };
+    std::atomic<uint32_t> throwSequence { 0 };
+    std::atomic<uint32_t> resetSequence { 0 };
+};
+
+//==============================================================================
+/**
+ * PhysicsWorld - process-wide batched simulation for every emitter body.
+ *
+ * One scheduler thread wakes at the fastest rate any registered body asks
+ * for and steps all bodies together. Simulation state lives in
+ * structure-of-arrays form so the integration pass runs as straight-line
+ * loops over contiguous floats; wall collisions and control sampling stay
+ * per body. Results go back through each body's PhysicsBodyControl buffers.
+ *
+ * Two clocks: free-running (the scheduler ticks on wall time) or locked to
+ * the audio sample clock, where the renderer's block posts the sample clock
+ * the world should reach and the scheduler runs the fixed steps up to it,
+ * publishing positions interpolated between the last two steps. The audio
+ * thread never steps the world itself.
+ *
+ * Locked stepping is reproducible in a bounded sense: step count, dt and
+ * the interpolation weight are functions of the sample clock alone, however
+ * it is split into blocks, and each step samples every body's controls once,
+ * in slot order. Two runs match bit for bit when the same control values
+ * reach the world between the same steps (static parameters, or a driver
+ * that waits for isSampleClockSettled() before changing them, as the physics
+ * probe does). OfflineSceneRenderer renders without physics, so bounces make
+ * no physics claim at all. Live emitters
+ * write their controls from their own audio threads, so an automation change
+ * can land one step earlier or later from run to run; that is not replayed
+ * exactly.
+ *
+ * Bodies that opt in also collide with each other as spheres. A hashed
+ * uniform grid (cell = largest participating diameter) keeps pair tests
+ * proportional to local density rather than N².
+ */
+class PhysicsWorld
+{
+public:
+    static constexpr int MAX_BODIES = SceneGraph::MAX_EMITTERS;
+
+    //--------------------------------------------------------------------------
+    // Singleton access
+    static PhysicsWorld& getInstance()
+    {
+        static PhysicsWorld instance;
+        return instance;
+    }
+
+    //--------------------------------------------------------------------------
+    // Body registration (message thread). The control block must outlive its
+    // registration; removeBody() waits for any in-flight tick to finish.
+    int addBody (PhysicsBodyControl& control)
+    {
+        const std::lock_guard<std::mutex> lifecycle (lifecycleMutex);
+        int slot = -1;
+        {
+            const std::lock_guard<std::mutex> lock (bodiesMutex);
+            for (int i = 0; i < MAX_BODIES; ++i)
+            {
+                if (bodies[static_cast<size_t> (i)] != nullptr)
+                    continue;
+
+                bodies[static_cast<size_t> (i)] = &control;
+                needsInit[static_cast<size_t> (i)] = true;
+                initialized[static_cast<size_t> (i)] = false;
+                slotHighWater = juce::jmax (slotHighWater, i + 1);
+                ++numBodies;
+                slot = i;
+                break;
+            }
+        }
+
+        if (slot >= 0 && ! running.load (std::memory_order_acquire))
+        {
+            running.store (true, std::memory_order_release);
+            scheduler = std::thread ([this] { runLoop(); });
+        }
+
+        return slot;
+    }
+
+    void removeBody (int slot)
+    {
+        if (slot < 0 || slot >= MAX_BODIES)
+            return;
+
+        const std::lock_guard<std::mutex> lifecycle (lifecycleMutex);
+        bool stopScheduler = false;
+        {
+            const std::lock_guard<std::mutex> lock (bodiesMutex);
+            if (bodies[static_cast<size_t> (slot)] == nullptr)
+                return;
+
+            bodies[static_cast<size_t> (slot)] = nullptr;
+            --numBodies;
+            while (slotHighWater > 0 && bodies[static_cast<size_t> (slotHighWater - 1)] == nullptr)
+                --slotHighWater;
+            stopScheduler = numBodies == 0;
+        }
+
+        if (stopScheduler)
+            stopSchedulerThread();
+    }
+
+    int getNumBodies() const
+    {
+        const std::lock_guard<std::mutex> lock (bodiesMutex);
+        return numBodies;
+    }
+
+    uint64_t getTickCount() const { return tickCount.load (std::memory_order_relaxed); }
+
+    //--------------------------------------------------------------------------
+    // Sample-clock lock (deterministic mode).
+    void setSampleClockLocked (bool shouldLock) noexcept
+    {
+        if (shouldLock && ! sampleClockLocked.load (std::memory_order_acquire))
+        {
+            clockAnchorRequested.store (true, std::memory_order_release);
+            lastClockAdvanceTicks.store (Clock::now().time_since_epoch().count(), std::memory_order_release);
+        }
+        sampleClockLocked.store (shouldLock, std::memory_order_release);
+    }
+
+    bool isSampleClockLocked() const noexcept { return sampleClockLocked.load (std::memory_order_acquire); }
+
+    // Audio thread (renderer block). Posts the sample clock the world should
+    // reach and wakes the scheduler, which steps up to it and publishes
+    // positions interpolated to it. O(1) and never blocks: if the scheduler
+    // is still busy, later posts supersede earlier ones, and only the post
+    // that finds no wake pending touches the semaphore.
+    void advanceToSampleClock (uint64_t sampleCounter, double sampleRate) noexcept
+    {
+        if (! sampleClockLocked.load (std::memory_order_acquire) || sampleRate <= 0.0)
+            return;
+
+        clockTargetRate.store (sampleRate, std::memory_order_relaxed);
+        clockTargetSample.store (sampleCounter, std::memory_order_relaxed);
+        clockTargetSerial.fetch_add (1, std::memory_order_release);
+        lastClockAdvanceTicks.store (Clock::now().time_since_epoch().count(), std::memory_order_release);
+        wakeScheduler();
+    }
+
+    // True once the scheduler has stepped to the latest posted sample clock.
+    bool isSampleClockSettled() const noexcept
+    {
+        return steppedClockSerial.load (std::memory_order_acquire) == clockTargetSerial.load (std::memory_order_acquire);
+    }
+
+    // Narrowphase sphere tests run by the last tick's broadphase.
+    int getLastBodyPairTests() const { return lastBodyPairTests.load (std::memory_order_relaxed); }
+
+private:
+    PhysicsWorld() = default;
+
+    ~PhysicsWorld()
+    {
+        const std::lock_guard<std::mutex> lifecycle (lifecycleMutex);
+        stopSchedulerThread();
+    }
+
+    PhysicsWorld (const PhysicsWorld&) = delete;
+    PhysicsWorld& operator= (const PhysicsWorld&) = delete;
+
+    void stopSchedulerThread()
+    {
+        if (! running.exchange (false, std::memory_order_acq_rel))
+            return;
+
+        wakeScheduler();
+        if (scheduler.joinable())
+            scheduler.join();
+    }
+
+    //==========================================================================
+    void runLoop()
+    {
+        auto nextTick = Clock::now();
+
+        uint64_t handledClockSerial = steppedClockSerial.load (std::memory_order_acquire);
+
+        while (running.load (std::memory_order_acquire))
+        {
+            // While the sample clock drives the world, step only when the
+            // renderer has posted a new target.
+            if (isDrivenBySampleClock())
+            {
+                const auto serial = clockTargetSerial.load (std::memory_order_acquire);
+                if (serial != handledClockSerial)
+                {
+                    handledClockSerial = serial;
+                    {
+                        const std::lock_guard<std::mutex> lock (bodiesMutex);
+                        stepToSampleClock (clockTargetSample.load (std::memory_order_relaxed),
+                                           clockTargetRate.load (std::memory_order_relaxed));
+                    }
+                    steppedClockSerial.store (serial, std::memory_order_release);
+                }
+
+                // Sleep until the next post (or stop). The timeout lets the
+                // loop notice a renderer that stopped advancing and fall
+                // back to wall-clock ticks.
+                if (clockWake.try_acquire_for (kClockSourceTimeout))
+                    clockWakePending.store (false, std::memory_order_release);
+                nextTick = Clock::now();
+                continue;
+            }
+
+            float dt = 1.0f;
+            {
+                const std::lock_guard<std::mutex> lock (bodiesMutex);
+                dt = 1.0f / getUpdateRateHz (fastestRequestedRateIndex());
+                step (dt);
+                publishAll (1.0f);
+                tickCount.fetch_add (1, std::memory_order_relaxed);
+            }
+
+            // Fixed cadence; after an overrun, restart from now instead of bursting.
+            const auto period = std::chrono::duration_cast<Clock::duration> (std::chrono::duration<float> (dt));
+            nextTick += period;
+            const auto now = Clock::now();
+            if (nextTick < now)
+                nextTick = now + period;
+            std::this_thread::sleep_until (nextTick);
+        }
+    }
+
+    // Scheduler thread, bodiesMutex held. Runs whole fixed steps up to
+    // sampleCounter and publishes positions interpolated to it.
+    void stepToSampleClock (uint64_t sampleCounter, double sampleRate)
+    {
+        if (sampleRate <= 0.0)
+            return;
+
+        if (clockAnchorRequested.exchange (false, std::memory_order_acq_rel) || sampleCounter < clockSample)
+        {
+            clockSample = sampleCounter;
+            clockAccumulatorSamples = 0.0;
+        }
+
+        const float rateHz = getUpdateRateHz (fastestRequestedRateIndex());
+        const double samplesPerStep = sampleRate / static_cast<double> (rateHz);
+        clockAccumulatorSamples += static_cast<double> (sampleCounter - clockSample);
+        clockSample = sampleCounter;
+
+        int steps = 0;
+        while (clockAccumulatorSamples >= samplesPerStep && steps < kMaxClockStepsPerAdvance)
+        {
+            step (1.0f / rateHz);
+            clockAccumulatorSamples -= samplesPerStep;
+            ++steps;
+        }
+        // Drop an unrecoverable backlog (e.g. after a stall) rather than bursting.
+        if (clockAccumulatorSamples >= samplesPerStep)
+            clockAccumulatorSamples = std::fmod (clockAccumulatorSamples, samplesPerStep);
+
+        publishAll (static_cast<float> (clockAccumulatorSamples / samplesPerStep));
+        tickCount.fetch_add (static_cast<uint64_t> (steps), std::memory_order_relaxed);
+    }
+
+    // Locked mode falls back to wall-clock ticks if the renderer stops
+    // advancing the clock (removed, bypassed or transport halted).
+    bool isDrivenBySampleClock()
+    {
+        if (! sampleClockLocked.load (std::memory_order_acquire))
+            return false;
+
+        const auto sinceAdvance = Clock::now().time_since_epoch().count()
+                                - lastClockAdvanceTicks.load (std::memory_order_acquire);
+        if (sinceAdvance <= std::chrono::duration_cast<Clock::duration> (kClockSourceTimeout).count())
+            return true;
+
+        clockAnchorRequested.store (true, std::memory_order_release);
+        return false;
+    }
+
+    int fastestRequestedRateIndex() const
+    {
+        int index = 0;
+        for (int i = 0; i < slotHighWater; ++i)
+            if (const auto* control = bodies[static_cast<size_t> (i)])
+                index = juce::jmax (index, control->updateRateIndex.load (std::memory_order_acquire));
+        return index;
+    }
+
+    void step (float dt)
+    {
+        const int count = slotHighWater;
+
+        // Interpolation start point for locked-clock publishing.
+        previousPosX = posX;
+        previousPosY = posY;
+        previousPosZ = posZ;
+
+        // Pass 1: sample controls, apply resets/throws/rest motion, and set the
+        // per-body integration inputs. Bodies that should not integrate get a
+        // zero timestep so pass 2 leaves them untouched.
+        for (int i = 0; i < count; ++i)
+            gatherBody (i, dt);
+
+        // Pass 2: semi-implicit Euler over all bodies at once.
+        for (int i = 0; i < count; ++i)
+        {
+            const auto n = static_cast<size_t> (i);
+            const float h = stepDt[n];
+            const float accelScale = invMass[n] * h;
+            velX[n] = (velX[n] + forceX[n] * accelScale) * dragFactor[n];
+            velY[n] = (velY[n] + forceY[n] * accelScale) * dragFactor[n];
+            velZ[n] = (velZ[n] + forceZ[n] * accelScale) * dragFactor[n];
+            posX[n] += velX[n] * h;
+            posY[n] += velY[n] * h;
+            posZ[n] += velZ[n] * h;
+        }
+
+        // Pass 3: body-vs-body contacts.
+        resolveBodyContacts (count);
+
+        // Pass 4: wall collisions; contacts accumulate until the next publish.
+        for (int i = 0; i < count; ++i)
+        {
+            const auto n = static_cast<size_t> (i);
+            auto* control = bodies[n];
+            if (control == nullptr)
+                continue;
+
+            if (integrating[n] && collideWithWalls[n])
+                resolveCollisions (i, *control, dt);
+
+            pendingCollisionMask[n] = static_cast<std::uint8_t> (pendingCollisionMask[n] | collisionMask[n]);
+            pendingCollisionEnergy[n] += collisionEnergy[n];
+        }
+    }
+
+    // alpha blends from the previous step (0) to the latest step (1).
+    void publishAll (float alpha)
+    {
+        for (int i = 0; i < slotHighWater; ++i)
+            if (auto* control = bodies[static_cast<size_t> (i)])
+                publish (i, *control, alpha);
+    }
+
+    void gatherBody (int i, float dt)
+    {
+        const auto n = static_cast<size_t> (i);
+        stepDt[n] = 0.0f;
+        dragFactor[n] = 1.0f;
+        integrating[n] = false;
+        collideWithBodies[n] = false;
+
+        auto* control = bodies[n];
+        if (control == nullptr)
+            return;
+
+        const Vec3 restPosition
+        {
+            control->restX.load (std::memory_order_acquire),
+            control->restY.load (std::memory_order_acquire),
+            control->restZ.load (std::memory_order_acquire)
+        };
+
+        if (needsInit[n])
+        {
+            needsInit[n] = false;
+            initialized[n] = false;
+            handledThrowSequence[n] = 0;
+            handledResetSequence[n] = 0;
+            setPreviousRest (n, restPosition);
+        }
+
+        if (! initialized[n])
+        {
+            placeAtRest (n, restPosition);
+            initialized[n] = true;
+        }
+
+        const auto latestResetSeq = control->resetSequence.load (std::memory_order_acquire);
+        if (latestResetSeq != handledResetSequence[n])
+        {
+            handledResetSequence[n] = latestResetSeq;
+            placeAtRest (n, restPosition);
+        }
+
+        if (! control->bodyEnabled.load (std::memory_order_acquire))
+        {
+            placeAtRest (n, restPosition);
+            return;
+        }
+
+        // Treat physics state as an offset from a moving rest pose:
+        // if animation/keyframes move the rest point, shift the body with it.
+        posX[n] += restPosition.x - prevRestX[n];
+        posY[n] += restPosition.y - prevRestY[n];
+        posZ[n] += restPosition.z - prevRestZ[n];
+        setPreviousRest (n, restPosition);
+
+        const auto latestThrowSeq = control->throwSequence.load (std::memory_order_acquire);
+        if (latestThrowSeq != handledThrowSequence[n])
+        {
+            handledThrowSequence[n] = latestThrowSeq;
+            velX[n] += control->throwVelocityX.load (std::memory_order_acquire);
+            velY[n] += control->throwVelocityY.load (std::memory_order_acquire);
+            velZ[n] += control->throwVelocityZ.load (std::memory_order_acquire);
+        }
+
+        forceX[n] = forceY[n] = forceZ[n] = 0.0f;
+        collisionMask[n] = 0;
+        collisionEnergy[n] = 0.0f;
+
+        if (control->simulationPaused.load (std::memory_order_acquire))
+            return;
+
+        const Vec3 gravity = computeGravityVector (*control, { posX[n], posY[n], posZ[n] });
+        forceX[n] = gravity.x + control->interactionForceX.load (std::memory_order_acquire);
+        forceY[n] = gravity.y + control->interactionForceY.load (std::memory_order_acquire);
+        forceZ[n] = gravity.z + control->interactionForceZ.load (std::memory_order_acquire);
+
+        invMass[n] = 1.0f / juce::jmax (0.01f, control->mass.load (std::memory_order_acquire));
+        dragFactor[n] = juce::jlimit (0.0f, 1.0f, 1.0f - control->drag.load (std::memory_order_acquire) * dt);
+        stepDt[n] = dt;
+        integrating[n] = true;
+        collideWithWalls[n] = control->wallCollisionEnabled.load (std::memory_order_acquire);
+        collideWithBodies[n] = control->bodyCollisionEnabled.load (std::memory_order_acquire);
+        radius[n] = control->collisionRadius.load (std::memory_order_acquire);
+        restitution[n] = control->elasticity.load (std::memory_order_acquire);
+    }
+
+    void placeAtRest (size_t n, const Vec3& restPosition)
+    {
+        posX[n] = previousPosX[n] = restPosition.x;
+        posY[n] = previousPosY[n] = restPosition.y;
+        posZ[n] = previousPosZ[n] = restPosition.z;
+        velX[n] = velY[n] = velZ[n] = 0.0f;
+        forceX[n] = forceY[n] = forceZ[n] = 0.0f;
+        collisionMask[n] = 0;
+        collisionEnergy[n] = 0.0f;
+        setPreviousRest (n, restPosition);
+    }
+
+    void setPreviousRest (size_t n, const Vec3& restPosition)
+    {
+        prevRestX[n] = restPosition.x;
+        prevRestY[n] = restPosition.y;
+        prevRestZ[n] = restPosition.z;
+    }
+
+    void publish (int i, PhysicsBodyControl& control, float alpha)
+    {
+        const auto n = static_cast<size_t> (i);
+        PhysicsBodyState state;
+        state.position = { previousPosX[n] + (posX[n] - previousPosX[n]) * alpha,
+                           previousPosY[n] + (posY[n] - previousPosY[n]) * alpha,
+                           previousPosZ[n] + (posZ[n] - previousPosZ[n]) * alpha };
+        state.velocity = { velX[n], velY[n], velZ[n] };
+        state.force = { forceX[n], forceY[n], forceZ[n] };
+        state.collisionMask = pendingCollisionMask[n];
+        state.collisionEnergy = pendingCollisionEnergy[n];
+        state.initialized = initialized[n];
+        control.writeState (state);
+
+        pendingCollisionMask[n] = 0;
+        pendingCollisionEnergy[n] = 0.0f;
+    }
+
+    //==========================================================================
+    void resolveBodyContacts (int count)
+    {
+        int numContactBodies = 0;
+        float maxRadius = 0.0f;
+        for (int i = 0; i < count; ++i)
+        {
+            if (! collideWithBodies[static_cast<size_t> (i)])
+                continue;
+
+            contactBodies[static_cast<size_t> (numContactBodies++)] = i;
+            maxRadius = juce::jmax (maxRadius, radius[static_cast<size_t> (i)]);
+        }
+
+        int pairTests = 0;
+        if (numContactBodies >= 2)
+        {
+            const float inverseCellSize = 1.0f / juce::jmax (kMinGridCellSize, 2.0f * maxRadius);
+
+            gridHeads.fill (-1);
+            for (int k = 0; k < numContactBodies; ++k)
+            {
+                const auto n = static_cast<size_t> (contactBodies[static_cast<size_t> (k)]);
+                cellX[n] = static_cast<int> (std::floor (posX[n] * inverseCellSize));
+                cellY[n] = static_cast<int> (std::floor (posY[n] * inverseCellSize));
+                cellZ[n] = static_cast<int> (std::floor (posZ[n] * inverseCellSize));
+                const auto bucket = static_cast<size_t> (gridBucket (cellX[n], cellY[n], cellZ[n]));
+                gridNext[n] = gridHeads[bucket];
+                gridHeads[bucket] = static_cast<int> (n);
+            }
+
+            for (int k = 0; k < numContactBodies; ++k)
+            {
+                const int i = contactBodies[static_cast<size_t> (k)];
+                const auto n = static_cast<size_t> (i);
+
+                // Walk the 27 neighbouring cells once each; distinct cells can share a bucket.
+                std::array<int, 27> visitedBuckets {};
+                int numVisited = 0;
+                for (int dz = -1; dz <= 1; ++dz)
+                    for (int dy = -1; dy <= 1; ++dy)
+                        for (int dx = -1; dx <= 1; ++dx)
+                        {
+                            const int bucket = gridBucket (cellX[n] + dx, cellY[n] + dy, cellZ[n] + dz);
+                            if (std::find (visitedBuckets.begin(), visitedBuckets.begin() + numVisited, bucket)
+                                != visitedBuckets.begin() + numVisited)
+                                continue;
+                            visitedBuckets[static_cast<size_t> (numVisited++)] = bucket;
+
+                            for (int j = gridHeads[static_cast<size_t> (bucket)]; j >= 0; j = gridNext[static_cast<size_t> (j)])
+                            {
+                                if (j <= i)
+                                    continue;
+                                ++pairTests;
+                                collideBodies (n, static_cast<size_t> (j));
+                            }
+                        }
+            }
+        }
+
+        lastBodyPairTests.store (pairTests, std::memory_order_relaxed);
+    }
+
+    static int gridBucket (int x, int y, int z) noexcept
+    {
+        const auto h = (static_cast<uint32_t> (x) * 73856093u)
+                     ^ (static_cast<uint32_t> (y) * 19349663u)
+                     ^ (static_cast<uint32_t> (z) * 83492791u);
+        return static_cast<int> (h & static_cast<uint32_t> (kGridBuckets - 1));
+    }
+
+    // Sphere contact: split the overlap by inverse mass, then exchange a
+    // restitution impulse along the contact normal if the bodies approach.
+    void collideBodies (size_t a, size_t b)
+    {
+        float nx = posX[a] - posX[b];
+        float ny = posY[a] - posY[b];
+        float nz = posZ[a] - posZ[b];
+        const float minDistance = radius[a] + radius[b];
+        const float distanceSq = nx * nx + ny * ny + nz * nz;
+        if (distanceSq >= minDistance * minDistance)
+            return;
+
+        const float distance = std::sqrt (distanceSq);
+        if (distance > 1.0e-6f)
+        {
+            nx /= distance;
+            ny /= distance;
+            nz /= distance;
+        }
+        else
+        {
+            nx = 1.0f;
+            ny = nz = 0.0f;
+        }
+
+        const float weightA = invMass[a];
+        const float weightB = invMass[b];
+        const float weightSum = weightA + weightB;
+        if (weightSum <= 0.0f)
+            return;
+
+        const float penetration = minDistance - distance;
+        const float pushA = penetration * weightA / weightSum;
+        const float pushB = penetration * weightB / weightSum;
+        posX[a] += nx * pushA; posY[a] += ny * pushA; posZ[a] += nz * pushA;
+        posX[b] -= nx * pushB; posY[b] -= ny * pushB; posZ[b] -= nz * pushB;
+
+        const float approachSpeed = (velX[a] - velX[b]) * nx + (velY[a] - velY[b]) * ny + (velZ[a] - velZ[b]) * nz;
+        if (approachSpeed < 0.0f)
+        {
+            const float bounce = juce::jmin (restitution[a], restitution[b]);
+            const float impulse = -(1.0f + bounce) * approachSpeed / weightSum;
+            velX[a] += nx * impulse * weightA; velY[a] += ny * impulse * weightA; velZ[a] += nz * impulse * weightA;
+            velX[b] -= nx * impulse * weightB; velY[b] -= ny * impulse * weightB; velZ[b] -= nz * impulse * weightB;
+            collisionEnergy[a] += impulse * weightA;
+            collisionEnergy[b] += impulse * weightB;
+        }
+
+        collisionMask[a] = static_cast<std::uint8_t> (collisionMask[a] | 0x8u);
+        collisionMask[b] = static_cast<std::uint8_t> (collisionMask[b] | 0x8u);
+    }
+
+    // Reflects one axis off the [minBound, maxBound] interval. Returns true on contact.
+    bool collideAxis (float& position, float& velocity, float minBound, float maxBound, float bounce, float& energy)
+    {
+        if (position < minBound)
+        {
+            const auto velocityBefore = velocity;
+            position = minBound;
+            velocity = std::abs (velocity) * bounce;
+            energy += std::abs (velocity - velocityBefore);
+            return true;
+        }
+
+        if (position > maxBound)
+        {
+            const auto velocityBefore = velocity;
+            position = maxBound;
+            velocity = -std::abs (velocity) * bounce;
+            energy += std::abs (velocity - velocityBefore);
+            return true;
+        }
+
+        return false;
+    }
+
+    void resolveCollisions (int i, const PhysicsBodyControl& control, float dt)
+    {
+        const auto n = static_cast<size_t> (i);
+        const float halfWidth = control.roomWidth.load (std::memory_order_acquire) * 0.5f;
+        const float halfDepth = control.roomDepth.load (std::memory_order_acquire) * 0.5f;
+        const float maxY = control.roomHeight.load (std::memory_order_acquire);
+        const float bounce = control.elasticity.load (std::memory_order_acquire);
+        const float surfaceFriction = control.friction.load (std::memory_order_acquire);
+
+        auto& energy = collisionEnergy[n];
+        const bool collideX = collideAxis (posX[n], velX[n], -halfWidth, halfWidth, bounce, energy);
+        const bool collideY = collideAxis (posY[n], velY[n], 0.0f, maxY, bounce, energy);
+        const bool collideZ = collideAxis (posZ[n], velZ[n], -halfDepth, halfDepth, bounce, energy);
+
+        if (collideX)
+        {
+            applySurfaceFriction (velY[n], velZ[n], surfaceFriction, dt);
+            collisionMask[n] = static_cast<std::uint8_t> (collisionMask[n] | 0x1u);
+        }
+        if (collideY)
+        {
+            applySurfaceFriction (velX[n], velZ[n], surfaceFriction, dt);
+            collisionMask[n] = static_cast<std::uint8_t> (collisionMask[n] | 0x2u);
+        }
+        if (collideZ)
+        {
+            applySurfaceFriction (velX[n], velY[n], surfaceFriction, dt);
+            collisionMask[n] = static_cast<std::uint8_t> (collisionMask[n] | 0x4u);
+        }
+    }
+
+    static void applySurfaceFriction (float& tangentA, float& tangentB, float frictionAmount, float dt)
+    {
+        const float friction = juce::jlimit (0.0f, 1.0f, frictionAmount);
+        const float damp = juce::jlimit (0.0f, 1.0f, 1.0f - friction * dt * 60.0f);
+        tangentA *= damp;
+        tangentB *= damp;
+    }
+
+    static Vec3 computeGravityVector (const PhysicsBodyControl& control, const Vec3& position)
+    {
+        const float magnitude = control.gravityMagnitude.load (std::memory_order_acquire);
+        const int direction = control.gravityDirection.load (std::memory_order_acquire);
+
+        switch (direction)
+        {
+            case 0: // Down
+                return { 0.0f, -magnitude, 0.0f };
+
+            case 1: // Up
+                return { 0.0f, magnitude, 0.0f };
+
+            case 2: // To center
+            case 3: // From center
+            {
+                Vec3 toCenter { -position.x, 1.2f - position.y, -position.z };
+                const float length = std::sqrt (toCenter.x * toCenter.x
+                                              + toCenter.y * toCenter.y
+                                              + toCenter.z * toCenter.z);
+
+                if (length < 1.0e-5f)
+                    return {};
+
+                const float scale = magnitude / length;
+                const float sign = (direction == 2) ? 1.0f : -1.0f;
+                return { toCenter.x * scale * sign,
+                         toCenter.y * scale * sign,
+                         toCenter.z * scale * sign };
+            }
+
+            case 4: // Custom (placeholder: use Down until vector params exist)
+            default:
+                return { 0.0f, -magnitude, 0.0f };
+        }
+    }
+
+    // At most one release is outstanding: the flag is cleared only after the
+    // scheduler has taken it, so the binary semaphore never overflows.
+    void wakeScheduler() noexcept
+    {
+        if (! clockWakePending.exchange (true, std::memory_order_acq_rel))
+            clockWake.release();
+    }
+
+    static float getUpdateRateHz (int index)
+    {
+        static constexpr float rates[] = { 30.0f, 60.0f, 120.0f, 240.0f };
+        return rates[static_cast<size_t> (juce::jlimit (0, 3, index))];
+    }
+
+    //==========================================================================
+    template <typename T>
+    using BodyArray = std::array<T, MAX_BODIES>;
+
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr int kGridBuckets = 4 * MAX_BODIES; // power of two
+    static constexpr int kMaxClockStepsPerAdvance = 64;
+    static constexpr std::chrono::milliseconds kClockSourceTimeout { 250 };
+    static constexpr float kMinGridCellSize = 0.05f;
+
+    // Registry (guarded by bodiesMutex; the scheduler holds it for a whole tick).
+    mutable std::mutex bodiesMutex;
+    BodyArray<PhysicsBodyControl*> bodies {};
+    int numBodies = 0;
+    int slotHighWater = 0;
+
+    std::mutex lifecycleMutex;
+    std::atomic<bool> running { false };
+    std::thread scheduler;
+    std::atomic<uint64_t> tickCount { 0 };
+    std::atomic<int> lastBodyPairTests { 0 };
+
+    // Sample-clock state. The renderer posts targets through the atomics;
+    // clockSample/accumulator are guarded by bodiesMutex (scheduler only).
+    std::atomic<bool> sampleClockLocked { false };
+    std::atomic<bool> clockAnchorRequested { true };
+    std::atomic<Clock::rep> lastClockAdvanceTicks { 0 };
+    std::atomic<uint64_t> clockTargetSample { 0 };
+    std::atomic<double> clockTargetRate { 0.0 };
+    std::atomic<uint64_t> clockTargetSerial { 0 };
+    std::atomic<uint64_t> steppedClockSerial { 0 };
+    std::binary_semaphore clockWake { 0 };
+    std::atomic<bool> clockWakePending { false };
+    uint64_t clockSample = 0;
+    double clockAccumulatorSamples = 0.0;
+
+    // Simulation state, scheduler thread only.
+    alignas (64) BodyArray<float> posX {}, posY {}, posZ {};
+    alignas (64) BodyArray<float> velX {}, velY {}, velZ {};
+    alignas (64) BodyArray<float> forceX {}, forceY {}, forceZ {};
+    alignas (64) BodyArray<float> invMass {}, dragFactor {}, stepDt {};
+    alignas (64) BodyArray<float> prevRestX {}, prevRestY {}, prevRestZ {};
+    alignas (64) BodyArray<float> previousPosX {}, previousPosY {}, previousPosZ {};
+    alignas (64) BodyArray<float> radius {}, restitution {};
+    BodyArray<float> collisionEnergy {}, pendingCollisionEnergy {};
+    BodyArray<std::uint8_t> collisionMask {}, pendingCollisionMask {};
+    BodyArray<bool> integrating {}, collideWithWalls {}, collideWithBodies {}, initialized {}, needsInit {};
+
+    // Broadphase scratch: bucket heads plus an intrusive per-body chain.
+    std::array<int, kGridBuckets> gridHeads {};
+    BodyArray<int> gridNext {}, cellX {}, cellY {}, cellZ {}, contactBodies {};
+    BodyArray<uint32_t> handledThrowSequence {}, handledResetSequence {};
+};
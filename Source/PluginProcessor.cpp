@@ -614,6 +614,46 @@ RendererHeadTrackingSnapshot buildRendererHeadTrackingSnapshot (
     return snapshot;
 }
 
+juce::String headTrackingLatencyHistogramToJson (const HeadTrackingLatencyHistogram::Snapshot& histogram)
+{
+    juce::String bins;
+    for (size_t bin = 0; bin < histogram.counts.size(); ++bin)
+    {
+        if (bin > 0)
+            bins << ",";
+        bins << juce::String (static_cast<juce::uint64> (histogram.counts[bin]));
+    }
+
+    return "{\"count\":" + juce::String (static_cast<juce::uint64> (histogram.count))
+        + ",\"meanMs\":" + juce::String (histogram.meanMs, 3)
+        + ",\"p50Ms\":" + juce::String (histogram.p50Ms, 3)
+        + ",\"p95Ms\":" + juce::String (histogram.p95Ms, 3)
+        + ",\"maxMs\":" + juce::String (histogram.maxMs, 3)
+        + ",\"bins\":[" + bins + "]}";
+}
+
+// Sender -> arrival -> audio-thread latency histograms for the diagnostics snapshot.
+juce::String headTrackingLatencyToJson (const HeadTrackingLatencyDiagnostics& diagnostics)
+{
+    juce::String edges;
+    for (size_t edge = 0; edge < HeadTrackingLatencyHistogram::kBinUpperEdgesMs.size(); ++edge)
+    {
+        if (edge > 0)
+            edges << ",";
+        edges << juce::String (HeadTrackingLatencyHistogram::kBinUpperEdgesMs[edge], 2);
+    }
+
+    return "{\"binUpperEdgesMs\":[" + edges + "]"
+        + ",\"transit\":" + headTrackingLatencyHistogramToJson (diagnostics.transit)
+        + ",\"consume\":" + headTrackingLatencyHistogramToJson (diagnostics.consume)
+        + ",\"endToEnd\":" + headTrackingLatencyHistogramToJson (diagnostics.endToEnd)
+        + ",\"receiveBatches\":" + juce::String (static_cast<juce::uint64> (diagnostics.receiveBatches))
+        + ",\"packetsReceived\":" + juce::String (static_cast<juce::uint64> (diagnostics.packetsReceived))
+        + ",\"packetsCoalesced\":" + juce::String (static_cast<juce::uint64> (diagnostics.packetsCoalesced))
+        + ",\"kernelTimestamps\":" + juce::String (diagnostics.kernelTimestamps ? "true" : "false")
+        + ",\"batchedReceive\":" + juce::String (diagnostics.batchedReceive ? "true" : "false") + "}";
+}
+
 RendererMatrixSnapshot buildRendererMatrixSnapshot (int requestedProfileIndex,
                                                     int activeProfileIndex,
                                                     int activeStageIndex,
@@ -653,7 +693,7 @@ RendererMatrixSnapshot buildRendererMatrixSnapshot (int requestedProfileIndex,
         matrix.activeDomain = "InternalBinaural";
 
     const auto activeHeadphoneMode = static_cast<SpatialRenderer::HeadphoneRenderMode> (
-        juce::jlimit (0, 1, activeHeadphoneModeIndex));
+        juce::jlimit (0, 3, activeHeadphoneModeIndex));
 
     if (requestedDomain == RendererMatrixDomain::InternalBinaural)
     {
@@ -735,7 +775,9 @@ RendererMatrixSnapshot buildRendererMatrixSnapshot (int requestedProfileIndex,
         matrix.failSafeRoute = "stereo_passthrough";
     }
 
-    if (activeHeadphoneMode == SpatialRenderer::HeadphoneRenderMode::SteamBinaural
+    if ((activeHeadphoneMode == SpatialRenderer::HeadphoneRenderMode::SteamBinaural
+         || activeHeadphoneMode == SpatialRenderer::HeadphoneRenderMode::NativeHrtfBinaural
+         || activeHeadphoneMode == SpatialRenderer::HeadphoneRenderMode::AmbisonicBinaural)
         && matrix.activeLayout == "stereo_2_0")
     {
         matrix.activeDomain = "InternalBinaural";
@@ -776,15 +818,6 @@ constexpr std::array<const char*, 35> kEmitterPresetParameterIds
     "anim_enable", "anim_mode", "anim_loop", "anim_speed", "anim_sync"
 };
 
-constexpr std::array<const char*, 5> kCurveNames
-{
-    "linear",
-    "easeIn",
-    "easeOut",
-    "easeInOut",
-    "step"
-};
-
 constexpr std::array<const char*, 4> kChoreographyPackIds
 {
     "orbit",
@@ -1101,6 +1134,10 @@ HeadphoneCalibrationDiagnosticsSnapshot buildHeadphoneCalibrationDiagnosticsSnap
         requestedHeadphoneModeIndex == static_cast<int> (SpatialRenderer::HeadphoneRenderMode::SteamBinaural);
     const bool activeSteamMode =
         activeHeadphoneModeIndex == static_cast<int> (SpatialRenderer::HeadphoneRenderMode::SteamBinaural);
+    const bool activeNativeMode =
+        activeHeadphoneModeIndex == static_cast<int> (SpatialRenderer::HeadphoneRenderMode::NativeHrtfBinaural);
+    const bool activeAmbisonicMode =
+        activeHeadphoneModeIndex == static_cast<int> (SpatialRenderer::HeadphoneRenderMode::AmbisonicBinaural);
     const auto steamStage = steamAudioInitStage.trim().toLowerCase();
 
     if (snapshot.requested == locusq::shared_contracts::headphone_calibration::path::kSteamBinaural)
@@ -1125,6 +1162,24 @@ HeadphoneCalibrationDiagnosticsSnapshot buildHeadphoneCalibrationDiagnosticsSnap
             return snapshot;
         }
 
+        if (activeAmbisonicMode)
+        {
+            // Ambisonic monitoring takes over the binaural request with the SOFA set.
+            snapshot.active = locusq::shared_contracts::headphone_calibration::path::kAmbisonicBinaural;
+            snapshot.stage = locusq::shared_contracts::headphone_calibration::stage::kDirect;
+            snapshot.fallbackReason = locusq::shared_contracts::headphone_calibration::fallback_reason::kNone;
+            return snapshot;
+        }
+
+        if (requestedSteamMode && activeNativeMode)
+        {
+            // Steam Audio unavailable; the in-tree SOFA HRTF renderer serves the request.
+            snapshot.active = locusq::shared_contracts::headphone_calibration::path::kNativeHrtfBinaural;
+            snapshot.stage = locusq::shared_contracts::headphone_calibration::stage::kFallback;
+            snapshot.fallbackReason = locusq::shared_contracts::headphone_calibration::fallback_reason::kSteamUnavailable;
+            return snapshot;
+        }
+
         snapshot.active = locusq::shared_contracts::headphone_calibration::path::kStereoDownmix;
         snapshot.stage = steamAudioAvailable
                              ? locusq::shared_contracts::headphone_calibration::stage::kFallback
@@ -1630,15 +1685,26 @@ LocusQAudioProcessor::LocusQAudioProcessor()
       apvts (*this, nullptr, "PARAMETERS", createParameterLayout()),
       sceneGraph (SceneGraph::getInstance())
 {
+    emitterTrackHandles.azimuth = keyframeTimeline.internTrackId (kTrackPosAzimuth);
+    emitterTrackHandles.elevation = keyframeTimeline.internTrackId (kTrackPosElevation);
+    emitterTrackHandles.distance = keyframeTimeline.internTrackId (kTrackPosDistance);
+    emitterTrackHandles.x = keyframeTimeline.internTrackId (kTrackPosX);
+    emitterTrackHandles.y = keyframeTimeline.internTrackId (kTrackPosY);
+    emitterTrackHandles.z = keyframeTimeline.internTrackId (kTrackPosZ);
+    emitterTrackHandles.sizeUniform = keyframeTimeline.internTrackId (kTrackSizeUniform);
     initialiseDefaultKeyframeTimeline();
 
     // Register with scene graph based on initial mode
     // Mode registration happens in prepareToPlay once we know the context
+
+    startTimerHz (10);
 }
 
 LocusQAudioProcessor::~LocusQAudioProcessor()
 {
+    stopTimer();
     headTrackingBridge.stop();
+    joinNativeSofaLoad();
 
     // Unregister from scene graph
     if (emitterSlotId >= 0)
@@ -1901,6 +1967,7 @@ void LocusQAudioProcessor::releaseResources()
         const juce::SpinLock::ScopedLockType timelineLock (keyframeTimelineLock);
         keyframeTimeline.reset();
     }
+    requestKeyframeTimelineSeek (0.0);
     visualTokenScheduler.reset();
 }
 
@@ -1977,6 +2044,27 @@ void LocusQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     bool confidenceMaskingValid = false;
     bool confidenceMaskingAdjusted = false;
 
+    // Follow this instance's listener stream on the shared head-tracking receiver.
+    headTrackingBridge.subscribeListener (
+        static_cast<int> (apvts.getRawParameterValue ("rend_headtrack_listener")->load()));
+    spatialRenderer.setHeadPoseSubBlockSamples (
+        static_cast<int> (apvts.getRawParameterValue ("rend_headtrack_key_interval")->load()));
+
+    // Predictive filtering looks ahead by the time this block takes to reach the output.
+    {
+        const auto filterMode = static_cast<HeadPoseInterpolator::FilterMode> (juce::jlimit (
+            0, 1, static_cast<int> (apvts.getRawParameterValue ("rend_headtrack_filter")->load())));
+        const double outputLatencyMs = 1000.0 * static_cast<double> (buffer.getNumSamples() + getLatencySamples())
+                                       / juce::jmax (1.0, currentSampleRate);
+        headPoseInterpolator.setFilterMode (filterMode);
+        headPoseInterpolator.setPredictionLookaheadMs (
+            filterMode == HeadPoseInterpolator::FilterMode::PredictiveKalman ? outputLatencyMs : 0.0);
+        headPoseLookaheadMs.store (static_cast<float> (headPoseInterpolator.getPredictionLookaheadMs()),
+                                   std::memory_order_relaxed);
+        headPoseJitterMs.store (static_cast<float> (headPoseInterpolator.getEstimatedJitterMs()),
+                                std::memory_order_relaxed);
+    }
+
     switch (mode)
     {
         case LocusQMode::Calibrate:
@@ -2044,6 +2132,9 @@ void LocusQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
                 apvts.getRawParameterValue ("rend_phys_walls")->load() > 0.5f);
             const bool physicsInteractionEnabled = apvts.getRawParameterValue ("rend_phys_interact")->load() > 0.5f;
             sceneGraph.setPhysicsInteractionEnabled (physicsInteractionEnabled);
+            if (rendererRegistered)
+                PhysicsWorld::getInstance().setSampleClockLocked (
+                    apvts.getRawParameterValue ("rend_phys_clock")->load() > 0.5f);
 
             // Update renderer DSP parameters from APVTS
             updateRendererParameters();
@@ -2058,35 +2149,58 @@ void LocusQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
 
             if (const auto* headTrackingPose = headTrackingBridge.currentPose())
             {
-                const float nowMs = static_cast<float> (juce::Time::getMillisecondCounterHiRes());
-                headPoseInterpolator.ingest (*headTrackingPose, nowMs);
-                const auto interpolated = headPoseInterpolator.interpolatedAt (nowMs);
+                const auto consumedPose = *headTrackingPose;
+                const double nowMs = juce::Time::getMillisecondCounterHiRes();
+                headPoseInterpolator.ingest (consumedPose, nowMs);
+                headTrackingBridge.notePoseConsumed (consumedPose);
 
                 // BL-045-C: store raw yaw for drift telemetry (message-thread readable)
                 {
+                    const auto interpolated = headPoseInterpolator.interpolatedAt (nowMs);
                     float rawYaw = 0.0f, dummyP = 0.0f, dummyR = 0.0f;
                     computeHeadTrackingEulerDegrees (interpolated, rawYaw, dummyP, dummyR);
                     lastHeadTrackYawDeg.store (rawYaw, std::memory_order_relaxed);
                 }
 
-                SpatialRenderer::PoseSnapshot rendererPose {};
-                rendererPose.qx          = interpolated.qx;
-                rendererPose.qy          = interpolated.qy;
-                rendererPose.qz          = interpolated.qz;
-                rendererPose.qw          = interpolated.qw;
-                rendererPose.timestampMs = interpolated.timestampMs;
-                rendererPose.seq         = interpolated.seq;
-
-                // BL-045-C: apply yaw reference offset (pre-rotate by -yawReferenceDeg about Z)
-                if (yawReferenceSet.load (std::memory_order_relaxed))
-                    applyYawOffsetToPose (rendererPose, yawReferenceDeg.load (std::memory_order_relaxed));
+                // Sample the pose across the block at the renderer's key spacing;
+                // the renderer ramps its rotation matrices between these keys.
+                const int numSamples = buffer.getNumSamples();
+                const int keyInterval = spatialRenderer.getHeadPoseKeyInterval (numSamples);
+                const int numKeys = juce::jlimit (1,
+                                                  SpatialRenderer::MAX_HEAD_POSE_KEYS,
+                                                  (numSamples + keyInterval - 1) / keyInterval);
+                const double msPerSample = 1000.0 / juce::jmax (1.0, currentSampleRate);
+                const bool applyYawReference = yawReferenceSet.load (std::memory_order_relaxed);
+                const float yawReference = yawReferenceDeg.load (std::memory_order_relaxed);
+
+                std::array<SpatialRenderer::PoseSnapshot, SpatialRenderer::MAX_HEAD_POSE_KEYS> poseKeys {};
+                for (int key = 0; key < numKeys; ++key)
+                {
+                    const int keyOffset = juce::jmin ((key + 1) * keyInterval, numSamples);
+                    const auto interpolated = headPoseInterpolator.interpolatedAt (
+                        nowMs + static_cast<double> (keyOffset) * msPerSample);
+
+                    auto& rendererPose = poseKeys[static_cast<size_t> (key)];
+                    rendererPose.qx          = interpolated.qx;
+                    rendererPose.qy          = interpolated.qy;
+                    rendererPose.qz          = interpolated.qz;
+                    rendererPose.qw          = interpolated.qw;
+                    rendererPose.timestampMs = interpolated.timestampMs;
+                    rendererPose.seq         = interpolated.seq;
+
+                    // BL-045-C: apply yaw reference offset (pre-rotate by -yawReferenceDeg about Z)
+                    if (applyYawReference)
+                        applyYawOffsetToPose (rendererPose, yawReference);
+                }
 
-                spatialRenderer.applyHeadPose (rendererPose);
+                spatialRenderer.applyHeadPoseTrajectory (poseKeys.data(), numKeys, keyInterval);
             }
 
             // Clear output buffer (renderer generates its own audio from emitters)
             buffer.clear();
 
+            spatialRenderer.setChoreographyTransportTime (getTransportTimeSeconds());
+
             // Spatialize all emitters into output
             const auto rendererStartTicks = juce::Time::getHighResolutionTicks();
             spatialRenderer.process (buffer, sceneGraph);
@@ -2282,19 +2396,27 @@ void LocusQAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     publishedConfidenceMaskingDiagnostics.valid.store (confidenceMaskingValid, std::memory_order_release);
     publishedConfidenceMaskingDiagnostics.snapshotSeq.fetch_add (1, std::memory_order_release);
 
-    sceneGraph.advanceSampleCounter (buffer.getNumSamples());
+    // The registered renderer's blocks are the scene sample clock; other
+    // instances must not add their own blocks or it would run once per instance.
+    if (mode == LocusQMode::Renderer && rendererRegistered)
+    {
+        sceneGraph.advanceSampleCounter (buffer.getNumSamples());
+        PhysicsWorld::getInstance().advanceToSampleClock (sceneGraph.getSampleCounter(), currentSampleRate);
+    }
 
     const auto blockElapsedTicks = juce::Time::getHighResolutionTicks() - blockStartTicks;
     const auto blockMs = (static_cast<double> (blockElapsedTicks) * 1000.0) / ticksPerSecond;
     updatePerfEma (perfProcessBlockMs, blockMs);
 
-    // Report calibration chain latency to the DAW host — guarded to avoid spamming
-    // hosts with redundant PDC-recalculation notifications on every block.
+    // Report calibration chain (+ native HRTF renderer) latency to the DAW host —
+    // guarded to avoid spamming hosts with redundant PDC-recalculation notifications
+    // on every block.
     const int calLatency = spatialRenderer.getCalibrationLatencySamples();
-    if (calLatency != lastReportedCalibrationLatency)
+    const int hostLatency = calLatency + spatialRenderer.getNativeBinauralLatencySamples();
+    if (hostLatency != lastReportedCalibrationLatency)
     {
-        lastReportedCalibrationLatency = calLatency;
-        setLatencySamples (calLatency);
+        lastReportedCalibrationLatency = hostLatency;
+        setLatencySamples (hostLatency);
     }
 }
 
@@ -2320,6 +2442,10 @@ void LocusQAudioProcessor::updateRendererParameters()
     spatialRenderer.loadPeqPresetForProfile (headphoneProfileIndex, currentSampleRate);
     spatialRenderer.setSpatialOutputProfile (
         static_cast<int> (apvts.getRawParameterValue ("rend_spatial_profile")->load()));
+    spatialRenderer.setAmbisonicNormalization (
+        static_cast<int> (apvts.getRawParameterValue ("rend_ambi_norm")->load()));
+    spatialRenderer.setAmbisonicMonitoringEnabled (
+        apvts.getRawParameterValue ("rend_ambi_monitor")->load() > 0.5f);
     spatialRenderer.setAuditionEnabled (
         apvts.getRawParameterValue ("rend_audition_enable")->load() > 0.5f);
     spatialRenderer.setAuditionSignalType (
@@ -2332,6 +2458,11 @@ void LocusQAudioProcessor::updateRendererParameters()
     // Air absorption
     spatialRenderer.setAirAbsorptionEnabled (
         apvts.getRawParameterValue ("rend_air_absorb")->load() > 0.5f);
+    spatialRenderer.setAirAbsorptionModel (
+        static_cast<int> (apvts.getRawParameterValue ("rend_air_model")->load()));
+    spatialRenderer.setAirAbsorptionConditions (
+        apvts.getRawParameterValue ("rend_air_temp")->load(),
+        apvts.getRawParameterValue ("rend_air_humidity")->load());
 
     // Doppler
     spatialRenderer.setDopplerEnabled (
@@ -2421,8 +2552,10 @@ void LocusQAudioProcessor::applyCalibrationMonitoringPath (juce::AudioBuffer<flo
 
             if (poseFresh)
             {
-                const float nowInterpMs = static_cast<float> (juce::Time::getMillisecondCounterHiRes());
-                headPoseInterpolator.ingest (*headTrackingPose, nowInterpMs);
+                const double nowInterpMs = juce::Time::getMillisecondCounterHiRes();
+                const auto consumedPose = *headTrackingPose;
+                headPoseInterpolator.ingest (consumedPose, nowInterpMs);
+                headTrackingBridge.notePoseConsumed (consumedPose);
                 const auto interpolated = headPoseInterpolator.interpolatedAt (nowInterpMs);
 
                 SpatialRenderer::PoseSnapshot listenerPose {};
@@ -2510,6 +2643,25 @@ void LocusQAudioProcessor::initialiseDefaultKeyframeTimeline()
     keyframeTimeline.setDurationSeconds (8.0);
     keyframeTimeline.setLooping (true);
     keyframeTimeline.setPlaybackRate (1.0f);
+
+    publishKeyframeTimelineSnapshotLocked();
+}
+
+void LocusQAudioProcessor::publishKeyframeTimelineSnapshotLocked()
+{
+    auto snapshot = std::make_shared<KeyframeTimelineSnapshot>();
+    snapshot->timeline = keyframeTimeline;
+    snapshot->version = ++timelineSnapshotVersion;
+
+    // Older snapshots stay alive in the publisher until the audio thread has
+    // let go of them, so the last reference (and the free) is on this thread.
+    publishedTimelineSnapshot.publish (std::move (snapshot));
+}
+
+void LocusQAudioProcessor::requestKeyframeTimelineSeek (double timeSeconds) noexcept
+{
+    timelineSeekSeconds.store (timeSeconds, std::memory_order_relaxed);
+    timelineSeekSerial.fetch_add (1, std::memory_order_release);
 }
 
 std::optional<double> LocusQAudioProcessor::getTransportTimeSeconds() const
@@ -2562,21 +2714,38 @@ void LocusQAudioProcessor::publishEmitterState (int numSamplesInBlock)
     const bool internalAnimation = animationEnabled
                                && static_cast<int> (apvts.getRawParameterValue ("anim_mode")->load()) == 1;
 
-    if (internalAnimation)
+    // Adopt the newest published timeline; the retained list on the message
+    // thread keeps the previous one alive, so dropping it here never frees.
+    if (auto latestTimeline = publishedTimelineSnapshot.load(); latestTimeline != activeTimelineSnapshot)
+    {
+        activeTimelineSnapshot = std::move (latestTimeline);
+        timelinePlayhead.cursors = {};
+    }
+
+    if (activeTimelineSnapshot != nullptr)
     {
-        const juce::SpinLock::ScopedTryLockType timelineLock (keyframeTimelineLock);
-        if (timelineLock.isLocked())
+        const auto& timeline = activeTimelineSnapshot->timeline;
+        const bool timelineLooping = apvts.getRawParameterValue ("anim_loop")->load() > 0.5f;
+        const float timelineRate = juce::jlimit (0.1f, 10.0f, apvts.getRawParameterValue ("anim_speed")->load());
+
+        if (const auto seekSerial = timelineSeekSerial.load (std::memory_order_acquire);
+            seekSerial != appliedTimelineSeekSerial)
         {
-            keyframeTimeline.setLooping (apvts.getRawParameterValue ("anim_loop")->load() > 0.5f);
-            keyframeTimeline.setPlaybackRate (apvts.getRawParameterValue ("anim_speed")->load());
+            appliedTimelineSeekSerial = seekSerial;
+            timeline.seekPlayhead (timelinePlayhead,
+                                   timelineSeekSeconds.load (std::memory_order_relaxed),
+                                   timelineLooping);
+        }
 
+        if (internalAnimation)
+        {
             bool advancedFromTransport = false;
             if (apvts.getRawParameterValue ("anim_sync")->load() > 0.5f)
             {
                 if (const auto transportTimeSeconds = getTransportTimeSeconds())
                 {
-                    const auto playbackSeconds = (*transportTimeSeconds) * static_cast<double> (keyframeTimeline.getPlaybackRate());
-                    keyframeTimeline.setCurrentTimeSeconds (playbackSeconds);
+                    const auto playbackSeconds = (*transportTimeSeconds) * static_cast<double> (timelineRate);
+                    timeline.seekPlayhead (timelinePlayhead, playbackSeconds, timelineLooping);
                     advancedFromTransport = true;
                 }
             }
@@ -2586,51 +2755,56 @@ void LocusQAudioProcessor::publishEmitterState (int numSamplesInBlock)
                 const auto blockDurationSeconds = (currentSampleRate > 0.0)
                                                 ? static_cast<double> (numSamplesInBlock) / currentSampleRate
                                                 : 0.0;
-                keyframeTimeline.advance (blockDurationSeconds);
+                timeline.advancePlayhead (timelinePlayhead, blockDurationSeconds, timelineRate, timelineLooping);
             }
 
+            // Prefill with the parameter values so tracks without keyframes fall through.
+            std::array<float, KeyframeTimeline::maxTrackHandles> trackValues {};
+            const auto& handles = emitterTrackHandles;
+            const auto prefill = [&trackValues] (KeyframeTimeline::TrackHandle handle, float value)
+            {
+                if (handle >= 0)
+                    trackValues[static_cast<size_t> (handle)] = value;
+            };
+            const auto pick = [&trackValues] (KeyframeTimeline::TrackHandle handle, float& value)
+            {
+                if (handle >= 0)
+                    value = trackValues[static_cast<size_t> (handle)];
+            };
+
+            prefill (handles.azimuth, azimuthDeg);
+            prefill (handles.elevation, elevationDeg);
+            prefill (handles.distance, distance);
+            prefill (handles.x, posX);
+            prefill (handles.y, posY);
+            prefill (handles.z, posZ);
+            prefill (handles.sizeUniform, sizeUniform);
+
+            timeline.evaluateAll (timelinePlayhead, trackValues.data());
+
             if (coordMode < 0.5f)
             {
-                if (const auto value = keyframeTimeline.evaluateTrackAtCurrentTime (kTrackPosAzimuth))
-                    azimuthDeg = *value;
-                if (const auto value = keyframeTimeline.evaluateTrackAtCurrentTime (kTrackPosElevation))
-                    elevationDeg = *value;
-                if (const auto value = keyframeTimeline.evaluateTrackAtCurrentTime (kTrackPosDistance))
-                    distance = *value;
+                pick (handles.azimuth, azimuthDeg);
+                pick (handles.elevation, elevationDeg);
+                pick (handles.distance, distance);
             }
             else
             {
-                if (const auto value = keyframeTimeline.evaluateTrackAtCurrentTime (kTrackPosX))
-                    posX = *value;
-                if (const auto value = keyframeTimeline.evaluateTrackAtCurrentTime (kTrackPosY))
-                    posY = *value;
-                if (const auto value = keyframeTimeline.evaluateTrackAtCurrentTime (kTrackPosZ))
-                    posZ = *value;
+                pick (handles.x, posX);
+                pick (handles.y, posY);
+                pick (handles.z, posZ);
             }
 
-            if (const auto value = keyframeTimeline.evaluateTrackAtCurrentTime (kTrackSizeUniform))
-                sizeUniform = *value;
+            pick (handles.sizeUniform, sizeUniform);
         }
-    }
-
-    Vec3 basePosition;
-
-    if (coordMode < 0.5f) // Spherical
-    {
-        const float azimuthRad = azimuthDeg * juce::MathConstants<float>::pi / 180.0f;
-        const float elevationRad = elevationDeg * juce::MathConstants<float>::pi / 180.0f;
 
-        basePosition.x = distance * std::cos (elevationRad) * std::sin (azimuthRad);
-        basePosition.z = distance * std::cos (elevationRad) * std::cos (azimuthRad);
-        basePosition.y = distance * std::sin (elevationRad);
-    }
-    else // Cartesian
-    {
-        basePosition.x = posX;
-        basePosition.y = posZ; // Z in param = Y in 3D (height)
-        basePosition.z = posY;
+        timelinePlayheadSeconds.store (timelinePlayhead.timeSeconds, std::memory_order_relaxed);
     }
 
+    const Vec3 basePosition = coordMode < 0.5f
+                                  ? emitterPositionFromSpherical (azimuthDeg, elevationDeg, distance)
+                                  : emitterPositionFromCartesian (posX, posY, posZ);
+
     data.position = basePosition;
 
     const bool linkedSize = apvts.getRawParameterValue ("size_link")->load() > 0.5f;
@@ -2672,6 +2846,8 @@ void LocusQAudioProcessor::publishEmitterState (int numSamplesInBlock)
 
     physicsEngine.setRestPosition (basePosition);
     physicsEngine.setPhysicsEnabled (physicsEnabled);
+    physicsEngine.setCollisionExtents (data.size);
+    physicsEngine.setBodyCollisionEnabled (physicsEnabled && sceneGraph.isPhysicsInteractionEnabled());
     physicsEngine.setMass (apvts.getRawParameterValue ("phys_mass")->load());
     physicsEngine.setDrag (apvts.getRawParameterValue ("phys_drag")->load());
     physicsEngine.setElasticity (apvts.getRawParameterValue ("phys_elasticity")->load());
@@ -2822,8 +2998,85 @@ void LocusQAudioProcessor::primeRendererStateFromCurrentParameters()
         updateRendererParameters();
 }
 
+void LocusQAudioProcessor::timerCallback()
+{
+    spatialRenderer.updateAirAbsorptionTable();
+}
+
+void LocusQAudioProcessor::joinNativeSofaLoad()
+{
+    if (nativeSofaLoadJob != nullptr && nativeSofaLoadJob->worker.joinable())
+        nativeSofaLoadJob->worker.join();
+    nativeSofaLoadJob.reset();
+}
+
+// Message thread. Publishes a finished SOFA load when it still matches the
+// requested file and sample rate, then starts a job for the current request
+// if it has not been applied yet. Never blocks on a running job.
+void LocusQAudioProcessor::serviceNativeSofaLoad()
+{
+    spatialRenderer.releaseRetiredNativeHrtfSets();
+
+    if (nativeSofaLoadJob != nullptr)
+    {
+        if (! nativeSofaLoadJob->finished.load (std::memory_order_acquire))
+            return;
+
+        nativeSofaLoadJob->worker.join();
+        const auto job = std::move (nativeSofaLoadJob);
+        if (job->sofaRef == loadedNativeSofaRef && job->sampleRate == loadedNativeSofaSampleRate)
+        {
+            if (job->sofaRef.isNotEmpty() && job->hrtfSet == nullptr)
+                DBG ("LocusQ: CalibrationProfile SOFA HRTF unavailable: " + job->sofaRef);
+
+            spatialRenderer.setNativeHrtfSet (job->hrtfSet, job->shFilters);
+            appliedNativeSofaRef = job->sofaRef;
+            appliedNativeSofaSampleRate = job->sampleRate;
+            return;
+        }
+        // Superseded while loading; fall through to load the current request.
+    }
+
+    if (loadedNativeSofaRef == appliedNativeSofaRef && loadedNativeSofaSampleRate == appliedNativeSofaSampleRate)
+        return;
+
+    if (loadedNativeSofaRef.isEmpty())
+    {
+        spatialRenderer.setNativeHrtfSet (nullptr, nullptr);
+        appliedNativeSofaRef = loadedNativeSofaRef;
+        appliedNativeSofaSampleRate = loadedNativeSofaSampleRate;
+        return;
+    }
+
+    nativeSofaLoadJob = std::make_unique<NativeSofaLoadJob>();
+    nativeSofaLoadJob->sofaRef = loadedNativeSofaRef;
+    nativeSofaLoadJob->sampleRate = loadedNativeSofaSampleRate;
+    nativeSofaLoadJob->worker = std::thread ([job = nativeSofaLoadJob.get()]
+    {
+       #if defined (LOCUSQ_ENABLE_SOFA) && LOCUSQ_ENABLE_SOFA
+        const auto sofaFile = juce::File::getSpecialLocation (juce::File::userApplicationDataDirectory)
+                                  .getChildFile ("LocusQ/sofa")
+                                  .getChildFile (job->sofaRef);
+        locusq::dsp::HrirGrid grid;
+        if (sofaFile.existsAsFile()
+            && locusq::dsp::loadSofaHrirGrid (sofaFile.getFullPathName().toStdString(),
+                                              juce::roundToInt (job->sampleRate),
+                                              grid))
+        {
+            job->hrtfSet = locusq::dsp::HrtfSet::build (grid);
+            if (job->hrtfSet != nullptr)
+                job->shFilters = locusq::dsp::ShHrtfFilters::build (*job->hrtfSet);
+        }
+       #endif
+
+        job->finished.store (true, std::memory_order_release);
+    });
+}
+
 void LocusQAudioProcessor::pollCompanionCalibrationProfileFromDisk()
 {
+    serviceNativeSofaLoad();
+
     const auto profileFile = resolveCompanionCalibrationProfileFile();
 
     if (! profileFile.existsAsFile())
@@ -2875,6 +3128,9 @@ void LocusQAudioProcessor::pollCompanionCalibrationProfileFromDisk()
     setIntegerParameterValueNotifyingHost ("cal_device_profile", profileIndex);
     setIntegerParameterValueNotifyingHost ("rend_headphone_profile", profileIndex);
 
+    // An FIR the chain could not stage yet (previous swap still blending)
+    // leaves the profile unapplied, so the next poll loads it again.
+    bool firTapsStaged = true;
     const auto eqMode = headphone->getProperty ("hp_eq_mode").toString().trim().toLowerCase();
     if (eqMode == "peq")
     {
@@ -2885,9 +3141,9 @@ void LocusQAudioProcessor::pollCompanionCalibrationProfileFromDisk()
     }
     else if (eqMode == "fir")
     {
+        firTapsStaged = spatialRenderer.applyJsonFirTaps (headphone->getProperty ("hp_fir_taps"));
         spatialRenderer.setHeadphoneCalibrationEngine (2); // FirConvolution
         spatialRenderer.setHeadphoneCalibrationEnabled (true);
-        // TODO(Task 13): load hp_fir_taps from JSON
     }
     else
     {
@@ -2902,28 +3158,22 @@ void LocusQAudioProcessor::pollCompanionCalibrationProfileFromDisk()
     // sofa_ref:     relative path under ~/Library/Application Support/LocusQ/sofa/
     //               (e.g. "SADIE_D1_HRIR_48k.sofa")
     //
-    // TODO(Task 13): Once the SpatialRenderer SOFA swap hook is wired (see the
-    // TODO(Task 13) comment in SpatialRenderer.h :: initSteamAudioRuntime()), forward
-    // these values to the renderer here:
-    //
-    //   const auto hrtfMode = headphone->getProperty ("hp_hrtf_mode").toString().trim().toLowerCase();
-    //   const auto sofaRef  = headphone->getProperty ("sofa_ref").toString().trim();
-    //   if (hrtfMode == "sofa" && sofaRef.isNotEmpty())
-    //       spatialRenderer.setPendingSofaRef (sofaRef);   // method to be added in follow-up
-    //   else
-    //       spatialRenderer.clearPendingSofaRef();
-    //
     // The sofa_ref is resolved at runtime to an absolute path:
     //   ~/Library/Application Support/LocusQ/sofa/<sofa_ref>
-    // The loader gracefully returns valid=false if the file is absent (first-run device / not yet downloaded).
+    // and converted into the native HRTF renderer's grid, which serves SteamBinaural
+    // requests whenever Steam Audio is unavailable. A missing/invalid file leaves the
+    // renderer without a set (stereo downmix fallback). The load itself runs on a
+    // worker (serviceNativeSofaLoad) and is published on a later poll.
     {
         const auto hrtfMode = headphone->getProperty ("hp_hrtf_mode").toString().trim().toLowerCase();
         const auto sofaRef  = headphone->getProperty ("sofa_ref").toString().trim();
-        // Log for diagnostics only; active wiring deferred until SpatialRenderer hook is complete.
-        if (hrtfMode == "sofa" && sofaRef.isNotEmpty())
+        const auto sofaKey = (hrtfMode == "sofa") ? sofaRef : juce::String();
+
+        if (sofaKey != loadedNativeSofaRef || currentSampleRate != loadedNativeSofaSampleRate)
         {
-            DBG ("LocusQ: CalibrationProfile requests SOFA HRTF: " + sofaRef
-                 + " (wiring deferred — see TODO(Task 13) in SpatialRenderer.h)");
+            loadedNativeSofaRef = sofaKey;
+            loadedNativeSofaSampleRate = currentSampleRate;
+            serviceNativeSofaLoad();
         }
     }
 
@@ -2989,7 +3239,8 @@ void LocusQAudioProcessor::pollCompanionCalibrationProfileFromDisk()
         }
     }
 
-    companionCalibrationProfileLastModifiedMs = modifiedMs;
+    if (firTapsStaged)
+        companionCalibrationProfileLastModifiedMs = modifiedMs;
 }
 
 juce::var LocusQAudioProcessor::getConfidenceMaskingStatus() const
@@ -3170,6 +3421,9 @@ void LocusQAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
         state.setProperty ("locusq_timeline_json",
                            juce::JSON::toString (serialiseKeyframeTimelineLocked(), true),
                            nullptr);
+
+        if (! choreographyTimelineState.isVoid())
+            state.setProperty ("locusq_choreography_json", juce::JSON::toString (choreographyTimelineState, true), nullptr);
     }
 
     state.setProperty ("locusq_ui_state_json",
@@ -3235,6 +3489,16 @@ void LocusQAudioProcessor::setStateInformation (const void* data, int sizeInByte
                 initialiseDefaultKeyframeTimeline();
             }
 
+            {
+                const auto choreographyState = juce::JSON::parse (state.getProperty ("locusq_choreography_json").toString());
+                const juce::SpinLock::ScopedLockType timelineLock (keyframeTimelineLock);
+                if (choreographyState.isVoid() || ! applyChoreographyTimelineLocked (choreographyState))
+                {
+                    choreographyTimelineState = {};
+                    spatialRenderer.setChoreographyTimeline (nullptr);
+                }
+            }
+
             if (state.hasProperty ("locusq_ui_state_json"))
             {
                 const auto uiState = juce::JSON::parse (state.getProperty ("locusq_ui_state_json").toString());
@@ -3511,6 +3775,19 @@ juce::AudioProcessorValueTreeState::ParameterLayout LocusQAudioProcessor::create
         juce::ParameterID { "rend_headphone_profile", 1 }, "Headphone Profile",
         juce::StringArray { "Generic", "AirPods Pro 2", "AirPods Pro 3", "Sony WH-1000XM5", "Custom SOFA" }, 0));
 
+    params.insert (params.end(), std::make_unique<juce::AudioParameterInt> (
+        juce::ParameterID { "rend_headtrack_listener", 1 }, "Head Tracker Listener",
+        0, HeadTrackingBridge::kMaxListeners - 1, 0));
+
+    params.insert (params.end(), std::make_unique<juce::AudioParameterChoice> (
+        juce::ParameterID { "rend_headtrack_filter", 1 }, "Head Tracker Filter",
+        juce::StringArray { "Interpolate", "Predictive (Kalman)" }, 0));
+
+    params.insert (params.end(), std::make_unique<juce::AudioParameterInt> (
+        juce::ParameterID { "rend_headtrack_key_interval", 1 }, "Head Pose Key Interval",
+        SpatialRenderer::MIN_HEAD_POSE_SUB_BLOCK, SpatialRenderer::MAX_HEAD_POSE_SUB_BLOCK,
+        SpatialRenderer::DEFAULT_HEAD_POSE_SUB_BLOCK));
+
     params.insert (params.end(), std::make_unique<juce::AudioParameterBool> (
         juce::ParameterID { "rend_audition_enable", 1 }, "Audition Enable", false));
 
@@ -3564,6 +3841,13 @@ juce::AudioProcessorValueTreeState::ParameterLayout LocusQAudioProcessor::create
             "Codec ADM"
         }, 0));
 
+    params.insert (params.end(), std::make_unique<juce::AudioParameterChoice> (
+        juce::ParameterID { "rend_ambi_norm", 1 }, "Ambisonic Normalization",
+        juce::StringArray { "SN3D", "N3D" }, 0));
+
+    params.insert (params.end(), std::make_unique<juce::AudioParameterBool> (
+        juce::ParameterID { "rend_ambi_monitor", 1 }, "Ambisonic Monitoring", false));
+
     params.insert (params.end(), std::make_unique<juce::AudioParameterFloat> (
         juce::ParameterID { "rend_distance_ref", 1 }, "Ref Distance",
         juce::NormalisableRange<float> (0.1f, 10.0f, 0.01f), 1.0f));
@@ -3582,6 +3866,18 @@ juce::AudioProcessorValueTreeState::ParameterLayout LocusQAudioProcessor::create
     params.insert (params.end(), std::make_unique<juce::AudioParameterBool> (
         juce::ParameterID { "rend_air_absorb", 1 }, "Air Absorption", true));
 
+    params.insert (params.end(), std::make_unique<juce::AudioParameterChoice> (
+        juce::ParameterID { "rend_air_model", 1 }, "Air Model",
+        juce::StringArray { "Simple", "ISO 9613-1" }, 0));
+
+    params.insert (params.end(), std::make_unique<juce::AudioParameterFloat> (
+        juce::ParameterID { "rend_air_temp", 1 }, "Air Temperature",
+        juce::NormalisableRange<float> (-20.0f, 50.0f, 0.1f), 20.0f));
+
+    params.insert (params.end(), std::make_unique<juce::AudioParameterFloat> (
+        juce::ParameterID { "rend_air_humidity", 1 }, "Air Humidity",
+        juce::NormalisableRange<float> (0.0f, 100.0f, 0.1f), 50.0f));
+
     // ==================== RENDERER: ROOM ====================
     params.insert (params.end(), std::make_unique<juce::AudioParameterBool> (
         juce::ParameterID { "rend_room_enable", 1 }, "Room Enable", true));
@@ -3615,6 +3911,10 @@ juce::AudioProcessorValueTreeState::ParameterLayout LocusQAudioProcessor::create
     params.insert (params.end(), std::make_unique<juce::AudioParameterBool> (
         juce::ParameterID { "rend_phys_pause", 1 }, "Pause Physics", false));
 
+    params.insert (params.end(), std::make_unique<juce::AudioParameterChoice> (
+        juce::ParameterID { "rend_phys_clock", 1 }, "Physics Clock",
+        juce::StringArray { "Free Running", "Sample Clock" }, 0));
+
     // ==================== RENDERER: VISUALIZATION ====================
     params.insert (params.end(), std::make_unique<juce::AudioParameterChoice> (
         juce::ParameterID { "rend_viz_mode", 1 }, "View Mode",
@@ -6,7 +6,9 @@
 #include <atomic>
 #include <array>
 #include <cstdint>
+#include <memory>
 #include <optional>
+#include <thread>
 #include "VisualTokenScheduler.h"
 #include "SceneGraph.h"
 #include "SpatialRenderer.h"
@@ -71,7 +73,8 @@ enum class RegistrationTransitionFallbackReason : int
  *
  * Phase 2.1: Foundation & Scene Graph
  */
-class LocusQAudioProcessor : public juce::AudioProcessor
+class LocusQAudioProcessor : public juce::AudioProcessor,
+                             private juce::Timer
 #if LOCUSQ_CLAP_PROPERTIES_AVAILABLE
                           , public clap_juce_extensions::clap_properties
                           , public clap_juce_extensions::clap_juce_audio_processor_capabilities
@@ -134,12 +137,19 @@ public:
     juce::var loadCalibrationProfileFromUI (const juce::var& options);
     juce::var renameCalibrationProfileFromUI (const juce::var& options);
     juce::var deleteCalibrationProfileFromUI (const juce::var& options);
+
+    // Object export (CodecADM / CodecIAMF) API for WebView bridge
+    juce::var startObjectExportFromUI (const juce::var& options);
+    juce::var stopObjectExportFromUI();
+    juce::var getObjectExportStatusFromUI() const;
     void pollCompanionCalibrationProfileFromDisk();
 
     // Timeline and preset API for WebView bridge (Phase 2.6)
     juce::var getKeyframeTimelineForUI() const;
     bool setKeyframeTimelineFromUI (const juce::var& timelineState);
     bool setTimelineCurrentTimeFromUI (double timeSeconds);
+    juce::var getChoreographyTimelineForUI() const;
+    bool setChoreographyTimelineFromUI (const juce::var& choreographyState);
     juce::var listEmitterPresetsFromUI() const;
     juce::var saveEmitterPresetFromUI (const juce::var& options);
     juce::var loadEmitterPresetFromUI (const juce::var& options);
@@ -276,6 +286,8 @@ private:
     SteamAudioVirtualSurround calMonitorVirtualSurround { spatialRenderer };
     HeadTrackingBridge   headTrackingBridge;
     HeadPoseInterpolator headPoseInterpolator;
+    std::atomic<float>   headPoseJitterMs { 0.0f };          // audio thread → diagnostics
+    std::atomic<float>   headPoseLookaheadMs { 0.0f };
     std::atomic<bool>    calibrationProfileTrackingEnabled { false };
     std::atomic<float>   calibrationProfileYawOffsetDeg { 0.0f };
 
@@ -298,11 +310,52 @@ private:
 
     //==============================================================================
     // Keyframe animation timeline (Phase 2.6)
+    // keyframeTimeline is the message-thread master (edited under
+    // keyframeTimelineLock). Every edit publishes an immutable copy; the audio
+    // thread adopts the newest copy per block and advances its own playhead, so
+    // it never waits on or skips a block because of a UI edit.
     KeyframeTimeline keyframeTimeline;
     mutable juce::SpinLock keyframeTimelineLock;
     void initialiseDefaultKeyframeTimeline();
+
+    struct KeyframeTimelineSnapshot
+    {
+        KeyframeTimeline timeline;
+        uint64_t version = 0;
+    };
+    // Call while holding keyframeTimelineLock.
+    void publishKeyframeTimelineSnapshotLocked();
+    void requestKeyframeTimelineSeek (double timeSeconds) noexcept;
+
+    RetainingSharedPtrPublisher<const KeyframeTimelineSnapshot> publishedTimelineSnapshot; // message -> audio, freed on message thread only
+    uint64_t timelineSnapshotVersion = 0;
+    std::shared_ptr<const KeyframeTimelineSnapshot> activeTimelineSnapshot; // audio thread
+    KeyframeTimeline::Playhead timelinePlayhead;                            // audio thread
+    std::atomic<double> timelinePlayheadSeconds { 0.0 };                    // audio -> UI
+    std::atomic<double> timelineSeekSeconds { 0.0 };                        // UI -> audio
+    std::atomic<uint32_t> timelineSeekSerial { 0 };
+    uint32_t appliedTimelineSeekSerial = 0;
+
+    // Interned once in the constructor; publishEmitterState evaluates the whole
+    // compiled track set per block and picks these entries out of it.
+    struct EmitterTrackHandles
+    {
+        KeyframeTimeline::TrackHandle azimuth = KeyframeTimeline::invalidTrackHandle;
+        KeyframeTimeline::TrackHandle elevation = KeyframeTimeline::invalidTrackHandle;
+        KeyframeTimeline::TrackHandle distance = KeyframeTimeline::invalidTrackHandle;
+        KeyframeTimeline::TrackHandle x = KeyframeTimeline::invalidTrackHandle;
+        KeyframeTimeline::TrackHandle y = KeyframeTimeline::invalidTrackHandle;
+        KeyframeTimeline::TrackHandle z = KeyframeTimeline::invalidTrackHandle;
+        KeyframeTimeline::TrackHandle sizeUniform = KeyframeTimeline::invalidTrackHandle;
+    };
+    EmitterTrackHandles emitterTrackHandles;
     std::optional<double> getTransportTimeSeconds() const;
 
+    // Scene choreography (renderer mode): the last applied JSON is kept for
+    // state save and UI reads; the compiled timeline lives in spatialRenderer.
+    juce::var choreographyTimelineState;
+    bool applyChoreographyTimelineLocked (const juce::var& choreographyState);
+
     // Timeline serialization helpers (call while holding keyframeTimelineLock)
     juce::var serialiseKeyframeTimelineLocked() const;
     bool applyKeyframeTimelineLocked (const juce::var& timelineState);
@@ -319,6 +372,7 @@ private:
     juce::File resolvePresetFileFromOptions (const juce::var& options) const;
     juce::File getCalibrationProfileDirectory() const;
     juce::File resolveCalibrationProfileFileFromOptions (const juce::var& options) const;
+    juce::File getObjectExportDirectory() const;
     juce::String getSnapshotOutputLayout() const;
     int getSnapshotOutputChannels() const;
     void migrateSnapshotLayoutIfNeeded (const juce::ValueTree& restoredState);
@@ -339,8 +393,6 @@ private:
                                             const juce::var& validationSummary) const;
     bool applyEmitterPresetLocked (const juce::var& presetState);
     bool applyCalibrationProfileState (const juce::var& profileState);
-    static juce::String keyframeCurveToString (KeyframeCurve curve);
-    static KeyframeCurve keyframeCurveFromVar (const juce::var& value);
     static juce::String sanitiseEmitterLabel (const juce::String& label);
     static std::optional<juce::var> readJsonFromFile (const juce::File& file);
     static bool writeJsonToFile (const juce::File& file, const juce::var& payload);
@@ -384,6 +436,31 @@ private:
     bool hasSeededInitialEmitterColor = false;
     int lastReportedCalibrationLatency = -1;  // -1 forces first-block update
     juce::int64 companionCalibrationProfileLastModifiedMs = -1;
+    juce::String loadedNativeSofaRef;
+    double loadedNativeSofaSampleRate = 0.0;
+
+    // The SOFA parse and the HrtfSet / ShHrtfFilters fits run on a worker so
+    // the editor timer that polls the companion profile never stalls on them.
+    // The message thread starts one job at a time and publishes its result
+    // only if the profile still asks for that file at that sample rate.
+    struct NativeSofaLoadJob
+    {
+        juce::String sofaRef;
+        double sampleRate = 0.0;
+        std::shared_ptr<const locusq::dsp::HrtfSet> hrtfSet;
+        std::shared_ptr<const locusq::dsp::ShHrtfFilters> shFilters;
+        std::atomic<bool> finished { false };
+        std::thread worker;
+    };
+    std::unique_ptr<NativeSofaLoadJob> nativeSofaLoadJob;
+    juce::String appliedNativeSofaRef;
+    double appliedNativeSofaSampleRate = 0.0;
+    void serviceNativeSofaLoad();
+    void joinNativeSofaLoad();
+
+    // Message-thread housekeeping that must run with the editor closed too
+    // (air absorption table builds for automated conditions).
+    void timerCallback() override;
 
     // Cached companion CalibrationProfile.json fields — populated on the message thread
     // by pollCompanionCalibrationProfileFromDisk(). Read by getCalibrationStatus() bridge handler.
@@ -3,6 +3,7 @@
 #include <juce_core/juce_core.h>
 #include <atomic>
 #include <array>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
 #include "SharedPtrAtomicContract.h"
@@ -15,6 +16,22 @@ struct Vec3
     float x = 0.0f, y = 0.0f, z = 0.0f;
 };
 
+// Emitter position parameters -> scene position (y up, +z front). Shared by
+// the plugin's emitter path and the offline scene renderer.
+inline Vec3 emitterPositionFromSpherical (float azimuthDeg, float elevationDeg, float distance) noexcept
+{
+    const float azimuthRad = azimuthDeg * juce::MathConstants<float>::pi / 180.0f;
+    const float elevationRad = elevationDeg * juce::MathConstants<float>::pi / 180.0f;
+    return { distance * std::cos (elevationRad) * std::sin (azimuthRad),
+             distance * std::sin (elevationRad),
+             distance * std::cos (elevationRad) * std::cos (azimuthRad) };
+}
+
+inline Vec3 emitterPositionFromCartesian (float posX, float posY, float posZ) noexcept
+{
+    return { posX, posZ, posY }; // Z in param = Y in 3D (height)
+}
+
 //==============================================================================
 // RoomProfile - Calibration data (read-only after creation)
 //==============================================================================
@@ -296,7 +313,7 @@ public:
     }
 
     //--------------------------------------------------------------------------
-    // Global sample counter for sync
+    // Global sample counter for sync (advanced by the renderer's blocks)
     void advanceSampleCounter (int numSamples)
     {
         globalSampleCounter.fetch_add (static_cast<uint64_t> (numSamples), std::memory_order_relaxed);
@@ -363,6 +380,10 @@ private:
         return static_cast<uint8_t> (x % 16u);
     }
 
+    // Offline bounces render into a private scene so they never touch the
+    // host-shared singleton.
+    friend class OfflineSceneRenderer;
+
     SceneGraph()
     {
         for (auto& state : slotStates)
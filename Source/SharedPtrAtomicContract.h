@@ -1,7 +1,9 @@
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <memory>
+#include <vector>
 
 // Shared_ptr publication wrapper with explicit acquire/release semantics.
 // Uses std::atomic<std::shared_ptr<T>> when supported by the toolchain; falls
@@ -56,3 +58,43 @@ private:
     std::shared_ptr<T> value;
    #endif
 };
+
+// Publisher side of a SharedPtrAtomicContract whose readers adopt and drop
+// values on the audio thread. Every published value stays retained here
+// until its use count shows no other holder, so the last reference (and the
+// free) is always on the publishing thread. publish() and releaseRetired()
+// must be called from that one thread; load() is safe from any thread.
+template <typename T>
+class RetainingSharedPtrPublisher
+{
+public:
+    void publish (std::shared_ptr<T> nextValue)
+    {
+        releaseRetired();
+        if (nextValue != nullptr)
+            retained.push_back (nextValue);
+        contract.store (std::move (nextValue));
+    }
+
+    std::shared_ptr<T> load() const noexcept
+    {
+        return contract.load();
+    }
+
+    void releaseRetired()
+    {
+        retained.erase (std::remove_if (retained.begin(),
+                                        retained.end(),
+                                        [] (const auto& value) { return value.use_count() <= 1; }),
+                        retained.end());
+    }
+
+    size_t getNumRetained() const noexcept
+    {
+        return retained.size();
+    }
+
+private:
+    SharedPtrAtomicContract<T> contract;
+    std::vector<std::shared_ptr<T>> retained;
+};
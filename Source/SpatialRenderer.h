@@ -4,6 +4,7 @@
 #include <juce_core/juce_core.h>
 #include <juce_dsp/juce_dsp.h>
 #include "SceneGraph.h"
+#include "ChoreographyTimeline.h"
 #include "VBAPPanner.h"
 #include "DistanceAttenuator.h"
 #include "AirAbsorption.h"
@@ -14,6 +15,11 @@
 #include "FDNReverb.h"
 #include "headphone_dsp/HeadphoneCalibrationChain.h"
 #include "headphone_dsp/HeadphonePresetLoader.h"
+#include "dsp/AmbisonicBinauralDecoder.h"
+#include "dsp/HrtfBinauralRenderer.h"
+#include "spatial_renderer/AmbisonicEncoder.h"
+#include "spatial_renderer/BedLayoutPanner.h"
+#include "spatial_renderer/ObjectExportStage.h"
 #include "spatial_renderer/SpatialProfileRouter.h"
 #include "spatial_renderer/SpatialRendererTypes.h"
 #include <algorithm>
@@ -23,6 +29,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <limits>
+#include <optional>
 #include <vector>
 
 #if defined (LOCUSQ_ENABLE_STEAM_AUDIO) && LOCUSQ_ENABLE_STEAM_AUDIO
@@ -52,7 +59,7 @@ struct IPLCoordinateSpace3
  * Reads all active emitters from the SceneGraph, applies:
  *   1. VBAP panning (azimuth → 4 speaker gains)
  *   2. Distance attenuation (selected model)
- *   3. Air absorption (distance-driven LPF)
+ *   3. Air absorption (distance-driven LPF or ISO 9613-1 shelving)
  *   4. Per-speaker delay compensation
  *   5. Per-speaker gain trims
  *   6. Master gain
@@ -64,6 +71,7 @@ class SpatialRenderer
 {
 public:
     static constexpr int NUM_SPEAKERS = 4;
+    static constexpr int MAX_BED_CHANNELS = locusq::bed_panner::kMaxBedChannels; // AtmosBed 7.1.4 / 9.1.6
     static constexpr int NUM_HEADPHONE_DEVICE_PROFILES = 5;
     static constexpr int MAX_SPEAKER_DELAY_MS = 50;
     static constexpr int MAX_DELAY_SAMPLE_RATE_HZ = 192000;
@@ -72,6 +80,11 @@ public:
     static_assert ((MAX_DELAY_SAMPLES - 1) >= ((MAX_SPEAKER_DELAY_MS * MAX_DELAY_SAMPLE_RATE_HZ) / 1000),
                    "speaker delay buffer must preserve full max delay at 192kHz");
     static constexpr int MAX_AUDITION_REACTIVE_SOURCES = locusq::spatial_renderer_types::kMaxAuditionReactiveSources;
+    static constexpr int DEFAULT_HEAD_POSE_SUB_BLOCK = 32;   // head-pose key spacing in samples
+    static constexpr int MIN_HEAD_POSE_SUB_BLOCK = 8;
+    static constexpr int MAX_HEAD_POSE_SUB_BLOCK = 1024;
+    static constexpr int MAX_HEAD_POSE_KEYS = 64;            // per block; the spacing widens beyond this
+    static constexpr int HEAD_POSE_KEY_BLOCK_END = std::numeric_limits<int>::max();
     using HeadphoneRenderMode = locusq::spatial_renderer_types::HeadphoneRenderMode;
     enum class HeadphoneDeviceProfile : int
     {
@@ -99,6 +112,7 @@ public:
     using CodecMappingExecutionSnapshot = locusq::spatial_renderer_types::CodecMappingExecutionSnapshot;
     using CodecAdmRuntimePayloadSnapshot = locusq::spatial_renderer_types::CodecAdmRuntimePayloadSnapshot;
     using CodecIamfRuntimePayloadSnapshot = locusq::spatial_renderer_types::CodecIamfRuntimePayloadSnapshot;
+    using ObjectExportStatus = locusq::object_export::ExportStatus;
     using AuditionReactiveHeadphoneFallbackReason = locusq::spatial_renderer_types::AuditionReactiveHeadphoneFallbackReason;
 
     SpatialRenderer()
@@ -162,6 +176,7 @@ public:
         // Prepare per-emitter air absorption filters
         for (auto& filter : emitterAbsorption)
             filter.prepare (sampleRate);
+        airAbsorptionTablePublisher.buildPendingTable();
 
         // Prepare per-emitter smoothed gains (4 speakers per emitter)
         for (auto& emitterGains : smoothedSpeakerGains)
@@ -176,11 +191,11 @@ public:
                 std::fill (buffer.begin(), buffer.end(), 0.0f);
         };
 
-        // Prepare per-speaker delay lines
-        for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+        // Prepare per-output-channel delay lines (quad bed or AtmosBed bus)
+        for (int ch = 0; ch < MAX_BED_CHANNELS; ++ch)
         {
-            ensureZeroedBuffer (speakerDelayLines[spk], MAX_DELAY_SAMPLES);
-            delayWritePos[spk] = 0;
+            ensureZeroedBuffer (speakerDelayLines[static_cast<size_t> (ch)], MAX_DELAY_SAMPLES);
+            delayWritePos[static_cast<size_t> (ch)] = 0;
         }
 
         for (auto& voiceGains : auditionSmoothedSpeakerGains)
@@ -195,12 +210,24 @@ public:
         // Prepare accumulation buffer (4 channels)
         accumBuffer.setSize (NUM_SPEAKERS, maxBlockSize);
 
+        // Direct ambisonic bus (ACN, up to 3rd order) plus rotation/room scratch
+        ambisonicBus.setSize (locusq::ambisonic_encoder::kMaxChannels, maxBlockSize);
+        ambisonicScratch.setSize (locusq::ambisonic_encoder::kMaxChannels, maxBlockSize);
+        ambisonicRoomDry.setSize (NUM_SPEAKERS, maxBlockSize);
+        resetAmbisonicEncoderState();
+
+        // AtmosBed accumulation bus (7.1.4 / 9.1.6, panned directly per emitter)
+        bedBuffer.setSize (MAX_BED_CHANNELS, maxBlockSize);
+        resetBedState();
+
         // Smoothed master gain
         smoothedMasterGain.reset (sampleRate, 0.020);
 
         // Smoothed speaker trims
         for (auto& trim : smoothedSpeakerTrim)
             trim.reset (sampleRate, 0.020);
+        for (auto& trim : smoothedBedChannelTrim)
+            trim.reset (sampleRate, 0.020);
 
         // Temp mono buffer for per-emitter processing
         ensureZeroedBuffer (tempMonoBuffer, static_cast<size_t> (maxBlockSize));
@@ -209,8 +236,8 @@ public:
         for (auto& doppler : emitterDoppler)
             doppler.prepare (sampleRate, maxBlockSize);
 
-        // Prepare room processors
-        earlyReflections.prepare (sampleRate, maxBlockSize);
+        // Prepare room processors (early reflections run per channel, so size for the bed)
+        earlyReflections.prepare (sampleRate, maxBlockSize, MAX_BED_CHANNELS);
         fdnReverb.prepare (sampleRate, maxBlockSize);
 
         setQualityTier (qualityHigh ? 1 : 0);
@@ -224,6 +251,13 @@ public:
 
         ensureZeroedBuffer (steamBinauralLeft, static_cast<size_t> (maxBlockSize));
         ensureZeroedBuffer (steamBinauralRight, static_cast<size_t> (maxBlockSize));
+        ensureZeroedBuffer (nativeBinauralLeft, static_cast<size_t> (maxBlockSize));
+        ensureZeroedBuffer (nativeBinauralRight, static_cast<size_t> (maxBlockSize));
+        nativeBinauralRenderer.prepare (sampleRate);
+        ensureZeroedBuffer (ambisonicMonitorLeft, static_cast<size_t> (maxBlockSize));
+        ensureZeroedBuffer (ambisonicMonitorRight, static_cast<size_t> (maxBlockSize));
+        ambisonicBinauralDecoder.prepare (sampleRate);
+        ensureZeroedBuffer (masterGainRamp, static_cast<size_t> (maxBlockSize));
         for (auto& rotated : headPoseRotatedQuadScratch)
             ensureZeroedBuffer (rotated, static_cast<size_t> (maxBlockSize));
         for (auto& rotated : monitoringHeadPoseRotatedQuadScratch_)
@@ -238,6 +272,7 @@ public:
         resetAuditionVoiceFieldStates();
         resetAuditionReactiveTelemetry();
         preloadBundledPeqPresets();
+        buildBundledPeqCoefficientSets (sampleRate);
         lastLoadedPeqPresetIndex = -1;
         lastLoadedPeqSampleRate = 0.0;
         updateHeadphoneCompensationForProfile (HeadphoneDeviceProfile::Generic);
@@ -269,9 +304,12 @@ public:
             std::fill (dl.begin(), dl.end(), 0.0f);
 
         accumBuffer.clear();
+        resetAmbisonicEncoderState();
+        resetBedState();
 
         for (auto& doppler : emitterDoppler)
             doppler.reset();
+        renderedLastBlock.fill (false);
 
         earlyReflections.reset();
         fdnReverb.reset();
@@ -303,6 +341,7 @@ public:
 
     void shutdown() noexcept
     {
+        objectExportStage.stop();
         teardownSteamAudioRuntime();
 #if defined (LOCUSQ_ENABLE_STEAM_AUDIO) && LOCUSQ_ENABLE_STEAM_AUDIO
         setSteamInitStage (SteamInitStage::Uninitialized, 0);
@@ -315,6 +354,16 @@ public:
     // Set renderer parameters (called from processBlock before process())
     //==========================================================================
 
+    // Per-block emitter budget. Realtime keeps the v1-tested envelope; offline
+    // bounces raise it to every tracked emitter.
+    void setRenderEmitterBudget (int budget) noexcept
+    {
+        renderEmitterBudget.store (juce::jlimit (1, MAX_TRACKED_EMITTERS, budget), std::memory_order_relaxed);
+    }
+
+    static constexpr int getMaxRenderEmitterBudget() noexcept { return MAX_TRACKED_EMITTERS; }
+    static constexpr int getDefaultRenderEmitterBudget() noexcept { return MAX_RENDER_EMITTERS_PER_BLOCK; }
+
     void setDistanceModel (int modelIndex)
     {
         const auto clamped = juce::jlimit (0, 3, modelIndex);
@@ -353,6 +402,30 @@ public:
         airAbsorptionEnabled = enabled;
     }
 
+    void setAirAbsorptionModel (int modelIndex)
+    {
+        const auto model = static_cast<AirAbsorption::Model> (juce::jlimit (0, 1, modelIndex));
+        if (airAbsorptionModel == model)
+            return;
+
+        airAbsorptionModel = model;
+        for (auto& filter : emitterAbsorption)
+            filter.setModel (airAbsorptionModel);
+    }
+
+    // Audio thread. Posts the conditions; the ISO 9613-1 table for them is
+    // built by the next updateAirAbsorptionTable() and adopted a block later.
+    void setAirAbsorptionConditions (float temperatureC, float humidityPercent) noexcept
+    {
+        airAbsorptionTablePublisher.requestConditions (temperatureC, humidityPercent);
+    }
+
+    // Non-RT (message thread or offline render loop).
+    void updateAirAbsorptionTable()
+    {
+        airAbsorptionTablePublisher.buildPendingTable();
+    }
+
     void setDopplerEnabled (bool enabled)
     {
         if (dopplerEnabled == enabled)
@@ -496,85 +569,83 @@ public:
         if (lastLoadedPeqPresetIndex == clampedProfileIndex && lastLoadedPeqSampleRate == sampleRate)
             return;
 
-        const auto& preset = bundledPeqPresets[static_cast<size_t> (clampedProfileIndex)].preset;
-
-        if (sampleRate <= 0.0 || ! preset.valid || preset.bands.empty())
+        // Runs on the audio thread (updateRendererParameters). Coefficient sets
+        // are built in prepare() for the prepared rate, so a profile switch
+        // only copies a cached set; biquads are never designed here. The
+        // publish never waits: if the companion path is mid-publish, or the
+        // cache is for another rate until prepare() rebuilds it, the switch
+        // is retried on the next block.
+        const auto& cacheEntry = bundledPeqPresets[static_cast<size_t> (clampedProfileIndex)];
+        if (cacheEntry.coefficientSampleRate != sampleRate
+            || ! headphoneCalibrationChain.tryPublishPeqCoefficients (cacheEntry.coefficients))
         {
-            headphoneCalibrationChain.clearPeqPreset();
-            lastLoadedPeqPresetIndex = clampedProfileIndex;
-            lastLoadedPeqSampleRate  = sampleRate;
             return;
         }
 
-        headphoneCalibrationChain.clearPeqPreset();
-
-        // NOTE: clearPeqPreset -> setPeqPreampDb -> setPeqStage writes are not atomic with respect
-        // to the audio thread. A brief glitch may occur during a profile switch while audio is
-        // processing. This is acceptable: profile changes are non-RT events on the message thread.
-        headphoneCalibrationChain.setPeqPreampDb (preset.preampDb);
-
-        const auto sr = static_cast<float> (sampleRate);
-        const int maxStages = juce::jmin (
-            static_cast<int> (preset.bands.size()),
-            locusq::headphone_dsp::HeadphonePeqHook::kMaxStages);
-
-        for (int i = 0; i < maxStages; ++i)
-        {
-            const auto& band = preset.bands[static_cast<size_t> (i)];
-            locusq::headphone_dsp::HeadphonePeqHook::Coefficients c;
-            switch (band.type)
-            {
-                case locusq::headphone_dsp::PeqBandSpec::Type::LSC:
-                    c = locusq::headphone_dsp::HeadphonePeqHook::makeLowShelf  (band.fcHz, band.gainDb, band.q, sr); break;
-                case locusq::headphone_dsp::PeqBandSpec::Type::HSC:
-                    c = locusq::headphone_dsp::HeadphonePeqHook::makeHighShelf (band.fcHz, band.gainDb, band.q, sr); break;
-                default:
-                    c = locusq::headphone_dsp::HeadphonePeqHook::makePeakEQ    (band.fcHz, band.gainDb, band.q, sr); break;
-            }
-            headphoneCalibrationChain.setPeqStage (i, c);
-        }
-
         lastLoadedPeqPresetIndex = clampedProfileIndex;
         lastLoadedPeqSampleRate  = sampleRate;
     }
 
     // Apply PEQ bands from a JSON-parsed var array (companion IPC path).
     // preampDb = 0.0 if the JSON schema has no preamp field.
-    // Called on message thread; not RT-safe (see loadPeqPresetForProfile note).
+    // Called on the message thread; the set is built here and published
+    // alongside the audio thread's profile switches (see HeadphonePeqHook).
     void applyJsonPeqBands (const juce::var& bandsArray, float preampDb, double sampleRate)
     {
-        headphoneCalibrationChain.clearPeqPreset();
-        headphoneCalibrationChain.setPeqPreampDb (preampDb);
-
-        if (! bandsArray.isArray())
-            return;
-
-        const auto sr = static_cast<float> (sampleRate);
-        const int maxStages = juce::jmin (
-            bandsArray.getArray()->size(),
-            locusq::headphone_dsp::HeadphonePeqHook::kMaxStages);
+        locusq::headphone_dsp::HeadphonePeqHook::CoefficientSet coefficients;
+        coefficients.preampLinear = std::pow (10.0f, preampDb / 20.0f);
 
-        for (int i = 0; i < maxStages; ++i)
+        if (bandsArray.isArray() && sampleRate > 0.0)
         {
-            auto* band = (*bandsArray.getArray())[i].getDynamicObject();
-            if (band == nullptr)
-                continue;
+            const auto sr = static_cast<float> (sampleRate);
+            const int maxStages = juce::jmin (
+                bandsArray.getArray()->size(),
+                locusq::headphone_dsp::HeadphonePeqHook::kMaxStages);
 
-            const auto typeStr = band->getProperty ("type").toString().trim().toUpperCase();
-            const auto fcHz    = static_cast<float> (static_cast<double> (band->getProperty ("fc_hz")));
-            const auto gainDb  = static_cast<float> (static_cast<double> (band->getProperty ("gain_db")));
-            const auto q       = static_cast<float> (static_cast<double> (band->getProperty ("q")));
+            for (int i = 0; i < maxStages; ++i)
+            {
+                auto* band = (*bandsArray.getArray())[i].getDynamicObject();
+                if (band == nullptr)
+                    continue;
+
+                const auto typeStr = band->getProperty ("type").toString().trim().toUpperCase();
+                const auto fcHz    = static_cast<float> (static_cast<double> (band->getProperty ("fc_hz")));
+                const auto gainDb  = static_cast<float> (static_cast<double> (band->getProperty ("gain_db")));
+                const auto q       = static_cast<float> (static_cast<double> (band->getProperty ("q")));
+
+                auto& c = coefficients.stages[static_cast<size_t> (i)];
+                if (typeStr == "LSC")
+                    c = locusq::headphone_dsp::HeadphonePeqHook::makeLowShelf  (fcHz, gainDb, q, sr);
+                else if (typeStr == "HSC")
+                    c = locusq::headphone_dsp::HeadphonePeqHook::makeHighShelf (fcHz, gainDb, q, sr);
+                else
+                    c = locusq::headphone_dsp::HeadphonePeqHook::makePeakEQ    (fcHz, gainDb, q, sr);
+            }
+        }
 
-            locusq::headphone_dsp::HeadphonePeqHook::Coefficients c;
-            if (typeStr == "LSC")
-                c = locusq::headphone_dsp::HeadphonePeqHook::makeLowShelf  (fcHz, gainDb, q, sr);
-            else if (typeStr == "HSC")
-                c = locusq::headphone_dsp::HeadphonePeqHook::makeHighShelf (fcHz, gainDb, q, sr);
-            else
-                c = locusq::headphone_dsp::HeadphonePeqHook::makePeakEQ    (fcHz, gainDb, q, sr);
+        headphoneCalibrationChain.publishPeqCoefficients (coefficients);
+    }
 
-            headphoneCalibrationChain.setPeqStage (i, c);
+    // Apply FIR taps from a JSON-parsed var array (companion IPC path, message
+    // thread). An empty or non-finite array stages the identity impulse.
+    // Returns false when the previous IR swap is still blending, so the
+    // caller retries on its next poll.
+    bool applyJsonFirTaps (const juce::var& tapsArray)
+    {
+        std::vector<float> taps;
+        bool hasFiniteTap = false;
+        if (const auto* array = tapsArray.getArray())
+        {
+            taps.reserve (static_cast<size_t> (array->size()));
+            for (const auto& tap : *array)
+            {
+                taps.push_back (static_cast<float> (static_cast<double> (tap)));
+                hasFiniteTap = hasFiniteTap || std::isfinite (taps.back());
+            }
         }
+
+        const auto staged = headphoneCalibrationChain.loadFirImpulseResponse (taps.data(), static_cast<int> (taps.size()));
+        return staged || ! hasFiniteTap;
     }
 
     void setHeadphoneCalibrationEnabled (bool enabled) noexcept
@@ -607,35 +678,61 @@ public:
         requestedSpatialProfileIndex.store (clamped, std::memory_order_relaxed);
     }
 
-    void applyHeadPose (const PoseSnapshot& pose) noexcept
+    void setAmbisonicNormalization (int normalizationIndex)
     {
-        if (! std::isfinite (pose.qx)
-            || ! std::isfinite (pose.qy)
-            || ! std::isfinite (pose.qz)
-            || ! std::isfinite (pose.qw))
-        {
-            return;
-        }
+        requestedAmbisonicNormalizationIndex.store (juce::jlimit (0, 1, normalizationIndex), std::memory_order_relaxed);
+    }
 
-        const float normSq = (pose.qx * pose.qx)
-                           + (pose.qy * pose.qy)
-                           + (pose.qz * pose.qz)
-                           + (pose.qw * pose.qw);
-        if (! std::isfinite (normSq) || normSq < 1.0e-12f)
+    // Stereo/binaural outputs only: encode the scene to 3rd order, rotate it in
+    // the SH domain and decode with the SH-domain HRTFs of the loaded SOFA set.
+    void setAmbisonicMonitoringEnabled (bool enabled) noexcept
+    {
+        requestedAmbisonicMonitoring.store (enabled, std::memory_order_relaxed);
+    }
+
+    // Head-pose keys: the processor samples its pose interpolator every
+    // getHeadPoseKeyInterval() samples and hands the keys over before
+    // process(). Speaker-mix and SH rotation matrices are built once per key
+    // and ramped between keys, so a 1024-sample host block no longer turns
+    // the head in one ~21 ms step. The processor sets the spacing from
+    // rend_headtrack_key_interval; it widens when a block would need more
+    // than MAX_HEAD_POSE_KEYS keys.
+    void setHeadPoseSubBlockSamples (int samples) noexcept
+    {
+        requestedHeadPoseSubBlockSamples.store (
+            juce::jlimit (MIN_HEAD_POSE_SUB_BLOCK, MAX_HEAD_POSE_SUB_BLOCK, samples),
+            std::memory_order_relaxed);
+    }
+
+    int getHeadPoseKeyInterval (int numSamples) const noexcept
+    {
+        const int requested = requestedHeadPoseSubBlockSamples.load (std::memory_order_relaxed);
+        const int minimumForBlock = (juce::jmax (0, numSamples) + MAX_HEAD_POSE_KEYS - 1) / MAX_HEAD_POSE_KEYS;
+        return juce::jmax (1, requested, minimumForBlock);
+    }
+
+    // poses[k] is the pose at sample offset (k + 1) * keyIntervalSamples of the
+    // next block (the last key may overshoot; it is clamped to the block end).
+    // The ramp starts from wherever the previous block ended.
+    void applyHeadPoseTrajectory (const PoseSnapshot* poses, int numPoses, int keyIntervalSamples) noexcept
+    {
+        if (poses == nullptr || numPoses <= 0)
             return;
 
-        const float invNorm = 1.0f / std::sqrt (normSq);
-        headPoseSnapshot.qx = pose.qx * invNorm;
-        headPoseSnapshot.qy = pose.qy * invNorm;
-        headPoseSnapshot.qz = pose.qz * invNorm;
-        headPoseSnapshot.qw = pose.qw * invNorm;
-        headPoseSnapshot.timestampMs = pose.timestampMs;
-        headPoseSnapshot.seq = pose.seq;
-        headPoseSnapshot.pad = 0;
-        headPoseValid = true;
+        const int interval = juce::jmax (1, keyIntervalSamples);
+        holdHeadPoseKeys();
+        for (int k = 0; k < juce::jmin (numPoses, MAX_HEAD_POSE_KEYS); ++k)
+            appendHeadPoseKey (poses[k], (k + 1) * interval);
 
-        updateHeadPoseOrientationFromSnapshot();
-        rebuildHeadPoseSpeakerMix();
+        headPoseKeysFresh = headPoseKeyCount > 1;
+    }
+
+    // Single pose for the next block, ramped in across the whole block.
+    void applyHeadPose (const PoseSnapshot& pose) noexcept
+    {
+        holdHeadPoseKeys();
+        appendHeadPoseKey (pose, HEAD_POSE_KEY_BLOCK_END);
+        headPoseKeysFresh = headPoseKeyCount > 1;
     }
 
     void setAuditionEnabled (bool enabled) noexcept
@@ -685,6 +782,53 @@ public:
         return activeHeadphoneModeIndex.load (std::memory_order_relaxed);
     }
 
+    // Message thread. Installs (or clears, with nullptr) the SOFA-derived HRTF
+    // set used when a SteamBinaural request cannot be served by Steam Audio,
+    // and the SH-domain filters fitted from it for ambisonic monitoring. Both
+    // are built by the caller off the message thread; this only publishes.
+    void setNativeHrtfSet (std::shared_ptr<const locusq::dsp::HrtfSet> set,
+                           std::shared_ptr<const locusq::dsp::ShHrtfFilters> shFilters)
+    {
+        ambisonicBinauralDecoder.setFilters (std::move (shFilters));
+        nativeBinauralRenderer.setHrtfSet (std::move (set));
+    }
+
+    // Message thread. Frees superseded HRTF sets and SH filters once the
+    // audio thread has switched away from them.
+    void releaseRetiredNativeHrtfSets()
+    {
+        ambisonicBinauralDecoder.releaseRetiredFilters();
+        nativeBinauralRenderer.releaseRetiredSets();
+    }
+
+    bool hasNativeHrtfSet() const noexcept
+    {
+        return nativeBinauralRenderer.hasHrtfSet();
+    }
+
+    // Message thread. Installs (or clears, with nullptr) the scene choreography
+    // that process() evaluates once per block and writes over the positions of
+    // the emitter slots it has tracks for. Superseded timelines stay retained
+    // here until the audio thread has moved on, so it never frees one.
+    void setChoreographyTimeline (std::shared_ptr<const ChoreographyTimeline> timeline)
+    {
+        publishedChoreography.publish (std::move (timeline));
+    }
+
+    // Audio thread, before process(). Host transport time drives the
+    // choreography clock; without one it free-runs with the rendered blocks.
+    void setChoreographyTransportTime (std::optional<double> transportSeconds) noexcept
+    {
+        choreographyTransportSeconds = transportSeconds;
+    }
+
+    // Non-zero only while an in-tree HRTF renderer (native or ambisonic
+    // monitoring) is producing the output.
+    int getNativeBinauralLatencySamples() const noexcept
+    {
+        return nativeBinauralLatencySamples.load (std::memory_order_relaxed);
+    }
+
     int getHeadphoneDeviceProfileRequestedIndex() const noexcept
     {
         return requestedHeadphoneProfileIndex.load (std::memory_order_relaxed);
@@ -806,6 +950,29 @@ public:
         return snapshot;
     }
 
+    //==========================================================================
+    // Object export (CodecADM / CodecIAMF). Message thread only; capture runs
+    // in process() while one of the codec profiles is requested.
+    bool startObjectExport (const juce::File& file)
+    {
+        const auto profile = static_cast<SpatialOutputProfile> (
+            requestedSpatialProfileIndex.load (std::memory_order_relaxed));
+        if (profile != SpatialOutputProfile::CodecADM && profile != SpatialOutputProfile::CodecIAMF)
+            return false;
+
+        return objectExportStage.start (file, currentSampleRate, maxDistance);
+    }
+
+    bool stopObjectExport()
+    {
+        return objectExportStage.stop();
+    }
+
+    ObjectExportStatus getObjectExportStatus() const noexcept
+    {
+        return objectExportStage.getStatus();
+    }
+
     bool isSteamAudioAvailable() const noexcept
     {
         return steamAudioAvailable.load (std::memory_order_relaxed);
@@ -840,9 +1007,11 @@ public:
 
     static const char* headphoneRenderModeToString (int modeIndex) noexcept
     {
-        switch (juce::jlimit (0, 1, modeIndex))
+        switch (juce::jlimit (0, 3, modeIndex))
         {
             case static_cast<int> (HeadphoneRenderMode::SteamBinaural): return "steam_binaural";
+            case static_cast<int> (HeadphoneRenderMode::NativeHrtfBinaural): return "native_hrtf_binaural";
+            case static_cast<int> (HeadphoneRenderMode::AmbisonicBinaural): return "ambisonic_binaural";
             case static_cast<int> (HeadphoneRenderMode::StereoDownmix):
             default: break;
         }
@@ -1118,20 +1287,69 @@ public:
         const int numSamples = outputBuffer.getNumSamples();
         const int numOutputChannels = outputBuffer.getNumChannels();
 
+        // Head-pose keys are consumed by one block; without fresh keys the last
+        // pose holds instead of replaying the previous block's ramp.
+        if (! headPoseKeysFresh)
+            holdHeadPoseKeys();
+        headPoseKeysFresh = false;
+
+        updateChoreography (numSamples);
+        int choreographedEmitterCount = 0;
+        airAbsorptionTablePublisher.adoptLatest (activeAirAbsorptionTable);
+
         // Clear accumulation buffer
         accumBuffer.clear();
 
-        struct EmitterCandidate
+        const auto profileResolution = resolveSpatialProfileForHost (numOutputChannels);
+        const auto activeSpatialProfile = profileResolution.profile;
+
+        // FOA/HOA on a multichannel host: emitters are encoded straight into the
+        // ambisonic bus instead of being re-encoded from the panned quad bed.
+        const int ambisonicEncodeOrder = ambisonicEncodeOrderForOutput (activeSpatialProfile, numOutputChannels);
+        const int ambisonicEncodeChannels = ambisonicEncodeOrder > 0
+                                                ? locusq::ambisonic_encoder::channelCountForOrder (ambisonicEncodeOrder)
+                                                : 0;
+        const auto ambisonicNormalization = static_cast<AmbisonicNormalization> (
+            requestedAmbisonicNormalizationIndex.load (std::memory_order_relaxed));
+
+        // Ambisonic monitoring on stereo/binaural outputs uses the same bus at
+        // 3rd order SN3D (what the SH-domain HRTFs expect), decoded to two ears.
+        const bool ambisonicMonitorActive = requestedAmbisonicMonitoring.load (std::memory_order_relaxed)
+                                            && ambisonicEncodeOrder == 0
+                                            && numOutputChannels >= 2
+                                            && (isStereoOrBinauralProfile (activeSpatialProfile) || numOutputChannels <= 2)
+                                            && numSamples <= static_cast<int> (ambisonicMonitorLeft.size())
+                                            && ambisonicBinauralDecoder.beginBlock();
+        const int ambisonicBusOrder = ambisonicMonitorActive ? locusq::dsp::ShHrtfFilters::kOrder : ambisonicEncodeOrder;
+        const int ambisonicBusChannels = ambisonicBusOrder > 0
+                                             ? locusq::ambisonic_encoder::channelCountForOrder (ambisonicBusOrder)
+                                             : 0;
+        const auto ambisonicBusNormalization = ambisonicMonitorActive ? AmbisonicNormalization::SN3D
+                                                                      : ambisonicNormalization;
+        if (ambisonicBusOrder > 0)
         {
-            int slotIdx = -1;
-            EmitterData data {};
-            float distance = 0.0f;
-            float distanceGain = 0.0f;
-            float emitterGainLinear = 0.0f;
-            float priority = 0.0f;
-        };
+            for (int ch = 0; ch < ambisonicBusChannels; ++ch)
+                juce::FloatVectorOperations::clear (ambisonicBus.getWritePointer (ch), numSamples);
+            ++ambisonicBlockCounter;
+        }
+
+        // AtmosBed on a 7.1.4 / 9.1.6 host: emitters are panned straight onto the
+        // full bed (tops included) instead of being upmixed from the quad bed.
+        auto bedLayout = locusq::bed_panner::BedLayout::Bed714;
+        const bool bedRenderActive = activeSpatialProfile == SpatialOutputProfile::AtmosBed
+                                     && locusq::bed_panner::layoutForOutputChannels (numOutputChannels, bedLayout)
+                                     && numSamples <= bedBuffer.getNumSamples();
+        const int bedChannels = bedRenderActive ? locusq::bed_panner::channelCountForLayout (bedLayout) : 0;
+        const auto bedZones = locusq::bed_panner::zonesForLayout (bedLayout);
+        if (bedRenderActive)
+        {
+            for (int ch = 0; ch < bedChannels; ++ch)
+                juce::FloatVectorOperations::clear (bedBuffer.getWritePointer (ch), numSamples);
+            ++bedBlockCounter;
+        }
 
-        std::array<EmitterCandidate, MAX_RENDER_EMITTERS_PER_BLOCK> selectedEmitters {};
+        const int emitterBudget = renderEmitterBudget.load (std::memory_order_relaxed);
+        auto& selectedEmitters = emitterCandidates;
         int selectedEmitterCount = 0;
         int selectedMinPriorityIndex = -1;
         float selectedMinPriority = std::numeric_limits<float>::max();
@@ -1159,12 +1377,28 @@ public:
         // First pass: collect eligible emitters and enforce a hard per-block budget.
         for (int slotIdx = 0; slotIdx < SceneGraph::MAX_EMITTERS; ++slotIdx)
         {
+            const auto slot = static_cast<size_t> (slotIdx);
             if (! scene.isSlotActive (slotIdx))
+            {
+                renderedLastBlock[slot] = false;
                 continue;
+            }
 
-            const auto emitterData = scene.getSlot (slotIdx).read();
+            auto emitterData = scene.getSlot (slotIdx).read();
             if (! emitterData.active || emitterData.muted)
+            {
+                renderedLastBlock[slot] = false;
                 continue;
+            }
+
+            // Pan, distance and Doppler ramp from where this slot ended the
+            // previous block; a slot seen for the first time starts at rest.
+            Vec3 blockStart = renderedLastBlock[slot] ? renderedEndPositions[slot] : emitterData.position;
+            if (applyChoreography (slotIdx, emitterData, blockStart, numSamples))
+                ++choreographedEmitterCount;
+
+            renderedEndPositions[slot] = emitterData.position;
+            renderedLastBlock[slot] = true;
 
             const float emitterGainLinear = juce::Decibels::decibelsToGain (emitterData.gain, -60.0f);
             if (! std::isfinite (emitterGainLinear) || emitterGainLinear <= 0.0f)
@@ -1187,12 +1421,12 @@ public:
             EmitterCandidate candidate;
             candidate.slotIdx = slotIdx;
             candidate.data = emitterData;
-            candidate.distance = distance;
+            candidate.blockStart = blockStart;
             candidate.distanceGain = distanceGain;
             candidate.emitterGainLinear = emitterGainLinear;
             candidate.priority = priority;
 
-            if (selectedEmitterCount < MAX_RENDER_EMITTERS_PER_BLOCK)
+            if (selectedEmitterCount < emitterBudget)
             {
                 selectedEmitters[static_cast<size_t> (selectedEmitterCount)] = candidate;
                 ++selectedEmitterCount;
@@ -1268,63 +1502,103 @@ public:
                 emitterDoppler[static_cast<size_t> (slotIdx)].processBlock (
                     tempMonoBuffer.data(),
                     samplesToProcess,
+                    candidate.blockStart,
                     candidate.data.position,
                     candidate.data.velocity,
                     dopplerEnabled);
             }
 
-            // Apply air absorption (distance-driven LPF)
+            // Pan, distance and absorption follow the block's trajectory keys
+            // (one key at the end position for a stationary emitter).
+            const Vec3 trajectoryStart = slotIdx < MAX_TRACKED_EMITTERS ? candidate.blockStart : candidate.data.position;
+
+            // Apply air absorption (distance-driven LPF or ISO 9613-1 shelving cascade)
             if (airAbsorptionEnabled && slotIdx < MAX_TRACKED_EMITTERS)
             {
-                emitterAbsorption[static_cast<size_t> (slotIdx)].updateForDistance (candidate.distance);
-                emitterAbsorption[static_cast<size_t> (slotIdx)].processBlock (tempMonoBuffer.data(), samplesToProcess);
+                auto& absorption = emitterAbsorption[static_cast<size_t> (slotIdx)];
+                const bool useIsoTable = airAbsorptionModel == AirAbsorption::Model::Iso9613 && activeAirAbsorptionTable != nullptr;
+                forEachEmitterTrajectoryKey (trajectoryStart, candidate.data.position, samplesToProcess,
+                                             [&] (const Vec3& keyPosition, int segmentStart, int segmentLength)
+                                             {
+                                                 const float keyDistance = calculateDistance (keyPosition);
+                                                 if (useIsoTable)
+                                                     absorption.updateForDistance (keyDistance, *activeAirAbsorptionTable);
+                                                 else
+                                                     absorption.updateForDistance (keyDistance);
+                                                 absorption.processBlock (tempMonoBuffer.data() + segmentStart, segmentLength);
+                                             });
             }
 
-            // Calculate VBAP gains for this emitter's position
-            const float azimuth = calculateAzimuth (candidate.data.position);
-            const float elevation = calculateElevation (candidate.data.position);
-            auto panGains = vbapPanner.calculateGains (azimuth, elevation);
-            auto speakerGains = panGains.gains;
-
-            // Spread (focused -> diffuse blend)
-            spreadProcessor.apply (speakerGains, candidate.data.spread);
-
-            // Directivity shaping (speaker-dependent pattern from emitter aim)
-            directivityFilter.apply (speakerGains,
-                                     candidate.data.directivity,
-                                     candidate.data.directivityAim,
-                                     candidate.data.position);
-
-            // Update smoothed speaker gains for this emitter
-            if (slotIdx < MAX_TRACKED_EMITTERS)
+            if (isEmitterMovingThisBlock (trajectoryStart, candidate.data.position))
             {
-                for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
-                {
-                    smoothedSpeakerGains[static_cast<size_t> (slotIdx)][static_cast<size_t> (spk)].setTargetValue (
-                        speakerGains[static_cast<size_t> (spk)] * candidate.distanceGain);
-                }
+                // Moving emitter: ramp pan/distance gains along the block's trajectory.
+                accumulateEmitterAlongTrajectory (slotIdx, candidate.data, trajectoryStart, samplesToProcess);
             }
-
-            // Accumulate into speaker channels with per-sample gain smoothing
-            for (int i = 0; i < samplesToProcess; ++i)
+            else
             {
-                const float sample = tempMonoBuffer[static_cast<size_t> (i)];
+                // Calculate VBAP gains for this emitter's position
+                auto speakerGains = vbapPanner.calculateGains (calculateAzimuth (candidate.data.position),
+                                                               calculateElevation (candidate.data.position)).gains;
 
-                for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+                // Spread (focused -> diffuse blend)
+                spreadProcessor.apply (speakerGains, candidate.data.spread);
+
+                // Directivity shaping (speaker-dependent pattern from emitter aim)
+                directivityFilter.apply (speakerGains,
+                                         candidate.data.directivity,
+                                         candidate.data.directivityAim,
+                                         candidate.data.position);
+
+                // Update smoothed speaker gains for this emitter
+                if (slotIdx < MAX_TRACKED_EMITTERS)
                 {
-                    float gain;
-                    if (slotIdx < MAX_TRACKED_EMITTERS)
+                    for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
                     {
-                        gain = smoothedSpeakerGains[static_cast<size_t> (slotIdx)][static_cast<size_t> (spk)].getNextValue();
+                        smoothedSpeakerGains[static_cast<size_t> (slotIdx)][static_cast<size_t> (spk)].setTargetValue (
+                            speakerGains[static_cast<size_t> (spk)] * candidate.distanceGain);
                     }
-                    else
+                }
+
+                // Accumulate into speaker channels with per-sample gain smoothing
+                for (int i = 0; i < samplesToProcess; ++i)
+                {
+                    const float sample = tempMonoBuffer[static_cast<size_t> (i)];
+
+                    for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
                     {
-                        gain = speakerGains[static_cast<size_t> (spk)] * candidate.distanceGain;
+                        float gain;
+                        if (slotIdx < MAX_TRACKED_EMITTERS)
+                        {
+                            gain = smoothedSpeakerGains[static_cast<size_t> (slotIdx)][static_cast<size_t> (spk)].getNextValue();
+                        }
+                        else
+                        {
+                            gain = speakerGains[static_cast<size_t> (spk)] * candidate.distanceGain;
+                        }
+
+                        accumBuffer.addSample (spk, i, sample * gain);
                     }
-
-                    accumBuffer.addSample (spk, i, sample * gain);
                 }
             }
+
+            if (ambisonicBusOrder > 0)
+            {
+                encodeEmitterToAmbisonicBus (slotIdx,
+                                             candidate.data,
+                                             trajectoryStart,
+                                             samplesToProcess,
+                                             ambisonicBusOrder,
+                                             ambisonicBusNormalization);
+            }
+
+            if (bedRenderActive)
+            {
+                panEmitterToBed (slotIdx,
+                                 candidate.data,
+                                 trajectoryStart,
+                                 samplesToProcess,
+                                 bedLayout);
+            }
         }
 
         bool renderedAuditionEmitter = false;
@@ -1343,45 +1617,83 @@ public:
 
         lastEligibleEmitterCount.store (eligibleEmitterCount, std::memory_order_relaxed);
         lastProcessedEmitterCount.store (processedEmitterCount, std::memory_order_relaxed);
+        lastChoreographedEmitterCount.store (choreographedEmitterCount, std::memory_order_relaxed);
         lastBudgetCulledEmitterCount.store (budgetCulledEmitterCount, std::memory_order_relaxed);
         lastActivityCulledEmitterCount.store (activityCulledEmitterCount, std::memory_order_relaxed);
-        lastGuardrailActive.store (eligibleEmitterCount > MAX_RENDER_EMITTERS_PER_BLOCK, std::memory_order_relaxed);
+        lastGuardrailActive.store (eligibleEmitterCount > emitterBudget, std::memory_order_relaxed);
+
+        const bool ambisonicRoomResidual = ambisonicBusOrder > 0 && roomEnabled && ! renderedAuditionEmitter;
+        if (ambisonicRoomResidual)
+        {
+            for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+                ambisonicRoomDry.copyFrom (spk, 0, accumBuffer, spk, 0, numSamples);
+        }
 
-        // Room acoustics chain (Phase 2.5)
-        if (roomEnabled)
+        // The internal audition emitter only renders into the quad bed.
+        if (bedRenderActive && renderedAuditionEmitter)
+            addQuadProxyToBed (numSamples, bedLayout);
+
+        // Room acoustics chain (Phase 2.5); on the AtmosBed bus the late field
+        // is shared through the bed channels' quad zones.
+        if (roomEnabled && bedRenderActive)
+        {
+            earlyReflections.process (bedBuffer, bedChannels);
+            if (! earlyReflectionsOnly)
+                fdnReverb.process (bedBuffer, bedZones, bedChannels);
+        }
+        else if (roomEnabled)
         {
             earlyReflections.process (accumBuffer);
             if (! earlyReflectionsOnly)
                 fdnReverb.process (accumBuffer);
         }
 
-        // Apply per-speaker delay compensation and gain trims
-        for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+        bool ambisonicMonitorRenderedThisBlock = false;
+        if (ambisonicBusOrder > 0)
         {
-            auto* channelData = accumBuffer.getWritePointer (spk);
-            const int delay = speakerDelaySamples[static_cast<size_t> (spk)];
+            // The room chain runs on the quad bed; its contribution (wet minus dry)
+            // joins the bus as a first-order proxy. The internal audition emitter
+            // only renders into the quad bed, so it is proxied as a whole.
+            if (renderedAuditionEmitter)
+                addQuadProxyToAmbisonicBus (nullptr, numSamples, ambisonicBusNormalization);
+            else if (ambisonicRoomResidual)
+                addQuadProxyToAmbisonicBus (&ambisonicRoomDry, numSamples, ambisonicBusNormalization);
 
-            if (delay > 0)
-            {
-                for (int i = 0; i < numSamples; ++i)
-                {
-                    speakerDelayLines[static_cast<size_t> (spk)][static_cast<size_t> (delayWritePos[static_cast<size_t> (spk)])] = channelData[i];
+            applyAmbisonicHeadRotation (ambisonicBusChannels, numSamples);
 
-                    int readPos = delayWritePos[static_cast<size_t> (spk)] - delay;
-                    if (readPos < 0)
-                        readPos += MAX_DELAY_SAMPLES;
+            if (ambisonicMonitorActive)
+            {
+                std::array<const float*, locusq::ambisonic_encoder::kMaxChannels> busPtrs {};
+                for (int ch = 0; ch < ambisonicBusChannels; ++ch)
+                    busPtrs[static_cast<size_t> (ch)] = ambisonicBus.getReadPointer (ch);
+
+                ambisonicBinauralDecoder.process (busPtrs.data(),
+                                                  ambisonicBusChannels,
+                                                  numSamples,
+                                                  ambisonicMonitorLeft.data(),
+                                                  ambisonicMonitorRight.data());
+                ambisonicMonitorRenderedThisBlock = true;
+            }
+        }
 
-                    channelData[i] = speakerDelayLines[static_cast<size_t> (spk)][static_cast<size_t> (readPos)];
-                    delayWritePos[static_cast<size_t> (spk)] = (delayWritePos[static_cast<size_t> (spk)] + 1) % MAX_DELAY_SAMPLES;
-                }
+        // Apply per-speaker delay compensation and gain trims
+        if (bedRenderActive)
+        {
+            for (int ch = 0; ch < bedChannels; ++ch)
+            {
+                const int zone = bedZones[static_cast<size_t> (ch)];
+                if (zone != locusq::bed_panner::kNoZone)
+                    smoothedBedChannelTrim[static_cast<size_t> (ch)].setTargetValue (
+                        smoothedSpeakerTrim[static_cast<size_t> (zone)].getTargetValue());
             }
 
-            for (int i = 0; i < numSamples; ++i)
-                channelData[i] *= smoothedSpeakerTrim[static_cast<size_t> (spk)].getNextValue();
+            applySpeakerDelayAndTrim (bedBuffer, bedChannels, bedZones, smoothedBedChannelTrim.data(), numSamples);
+        }
+        else
+        {
+            applySpeakerDelayAndTrim (accumBuffer, NUM_SPEAKERS, kQuadSpeakerZones, smoothedSpeakerTrim.data(), numSamples);
         }
 
-        const auto profileResolution = resolveSpatialProfileForHost (numOutputChannels);
-        const auto activeSpatialProfile = profileResolution.profile;
         activeSpatialProfileIndex.store (static_cast<int> (activeSpatialProfile), std::memory_order_relaxed);
         activeSpatialStageIndex.store (static_cast<int> (profileResolution.stage), std::memory_order_relaxed);
 
@@ -1395,12 +1707,16 @@ public:
         headPoseInternalBinauralActive = profileAllowsHeadphoneRender
                                          && numOutputChannels >= 2
                                          && numOutputChannels < NUM_SPEAKERS;
-        auto activeHeadphoneMode = (requestedHeadphoneMode == HeadphoneRenderMode::SteamBinaural
-                                    && profileAllowsHeadphoneRender
-                                    && numOutputChannels >= 2
-                                    && steamBackendAvailable)
-                                       ? HeadphoneRenderMode::SteamBinaural
-                                       : HeadphoneRenderMode::StereoDownmix;
+        const bool binauralRequestServable = requestedHeadphoneMode == HeadphoneRenderMode::SteamBinaural
+                                             && profileAllowsHeadphoneRender
+                                             && numOutputChannels >= 2;
+        auto activeHeadphoneMode = HeadphoneRenderMode::StereoDownmix;
+        if (binauralRequestServable && steamBackendAvailable)
+            activeHeadphoneMode = HeadphoneRenderMode::SteamBinaural;
+        else if (binauralRequestServable)
+            activeHeadphoneMode = HeadphoneRenderMode::NativeHrtfBinaural;
+        if (ambisonicMonitorRenderedThisBlock)
+            activeHeadphoneMode = HeadphoneRenderMode::AmbisonicBinaural;
         const auto activeHeadphoneProfile = (numOutputChannels >= 2)
                                                 ? requestedHeadphoneProfile
                                                 : HeadphoneDeviceProfile::Generic;
@@ -1436,6 +1752,17 @@ public:
         if (activeHeadphoneMode == HeadphoneRenderMode::SteamBinaural && ! steamRenderedThisBlock)
             activeHeadphoneMode = HeadphoneRenderMode::StereoDownmix;
 
+        const bool nativeBinauralRenderedThisBlock = activeHeadphoneMode == HeadphoneRenderMode::NativeHrtfBinaural
+                                                     && renderNativeBinauralBlock (numSamples);
+
+        if (activeHeadphoneMode == HeadphoneRenderMode::NativeHrtfBinaural && ! nativeBinauralRenderedThisBlock)
+            activeHeadphoneMode = HeadphoneRenderMode::StereoDownmix;
+
+        nativeBinauralLatencySamples.store (nativeBinauralRenderedThisBlock
+                                                ? nativeBinauralRenderer.getLatencySamples()
+                                                : (ambisonicMonitorRenderedThisBlock ? ambisonicBinauralDecoder.getLatencySamples() : 0),
+                                            std::memory_order_relaxed);
+
         activeHeadphoneModeIndex.store (static_cast<int> (activeHeadphoneMode), std::memory_order_relaxed);
         activeHeadphoneProfileIndex.store (activeHeadphoneProfileIndexValue, std::memory_order_relaxed);
         steamAudioAvailable.store (steamBackendAvailable, std::memory_order_relaxed);
@@ -1446,12 +1773,17 @@ public:
         const auto requestedSpatialProfile = static_cast<SpatialOutputProfile> (requestedSpatialProfileIndexValue);
         const int requestedAmbisonicOrder = ambisonicOrderForProfile (requestedSpatialProfile);
         const int activeAmbisonicOrder = ambisonicOrderForProfile (activeSpatialProfile);
-        const int contractAmbisonicOrder = requestedAmbisonicOrder > 0 ? requestedAmbisonicOrder
-                                                                        : activeAmbisonicOrder;
+        // When the direct encoder runs, report the order the bus actually carries.
+        const int contractAmbisonicOrder = ambisonicEncodeOrder > 0
+                                               ? ambisonicEncodeOrder
+                                               : (requestedAmbisonicOrder > 0 ? requestedAmbisonicOrder
+                                                                              : activeAmbisonicOrder);
         const int contractChannelCount = contractAmbisonicOrder > 0
                                              ? (contractAmbisonicOrder + 1) * (contractAmbisonicOrder + 1)
                                              : 0;
-        const bool contractFallbackActive = requestedAmbisonicOrder > 0 && activeAmbisonicOrder == 0;
+        const bool contractFallbackActive = requestedAmbisonicOrder > 0
+                                            && (activeAmbisonicOrder == 0
+                                                || (ambisonicEncodeOrder > 0 && ambisonicEncodeOrder < requestedAmbisonicOrder));
         const auto contractTimestampSamples = ambisonicIrSampleCursor.fetch_add (
             static_cast<std::uint64_t> (juce::jmax (0, numSamples)),
             std::memory_order_relaxed);
@@ -1459,7 +1791,7 @@ public:
         ambisonicIrTimestampSamples.store (contractTimestampSamples, std::memory_order_relaxed);
         ambisonicIrOrder.store (contractAmbisonicOrder, std::memory_order_relaxed);
         ambisonicIrNormalizationIndex.store (
-            static_cast<int> (AmbisonicNormalization::SN3D),
+            static_cast<int> (ambisonicNormalization),
             std::memory_order_relaxed);
         ambisonicIrChannelCount.store (contractChannelCount, std::memory_order_relaxed);
         ambisonicIrHeadphoneRenderAllowed.store (profileAllowsHeadphoneRender, std::memory_order_relaxed);
@@ -1567,10 +1899,10 @@ public:
                 std::memory_order_relaxed);
         }
 
-        double auditionReactiveHeadphoneEnergy = 0.0;
-        double auditionReactiveHeadphoneReferenceEnergy = 0.0;
-        float auditionReactiveHeadphonePeak = 0.0f;
-        bool auditionReactiveHeadphoneSamplesCaptured = false;
+        // Object export: per-emitter stems + metadata, memcpy-only on this thread.
+        if (codecMode != CodecMappingMode::None)
+            objectExportStage.capture (scene, numSamples);
+
         int auditionReactiveHeadphoneFallbackReasonIndex = static_cast<int> (
             AuditionReactiveHeadphoneFallbackReason::None);
         if (renderedAuditionEmitter && requestedHeadphoneMode == HeadphoneRenderMode::SteamBinaural)
@@ -1580,173 +1912,69 @@ public:
                 auditionReactiveHeadphoneFallbackReasonIndex = static_cast<int> (
                     AuditionReactiveHeadphoneFallbackReason::OutputIncompatible);
             }
-            else if (! steamBackendAvailable)
+            else if (! steamBackendAvailable && ! nativeBinauralRenderedThisBlock && ! ambisonicMonitorRenderedThisBlock)
             {
                 auditionReactiveHeadphoneFallbackReasonIndex = static_cast<int> (
                     AuditionReactiveHeadphoneFallbackReason::SteamUnavailable);
             }
-            else if (! steamRenderedThisBlock || activeHeadphoneMode != HeadphoneRenderMode::SteamBinaural)
+            else if (steamBackendAvailable
+                     && (! steamRenderedThisBlock || activeHeadphoneMode != HeadphoneRenderMode::SteamBinaural))
             {
                 auditionReactiveHeadphoneFallbackReasonIndex = static_cast<int> (
                     AuditionReactiveHeadphoneFallbackReason::SteamRenderFailed);
             }
         }
 
-        // Apply master gain and write to output
-        for (int i = 0; i < numSamples; ++i)
+        // Output stage: one block writer per layout, picked once per block from
+        // outputBlockWriters. Writers apply the master-gain ramp with vector ops.
+        OutputBlockContext outputContext;
+        outputContext.spatialProfile = activeSpatialProfile;
+        outputContext.ambisonicChannels = ambisonicEncodeChannels;
+        outputContext.bedChannels = bedChannels;
+        outputContext.measureAuditionHeadphone = renderedAuditionEmitter;
+        if (steamRenderedThisBlock && activeHeadphoneMode == HeadphoneRenderMode::SteamBinaural)
         {
-            const float masterGain = smoothedMasterGain.getNextValue();
-
-            if (numOutputChannels >= 13
-                && (activeSpatialProfile == SpatialOutputProfile::Surround742
-                    || activeSpatialProfile == SpatialOutputProfile::AtmosBed))
-            {
-                writeSurround742Sample (outputBuffer, i, masterGain);
-                continue;
-            }
-
-            if (numOutputChannels >= 10 && activeSpatialProfile == SpatialOutputProfile::Surround721)
-            {
-                writeSurround721Sample (outputBuffer, i, masterGain);
-                continue;
-            }
-
-            if (numOutputChannels >= 8 && activeSpatialProfile == SpatialOutputProfile::Surround521)
-            {
-                writeSurround521Sample (outputBuffer, i, masterGain);
-                continue;
-            }
-
-            if (numOutputChannels >= 4
-                && (activeSpatialProfile == SpatialOutputProfile::AmbisonicFOA
-                    || activeSpatialProfile == SpatialOutputProfile::AmbisonicHOA))
-            {
-                const float fl = accumBuffer.getSample (0, i);
-                const float fr = accumBuffer.getSample (1, i);
-                const float rr = accumBuffer.getSample (2, i);
-                const float rl = accumBuffer.getSample (3, i);
-                float w = 0.0f;
-                float x = 0.0f;
-                float y = 0.0f;
-                float z = 0.0f;
-                encodeAmbisonicFoaProxyFromQuad (fl, fr, rr, rl, w, x, y, z);
-                outputBuffer.setSample (0, i, w * masterGain);
-                outputBuffer.setSample (1, i, x * masterGain);
-                outputBuffer.setSample (2, i, y * masterGain);
-                outputBuffer.setSample (3, i, z * masterGain);
-                for (int ch = 4; ch < numOutputChannels; ++ch)
-                    outputBuffer.setSample (ch, i, 0.0f);
-                continue;
-            }
+            outputContext.binauralLeft = steamBinauralLeft.data();
+            outputContext.binauralRight = steamBinauralRight.data();
+        }
+        else if (nativeBinauralRenderedThisBlock)
+        {
+            outputContext.binauralLeft = nativeBinauralLeft.data();
+            outputContext.binauralRight = nativeBinauralRight.data();
+        }
+        else if (ambisonicMonitorRenderedThisBlock)
+        {
+            outputContext.binauralLeft = ambisonicMonitorLeft.data();
+            outputContext.binauralRight = ambisonicMonitorRight.data();
+        }
 
-            if (numOutputChannels >= NUM_SPEAKERS)
-            {
-                // Quad output: explicit host order FL, FR, RL, RR.
-                for (int outCh = 0; outCh < NUM_SPEAKERS; ++outCh)
-                {
-                    const int speakerIdx = kQuadOutputSpeakerOrder[static_cast<size_t> (outCh)];
-                    outputBuffer.setSample (outCh, i, accumBuffer.getSample (speakerIdx, i) * masterGain);
-                }
+        auto writerKind = selectOutputBlockWriter (activeSpatialProfile, numOutputChannels, ambisonicEncodeOrder, bedChannels);
+        if (numSamples > static_cast<int> (masterGainRamp.size()))
+            writerKind = OutputBlockWriterKind::Silent; // larger than prepared; nothing below is sized for it
+        else
+            outputContext.masterGain = fillMasterGainRamp (numSamples);
 
-                for (int outCh = NUM_SPEAKERS; outCh < numOutputChannels; ++outCh)
-                    outputBuffer.setSample (outCh, i, 0.0f);
-                continue;
-            }
+        const auto writer = outputBlockWriters[static_cast<size_t> (writerKind)];
+        (this->*writer) (outputBuffer, numSamples, outputContext);
 
-            if (numOutputChannels >= 2)
-            {
-                float left = 0.0f;
-                float right = 0.0f;
-                float referenceLeft = 0.0f;
-                float referenceRight = 0.0f;
-                bool referenceCaptured = false;
-
-                if (steamRenderedThisBlock && activeHeadphoneMode == HeadphoneRenderMode::SteamBinaural)
-                {
-                    left = steamBinauralLeft[static_cast<size_t> (i)];
-                    right = steamBinauralRight[static_cast<size_t> (i)];
-                    renderStereoDownmixSample (i, referenceLeft, referenceRight);
-                    referenceCaptured = true;
-                }
-                else if (activeSpatialProfile == SpatialOutputProfile::Virtual3dStereo)
-                {
-                    renderVirtual3dStereoSample (i, left, right);
-                }
-                else if (activeSpatialProfile == SpatialOutputProfile::AmbisonicFOA
-                         || activeSpatialProfile == SpatialOutputProfile::AmbisonicHOA)
-                {
-                    float fl = 0.0f;
-                    float fr = 0.0f;
-                    float rr = 0.0f;
-                    float rl = 0.0f;
-                    getHeadPoseAdjustedQuadSample (i, fl, fr, rr, rl);
-                    float w = 0.0f;
-                    float x = 0.0f;
-                    float y = 0.0f;
-                    float z = 0.0f;
-                    encodeAmbisonicFoaProxyFromQuad (fl, fr, rr, rl, w, x, y, z);
-                    decodeAmbisonicFoaProxyToStereo (w, x, y, z, left, right);
-                }
-                else
-                {
-                    renderStereoDownmixSample (i, left, right);
-                }
-
-                if (renderedAuditionEmitter)
-                {
-                    const auto mono = 0.5f * (left + right);
-                    auditionReactiveHeadphoneEnergy += static_cast<double> (mono * mono);
-                    auditionReactiveHeadphonePeak = juce::jmax (
-                        auditionReactiveHeadphonePeak,
-                        juce::jmax (std::abs (left), std::abs (right)));
-
-                    if (referenceCaptured)
-                    {
-                        const auto referenceMono = 0.5f * (referenceLeft + referenceRight);
-                        auditionReactiveHeadphoneReferenceEnergy += static_cast<double> (referenceMono * referenceMono);
-                    }
-                    else
-                    {
-                        auditionReactiveHeadphoneReferenceEnergy += static_cast<double> (mono * mono);
-                    }
-
-                    auditionReactiveHeadphoneSamplesCaptured = true;
-                }
-
-                applyHeadphoneProfileCompensation (left, right);
-                headphoneCalibrationChain.processStereoSample (left, right);
-                outputBuffer.setSample (0, i, left * masterGain);
-                outputBuffer.setSample (1, i, right * masterGain);
-                continue;
-            }
-
-            if (numOutputChannels == 1)
-            {
-                float mono = 0.0f;
-                for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
-                    mono += accumBuffer.getSample (spk, i);
-                outputBuffer.setSample (0, i, mono * 0.5f * masterGain);
-            }
-        }
-
-        if (renderedAuditionEmitter && auditionReactiveHeadphoneSamplesCaptured && numSamples > 0)
-        {
-            const auto invNumSamples = 1.0f / static_cast<float> (numSamples);
-            const auto headphoneOutputRms = juce::jlimit (
-                0.0f,
-                2.0f,
-                std::sqrt (static_cast<float> (auditionReactiveHeadphoneEnergy * static_cast<double> (invNumSamples))));
-            const auto headphoneReferenceRms = juce::jlimit (
-                0.0f,
-                2.0f,
-                std::sqrt (static_cast<float> (auditionReactiveHeadphoneReferenceEnergy * static_cast<double> (invNumSamples))));
-            const auto headphoneParity = headphoneOutputRms > 1.0e-6f
-                ? juce::jlimit (0.5f, 2.0f, headphoneReferenceRms / headphoneOutputRms)
-                : 1.0f;
+        if (renderedAuditionEmitter && outputContext.auditionHeadphoneSamplesCaptured && numSamples > 0)
+        {
+            const auto invNumSamples = 1.0f / static_cast<float> (numSamples);
+            const auto headphoneOutputRms = juce::jlimit (
+                0.0f,
+                2.0f,
+                std::sqrt (static_cast<float> (outputContext.auditionHeadphoneEnergy * static_cast<double> (invNumSamples))));
+            const auto headphoneReferenceRms = juce::jlimit (
+                0.0f,
+                2.0f,
+                std::sqrt (static_cast<float> (outputContext.auditionHeadphoneReferenceEnergy * static_cast<double> (invNumSamples))));
+            const auto headphoneParity = headphoneOutputRms > 1.0e-6f
+                ? juce::jlimit (0.5f, 2.0f, headphoneReferenceRms / headphoneOutputRms)
+                : 1.0f;
 
             applyAuditionReactiveHeadphoneParity (
                 headphoneOutputRms,
-                auditionReactiveHeadphonePeak,
+                outputContext.auditionHeadphonePeak,
                 headphoneParity,
                 auditionReactiveHeadphoneFallbackReasonIndex);
         }
@@ -1770,6 +1998,11 @@ public:
         return lastProcessedEmitterCount.load (std::memory_order_relaxed);
     }
 
+    int getLastChoreographedEmitterCount() const noexcept
+    {
+        return lastChoreographedEmitterCount.load (std::memory_order_relaxed);
+    }
+
     int getLastBudgetCulledEmitterCount() const noexcept
     {
         return lastBudgetCulledEmitterCount.load (std::memory_order_relaxed);
@@ -1879,6 +2112,39 @@ public:
     }
 
 private:
+    // Entries of outputBlockWriters, in this order.
+    enum class OutputBlockWriterKind : int
+    {
+        Silent = 0,
+        Mono,
+        Stereo,
+        Quad,
+        Ambisonic,
+        Surround521,
+        Surround721,
+        Surround742,
+        AtmosBed,
+        NumKinds
+    };
+
+    struct OutputBlockContext
+    {
+        const float* masterGain = nullptr; // per-sample ramp, numSamples long
+        SpatialOutputProfile spatialProfile = SpatialOutputProfile::Auto;
+        int ambisonicChannels = 0;
+        int bedChannels = 0; // AtmosBed bus width when the bed renderer ran, else 0
+        const float* binauralLeft = nullptr; // Steam / native HRTF / ambisonic monitoring render, if one ran
+        const float* binauralRight = nullptr;
+        bool measureAuditionHeadphone = false;
+        double auditionHeadphoneEnergy = 0.0;
+        double auditionHeadphoneReferenceEnergy = 0.0;
+        float auditionHeadphonePeak = 0.0f;
+        bool auditionHeadphoneSamplesCaptured = false;
+    };
+
+    using OutputBlockWriter = void (SpatialRenderer::*) (juce::AudioBuffer<float>&, int, OutputBlockContext&) noexcept;
+    using QuadToStereoMatrix = std::array<std::array<float, NUM_SPEAKERS>, 2>; // rows L, R; columns FL, FR, RR, RL
+
     static float sanitizeUnitScalar (float value, float fallback = 0.0f) noexcept
     {
         if (! std::isfinite (value))
@@ -1905,6 +2171,11 @@ private:
     static constexpr float ACTIVITY_PEAK_GATE_LINEAR = 1.0e-6f;   // ~ -120 dB
     static constexpr int AUDITION_MAX_VOICES = MAX_AUDITION_REACTIVE_SOURCES;
     static constexpr int AUDITION_HISTORY_BUFFER_SAMPLES = 8192;
+    static constexpr int AMBISONIC_ROTATION_SUB_BLOCK = 32; // SH rotation matrix update interval
+    static constexpr int EMITTER_TRAJECTORY_SUB_BLOCK = 64; // pan/distance key spacing for moving emitters
+    static constexpr int MAX_EMITTER_TRAJECTORY_KEYS = 32;
+    static constexpr float EMITTER_TRAJECTORY_MIN_TRAVEL_M = 1.0e-4f;
+    static constexpr float CHOREOGRAPHY_MAX_SPEED_MPS = 100.0f; // faster per-block moves are treated as jumps
 
     double currentSampleRate = 44100.0;
     int currentBlockSize = 512;
@@ -1917,25 +2188,52 @@ private:
 
     // Per-emitter air absorption filters
     std::array<AirAbsorption, MAX_TRACKED_EMITTERS> emitterAbsorption;
+    AirAbsorptionIsoTablePublisher airAbsorptionTablePublisher;
+    std::shared_ptr<const AirAbsorptionIsoTable> activeAirAbsorptionTable; // audio thread
     std::array<DopplerProcessor, MAX_TRACKED_EMITTERS> emitterDoppler;
 
     // Per-emitter smoothed speaker gains (for click-safe panning)
     std::array<std::array<juce::SmoothedValue<float>, NUM_SPEAKERS>, MAX_TRACKED_EMITTERS> smoothedSpeakerGains;
+
+    // Direct ambisonic encode state (FOA/HOA profiles on >= 4 channel hosts).
+    locusq::ambisonic_encoder::SphericalHarmonicLut ambisonicShLut;
+    locusq::ambisonic_encoder::ShRotator ambisonicRotator;
+    juce::AudioBuffer<float> ambisonicBus;
+    juce::AudioBuffer<float> ambisonicScratch;
+    juce::AudioBuffer<float> ambisonicRoomDry;
+    std::array<locusq::ambisonic_encoder::ShCoefficients, MAX_TRACKED_EMITTERS> ambisonicEmitterGains {};
+    std::array<std::uint64_t, MAX_TRACKED_EMITTERS> ambisonicEmitterLastBlock {};
+    std::uint64_t ambisonicBlockCounter = 0;
+    bool ambisonicRotationActive = false;
+    std::array<float, 4> ambisonicRotationQuat { 0.0f, 0.0f, 0.0f, 1.0f }; // x, y, z, w at the end of the last block
+    std::atomic<int> requestedAmbisonicNormalizationIndex { static_cast<int> (AmbisonicNormalization::SN3D) };
     std::array<std::array<juce::SmoothedValue<float>, NUM_SPEAKERS>, AUDITION_MAX_VOICES> auditionSmoothedSpeakerGains;
 
-    // Speaker delay lines
-    std::array<std::vector<float>, NUM_SPEAKERS> speakerDelayLines;
-    std::array<int, NUM_SPEAKERS> delayWritePos {};
+    // AtmosBed bus: emitters panned straight onto the 7.1.4 / 9.1.6 bed.
+    const locusq::bed_panner::BedVbapLut bed714Lut { locusq::bed_panner::BedLayout::Bed714 };
+    const locusq::bed_panner::BedVbapLut bed916Lut { locusq::bed_panner::BedLayout::Bed916 };
+    juce::AudioBuffer<float> bedBuffer;
+    std::array<locusq::bed_panner::BedGains, MAX_TRACKED_EMITTERS> bedEmitterGains {};
+    std::array<std::uint64_t, MAX_TRACKED_EMITTERS> bedEmitterLastBlock {};
+    std::uint64_t bedBlockCounter = 0;
+
+    // Delay lines and trims run per output channel (quad bed or AtmosBed bus);
+    // calibration delays/trims are per quad speaker and bed channels inherit
+    // their zone's values.
+    std::array<std::vector<float>, MAX_BED_CHANNELS> speakerDelayLines;
+    std::array<int, MAX_BED_CHANNELS> delayWritePos {};
     std::array<int, NUM_SPEAKERS> speakerDelaySamples {};
 
-    // Speaker trim gains
+    // Speaker trim gains, plus the per-channel ramps the AtmosBed bus follows them with
     std::array<juce::SmoothedValue<float>, NUM_SPEAKERS> smoothedSpeakerTrim;
+    std::array<juce::SmoothedValue<float>, MAX_BED_CHANNELS> smoothedBedChannelTrim;
 
     // Master gain
     juce::SmoothedValue<float> smoothedMasterGain { 1.0f };
 
     // Air absorption toggle
     bool airAbsorptionEnabled = true;
+    AirAbsorption::Model airAbsorptionModel = AirAbsorption::Model::Simple;
     bool dopplerEnabled = false;
     float dopplerScale = 1.0f;
     bool qualityHigh = false;
@@ -2080,6 +2378,8 @@ private:
     // Temp buffer for mono downmix of emitter audio
     std::vector<float> tempMonoBuffer;
 
+    std::atomic<int> renderEmitterBudget { MAX_RENDER_EMITTERS_PER_BLOCK };
+
     // Per-block guardrail stats (read on non-audio threads for diagnostics/UI).
     std::atomic<int> lastEligibleEmitterCount { 0 };
     std::atomic<int> lastProcessedEmitterCount { 0 };
@@ -2136,6 +2436,7 @@ private:
     std::atomic<int> codecIamfPayloadElementCount { 0 };
     std::atomic<float> codecIamfPayloadSceneGain { 0.0f };
     std::array<std::atomic<float>, 2> codecIamfPayloadElementGain {};
+    locusq::object_export::ObjectExportStage objectExportStage;
     std::atomic<bool> steamAudioAvailable { false };
     std::atomic<int> steamInitStageIndex { static_cast<int> (SteamInitStage::NotCompiled) };
     std::atomic<int> steamInitErrorCode { 0 };
@@ -2146,6 +2447,26 @@ private:
     // Steam Audio scratch/output buffers reused each block.
     std::vector<float> steamBinauralLeft;
     std::vector<float> steamBinauralRight;
+    std::vector<float> nativeBinauralLeft;
+    std::vector<float> nativeBinauralRight;
+    locusq::dsp::HrtfBinauralRenderer nativeBinauralRenderer;
+    std::atomic<int> nativeBinauralLatencySamples { 0 };
+    std::vector<float> ambisonicMonitorLeft;
+    std::vector<float> ambisonicMonitorRight;
+    locusq::dsp::AmbisonicBinauralDecoder ambisonicBinauralDecoder;
+    std::atomic<bool> requestedAmbisonicMonitoring { false };
+    std::vector<float> masterGainRamp; // per-sample master gain, filled once per block for the output writers
+    const std::array<OutputBlockWriter, static_cast<size_t> (OutputBlockWriterKind::NumKinds)> outputBlockWriters {
+        &SpatialRenderer::writeSilentBlock,
+        &SpatialRenderer::writeMonoBlock,
+        &SpatialRenderer::writeStereoBlock,
+        &SpatialRenderer::writeQuadBlock,
+        &SpatialRenderer::writeAmbisonicBlock,
+        &SpatialRenderer::writeSurround521Block,
+        &SpatialRenderer::writeSurround721Block,
+        &SpatialRenderer::writeSurround742Block,
+        &SpatialRenderer::writeAtmosBedBlock
+    };
     std::array<std::vector<float>, NUM_SPEAKERS> headPoseRotatedQuadScratch;
     std::array<std::vector<float>, NUM_SPEAKERS> monitoringHeadPoseRotatedQuadScratch_;
     std::array<std::array<float, NUM_SPEAKERS>, NUM_SPEAKERS> headPoseSpeakerMix {};
@@ -2154,6 +2475,43 @@ private:
     ListenerOrientation headPoseOrientation {};
     bool headPoseValid = false;
     bool headPoseInternalBinauralActive = false;
+    // Key 0 is where the previous block ended; keys 1..count-1 come from the
+    // last applyHeadPoseTrajectory()/applyHeadPose() call.
+    std::array<std::array<float, 4>, MAX_HEAD_POSE_KEYS + 1> headPoseKeyQuats {};
+    std::array<std::array<std::array<float, NUM_SPEAKERS>, NUM_SPEAKERS>, MAX_HEAD_POSE_KEYS + 1> headPoseKeyMixes {};
+    std::array<int, MAX_HEAD_POSE_KEYS + 1> headPoseKeyOffsets {};
+    int headPoseKeyCount = 1;
+    bool headPoseKeysFresh = false;
+    // Scene choreography: published by the message thread, evaluated on the
+    // audio thread into choreographyResult once per block.
+    RetainingSharedPtrPublisher<const ChoreographyTimeline> publishedChoreography;      // message -> audio
+    std::shared_ptr<const ChoreographyTimeline> activeChoreography;                     // audio thread
+    ChoreographyTimeline::Playhead choreographyPlayhead;
+    ChoreographyTimeline::Result choreographyResult;
+    std::array<Vec3, SceneGraph::MAX_EMITTERS> choreographyPreviousPositions {};
+    std::array<bool, SceneGraph::MAX_EMITTERS> choreographedLastBlock {};
+    // Where each slot's position ended the last block it was rendered; the
+    // next block's pan, distance and Doppler ramps start here.
+    std::array<Vec3, SceneGraph::MAX_EMITTERS> renderedEndPositions {};
+    std::array<bool, SceneGraph::MAX_EMITTERS> renderedLastBlock {};
+
+    // Per-block emitter selection scratch (audio thread); only the first
+    // selectedEmitterCount entries of a block are meaningful.
+    struct EmitterCandidate
+    {
+        int slotIdx = -1;
+        EmitterData data {};
+        Vec3 blockStart {};
+        float distanceGain = 0.0f;
+        float emitterGainLinear = 0.0f;
+        float priority = 0.0f;
+    };
+
+    std::array<EmitterCandidate, MAX_TRACKED_EMITTERS> emitterCandidates {};
+    std::optional<double> choreographyTransportSeconds;
+    bool choreographyActive = false;
+    std::atomic<int> lastChoreographedEmitterCount { 0 };
+    std::atomic<int> requestedHeadPoseSubBlockSamples { DEFAULT_HEAD_POSE_SUB_BLOCK };
     float headphoneCompLowAlpha = 0.0f;
     float headphoneCompLowGain = 1.0f;
     float headphoneCompHighGain = 1.0f;
@@ -2163,6 +2521,8 @@ private:
     struct BundledPeqPresetCacheEntry
     {
         locusq::headphone_dsp::HeadphonePreset preset;
+        locusq::headphone_dsp::HeadphonePeqHook::CoefficientSet coefficients;
+        double coefficientSampleRate = 0.0;
     };
     std::array<BundledPeqPresetCacheEntry, NUM_HEADPHONE_DEVICE_PROFILES> bundledPeqPresets {};
     int    lastAppliedHeadphoneProfileIndex = -1;
@@ -2205,6 +2565,12 @@ private:
     bool steamAudioRuntimeReady = false;
 
     // World speaker vectors use scene coordinates where +Z is front.
+    // Quad bed channels map onto themselves for the per-channel delay/trim stage.
+    static constexpr locusq::bed_panner::BedZones kQuadSpeakerZones
+    {
+        0, 1, 2, 3, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+    };
+
     static constexpr std::array<std::array<float, 3>, NUM_SPEAKERS> kQuadWorldSpeakerDirs
     {{
         { -0.70710678f, 0.0f,  0.70710678f }, // FL
@@ -2306,6 +2672,49 @@ private:
         }
     }
 
+    void buildBundledPeqCoefficientSets (double sampleRate)
+    {
+        for (auto& cacheEntry : bundledPeqPresets)
+        {
+            cacheEntry.coefficients = buildPeqCoefficientSet (cacheEntry.preset, sampleRate);
+            cacheEntry.coefficientSampleRate = sampleRate;
+        }
+    }
+
+    // Invalid presets or rates yield the identity set (unity preamp, no stages).
+    static locusq::headphone_dsp::HeadphonePeqHook::CoefficientSet buildPeqCoefficientSet (
+        const locusq::headphone_dsp::HeadphonePreset& preset,
+        double sampleRate)
+    {
+        locusq::headphone_dsp::HeadphonePeqHook::CoefficientSet coefficients;
+        if (sampleRate <= 0.0 || ! preset.valid || preset.bands.empty())
+            return coefficients;
+
+        coefficients.preampLinear = std::pow (10.0f, preset.preampDb / 20.0f);
+
+        const auto sr = static_cast<float> (sampleRate);
+        const int maxStages = juce::jmin (
+            static_cast<int> (preset.bands.size()),
+            locusq::headphone_dsp::HeadphonePeqHook::kMaxStages);
+
+        for (int i = 0; i < maxStages; ++i)
+        {
+            const auto& band = preset.bands[static_cast<size_t> (i)];
+            auto& c = coefficients.stages[static_cast<size_t> (i)];
+            switch (band.type)
+            {
+                case locusq::headphone_dsp::PeqBandSpec::Type::LSC:
+                    c = locusq::headphone_dsp::HeadphonePeqHook::makeLowShelf  (band.fcHz, band.gainDb, band.q, sr); break;
+                case locusq::headphone_dsp::PeqBandSpec::Type::HSC:
+                    c = locusq::headphone_dsp::HeadphonePeqHook::makeHighShelf (band.fcHz, band.gainDb, band.q, sr); break;
+                default:
+                    c = locusq::headphone_dsp::HeadphonePeqHook::makePeakEQ    (band.fcHz, band.gainDb, band.q, sr); break;
+            }
+        }
+
+        return coefficients;
+    }
+
     static bool tryBuildListenerOrientationFromCoordinateSpace (const IPLCoordinateSpace3& coordinateSpace,
                                                                 ListenerOrientation& orientation) noexcept
     {
@@ -2396,15 +2805,108 @@ private:
         headPoseValid = false;
         headPoseInternalBinauralActive = false;
         setHeadPoseIdentityMix();
+        holdHeadPoseKeys();
+        headPoseKeysFresh = false;
+    }
+
+    // Collapses the key list to the current pose, which then holds for the block.
+    void holdHeadPoseKeys() noexcept
+    {
+        headPoseKeyQuats[0] = { headPoseSnapshot.qx, headPoseSnapshot.qy, headPoseSnapshot.qz, headPoseSnapshot.qw };
+        headPoseKeyMixes[0] = headPoseSpeakerMix;
+        headPoseKeyOffsets[0] = 0;
+        headPoseKeyCount = 1;
+    }
+
+    // Quaternion and speaker-mix work happens here, once per key. Each key is
+    // sign-aligned with its predecessor so nlerp between keys takes the short arc.
+    void appendHeadPoseKey (const PoseSnapshot& pose, int sampleOffset) noexcept
+    {
+        if (headPoseKeyCount > MAX_HEAD_POSE_KEYS
+            || ! std::isfinite (pose.qx)
+            || ! std::isfinite (pose.qy)
+            || ! std::isfinite (pose.qz)
+            || ! std::isfinite (pose.qw))
+        {
+            return;
+        }
+
+        const float normSq = (pose.qx * pose.qx)
+                           + (pose.qy * pose.qy)
+                           + (pose.qz * pose.qz)
+                           + (pose.qw * pose.qw);
+        if (! std::isfinite (normSq) || normSq < 1.0e-12f)
+            return;
+
+        const auto& previous = headPoseKeyQuats[static_cast<size_t> (headPoseKeyCount - 1)];
+        float invNorm = 1.0f / std::sqrt (normSq);
+        if ((previous[0] * pose.qx) + (previous[1] * pose.qy) + (previous[2] * pose.qz) + (previous[3] * pose.qw) < 0.0f)
+            invNorm = -invNorm;
+
+        headPoseSnapshot.qx = pose.qx * invNorm;
+        headPoseSnapshot.qy = pose.qy * invNorm;
+        headPoseSnapshot.qz = pose.qz * invNorm;
+        headPoseSnapshot.qw = pose.qw * invNorm;
+        headPoseSnapshot.timestampMs = pose.timestampMs;
+        headPoseSnapshot.seq = pose.seq;
+        headPoseSnapshot.pad = 0;
+        headPoseValid = true;
+
+        updateHeadPoseOrientationFromSnapshot();
+        rebuildHeadPoseSpeakerMix();
+
+        const auto key = static_cast<size_t> (headPoseKeyCount);
+        headPoseKeyQuats[key] = { headPoseSnapshot.qx, headPoseSnapshot.qy, headPoseSnapshot.qz, headPoseSnapshot.qw };
+        headPoseKeyMixes[key] = headPoseSpeakerMix;
+        headPoseKeyOffsets[key] = juce::jmax (sampleOffset, headPoseKeyOffsets[key - 1]);
+        ++headPoseKeyCount;
+    }
+
+    // Head quaternion at a sample offset of the current block, nlerped between keys.
+    std::array<float, 4> headPoseQuaternionAt (int sampleOffset, int numSamples) const noexcept
+    {
+        for (int key = 1; key < headPoseKeyCount; ++key)
+        {
+            const int segmentStart = juce::jmin (headPoseKeyOffsets[static_cast<size_t> (key - 1)], numSamples);
+            const int segmentEnd = juce::jmin (headPoseKeyOffsets[static_cast<size_t> (key)], numSamples);
+            if (sampleOffset > segmentEnd || segmentEnd <= segmentStart)
+                continue;
+
+            const float t = static_cast<float> (sampleOffset - segmentStart) / static_cast<float> (segmentEnd - segmentStart);
+            const auto& from = headPoseKeyQuats[static_cast<size_t> (key - 1)];
+            const auto& to = headPoseKeyQuats[static_cast<size_t> (key)];
+
+            std::array<float, 4> q {};
+            float normSq = 0.0f;
+            for (size_t k = 0; k < q.size(); ++k)
+            {
+                q[k] = from[k] + ((to[k] - from[k]) * t);
+                normSq += q[k] * q[k];
+            }
+
+            if (normSq > 1.0e-12f)
+            {
+                const float invNorm = 1.0f / std::sqrt (normSq);
+                for (auto& component : q)
+                    component *= invNorm;
+                return q;
+            }
+        }
+
+        return headPoseKeyQuats[static_cast<size_t> (headPoseKeyCount - 1)];
     }
 
-    // Quaternion follows Steam canonical axes (right +X, up +Y, ahead -Z).
     void updateHeadPoseOrientationFromSnapshot() noexcept
     {
-        const float x = headPoseSnapshot.qx;
-        const float y = headPoseSnapshot.qy;
-        const float z = headPoseSnapshot.qz;
-        const float w = headPoseSnapshot.qw;
+        headPoseOrientation = orientationFromQuaternion (headPoseSnapshot.qx,
+                                                         headPoseSnapshot.qy,
+                                                         headPoseSnapshot.qz,
+                                                         headPoseSnapshot.qw);
+    }
+
+    // Quaternion follows Steam canonical axes (right +X, up +Y, ahead -Z).
+    static ListenerOrientation orientationFromQuaternion (float x, float y, float z, float w) noexcept
+    {
 
         const float xx = x * x;
         const float yy = y * y;
@@ -2428,9 +2930,11 @@ private:
         const float m12 = 2.0f * (yz - xw);
         const float m22 = 1.0f - 2.0f * (xx + yy);
 
-        headPoseOrientation.right = { m00, m10, m20 };
-        headPoseOrientation.up = { m01, m11, m21 };
-        headPoseOrientation.ahead = { -m02, -m12, -m22 };
+        ListenerOrientation orientation {};
+        orientation.right = { m00, m10, m20 };
+        orientation.up = { m01, m11, m21 };
+        orientation.ahead = { -m02, -m12, -m22 };
+        return orientation;
     }
 
     void rebuildHeadPoseSpeakerMix() noexcept
@@ -2443,35 +2947,79 @@ private:
         buildSpeakerMixFromOrientation (headPoseOrientation, headPoseSpeakerMix);
     }
 
-    inline void getHeadPoseAdjustedQuadSample (int sampleIndex, float& fl, float& fr, float& rr, float& rl) const noexcept
+    // Quad bed in internal order FL, FR, RR, RL, remixed through the head-pose
+    // speaker mix while internal binaural head tracking is active.
+    void getHeadPoseAdjustedQuadBlock (int numSamples, std::array<const float*, NUM_SPEAKERS>& quad) noexcept
     {
+        for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+            quad[static_cast<size_t> (spk)] = accumBuffer.getReadPointer (spk);
+
         if (! headPoseInternalBinauralActive || ! headPoseValid)
-        {
-            fl = accumBuffer.getSample (0, sampleIndex);
-            fr = accumBuffer.getSample (1, sampleIndex);
-            rr = accumBuffer.getSample (2, sampleIndex);
-            rl = accumBuffer.getSample (3, sampleIndex);
             return;
+
+        for (const auto& rotated : headPoseRotatedQuadScratch)
+        {
+            if (static_cast<int> (rotated.size()) < numSamples)
+                return;
         }
 
-        const float sourceFl = accumBuffer.getSample (0, sampleIndex);
-        const float sourceFr = accumBuffer.getSample (1, sampleIndex);
-        const float sourceRr = accumBuffer.getSample (2, sampleIndex);
-        const float sourceRl = accumBuffer.getSample (3, sampleIndex);
+        mixHeadPoseRotatedQuad (quad, numSamples);
+        for (int target = 0; target < NUM_SPEAKERS; ++target)
+            quad[static_cast<size_t> (target)] = headPoseRotatedQuadScratch[static_cast<size_t> (target)].data();
+    }
 
-        const auto mixSpeaker = [this, sourceFl, sourceFr, sourceRr, sourceRl] (int targetSpeaker) noexcept
+    // Remixes the quad bed into headPoseRotatedQuadScratch, ramping each
+    // speaker-mix coefficient linearly from key to key. Past the last key (or
+    // with a single held key) the mix is constant.
+    void mixHeadPoseRotatedQuad (const std::array<const float*, NUM_SPEAKERS>& source, int numSamples) noexcept
+    {
+        int segmentStart = 0;
+        for (int key = 1; key < headPoseKeyCount && segmentStart < numSamples; ++key)
         {
-            const auto& mix = headPoseSpeakerMix[static_cast<size_t> (targetSpeaker)];
-            return (mix[0] * sourceFl)
-                 + (mix[1] * sourceFr)
-                 + (mix[2] * sourceRr)
-                 + (mix[3] * sourceRl);
-        };
+            const int segmentEnd = juce::jmin (headPoseKeyOffsets[static_cast<size_t> (key)], numSamples);
+            const int count = segmentEnd - segmentStart;
+            if (count <= 0)
+                continue;
+
+            const auto& fromMix = headPoseKeyMixes[static_cast<size_t> (key - 1)];
+            const auto& toMix = headPoseKeyMixes[static_cast<size_t> (key)];
+            const float step = 1.0f / static_cast<float> (count);
+
+            for (int target = 0; target < NUM_SPEAKERS; ++target)
+            {
+                auto gain = fromMix[static_cast<size_t> (target)];
+                std::array<float, NUM_SPEAKERS> delta {};
+                for (size_t src = 0; src < static_cast<size_t> (NUM_SPEAKERS); ++src)
+                    delta[src] = (toMix[static_cast<size_t> (target)][src] - gain[src]) * step;
+
+                auto* destination = headPoseRotatedQuadScratch[static_cast<size_t> (target)].data() + segmentStart;
+                for (int i = 0; i < count; ++i)
+                {
+                    float sum = 0.0f;
+                    for (size_t src = 0; src < static_cast<size_t> (NUM_SPEAKERS); ++src)
+                    {
+                        gain[src] += delta[src];
+                        sum += gain[src] * source[src][segmentStart + i];
+                    }
+                    destination[i] = sum;
+                }
+            }
+
+            segmentStart = segmentEnd;
+        }
+
+        const int remaining = numSamples - segmentStart;
+        if (remaining <= 0)
+            return;
 
-        fl = mixSpeaker (0);
-        fr = mixSpeaker (1);
-        rr = mixSpeaker (2);
-        rl = mixSpeaker (3);
+        for (int target = 0; target < NUM_SPEAKERS; ++target)
+        {
+            const auto& mix = headPoseSpeakerMix[static_cast<size_t> (target)];
+            auto* destination = headPoseRotatedQuadScratch[static_cast<size_t> (target)].data() + segmentStart;
+            juce::FloatVectorOperations::copyWithMultiply (destination, source[0] + segmentStart, mix[0], remaining);
+            for (size_t src = 1; src < static_cast<size_t> (NUM_SPEAKERS); ++src)
+                juce::FloatVectorOperations::addWithMultiply (destination, source[src] + segmentStart, mix[src], remaining);
+        }
     }
 
     //==========================================================================
@@ -4287,6 +4835,487 @@ private:
             NUM_SPEAKERS);
     }
 
+    static int ambisonicEncodeOrderForOutput (SpatialOutputProfile profile, int numOutputChannels) noexcept
+    {
+        if (numOutputChannels < 4)
+            return 0;
+
+        const int order = ambisonicOrderForProfile (profile);
+        if (order <= 0)
+            return 0;
+
+        return numOutputChannels >= locusq::ambisonic_encoder::channelCountForOrder (order) ? order : 1;
+    }
+
+    const locusq::bed_panner::BedVbapLut& bedLutForLayout (locusq::bed_panner::BedLayout layout) const noexcept
+    {
+        return layout == locusq::bed_panner::BedLayout::Bed916 ? bed916Lut : bed714Lut;
+    }
+
+    void resetBedState() noexcept
+    {
+        bedBuffer.clear();
+        for (auto& gains : bedEmitterGains)
+            gains.fill (0.0f);
+        bedEmitterLastBlock.fill (0);
+        bedBlockCounter = 0;
+    }
+
+    void updateChoreography (int numSamples) noexcept
+    {
+        if (auto latest = publishedChoreography.load(); latest != activeChoreography)
+        {
+            activeChoreography = std::move (latest);
+            choreographyPlayhead.cursors = {};
+        }
+
+        const auto transportSeconds = choreographyTransportSeconds;
+        choreographyTransportSeconds.reset();
+
+        choreographyActive = activeChoreography != nullptr && ! activeChoreography->empty();
+        if (! choreographyActive)
+            return;
+
+        if (transportSeconds.has_value())
+            activeChoreography->seek (choreographyPlayhead, *transportSeconds);
+        else
+            activeChoreography->advance (choreographyPlayhead, static_cast<double> (numSamples) / currentSampleRate);
+
+        activeChoreography->evaluate (choreographyPlayhead, choreographyResult);
+    }
+
+    // Overrides the choreographed axes of one emitter with this block's
+    // evaluated position, ramping from where the previous block left it
+    // (blockStart is moved onto the new position for loop wraps and seeks).
+    bool applyChoreography (int slotIdx, EmitterData& emitter, Vec3& blockStart, int numSamples) noexcept
+    {
+        const auto slot = static_cast<size_t> (slotIdx);
+        const auto mask = choreographyActive ? choreographyResult.sceneAxisMask[slot] : uint8_t { 0 };
+        if (mask == 0)
+        {
+            choreographedLastBlock[slot] = false;
+            return false;
+        }
+
+        const auto& target = choreographyResult.positions[slot];
+        Vec3 position = emitter.position;
+        if ((mask & 0x1) != 0) position.x = target.x;
+        if ((mask & 0x2) != 0) position.y = target.y;
+        if ((mask & 0x4) != 0) position.z = target.z;
+
+        Vec3 start = choreographedLastBlock[slot] ? choreographyPreviousPositions[slot] : position;
+        const float blockSeconds = static_cast<float> (numSamples / currentSampleRate);
+        const Vec3 travel { position.x - start.x, position.y - start.y, position.z - start.z };
+        const float travelDistance = std::sqrt (travel.x * travel.x + travel.y * travel.y + travel.z * travel.z);
+
+        // Loop wraps and seeks jump instead of sweeping (and Doppler-shifting) across the room.
+        if (blockSeconds <= 0.0f || travelDistance > CHOREOGRAPHY_MAX_SPEED_MPS * blockSeconds)
+        {
+            start = position;
+            emitter.velocity = {};
+        }
+        else
+        {
+            emitter.velocity = { travel.x / blockSeconds, travel.y / blockSeconds, travel.z / blockSeconds };
+        }
+
+        blockStart = start;
+        emitter.position = position;
+        choreographyPreviousPositions[slot] = position;
+        choreographedLastBlock[slot] = true;
+        return true;
+    }
+
+    static bool isEmitterMovingThisBlock (const Vec3& start, const Vec3& end) noexcept
+    {
+        const float dx = end.x - start.x;
+        const float dy = end.y - start.y;
+        const float dz = end.z - start.z;
+        const float travelSq = dx * dx + dy * dy + dz * dz;
+        return std::isfinite (travelSq) && travelSq > EMITTER_TRAJECTORY_MIN_TRAVEL_M * EMITTER_TRAJECTORY_MIN_TRAVEL_M;
+    }
+
+    // Splits a block into keys along the straight start->end path and calls
+    // fn (keyPosition, segmentStart, segmentLength) per segment, keyPosition
+    // being where the segment ends. A stationary emitter gets one key at end.
+    template <typename KeyFunction>
+    static void forEachEmitterTrajectoryKey (const Vec3& start, const Vec3& end, int numSamples, KeyFunction&& fn)
+    {
+        if (numSamples <= 0)
+            return;
+
+        const int numKeys = isEmitterMovingThisBlock (start, end)
+            ? juce::jlimit (1,
+                            MAX_EMITTER_TRAJECTORY_KEYS,
+                            (numSamples + EMITTER_TRAJECTORY_SUB_BLOCK - 1) / EMITTER_TRAJECTORY_SUB_BLOCK)
+            : 1;
+
+        int segmentStart = 0;
+        for (int key = 1; key <= numKeys; ++key)
+        {
+            const int segmentEnd = (numSamples * key) / numKeys;
+            const int segmentLength = segmentEnd - segmentStart;
+            if (segmentLength <= 0)
+                continue;
+
+            const float t = static_cast<float> (segmentEnd) / static_cast<float> (numSamples);
+            const Vec3 keyPosition = key == numKeys ? end
+                                                    : Vec3 { start.x + (end.x - start.x) * t,
+                                                             start.y + (end.y - start.y) * t,
+                                                             start.z + (end.z - start.z) * t };
+            fn (keyPosition, segmentStart, segmentLength);
+            segmentStart = segmentEnd;
+        }
+    }
+
+    float calculateDistanceGain (const Vec3& position) const
+    {
+        const float distanceGain = distanceAttenuator.calculateGain (calculateDistance (position));
+        return std::isfinite (distanceGain) ? distanceGain : 0.0f;
+    }
+
+    // Pan, spread, directivity and distance gain for one point on the emitter's path.
+    std::array<float, NUM_SPEAKERS> computeEmitterSpeakerGains (const EmitterData& emitter, const Vec3& position) const
+    {
+        auto gains = vbapPanner.calculateGains (calculateAzimuth (position), calculateElevation (position)).gains;
+        spreadProcessor.apply (gains, emitter.spread);
+        directivityFilter.apply (gains, emitter.directivity, emitter.directivityAim, position);
+
+        const float distanceGain = calculateDistanceGain (position);
+        for (auto& gain : gains)
+            gain *= distanceGain;
+        return gains;
+    }
+
+    // Moving emitters: evaluate gains at keys along the straight start->end
+    // path of this block and ramp linearly between them, starting from the
+    // smoothed gain the previous block ended on. The smoothers are then parked
+    // on the final key so a stationary block continues without a step.
+    void accumulateEmitterAlongTrajectory (int slotIdx, const EmitterData& emitter, const Vec3& start, int numSamples)
+    {
+        if (numSamples <= 0)
+            return;
+
+        auto& smoothed = smoothedSpeakerGains[static_cast<size_t> (slotIdx)];
+        std::array<float, NUM_SPEAKERS> keyStartGains {};
+        for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+            keyStartGains[static_cast<size_t> (spk)] = smoothed[static_cast<size_t> (spk)].getCurrentValue();
+
+        forEachEmitterTrajectoryKey (start, emitter.position, numSamples,
+                                     [&] (const Vec3& keyPosition, int segmentStart, int segmentLength)
+                                     {
+                                         const auto keyEndGains = computeEmitterSpeakerGains (emitter, keyPosition);
+                                         const float* input = tempMonoBuffer.data() + segmentStart;
+                                         const float inverseLength = 1.0f / static_cast<float> (segmentLength);
+                                         for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+                                         {
+                                             const float gainStart = keyStartGains[static_cast<size_t> (spk)];
+                                             const float gainStep = (keyEndGains[static_cast<size_t> (spk)] - gainStart) * inverseLength;
+                                             float* output = accumBuffer.getWritePointer (spk, segmentStart);
+                                             for (int i = 0; i < segmentLength; ++i)
+                                                 output[i] += input[i] * (gainStart + gainStep * static_cast<float> (i + 1));
+                                         }
+
+                                         keyStartGains = keyEndGains;
+                                     });
+
+        for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+            smoothed[static_cast<size_t> (spk)].setCurrentAndTargetValue (keyStartGains[static_cast<size_t> (spk)]);
+    }
+
+    // Bed gains ramp key to key along the block's trajectory, like the quad path.
+    void panEmitterToBed (int slotIdx,
+                          const EmitterData& emitter,
+                          const Vec3& start,
+                          int numSamples,
+                          locusq::bed_panner::BedLayout layout) noexcept
+    {
+        using namespace locusq::bed_panner;
+
+        const auto& lut = bedLutForLayout (layout);
+        const int numChannels = lut.getNumChannels();
+
+        const bool tracked = slotIdx >= 0 && slotIdx < MAX_TRACKED_EMITTERS;
+        BedGains untrackedGains {};
+        auto& current = tracked ? bedEmitterGains[static_cast<size_t> (slotIdx)] : untrackedGains;
+        if (tracked)
+        {
+            // Emitters that were silent last block fade in from zero.
+            auto& lastBlock = bedEmitterLastBlock[static_cast<size_t> (slotIdx)];
+            if (lastBlock + 1 != bedBlockCounter)
+                current.fill (0.0f);
+            lastBlock = bedBlockCounter;
+        }
+
+        forEachEmitterTrajectoryKey (start, emitter.position, numSamples,
+                                     [&] (const Vec3& keyPosition, int segmentStart, int segmentLength)
+                                     {
+                                         BedGains target {};
+                                         lut.lookup (calculateAzimuth (keyPosition), calculateElevation (keyPosition), target);
+                                         applySpread (target, layout, emitter.spread);
+                                         applyDirectivity (target, layout, emitter.directivity, emitter.directivityAim, keyPosition);
+
+                                         const float distanceGain = calculateDistanceGain (keyPosition);
+                                         std::array<float*, kMaxBedChannels> bedPtrs {};
+                                         for (int ch = 0; ch < numChannels; ++ch)
+                                         {
+                                             target[static_cast<size_t> (ch)] *= distanceGain;
+                                             bedPtrs[static_cast<size_t> (ch)] = bedBuffer.getWritePointer (ch, segmentStart);
+                                         }
+
+                                         // Untracked slots have no ramp state and start on their first key.
+                                         if (! tracked && segmentStart == 0)
+                                             current = target;
+
+                                         panBlock (bedPtrs.data(), numChannels, tempMonoBuffer.data() + segmentStart,
+                                                   segmentLength, current, target);
+                                     });
+    }
+
+    // Pans each quad bed feed onto the bed from its nominal speaker direction.
+    void addQuadProxyToBed (int numSamples, locusq::bed_panner::BedLayout layout) noexcept
+    {
+        static constexpr std::array<float, NUM_SPEAKERS> kQuadAzimuthDeg { -45.0f, 45.0f, 135.0f, -135.0f };
+
+        const auto& lut = bedLutForLayout (layout);
+        for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+        {
+            locusq::bed_panner::BedGains gains {};
+            lut.lookup (kQuadAzimuthDeg[static_cast<size_t> (spk)], 0.0f, gains);
+            for (int ch = 0; ch < lut.getNumChannels(); ++ch)
+            {
+                const float gain = gains[static_cast<size_t> (ch)];
+                if (gain > 0.0f)
+                    juce::FloatVectorOperations::addWithMultiply (bedBuffer.getWritePointer (ch),
+                                                                  accumBuffer.getReadPointer (spk),
+                                                                  gain,
+                                                                  numSamples);
+            }
+        }
+    }
+
+    // Calibration delay and trim per output channel; channel ch follows quad
+    // speaker zones[ch], channels without a zone pass through untouched.
+    void applySpeakerDelayAndTrim (juce::AudioBuffer<float>& buffer,
+                                   int numChannels,
+                                   const locusq::bed_panner::BedZones& zones,
+                                   juce::SmoothedValue<float>* trims,
+                                   int numSamples) noexcept
+    {
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const int zone = zones[static_cast<size_t> (ch)];
+            if (zone < 0 || zone >= NUM_SPEAKERS)
+                continue;
+
+            auto* channelData = buffer.getWritePointer (ch);
+            auto& delayLine = speakerDelayLines[static_cast<size_t> (ch)];
+            auto& writePos = delayWritePos[static_cast<size_t> (ch)];
+            const int delay = speakerDelaySamples[static_cast<size_t> (zone)];
+
+            if (delay > 0)
+            {
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    delayLine[static_cast<size_t> (writePos)] = channelData[i];
+
+                    int readPos = writePos - delay;
+                    if (readPos < 0)
+                        readPos += MAX_DELAY_SAMPLES;
+
+                    channelData[i] = delayLine[static_cast<size_t> (readPos)];
+                    writePos = (writePos + 1) % MAX_DELAY_SAMPLES;
+                }
+            }
+
+            for (int i = 0; i < numSamples; ++i)
+                channelData[i] *= trims[ch].getNextValue();
+        }
+    }
+
+    void resetAmbisonicEncoderState() noexcept
+    {
+        ambisonicBus.clear();
+        ambisonicScratch.clear();
+        ambisonicRoomDry.clear();
+        for (auto& gains : ambisonicEmitterGains)
+            gains.fill (0.0f);
+        ambisonicEmitterLastBlock.fill (0);
+        ambisonicBlockCounter = 0;
+        ambisonicRotator.reset();
+        ambisonicRotationActive = false;
+        ambisonicRotationQuat = { 0.0f, 0.0f, 0.0f, 1.0f };
+    }
+
+    // SH coefficients ramp key to key along the block's trajectory, like the quad path.
+    void encodeEmitterToAmbisonicBus (int slotIdx,
+                                      const EmitterData& emitter,
+                                      const Vec3& start,
+                                      int numSamples,
+                                      int order,
+                                      AmbisonicNormalization normalization) noexcept
+    {
+        using namespace locusq::ambisonic_encoder;
+
+        // Spread widens the image by attenuating the directional orders.
+        const float focus = 1.0f - juce::jlimit (0.0f, 1.0f, std::isfinite (emitter.spread) ? emitter.spread : 0.0f);
+        const int numChannels = channelCountForOrder (order);
+        ShCoefficients orderWeights {};
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const int channelOrder = orderForChannel (ch);
+            float orderWeight = 1.0f;
+            for (int l = 0; l < channelOrder; ++l)
+                orderWeight *= focus;
+            orderWeights[static_cast<size_t> (ch)] = orderWeight;
+        }
+
+        const bool tracked = slotIdx >= 0 && slotIdx < MAX_TRACKED_EMITTERS;
+        ShCoefficients untrackedGains {};
+        auto& current = tracked ? ambisonicEmitterGains[static_cast<size_t> (slotIdx)] : untrackedGains;
+        if (tracked)
+        {
+            // Emitters that were silent last block fade in from zero.
+            auto& lastBlock = ambisonicEmitterLastBlock[static_cast<size_t> (slotIdx)];
+            if (lastBlock + 1 != ambisonicBlockCounter)
+                current.fill (0.0f);
+            lastBlock = ambisonicBlockCounter;
+        }
+
+        forEachEmitterTrajectoryKey (start, emitter.position, numSamples,
+                                     [&] (const Vec3& keyPosition, int segmentStart, int segmentLength)
+                                     {
+                                         ShCoefficients target {};
+                                         ambisonicShLut.lookup (calculateAzimuth (keyPosition), calculateElevation (keyPosition),
+                                                                order, normalization, target);
+
+                                         const float distanceGain = calculateDistanceGain (keyPosition);
+                                         std::array<float*, kMaxChannels> busPtrs {};
+                                         for (int ch = 0; ch < numChannels; ++ch)
+                                         {
+                                             target[static_cast<size_t> (ch)] *= distanceGain * orderWeights[static_cast<size_t> (ch)];
+                                             busPtrs[static_cast<size_t> (ch)] = ambisonicBus.getWritePointer (ch, segmentStart);
+                                         }
+
+                                         // Untracked slots have no ramp state and start on their first key.
+                                         if (! tracked && segmentStart == 0)
+                                             current = target;
+
+                                         encodeBlock (busPtrs.data(), numChannels, tempMonoBuffer.data() + segmentStart,
+                                                      segmentLength, current, target);
+                                     });
+    }
+
+    // Adds a first-order proxy of the quad bed (optionally minus `dry`) to ACN 0..3.
+    void addQuadProxyToAmbisonicBus (const juce::AudioBuffer<float>* dry,
+                                     int numSamples,
+                                     AmbisonicNormalization normalization) noexcept
+    {
+        const float firstOrderScale = normalization == AmbisonicNormalization::N3D ? 1.7320508f : 1.0f;
+        auto* busW = ambisonicBus.getWritePointer (0);
+        auto* busY = ambisonicBus.getWritePointer (1);
+        auto* busZ = ambisonicBus.getWritePointer (2);
+        auto* busX = ambisonicBus.getWritePointer (3);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            float fl = accumBuffer.getSample (0, i);
+            float fr = accumBuffer.getSample (1, i);
+            float rr = accumBuffer.getSample (2, i);
+            float rl = accumBuffer.getSample (3, i);
+            if (dry != nullptr)
+            {
+                fl -= dry->getSample (0, i);
+                fr -= dry->getSample (1, i);
+                rr -= dry->getSample (2, i);
+                rl -= dry->getSample (3, i);
+            }
+
+            float w = 0.0f;
+            float lateral = 0.0f;
+            float frontal = 0.0f;
+            float z = 0.0f;
+            encodeAmbisonicFoaProxyFromQuad (fl, fr, rr, rl, w, lateral, frontal, z);
+
+            // Proxy axes are (right, front); ACN wants Y = left, X = front.
+            busW[i] += w;
+            busY[i] -= lateral * firstOrderScale;
+            busZ[i] += z * firstOrderScale;
+            busX[i] += frontal * firstOrderScale;
+        }
+    }
+
+    // Rotates the bus into the listener frame while a head pose is valid and
+    // ramps back to identity once tracking drops out. The SH matrices are
+    // rebuilt every AMBISONIC_ROTATION_SUB_BLOCK samples from the head-pose
+    // keys of this block, so fast turns on large host blocks follow the
+    // tracked arc instead of a linear blend between two far-apart matrices.
+    void applyAmbisonicHeadRotation (int numChannels, int numSamples) noexcept
+    {
+        using namespace locusq::ambisonic_encoder;
+
+        if (! headPoseValid && ! ambisonicRotationActive)
+            return;
+
+        const auto& from = ambisonicRotationQuat;
+        std::array<float, 4> identity { 0.0f, 0.0f, 0.0f, 1.0f };
+        if (from[3] < 0.0f)
+            identity[3] = -1.0f; // shortest arc: q and -q are the same rotation
+
+        std::array<float*, kMaxChannels> channelPtrs {};
+        std::array<float*, kMaxChannels> scratchPtrs {};
+        std::array<float, 4> q = from;
+        for (int start = 0; start < numSamples; start += AMBISONIC_ROTATION_SUB_BLOCK)
+        {
+            const int count = juce::jmin (AMBISONIC_ROTATION_SUB_BLOCK, numSamples - start);
+
+            if (headPoseValid)
+            {
+                q = headPoseQuaternionAt (start + count, numSamples);
+            }
+            else
+            {
+                const float t = static_cast<float> (start + count) / static_cast<float> (numSamples);
+                for (size_t k = 0; k < q.size(); ++k)
+                    q[k] = from[k] + ((identity[k] - from[k]) * t);
+            }
+
+            const float normSq = (q[0] * q[0]) + (q[1] * q[1]) + (q[2] * q[2]) + (q[3] * q[3]);
+            const float invNorm = normSq > 1.0e-12f ? 1.0f / std::sqrt (normSq) : 0.0f;
+            const auto orientation = normSq > 1.0e-12f
+                                         ? orientationFromQuaternion (q[0] * invNorm, q[1] * invNorm, q[2] * invNorm, q[3] * invNorm)
+                                         : ListenerOrientation {};
+            ambisonicRotator.setRotation (rotationFromOrientation (orientation));
+
+            for (int ch = 0; ch < numChannels; ++ch)
+            {
+                channelPtrs[static_cast<size_t> (ch)] = ambisonicBus.getWritePointer (ch) + start;
+                scratchPtrs[static_cast<size_t> (ch)] = ambisonicScratch.getWritePointer (ch) + start;
+            }
+
+            ambisonicRotator.process (channelPtrs.data(), scratchPtrs.data(), numChannels, count);
+        }
+
+        ambisonicRotationQuat = q;
+        ambisonicRotationActive = headPoseValid;
+    }
+
+    // Rows: listener front, left and up, expressed in world ambisonic axes
+    // (scene x right, y up, z front -> X = z, Y = -x, Z = y).
+    static locusq::ambisonic_encoder::RotationMatrix3 rotationFromOrientation (const ListenerOrientation& orientation) noexcept
+    {
+        const auto toAmbisonicAxes = [] (const std::array<float, 3>& v, float sign) noexcept
+        {
+            return std::array<float, 3> { sign * v[2], -sign * v[0], sign * v[1] };
+        };
+
+        locusq::ambisonic_encoder::RotationMatrix3 rotation {};
+        rotation[0] = toAmbisonicAxes (orientation.ahead, -1.0f);
+        rotation[1] = toAmbisonicAxes (orientation.right, -1.0f);
+        rotation[2] = toAmbisonicAxes (orientation.up, 1.0f);
+        return rotation;
+    }
+
     static int ambisonicOrderForProfile (SpatialOutputProfile profile) noexcept
     {
         return locusq::spatial_profile_router::ambisonicOrderForProfile (profile);
@@ -4304,61 +5333,266 @@ private:
         locusq::spatial_profile_router::decodeAmbisonicFoaProxyToStereo (w, x, y, z, left, right);
     }
 
-    inline void renderVirtual3dStereoSample (int sampleIndex, float& left, float& right) const noexcept
+    //==========================================================================
+    // Output block writers
+    //==========================================================================
+
+    static OutputBlockWriterKind selectOutputBlockWriter (SpatialOutputProfile profile,
+                                                          int numOutputChannels,
+                                                          int ambisonicEncodeOrder,
+                                                          int bedChannels) noexcept
+    {
+        if (bedChannels > 0)
+            return OutputBlockWriterKind::AtmosBed;
+        if (numOutputChannels >= 13 && profile == SpatialOutputProfile::Surround742)
+            return OutputBlockWriterKind::Surround742;
+        // AtmosBed below 7.1.4 keeps the quad-derived 7.2.1 mapping.
+        if (numOutputChannels >= 10
+            && (profile == SpatialOutputProfile::Surround721 || profile == SpatialOutputProfile::AtmosBed))
+            return OutputBlockWriterKind::Surround721;
+        if (numOutputChannels >= 8 && profile == SpatialOutputProfile::Surround521)
+            return OutputBlockWriterKind::Surround521;
+        if (ambisonicEncodeOrder > 0)
+            return OutputBlockWriterKind::Ambisonic;
+        if (numOutputChannels >= NUM_SPEAKERS)
+            return OutputBlockWriterKind::Quad;
+        if (numOutputChannels >= 2)
+            return OutputBlockWriterKind::Stereo;
+        if (numOutputChannels == 1)
+            return OutputBlockWriterKind::Mono;
+        return OutputBlockWriterKind::Silent;
+    }
+
+    const float* fillMasterGainRamp (int numSamples) noexcept
+    {
+        auto* ramp = masterGainRamp.data();
+        if (smoothedMasterGain.isSmoothing())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                ramp[i] = smoothedMasterGain.getNextValue();
+        }
+        else
+        {
+            juce::FloatVectorOperations::fill (ramp, smoothedMasterGain.getTargetValue(), numSamples);
+        }
+
+        return ramp;
+    }
+
+    std::array<const float*, NUM_SPEAKERS> getQuadBedPointers() const noexcept
     {
-        float fl = 0.0f;
-        float fr = 0.0f;
-        float rr = 0.0f;
-        float rl = 0.0f;
-        getHeadPoseAdjustedQuadSample (sampleIndex, fl, fr, rr, rl);
-        // Simple crossfeed/Haas-style stereo virtualization from quad bed.
-        left = (0.74f * fl) + (0.46f * rl) + (0.12f * fr) + (0.08f * rr);
-        right = (0.74f * fr) + (0.46f * rr) + (0.12f * fl) + (0.08f * rl);
+        std::array<const float*, NUM_SPEAKERS> quad {};
+        for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+            quad[static_cast<size_t> (spk)] = accumBuffer.getReadPointer (spk);
+        return quad;
     }
 
-    inline void writeSurround521Sample (juce::AudioBuffer<float>& outputBuffer, int sampleIndex, float masterGain) const noexcept
+    void writeSilentBlock (juce::AudioBuffer<float>& outputBuffer, int numSamples, OutputBlockContext&) noexcept
     {
-        const float fl = accumBuffer.getSample (0, sampleIndex);
-        const float fr = accumBuffer.getSample (1, sampleIndex);
-        const float rr = accumBuffer.getSample (2, sampleIndex);
-        const float rl = accumBuffer.getSample (3, sampleIndex);
+        locusq::spatial_profile_router::clearChannelsFrom (outputBuffer, 0, numSamples);
+    }
+
+    void writeMonoBlock (juce::AudioBuffer<float>& outputBuffer, int numSamples, OutputBlockContext& context) noexcept
+    {
+        // Sum of the bed at -6 dB.
+        const auto quad = getQuadBedPointers();
+        locusq::spatial_profile_router::writeGainedBed (outputBuffer.getWritePointer (0), quad.data(), 2.0f, context.masterGain, numSamples);
+        locusq::spatial_profile_router::clearChannelsFrom (outputBuffer, 1, numSamples);
+    }
+
+    void writeQuadBlock (juce::AudioBuffer<float>& outputBuffer, int numSamples, OutputBlockContext& context) noexcept
+    {
+        // Quad output: explicit host order FL, FR, RL, RR.
+        for (int outCh = 0; outCh < NUM_SPEAKERS; ++outCh)
+        {
+            const int speakerIdx = kQuadOutputSpeakerOrder[static_cast<size_t> (outCh)];
+            locusq::spatial_profile_router::writeGainedChannel (outputBuffer.getWritePointer (outCh),
+                                                                accumBuffer.getReadPointer (speakerIdx),
+                                                                context.masterGain,
+                                                                numSamples);
+        }
+
+        locusq::spatial_profile_router::clearChannelsFrom (outputBuffer, NUM_SPEAKERS, numSamples);
+    }
+
+    void writeAmbisonicBlock (juce::AudioBuffer<float>& outputBuffer, int numSamples, OutputBlockContext& context) noexcept
+    {
+        // ACN channel order, normalization per rend_ambi_norm.
+        for (int ch = 0; ch < context.ambisonicChannels; ++ch)
+        {
+            locusq::spatial_profile_router::writeGainedChannel (outputBuffer.getWritePointer (ch),
+                                                                ambisonicBus.getReadPointer (ch),
+                                                                context.masterGain,
+                                                                numSamples);
+        }
 
-        locusq::spatial_profile_router::writeSurround521Sample (
-            outputBuffer, sampleIndex, masterGain, fl, fr, rr, rl);
+        locusq::spatial_profile_router::clearChannelsFrom (outputBuffer, context.ambisonicChannels, numSamples);
     }
 
-    inline void writeSurround721Sample (juce::AudioBuffer<float>& outputBuffer, int sampleIndex, float masterGain) const noexcept
+    void writeSurround521Block (juce::AudioBuffer<float>& outputBuffer, int numSamples, OutputBlockContext& context) noexcept
     {
-        const float fl = accumBuffer.getSample (0, sampleIndex);
-        const float fr = accumBuffer.getSample (1, sampleIndex);
-        const float rr = accumBuffer.getSample (2, sampleIndex);
-        const float rl = accumBuffer.getSample (3, sampleIndex);
+        const auto quad = getQuadBedPointers();
+        locusq::spatial_profile_router::writeSurround521Block (outputBuffer, quad.data(), context.masterGain, numSamples);
+    }
+
+    void writeSurround721Block (juce::AudioBuffer<float>& outputBuffer, int numSamples, OutputBlockContext& context) noexcept
+    {
+        const auto quad = getQuadBedPointers();
+        locusq::spatial_profile_router::writeSurround721Block (outputBuffer, quad.data(), context.masterGain, numSamples);
+    }
+
+    void writeSurround742Block (juce::AudioBuffer<float>& outputBuffer, int numSamples, OutputBlockContext& context) noexcept
+    {
+        const auto quad = getQuadBedPointers();
+        locusq::spatial_profile_router::writeSurround742Block (outputBuffer, quad.data(), context.masterGain, numSamples);
+    }
+
+    // AtmosBed: the bed bus goes out channel for channel (it already carries the
+    // room and calibration stages); LFE is derived from the processed mains.
+    void writeAtmosBedBlock (juce::AudioBuffer<float>& outputBuffer, int numSamples, OutputBlockContext& context) noexcept
+    {
+        using namespace locusq::bed_panner;
+
+        auto* lfe = outputBuffer.getWritePointer (kLfeChannel);
+        juce::FloatVectorOperations::clear (lfe, numSamples);
+        for (int ch = 0; ch < context.bedChannels; ++ch)
+        {
+            if (ch == kLfeChannel)
+                continue;
+
+            const auto* bed = bedBuffer.getReadPointer (ch);
+            juce::FloatVectorOperations::add (lfe, bed, numSamples);
+            locusq::spatial_profile_router::writeGainedChannel (outputBuffer.getWritePointer (ch),
+                                                                bed,
+                                                                context.masterGain,
+                                                                numSamples);
+        }
+
+        juce::FloatVectorOperations::multiply (lfe, context.masterGain, numSamples);
+        juce::FloatVectorOperations::multiply (lfe, kLfeSendFromMains, numSamples);
+        locusq::spatial_profile_router::clearChannelsFrom (outputBuffer, context.bedChannels, numSamples);
+    }
+
+    // Stereo/headphone output: binaural render (when one ran) or a quad-bed
+    // matrix per profile, then headphone compensation and the calibration chain
+    // over the whole block, master gain last.
+    void writeStereoBlock (juce::AudioBuffer<float>& outputBuffer, int numSamples, OutputBlockContext& context) noexcept
+    {
+        auto* left = outputBuffer.getWritePointer (0);
+        auto* right = outputBuffer.getWritePointer (1);
+        const bool binauralSource = context.binauralLeft != nullptr && context.binauralRight != nullptr;
+
+        std::array<const float*, NUM_SPEAKERS> quad {};
+        if (! binauralSource || context.measureAuditionHeadphone)
+            getHeadPoseAdjustedQuadBlock (numSamples, quad);
+
+        if (binauralSource)
+        {
+            juce::FloatVectorOperations::copy (left, context.binauralLeft, numSamples);
+            juce::FloatVectorOperations::copy (right, context.binauralRight, numSamples);
+        }
+        else
+        {
+            mixQuadToStereo (quad, stereoMatrixForProfile (context.spatialProfile), left, right, numSamples);
+        }
+
+        if (context.measureAuditionHeadphone)
+            measureAuditionHeadphoneBlock (left, right, binauralSource ? &quad : nullptr, numSamples, context);
 
-        locusq::spatial_profile_router::writeSurround721Sample (
-            outputBuffer, sampleIndex, masterGain, fl, fr, rr, rl);
+        for (int i = 0; i < numSamples; ++i)
+            applyHeadphoneProfileCompensation (left[i], right[i]);
+
+        headphoneCalibrationChain.processBlock (left, right, numSamples);
+        juce::FloatVectorOperations::multiply (left, context.masterGain, numSamples);
+        juce::FloatVectorOperations::multiply (right, context.masterGain, numSamples);
+        locusq::spatial_profile_router::clearChannelsFrom (outputBuffer, 2, numSamples);
     }
 
-    inline void writeSurround742Sample (juce::AudioBuffer<float>& outputBuffer, int sampleIndex, float masterGain) const noexcept
+    // Pre-compensation headphone energy for the audition parity telemetry. The
+    // reference is the legacy downmix of `referenceQuad` when a binaural render
+    // is measured, otherwise the output itself.
+    static void measureAuditionHeadphoneBlock (const float* left,
+                                               const float* right,
+                                               const std::array<const float*, NUM_SPEAKERS>* referenceQuad,
+                                               int numSamples,
+                                               OutputBlockContext& context) noexcept
     {
-        const float fl = accumBuffer.getSample (0, sampleIndex);
-        const float fr = accumBuffer.getSample (1, sampleIndex);
-        const float rr = accumBuffer.getSample (2, sampleIndex);
-        const float rl = accumBuffer.getSample (3, sampleIndex);
+        const auto downmix = stereoMatrixForProfile (SpatialOutputProfile::Stereo20);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto mono = 0.5f * (left[i] + right[i]);
+            context.auditionHeadphoneEnergy += static_cast<double> (mono * mono);
+            context.auditionHeadphonePeak = juce::jmax (context.auditionHeadphonePeak,
+                                                        juce::jmax (std::abs (left[i]), std::abs (right[i])));
+
+            auto referenceMono = mono;
+            if (referenceQuad != nullptr)
+            {
+                float referenceLeft = 0.0f;
+                float referenceRight = 0.0f;
+                for (size_t spk = 0; spk < static_cast<size_t> (NUM_SPEAKERS); ++spk)
+                {
+                    const auto sample = (*referenceQuad)[spk][i];
+                    referenceLeft += downmix[0][spk] * sample;
+                    referenceRight += downmix[1][spk] * sample;
+                }
+                referenceMono = 0.5f * (referenceLeft + referenceRight);
+            }
 
-        locusq::spatial_profile_router::writeSurround742Sample (
-            outputBuffer, sampleIndex, masterGain, fl, fr, rr, rl);
+            context.auditionHeadphoneReferenceEnergy += static_cast<double> (referenceMono * referenceMono);
+        }
+
+        context.auditionHeadphoneSamplesCaptured = context.auditionHeadphoneSamplesCaptured || numSamples > 0;
     }
 
-    inline void renderStereoDownmixSample (int sampleIndex, float& left, float& right) const noexcept
+    static QuadToStereoMatrix stereoMatrixForProfile (SpatialOutputProfile profile) noexcept
     {
-        float fl = 0.0f;
-        float fr = 0.0f;
-        float rr = 0.0f;
-        float rl = 0.0f;
-        getHeadPoseAdjustedQuadSample (sampleIndex, fl, fr, rr, rl);
+        if (profile == SpatialOutputProfile::Virtual3dStereo)
+        {
+            // Simple crossfeed/Haas-style stereo virtualization from quad bed.
+            return { { { 0.74f, 0.12f, 0.08f, 0.46f },
+                       { 0.12f, 0.74f, 0.46f, 0.08f } } };
+        }
+
+        if (profile == SpatialOutputProfile::AmbisonicFOA || profile == SpatialOutputProfile::AmbisonicHOA)
+        {
+            // FOA proxy encode + stereo decode is linear in the bed; probe it per speaker.
+            QuadToStereoMatrix matrix {};
+            for (size_t spk = 0; spk < static_cast<size_t> (NUM_SPEAKERS); ++spk)
+            {
+                std::array<float, NUM_SPEAKERS> bed {};
+                bed[spk] = 1.0f;
+                float w = 0.0f;
+                float x = 0.0f;
+                float y = 0.0f;
+                float z = 0.0f;
+                encodeAmbisonicFoaProxyFromQuad (bed[0], bed[1], bed[2], bed[3], w, x, y, z);
+                decodeAmbisonicFoaProxyToStereo (w, x, y, z, matrix[0][spk], matrix[1][spk]);
+            }
+            return matrix;
+        }
+
         // Legacy headphone path: FL+RL -> Left, FR+RR -> Right.
-        left = (fl + rl) * 0.707f;
-        right = (fr + rr) * 0.707f;
+        return { { { 0.707f, 0.0f, 0.0f, 0.707f },
+                   { 0.0f, 0.707f, 0.707f, 0.0f } } };
+    }
+
+    static void mixQuadToStereo (const std::array<const float*, NUM_SPEAKERS>& quad,
+                                 const QuadToStereoMatrix& matrix,
+                                 float* left,
+                                 float* right,
+                                 int numSamples) noexcept
+    {
+        const std::array<float*, 2> outputs { left, right };
+        for (size_t ear = 0; ear < outputs.size(); ++ear)
+        {
+            juce::FloatVectorOperations::clear (outputs[ear], numSamples);
+            for (size_t spk = 0; spk < static_cast<size_t> (NUM_SPEAKERS); ++spk)
+            {
+                if (matrix[ear][spk] != 0.0f)
+                    juce::FloatVectorOperations::addWithMultiply (outputs[ear], quad[spk], matrix[ear][spk], numSamples);
+            }
+        }
     }
 
     void resetHeadphoneCompensationState() noexcept
@@ -4461,23 +5695,10 @@ private:
 
         if (canUseHeadPoseRotation)
         {
-            for (int i = 0; i < numSamples; ++i)
-            {
-                const float sourceFl = accumBuffer.getSample (0, i);
-                const float sourceFr = accumBuffer.getSample (1, i);
-                const float sourceRr = accumBuffer.getSample (2, i);
-                const float sourceRl = accumBuffer.getSample (3, i);
-
-                for (int targetSpeaker = 0; targetSpeaker < NUM_SPEAKERS; ++targetSpeaker)
-                {
-                    const auto& mix = headPoseSpeakerMix[static_cast<size_t> (targetSpeaker)];
-                    headPoseRotatedQuadScratch[static_cast<size_t> (targetSpeaker)][static_cast<size_t> (i)] =
-                        (mix[0] * sourceFl)
-                        + (mix[1] * sourceFr)
-                        + (mix[2] * sourceRr)
-                        + (mix[3] * sourceRl);
-                }
-            }
+            std::array<const float*, NUM_SPEAKERS> source {};
+            for (int spk = 0; spk < NUM_SPEAKERS; ++spk)
+                source[static_cast<size_t> (spk)] = accumBuffer.getReadPointer (spk);
+            mixHeadPoseRotatedQuad (source, numSamples);
 
             // Steam virtual surround expects quad order FL, FR, RL, RR.
             steamInputChannelPtrs[0] = headPoseRotatedQuadScratch[0].data();
@@ -4518,6 +5739,49 @@ private:
 #endif
     }
 
+    // In-tree fallback for SteamBinaural requests: each quad virtual speaker
+    // (post-room accumBuffer) is rendered through the loaded SOFA HRTF set at
+    // its head-relative direction, so head pose moves the speakers rather
+    // than remixing them.
+    bool renderNativeBinauralBlock (int numSamples) noexcept
+    {
+        if (numSamples <= 0
+            || static_cast<int> (nativeBinauralLeft.size()) < numSamples
+            || static_cast<int> (nativeBinauralRight.size()) < numSamples
+            || ! nativeBinauralRenderer.beginBlock())
+        {
+            return false;
+        }
+
+        std::fill (nativeBinauralLeft.begin(), nativeBinauralLeft.begin() + numSamples, 0.0f);
+        std::fill (nativeBinauralRight.begin(), nativeBinauralRight.begin() + numSamples, 0.0f);
+
+        const auto orientation = (headPoseInternalBinauralActive && headPoseValid) ? headPoseOrientation
+                                                                                   : ListenerOrientation {};
+        constexpr float radToDeg = 180.0f / 3.14159265358979323846f;
+
+        for (int speaker = 0; speaker < NUM_SPEAKERS; ++speaker)
+        {
+            const auto& worldDir = kQuadWorldSpeakerDirs[static_cast<size_t> (speaker)];
+            const float relRight = dot3 (worldDir, orientation.right);
+            const float relUp = dot3 (worldDir, orientation.up);
+            const float relFront = -dot3 (worldDir, orientation.ahead);
+
+            const float azimuthDeg = std::atan2 (relRight, relFront) * radToDeg;
+            const float elevationDeg = std::asin (juce::jlimit (-1.0f, 1.0f, relUp)) * radToDeg;
+
+            nativeBinauralRenderer.processSource (speaker,
+                                                  accumBuffer.getReadPointer (speaker),
+                                                  numSamples,
+                                                  azimuthDeg,
+                                                  elevationDeg,
+                                                  nativeBinauralLeft.data(),
+                                                  nativeBinauralRight.data());
+        }
+
+        return true;
+    }
+
     static float calculateDistance (const Vec3& pos)
     {
         return std::sqrt (pos.x * pos.x + pos.y * pos.y + pos.z * pos.z);
@@ -97,6 +97,29 @@ public:
         Only valid after prepare() with Type::LogSweep. */
     const std::vector<float>& getInverseFilter() const { return inverseFilter_; }
 
+    /** Mix a window of the prepared sweep into output without advancing playback,
+        so several outputs can play the same sweep at different offsets.
+        Real-time safe. Only valid after prepare() with Type::LogSweep.
+        @param output         Destination buffer (added to, not overwritten).
+        @param numSamples     Window length.
+        @param sweepPosition  Sweep sample index of output[0]; may be negative. */
+    void addSweepWindow (float* output, int numSamples, int sweepPosition) const
+    {
+        const int N     = static_cast<int> (sweepBuffer_.size());
+        const int begin = std::max (0, -sweepPosition);
+        const int end   = std::min (numSamples, N - sweepPosition);
+        for (int i = begin; i < end; ++i)
+            output[i] += sweepBuffer_[static_cast<size_t> (sweepPosition + i)] * levelGain_;
+    }
+
+    /** Time by which the k-th harmonic distortion product of a log sweep
+        precedes the linear IR after deconvolution (Farina). */
+    static double harmonicLeadSeconds (float durationSeconds, int harmonic)
+    {
+        return static_cast<double> (durationSeconds) * std::log (static_cast<double> (std::max (1, harmonic)))
+             / std::log (static_cast<double> (SWEEP_F2) / static_cast<double> (SWEEP_F1));
+    }
+
 private:
     //==========================================================================
     void buildLogSweep (float durationSeconds)
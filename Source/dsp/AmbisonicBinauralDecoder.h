@@ -0,0 +1,477 @@
+/**
+ * AmbisonicBinauralDecoder.h
+ *
+ * Binaural decode of a 3rd-order ACN/SN3D bus with one FIR pair per SH
+ * channel ("SH-domain HRTFs"), so the cost is fixed (16 x 2 partitioned
+ * convolutions) no matter how many emitters were encoded into the bus.
+ *
+ *   ShHrtfFilters            - SH-domain filters fitted from an HrtfSet
+ *                              (message thread).
+ *   AmbisonicBinauralDecoder - uniformly partitioned runtime convolution.
+ *
+ * Fitting: the minimum-phase HRIRs of the HrtfSet grid get the interaural
+ * delay back (as +-ITD/2 around the common delay) below ~1 kHz, where a
+ * 3rd-order field can still carry it, and only the common delay above
+ * ~2 kHz. A regularised, area-weighted least-squares projection onto N3D
+ * harmonics is then taken per frequency bin.
+ * The grid does not cover the lower cap, which the regularisation absorbs.
+ *
+ * Real-time contract: beginBlock()/process() never allocate or lock.
+ */
+
+#pragma once
+
+#include "HrtfBinauralRenderer.h"
+#include "../spatial_renderer/AmbisonicEncoder.h"
+
+#include <juce_dsp/juce_dsp.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <memory>
+#include <vector>
+
+namespace locusq::dsp
+{
+
+//==============================================================================
+struct ShHrtfFilters
+{
+    static constexpr int kOrder = 3;
+    static constexpr int kNumChannels = (kOrder + 1) * (kOrder + 1);
+    static constexpr int kFitFftOrder = 9;
+    static constexpr int kFitFftSize = 1 << kFitFftOrder;
+    static constexpr float kItdFullBelowHz = 1000.0f;
+    static constexpr float kItdNoneAboveHz = 2000.0f;
+    static constexpr double kPreRingSamples = 16.0;
+
+    double sampleRate = 0.0;
+    int numPartitions = 0;
+    std::vector<float> spectra; // [channel][ear][HrtfSet::kFilterFloats]
+
+    const float* getSpectra (int channel, int ear) const noexcept
+    {
+        return spectra.data() + static_cast<size_t> (((channel * 2) + ear) * HrtfSet::kFilterFloats);
+    }
+
+    //--------------------------------------------------------------------------
+    // Not real-time safe. Filters expect an SN3D-normalised bus.
+    static std::shared_ptr<const ShHrtfFilters> build (const HrtfSet& set)
+    {
+        if (set.numPartitions <= 0 || set.sampleRate <= 0.0)
+            return {};
+
+        constexpr int numDirections = HrirGrid::kNumDirections;
+        constexpr int numBins = (kFitFftSize / 2) + 1;
+        constexpr double pi = 3.14159265358979323846;
+        constexpr double degToRad = pi / 180.0;
+
+        //----------------------------------------------------------------------
+        // Basis (N3D) and area weights for every grid direction.
+        std::vector<std::array<double, kNumChannels>> basis (static_cast<size_t> (numDirections));
+        std::vector<double> weights (static_cast<size_t> (numDirections), 0.0);
+        const double azimuthStep = HrirGrid::kAzimuthStepDeg * degToRad;
+        const double elevationStep = HrirGrid::kElevationStepDeg * degToRad;
+
+        for (int e = 0; e < HrirGrid::kNumElevations; ++e)
+        {
+            const double elevation = (HrirGrid::kElevationMinDeg + (static_cast<double> (e) * HrirGrid::kElevationStepDeg)) * degToRad;
+            const bool pole = std::abs (std::abs (elevation) - (pi * 0.5)) < 1.0e-6;
+            const double cellArea = pole ? (2.0 * pi * (1.0 - std::cos (elevationStep * 0.5))) / HrirGrid::kNumAzimuths
+                                         : std::cos (elevation) * azimuthStep * elevationStep;
+
+            for (int a = 0; a < HrirGrid::kNumAzimuths; ++a)
+            {
+                const double azimuth = static_cast<double> (a) * azimuthStep;
+                const auto sceneX = static_cast<float> (std::sin (azimuth) * std::cos (elevation));
+                const auto sceneY = static_cast<float> (std::sin (elevation));
+                const auto sceneZ = static_cast<float> (std::cos (azimuth) * std::cos (elevation));
+
+                ambisonic_encoder::ShCoefficients sn3d {};
+                ambisonic_encoder::evaluateSn3d (sceneZ, -sceneX, sceneY, sn3d);
+
+                const auto direction = static_cast<size_t> (HrirGrid::directionIndex (e, a));
+                for (int ch = 0; ch < kNumChannels; ++ch)
+                {
+                    const auto order = ambisonic_encoder::orderForChannel (ch);
+                    basis[direction][static_cast<size_t> (ch)] =
+                        static_cast<double> (sn3d[static_cast<size_t> (ch)]) * std::sqrt ((2.0 * order) + 1.0);
+                }
+                weights[direction] = cellArea;
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // projection = (B^T W B + lambda I)^-1 B^T W
+        std::array<std::array<double, 2 * kNumChannels>, kNumChannels> gram {};
+        for (int d = 0; d < numDirections; ++d)
+        {
+            const auto& y = basis[static_cast<size_t> (d)];
+            const auto w = weights[static_cast<size_t> (d)];
+            for (size_t i = 0; i < kNumChannels; ++i)
+                for (size_t j = 0; j < kNumChannels; ++j)
+                    gram[i][j] += w * y[i] * y[j];
+        }
+
+        double trace = 0.0;
+        for (size_t i = 0; i < kNumChannels; ++i)
+            trace += gram[i][i];
+        const double lambda = 1.0e-2 * trace / kNumChannels;
+
+        for (size_t i = 0; i < kNumChannels; ++i)
+        {
+            gram[i][i] += lambda;
+            gram[i][kNumChannels + i] = 1.0;
+        }
+
+        if (! invertAugmented (gram))
+            return {};
+
+        std::vector<std::array<double, kNumChannels>> projection (static_cast<size_t> (numDirections));
+        for (int d = 0; d < numDirections; ++d)
+        {
+            const auto& y = basis[static_cast<size_t> (d)];
+            const auto w = weights[static_cast<size_t> (d)];
+            for (size_t i = 0; i < kNumChannels; ++i)
+            {
+                double sum = 0.0;
+                for (size_t j = 0; j < kNumChannels; ++j)
+                    sum += gram[i][kNumChannels + j] * y[j];
+                projection[static_cast<size_t> (d)][i] = sum * w;
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // Grid HRTFs on the fitting FFT, with band-limited ITD re-applied.
+        // The common delay must cover half the largest ITD plus some headroom for
+        // the pre-ringing of fractional delays, or the leading ear wraps around
+        // the fitting FFT and is lost when the taps are truncated.
+        double commonDelay = 0.0;
+        double maxHalfItd = 0.0;
+        for (const auto delay : set.delaySamples)
+            commonDelay += static_cast<double> (delay);
+        commonDelay /= static_cast<double> (juce::jmax<size_t> (1, set.delaySamples.size()));
+        for (int d = 0; d < numDirections; ++d)
+            maxHalfItd = juce::jmax (maxHalfItd, 0.5 * std::abs (static_cast<double> (set.getDelay (d, 0) - set.getDelay (d, 1))));
+        commonDelay = juce::jmax (commonDelay, maxHalfItd) + kPreRingSamples;
+
+        const int minimumPhaseTaps = set.numPartitions * HrtfSet::kPartitionSize;
+        juce::dsp::FFT partitionFft (HrtfSet::kFftOrder);
+        juce::dsp::FFT fitFft (kFitFftOrder);
+        std::array<float, 2 * HrtfSet::kFftSize> partitionScratch {};
+        std::vector<float> fitScratch (static_cast<size_t> (2 * kFitFftSize), 0.0f);
+
+        std::vector<float> itdBlend (static_cast<size_t> (numBins), 0.0f);
+        for (int bin = 0; bin < numBins; ++bin)
+        {
+            const auto frequency = static_cast<float> (bin * set.sampleRate / kFitFftSize);
+            auto blend = 0.0f;
+            if (frequency <= kItdFullBelowHz)
+                blend = 1.0f;
+            else if (frequency < kItdNoneAboveHz)
+                blend = 0.5f + 0.5f * std::cos (juce::MathConstants<float>::pi * (frequency - kItdFullBelowHz)
+                                                / (kItdNoneAboveHz - kItdFullBelowHz));
+            itdBlend[static_cast<size_t> (bin)] = blend;
+        }
+
+        using Complex = std::complex<double>;
+        std::vector<Complex> shSpectra (static_cast<size_t> (kNumChannels * 2 * numBins), Complex {});
+        std::vector<Complex> directionSpectrum (static_cast<size_t> (numBins));
+
+        for (int d = 0; d < numDirections; ++d)
+        {
+            for (int ear = 0; ear < 2; ++ear)
+            {
+                std::fill (fitScratch.begin(), fitScratch.end(), 0.0f);
+                const auto* spectrum = set.getSpectra (d, ear);
+                for (int partition = 0; partition < set.numPartitions; ++partition)
+                {
+                    std::fill (partitionScratch.begin(), partitionScratch.end(), 0.0f);
+                    std::copy_n (spectrum + (partition * HrtfSet::kSpectrumFloats), HrtfSet::kSpectrumFloats, partitionScratch.data());
+                    partitionFft.performRealOnlyInverseTransform (partitionScratch.data());
+                    std::copy_n (partitionScratch.data(),
+                                 HrtfSet::kPartitionSize,
+                                 fitScratch.data() + (partition * HrtfSet::kPartitionSize));
+                }
+
+                fitFft.performRealOnlyForwardTransform (fitScratch.data(), true);
+
+                // Symmetric +-ITD/2 around the common delay is far smoother over
+                // the sphere than the raw per-ear onsets, so it survives order 3.
+                const auto interauralDelay = static_cast<double> (set.getDelay (d, 0) - set.getDelay (d, 1));
+                const auto earOffset = (ear == 0 ? 0.5 : -0.5) * interauralDelay;
+                for (int bin = 0; bin < numBins; ++bin)
+                {
+                    const double blend = itdBlend[static_cast<size_t> (bin)];
+                    const double effectiveDelay = commonDelay + (earOffset * blend);
+                    const double phase = -2.0 * pi * bin * effectiveDelay / kFitFftSize;
+                    const Complex value (fitScratch[static_cast<size_t> (2 * bin)], fitScratch[static_cast<size_t> ((2 * bin) + 1)]);
+                    directionSpectrum[static_cast<size_t> (bin)] = value * std::polar (1.0, phase);
+                }
+
+                const auto& p = projection[static_cast<size_t> (d)];
+                for (int ch = 0; ch < kNumChannels; ++ch)
+                {
+                    const auto weight = p[static_cast<size_t> (ch)];
+                    auto* destination = shSpectra.data() + static_cast<size_t> (((ch * 2) + ear) * numBins);
+                    for (int bin = 0; bin < numBins; ++bin)
+                        destination[bin] += weight * directionSpectrum[static_cast<size_t> (bin)];
+                }
+            }
+        }
+
+        //----------------------------------------------------------------------
+        // Back to taps (SN3D scaling folded in), truncated and partitioned.
+        auto filters = std::make_shared<ShHrtfFilters>();
+        filters->sampleRate = set.sampleRate;
+        const int tapCount = juce::jmin (HrtfSet::kMaxTaps,
+                                         minimumPhaseTaps + static_cast<int> (std::ceil (HrtfSet::kMaxDelaySamples)));
+        filters->numPartitions = (tapCount + HrtfSet::kPartitionSize - 1) / HrtfSet::kPartitionSize;
+        filters->spectra.assign (static_cast<size_t> (kNumChannels * 2 * HrtfSet::kFilterFloats), 0.0f);
+
+        constexpr int taper = 16;
+        for (int ch = 0; ch < kNumChannels; ++ch)
+        {
+            const auto sn3dScale = std::sqrt ((2.0 * ambisonic_encoder::orderForChannel (ch)) + 1.0);
+            for (int ear = 0; ear < 2; ++ear)
+            {
+                const auto* source = shSpectra.data() + static_cast<size_t> (((ch * 2) + ear) * numBins);
+                std::fill (fitScratch.begin(), fitScratch.end(), 0.0f);
+                for (int bin = 0; bin < numBins; ++bin)
+                {
+                    fitScratch[static_cast<size_t> (2 * bin)] = static_cast<float> (source[bin].real() * sn3dScale);
+                    fitScratch[static_cast<size_t> ((2 * bin) + 1)] = static_cast<float> (source[bin].imag() * sn3dScale);
+                }
+                fitFft.performRealOnlyInverseTransform (fitScratch.data());
+
+                for (int i = 0; i < tapCount; ++i)
+                {
+                    const auto fromEnd = tapCount - 1 - i;
+                    if (fromEnd < taper)
+                        fitScratch[static_cast<size_t> (i)] *= 0.5f - 0.5f * std::cos (juce::MathConstants<float>::pi
+                                                                                        * static_cast<float> (fromEnd)
+                                                                                        / static_cast<float> (taper));
+                }
+
+                auto* destination = filters->spectra.data() + static_cast<size_t> (((ch * 2) + ear) * HrtfSet::kFilterFloats);
+                for (int partition = 0; partition < filters->numPartitions; ++partition)
+                {
+                    const auto offset = partition * HrtfSet::kPartitionSize;
+                    const auto count = juce::jmin (HrtfSet::kPartitionSize, tapCount - offset);
+                    std::fill (partitionScratch.begin(), partitionScratch.end(), 0.0f);
+                    std::copy_n (fitScratch.data() + offset, count, partitionScratch.data());
+                    partitionFft.performRealOnlyForwardTransform (partitionScratch.data(), true);
+                    std::copy_n (partitionScratch.data(), HrtfSet::kSpectrumFloats, destination + (partition * HrtfSet::kSpectrumFloats));
+                }
+            }
+        }
+
+        return filters;
+    }
+
+private:
+    // Gauss-Jordan with partial pivoting on [A | I]; leaves A^-1 in the right half.
+    static bool invertAugmented (std::array<std::array<double, 2 * kNumChannels>, kNumChannels>& m) noexcept
+    {
+        for (size_t column = 0; column < kNumChannels; ++column)
+        {
+            size_t pivot = column;
+            for (size_t row = column + 1; row < kNumChannels; ++row)
+                if (std::abs (m[row][column]) > std::abs (m[pivot][column]))
+                    pivot = row;
+
+            if (std::abs (m[pivot][column]) < 1.0e-12)
+                return false;
+
+            std::swap (m[column], m[pivot]);
+            const auto invPivot = 1.0 / m[column][column];
+            for (auto& value : m[column])
+                value *= invPivot;
+
+            for (size_t row = 0; row < kNumChannels; ++row)
+            {
+                if (row == column)
+                    continue;
+
+                const auto factor = m[row][column];
+                if (factor == 0.0)
+                    continue;
+
+                for (size_t k = 0; k < 2 * kNumChannels; ++k)
+                    m[row][k] -= factor * m[column][k];
+            }
+        }
+
+        return true;
+    }
+};
+
+//==============================================================================
+class AmbisonicBinauralDecoder
+{
+public:
+    static constexpr int kNumChannels = ShHrtfFilters::kNumChannels;
+
+    AmbisonicBinauralDecoder()
+        : fft (HrtfSet::kFftOrder)
+    {
+    }
+
+    void prepare (double sampleRate) noexcept
+    {
+        preparedSampleRate = sampleRate;
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& window : inputWindows)
+            window.fill (0.0f);
+        for (auto& spectra : inputSpectra)
+            spectra.fill (0.0f);
+        for (auto& output : outputs)
+            output.fill (0.0f);
+        spectraHead = 0;
+        fifoPosition = 0;
+    }
+
+    // Message thread; the publisher retains filter sets until the audio
+    // thread has moved past them, so it never releases the last reference.
+    void setFilters (std::shared_ptr<const ShHrtfFilters> filters)
+    {
+        publishedFilters.publish (std::move (filters));
+    }
+
+    // Message thread. Frees filter sets the audio thread has moved past.
+    void releaseRetiredFilters()
+    {
+        publishedFilters.releaseRetired();
+    }
+
+    bool hasFilters() const noexcept
+    {
+        return publishedFilters.load() != nullptr;
+    }
+
+    int getLatencySamples() const noexcept
+    {
+        return HrtfSet::kPartitionSize;
+    }
+
+    // Audio thread, once per block. Returns true when filters matching the
+    // prepared sample rate are active.
+    bool beginBlock() noexcept
+    {
+        auto latest = publishedFilters.load();
+        if (latest.get() != activeFilters.get())
+        {
+            activeFilters = std::move (latest);
+            reset();
+        }
+
+        return activeFilters != nullptr
+               && std::abs (activeFilters->sampleRate - preparedSampleRate) < 0.5;
+    }
+
+    // Decodes numChannels (<= 16, ACN/SN3D) into outLeft/outRight (overwritten).
+    // Output is delayed by getLatencySamples().
+    void process (const float* const* channels, int numChannels, int numSamples, float* outLeft, float* outRight) noexcept
+    {
+        if (activeFilters == nullptr || channels == nullptr || numSamples <= 0)
+            return;
+
+        const auto usedChannels = juce::jlimit (0, kNumChannels, numChannels);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            for (int ch = 0; ch < usedChannels; ++ch)
+            {
+                const auto x = channels[ch][i];
+                inputWindows[static_cast<size_t> (ch)][static_cast<size_t> (HrtfSet::kPartitionSize + fifoPosition)] =
+                    std::isfinite (x) ? x : 0.0f;
+            }
+
+            outLeft[i] = outputs[0][static_cast<size_t> (fifoPosition)];
+            outRight[i] = outputs[1][static_cast<size_t> (fifoPosition)];
+
+            if (++fifoPosition == HrtfSet::kPartitionSize)
+            {
+                processPartition (usedChannels);
+                fifoPosition = 0;
+            }
+        }
+    }
+
+private:
+    void processPartition (int usedChannels) noexcept
+    {
+        const auto numPartitions = activeFilters->numPartitions;
+        spectraHead = (spectraHead + 1) % HrtfSet::kMaxPartitions;
+
+        for (int ch = 0; ch < usedChannels; ++ch)
+        {
+            auto& window = inputWindows[static_cast<size_t> (ch)];
+            std::fill (scratch.begin(), scratch.end(), 0.0f);
+            std::copy (window.begin(), window.end(), scratch.begin());
+            fft.performRealOnlyForwardTransform (scratch.data(), true);
+            std::copy_n (scratch.data(),
+                         HrtfSet::kSpectrumFloats,
+                         inputSpectra[static_cast<size_t> (ch)].data() + (spectraHead * HrtfSet::kSpectrumFloats));
+            std::copy_n (window.data() + HrtfSet::kPartitionSize, HrtfSet::kPartitionSize, window.data());
+        }
+
+        for (int ear = 0; ear < 2; ++ear)
+        {
+            accumulator.fill (0.0f);
+
+            for (int ch = 0; ch < usedChannels; ++ch)
+            {
+                const auto* filter = activeFilters->getSpectra (ch, ear);
+                const auto& history = inputSpectra[static_cast<size_t> (ch)];
+
+                for (int partition = 0; partition < numPartitions; ++partition)
+                {
+                    const auto slot = (spectraHead - partition + HrtfSet::kMaxPartitions) % HrtfSet::kMaxPartitions;
+                    const auto* x = history.data() + (slot * HrtfSet::kSpectrumFloats);
+                    const auto* h = filter + (partition * HrtfSet::kSpectrumFloats);
+
+                    for (int bin = 0; bin < HrtfSet::kNumBins; ++bin)
+                    {
+                        const auto re = 2 * bin;
+                        const auto im = re + 1;
+                        accumulator[static_cast<size_t> (re)] += (x[re] * h[re]) - (x[im] * h[im]);
+                        accumulator[static_cast<size_t> (im)] += (x[re] * h[im]) + (x[im] * h[re]);
+                    }
+                }
+            }
+
+            std::fill (scratch.begin(), scratch.end(), 0.0f);
+            std::copy (accumulator.begin(), accumulator.end(), scratch.begin());
+            fft.performRealOnlyInverseTransform (scratch.data());
+
+            auto& output = outputs[static_cast<size_t> (ear)];
+            for (int i = 0; i < HrtfSet::kPartitionSize; ++i)
+            {
+                const auto y = scratch[static_cast<size_t> (HrtfSet::kPartitionSize + i)];
+                output[static_cast<size_t> (i)] = std::isfinite (y) ? y : 0.0f;
+            }
+        }
+    }
+
+    juce::dsp::FFT fft;
+    std::array<float, 2 * HrtfSet::kFftSize> scratch {};
+    std::array<float, HrtfSet::kSpectrumFloats> accumulator {};
+
+    std::array<std::array<float, HrtfSet::kFftSize>, kNumChannels> inputWindows {};
+    std::array<std::array<float, HrtfSet::kFilterFloats>, kNumChannels> inputSpectra {}; // kMaxPartitions ring
+    std::array<std::array<float, HrtfSet::kPartitionSize>, 2> outputs {};
+    int spectraHead = 0;
+    int fifoPosition = 0;
+    double preparedSampleRate = 0.0;
+
+    std::shared_ptr<const ShHrtfFilters> activeFilters;                   // audio thread
+    RetainingSharedPtrPublisher<const ShHrtfFilters> publishedFilters; // message -> audio
+};
+
+} // namespace locusq::dsp
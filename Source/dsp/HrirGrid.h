@@ -0,0 +1,73 @@
+/**
+ * HrirGrid.h
+ *
+ * Plain-data HRIR set resampled onto a regular azimuth/elevation grid.
+ *
+ * This header is deliberately free of JUCE and libmysofa so it can be shared
+ * between the isolated SOFA compilation unit (which fills it) and the JUCE side
+ * (HrtfBinauralRenderer, which converts it into a minimum-phase
+ * frequency-domain grid).
+ *
+ * Conventions (match SpatialRenderer::calculateAzimuth / calculateElevation):
+ *   - azimuth in degrees, 0 = front, clockwise positive (+90 = right),
+ *     grid column a covers azimuth  a * kAzimuthStepDeg  in [0, 360)
+ *   - elevation in degrees, +90 = up, grid row e covers
+ *     kElevationMinDeg + e * kElevationStepDeg
+ *   - taps stored row-major as [elevation][azimuth][tap], one array per ear
+ *   - delays are the per-ear onset delays (samples) reported by the SOFA set
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace locusq::dsp
+{
+
+struct HrirGrid
+{
+    static constexpr float kAzimuthStepDeg = 5.0f;
+    static constexpr float kElevationMinDeg = -40.0f;
+    static constexpr float kElevationMaxDeg = 90.0f;
+    static constexpr float kElevationStepDeg = 10.0f;
+    static constexpr int kNumAzimuths = 72;   // 360 / kAzimuthStepDeg
+    static constexpr int kNumElevations = 14; // (max - min) / step + 1
+    static constexpr int kNumDirections = kNumAzimuths * kNumElevations;
+
+    int sampleRate = 0;
+    int irLength = 0;
+    std::vector<float> left;            // kNumDirections * irLength
+    std::vector<float> right;           // kNumDirections * irLength
+    std::vector<float> leftDelaySamples;  // kNumDirections
+    std::vector<float> rightDelaySamples; // kNumDirections
+
+    static constexpr int directionIndex (int elevationIndex, int azimuthIndex) noexcept
+    {
+        return (elevationIndex * kNumAzimuths) + azimuthIndex;
+    }
+
+    bool isValid() const noexcept
+    {
+        const auto tapCount = static_cast<size_t> (kNumDirections) * static_cast<size_t> (irLength);
+        return sampleRate > 0
+               && irLength > 0
+               && left.size() == tapCount
+               && right.size() == tapCount
+               && leftDelaySamples.size() == static_cast<size_t> (kNumDirections)
+               && rightDelaySamples.size() == static_cast<size_t> (kNumDirections);
+    }
+};
+
+#if defined (LOCUSQ_ENABLE_SOFA) && LOCUSQ_ENABLE_SOFA
+/**
+ * Opens `path`, resamples to `targetSampleRate` and samples the set onto the
+ * HrirGrid directions (libmysofa neighbour interpolation). Implemented in the
+ * isolated SofaHrtfLoader.cpp unit. Not real-time safe: call from the message
+ * thread or a loader thread. Returns false (grid left empty) on any failure or
+ * if any sampled tap is non-finite.
+ */
+bool loadSofaHrirGrid (const std::string& path, int targetSampleRate, HrirGrid& grid);
+#endif
+
+} // namespace locusq::dsp
@@ -0,0 +1,539 @@
+/**
+ * HrtfBinauralRenderer.h
+ *
+ * In-tree binaural renderer used when Steam Audio is unavailable.
+ *
+ *   HrtfSet               - dense minimum-phase, frequency-domain HRTF grid
+ *                           built once from an HrirGrid (message thread).
+ *   HrtfBinauralRenderer  - per-source uniformly partitioned convolution with
+ *                           bilinear HRTF interpolation, pure-delay ITD and a
+ *                           one-partition crossfade when a source moves.
+ *
+ * Minimum-phase filters make bilinear interpolation between neighbouring grid
+ * points well behaved (no comb filtering from misaligned onsets); the removed
+ * onset is re-applied per ear as a fractional delay, so ITD is preserved.
+ *
+ * Real-time contract: processSource()/beginBlock() never allocate or lock.
+ * All per-source buffers are fixed-size and sized in prepare().
+ */
+
+#pragma once
+
+#include "HrirGrid.h"
+#include "../SharedPtrAtomicContract.h"
+
+#include <juce_dsp/juce_dsp.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace locusq::dsp
+{
+
+//==============================================================================
+struct HrtfSet
+{
+    static constexpr int kPartitionSize = 64;
+    static constexpr int kFftOrder = 7;
+    static constexpr int kFftSize = 2 * kPartitionSize;
+    static constexpr int kNumBins = kPartitionSize + 1;
+    static constexpr int kSpectrumFloats = 2 * kNumBins; // interleaved re/im
+    static constexpr int kMaxTaps = 256;
+    static constexpr int kMaxPartitions = kMaxTaps / kPartitionSize;
+    static constexpr int kFilterFloats = kMaxPartitions * kSpectrumFloats;
+    static constexpr float kMaxDelaySamples = 200.0f;
+
+    double sampleRate = 0.0;
+    int numPartitions = 0;
+    std::vector<float> spectra;      // [direction][ear][kFilterFloats]
+    std::vector<float> delaySamples; // [direction][ear]
+
+    const float* getSpectra (int direction, int ear) const noexcept
+    {
+        return spectra.data() + static_cast<size_t> (((direction * 2) + ear) * kFilterFloats);
+    }
+
+    float getDelay (int direction, int ear) const noexcept
+    {
+        return delaySamples[static_cast<size_t> ((direction * 2) + ear)];
+    }
+
+    //--------------------------------------------------------------------------
+    // Not real-time safe. Returns nullptr when the grid is invalid.
+    static std::shared_ptr<const HrtfSet> build (const HrirGrid& grid)
+    {
+        if (! grid.isValid())
+            return {};
+
+        auto set = std::make_shared<HrtfSet>();
+        set->sampleRate = static_cast<double> (grid.sampleRate);
+
+        const auto tapCount = juce::jmin (grid.irLength, kMaxTaps);
+        set->numPartitions = (tapCount + kPartitionSize - 1) / kPartitionSize;
+        set->spectra.assign (static_cast<size_t> (HrirGrid::kNumDirections * 2 * kFilterFloats), 0.0f);
+        set->delaySamples.assign (static_cast<size_t> (HrirGrid::kNumDirections * 2), 0.0f);
+
+        // Cepstral minimum-phase reconstruction; 8x oversampling keeps cepstral aliasing low.
+        const auto cepstrumSize = juce::jlimit (1024, 16384, juce::nextPowerOfTwo (grid.irLength) * 8);
+        int cepstrumOrder = 1;
+        while ((1 << cepstrumOrder) < cepstrumSize)
+            ++cepstrumOrder;
+
+        juce::dsp::FFT cepstrumFft (cepstrumOrder);
+        juce::dsp::FFT partitionFft (kFftOrder);
+        std::vector<float> work (static_cast<size_t> (2 * cepstrumSize), 0.0f);
+        std::vector<float> minimumPhase (static_cast<size_t> (tapCount), 0.0f);
+        std::array<float, 2 * kFftSize> partitionScratch {};
+
+        float minOnset = std::numeric_limits<float>::max();
+
+        for (int direction = 0; direction < HrirGrid::kNumDirections; ++direction)
+        {
+            for (int ear = 0; ear < 2; ++ear)
+            {
+                const auto& taps = (ear == 0) ? grid.left : grid.right;
+                const auto* hrir = taps.data() + static_cast<size_t> (direction * grid.irLength);
+                const auto sofaDelay = (ear == 0) ? grid.leftDelaySamples[static_cast<size_t> (direction)]
+                                                  : grid.rightDelaySamples[static_cast<size_t> (direction)];
+
+                const auto onset = sofaDelay + static_cast<float> (findOnset (hrir, grid.irLength));
+                set->delaySamples[static_cast<size_t> ((direction * 2) + ear)] = onset;
+                minOnset = juce::jmin (minOnset, onset);
+
+                makeMinimumPhase (cepstrumFft, cepstrumSize, hrir, grid.irLength, work, minimumPhase);
+
+                auto* destination = set->spectra.data() + static_cast<size_t> (((direction * 2) + ear) * kFilterFloats);
+                for (int partition = 0; partition < set->numPartitions; ++partition)
+                {
+                    const auto offset = partition * kPartitionSize;
+                    const auto count = juce::jmin (kPartitionSize, tapCount - offset);
+
+                    std::fill (partitionScratch.begin(), partitionScratch.end(), 0.0f);
+                    std::copy_n (minimumPhase.data() + offset, count, partitionScratch.data());
+                    partitionFft.performRealOnlyForwardTransform (partitionScratch.data(), true);
+                    std::copy_n (partitionScratch.data(), kSpectrumFloats, destination + (partition * kSpectrumFloats));
+                }
+            }
+        }
+
+        // Remove the common bulk delay so only the interaural/directional part remains.
+        for (auto& delay : set->delaySamples)
+            delay = juce::jlimit (0.0f, kMaxDelaySamples, delay - minOnset);
+
+        return set;
+    }
+
+private:
+    static int findOnset (const float* hrir, int length) noexcept
+    {
+        float peak = 0.0f;
+        for (int i = 0; i < length; ++i)
+            peak = juce::jmax (peak, std::abs (hrir[i]));
+
+        const auto threshold = 0.1f * peak;
+        for (int i = 0; i < length; ++i)
+        {
+            if (std::abs (hrir[i]) >= threshold)
+                return juce::jmax (0, i - 1);
+        }
+
+        return 0;
+    }
+
+    static void makeMinimumPhase (juce::dsp::FFT& fft,
+                                  int size,
+                                  const float* hrir,
+                                  int length,
+                                  std::vector<float>& work,
+                                  std::vector<float>& output)
+    {
+        const auto half = size / 2;
+
+        // log|H|
+        std::fill (work.begin(), work.end(), 0.0f);
+        std::copy_n (hrir, juce::jmin (length, size), work.data());
+        fft.performRealOnlyForwardTransform (work.data(), true);
+        for (int bin = 0; bin <= half; ++bin)
+        {
+            const auto re = work[static_cast<size_t> (2 * bin)];
+            const auto im = work[static_cast<size_t> ((2 * bin) + 1)];
+            work[static_cast<size_t> (2 * bin)] = std::log (juce::jmax (1.0e-7f, std::sqrt ((re * re) + (im * im))));
+            work[static_cast<size_t> ((2 * bin) + 1)] = 0.0f;
+        }
+
+        // Real cepstrum, folded onto the causal half.
+        fft.performRealOnlyInverseTransform (work.data());
+        for (int n = 1; n < half; ++n)
+            work[static_cast<size_t> (n)] *= 2.0f;
+        std::fill (work.begin() + half + 1, work.end(), 0.0f);
+
+        // exp() of the analytic log spectrum -> minimum-phase spectrum.
+        fft.performRealOnlyForwardTransform (work.data(), true);
+        for (int bin = 0; bin <= half; ++bin)
+        {
+            const auto magnitude = std::exp (work[static_cast<size_t> (2 * bin)]);
+            const auto phase = work[static_cast<size_t> ((2 * bin) + 1)];
+            work[static_cast<size_t> (2 * bin)] = magnitude * std::cos (phase);
+            work[static_cast<size_t> ((2 * bin) + 1)] = magnitude * std::sin (phase);
+        }
+
+        fft.performRealOnlyInverseTransform (work.data());
+
+        // Truncate with a short half-Hann taper.
+        const auto tapCount = static_cast<int> (output.size());
+        const auto taper = juce::jmin (16, tapCount);
+        for (int i = 0; i < tapCount; ++i)
+        {
+            auto gain = 1.0f;
+            const auto fromEnd = tapCount - 1 - i;
+            if (fromEnd < taper)
+                gain = 0.5f - 0.5f * std::cos (juce::MathConstants<float>::pi * static_cast<float> (fromEnd) / static_cast<float> (taper));
+            output[static_cast<size_t> (i)] = work[static_cast<size_t> (i)] * gain;
+        }
+    }
+};
+
+//==============================================================================
+class HrtfBinauralRenderer
+{
+public:
+    static constexpr int kMaxSources = 8;
+    static constexpr int kDelayLineSize = 256; // power of two, > HrtfSet::kMaxDelaySamples + 2
+    static constexpr float kDirectionEpsilonDeg = 0.25f;
+
+    HrtfBinauralRenderer()
+        : fft (HrtfSet::kFftOrder)
+    {
+    }
+
+    void prepare (double sampleRate)
+    {
+        preparedSampleRate = sampleRate;
+        sources.resize (static_cast<size_t> (kMaxSources));
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        for (auto& source : sources)
+            source = SourceState {};
+    }
+
+    //--------------------------------------------------------------------------
+    // Message thread. The publisher retains every published set until
+    // neither the published slot nor the audio thread still holds it, so the
+    // audio thread never drops the last reference (and never frees) a set
+    // however quickly sets are replaced.
+    void setHrtfSet (std::shared_ptr<const HrtfSet> set)
+    {
+        publishedSet.publish (std::move (set));
+    }
+
+    // Message thread. Frees sets the audio thread has moved past.
+    void releaseRetiredSets()
+    {
+        publishedSet.releaseRetired();
+    }
+
+    bool hasHrtfSet() const noexcept
+    {
+        return publishedSet.load() != nullptr;
+    }
+
+    int getLatencySamples() const noexcept
+    {
+        return HrtfSet::kPartitionSize;
+    }
+
+    //--------------------------------------------------------------------------
+    // Audio thread, once per block. Adopts a newly published set (sources are
+    // reset because filter/FDL contents belong to the old set). Returns true
+    // when a set matching the prepared sample rate is active.
+    bool beginBlock() noexcept
+    {
+        auto latest = publishedSet.load();
+        if (latest.get() != activeSet.get())
+        {
+            activeSet = std::move (latest);
+            reset();
+        }
+
+        return activeSet != nullptr
+               && ! sources.empty()
+               && std::abs (activeSet->sampleRate - preparedSampleRate) < 0.5;
+    }
+
+    // Renders one mono source at a head-relative direction (degrees, renderer
+    // convention) and accumulates into outLeft/outRight. Output is delayed by
+    // getLatencySamples().
+    void processSource (int sourceIndex,
+                        const float* input,
+                        int numSamples,
+                        float azimuthDeg,
+                        float elevationDeg,
+                        float* outLeft,
+                        float* outRight) noexcept
+    {
+        if (activeSet == nullptr
+            || sourceIndex < 0
+            || sourceIndex >= static_cast<int> (sources.size())
+            || input == nullptr
+            || numSamples <= 0)
+        {
+            return;
+        }
+
+        auto& source = sources[static_cast<size_t> (sourceIndex)];
+        updateSourceDirection (source, azimuthDeg, elevationDeg);
+
+        const auto invNumSamples = 1.0f / static_cast<float> (numSamples);
+        std::array<float, 2> delayStep {};
+        for (size_t ear = 0; ear < 2; ++ear)
+            delayStep[ear] = (source.targetDelay[ear] - source.currentDelay[ear]) * invNumSamples;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto x = input[i];
+            source.delayLine[static_cast<size_t> (source.delayWrite)] = std::isfinite (x) ? x : 0.0f;
+
+            for (size_t ear = 0; ear < 2; ++ear)
+            {
+                source.currentDelay[ear] += delayStep[ear];
+                source.inputWindow[ear][static_cast<size_t> (HrtfSet::kPartitionSize + source.fifoPosition)] =
+                    readDelayed (source, source.currentDelay[ear]);
+            }
+
+            source.delayWrite = (source.delayWrite + 1) & (kDelayLineSize - 1);
+
+            outLeft[i] += source.output[0][static_cast<size_t> (source.fifoPosition)];
+            outRight[i] += source.output[1][static_cast<size_t> (source.fifoPosition)];
+
+            if (++source.fifoPosition == HrtfSet::kPartitionSize)
+            {
+                processPartition (source);
+                source.fifoPosition = 0;
+            }
+        }
+
+        source.currentDelay = source.targetDelay;
+    }
+
+private:
+    using Spectrum = std::array<float, HrtfSet::kFilterFloats>;
+
+    struct SourceState
+    {
+        std::array<float, kDelayLineSize> delayLine {};
+        int delayWrite = 0;
+        std::array<float, 2> currentDelay {};
+        std::array<float, 2> targetDelay {};
+
+        std::array<std::array<float, HrtfSet::kFftSize>, 2> inputWindow {};
+        std::array<std::array<float, HrtfSet::kPartitionSize>, 2> output {};
+        std::array<Spectrum, 2> delayLineSpectra {}; // [ear], kMaxPartitions ring
+        int spectraHead = 0;
+        int fifoPosition = 0;
+
+        std::array<std::array<Spectrum, 2>, 2> filters {}; // [bank][ear]
+        int activeBank = 0;
+        bool fadePending = false;
+        bool hasFilter = false;
+        float lastAzimuthDeg = 0.0f;
+        float lastElevationDeg = 0.0f;
+    };
+
+    static float wrapDegrees (float degrees) noexcept
+    {
+        auto wrapped = std::fmod (degrees, 360.0f);
+        if (wrapped < 0.0f)
+            wrapped += 360.0f;
+        return wrapped;
+    }
+
+    float readDelayed (const SourceState& source, float delaySamples) const noexcept
+    {
+        // Linear fractional read; delayWrite holds the newest sample.
+        const auto position = static_cast<float> (source.delayWrite) - delaySamples;
+        const auto base = static_cast<int> (std::floor (position));
+        const auto frac = position - static_cast<float> (base);
+        const auto i0 = base & (kDelayLineSize - 1);
+        const auto i1 = (base + 1) & (kDelayLineSize - 1);
+        const auto a = source.delayLine[static_cast<size_t> (i0)];
+        const auto b = source.delayLine[static_cast<size_t> (i1)];
+        return a + ((b - a) * frac);
+    }
+
+    void updateSourceDirection (SourceState& source, float azimuthDeg, float elevationDeg) noexcept
+    {
+        if (! std::isfinite (azimuthDeg) || ! std::isfinite (elevationDeg))
+            return;
+
+        auto azimuthDelta = std::abs (wrapDegrees (azimuthDeg) - wrapDegrees (source.lastAzimuthDeg));
+        azimuthDelta = juce::jmin (azimuthDelta, 360.0f - azimuthDelta);
+        if (source.hasFilter
+            && azimuthDelta < kDirectionEpsilonDeg
+            && std::abs (elevationDeg - source.lastElevationDeg) < kDirectionEpsilonDeg)
+        {
+            return;
+        }
+
+        // Before the first filter there is nothing to blend from; otherwise the
+        // idle bank takes the target and is blended in at the next partition.
+        const auto bank = source.hasFilter ? 1 - source.activeBank : source.activeBank;
+        interpolateFilter (azimuthDeg, elevationDeg, source.filters[static_cast<size_t> (bank)], source.targetDelay);
+
+        if (source.hasFilter)
+        {
+            source.fadePending = true;
+        }
+        else
+        {
+            source.currentDelay = source.targetDelay;
+            source.hasFilter = true;
+        }
+
+        source.lastAzimuthDeg = azimuthDeg;
+        source.lastElevationDeg = elevationDeg;
+    }
+
+    // Bilinear blend of the four surrounding grid directions (spectra + delays).
+    void interpolateFilter (float azimuthDeg,
+                            float elevationDeg,
+                            std::array<Spectrum, 2>& destination,
+                            std::array<float, 2>& delays) const noexcept
+    {
+        const auto azimuthPosition = wrapDegrees (azimuthDeg) / HrirGrid::kAzimuthStepDeg;
+        const auto a0 = static_cast<int> (azimuthPosition) % HrirGrid::kNumAzimuths;
+        const auto a1 = (a0 + 1) % HrirGrid::kNumAzimuths;
+        const auto fa = azimuthPosition - std::floor (azimuthPosition);
+
+        const auto clampedElevation = juce::jlimit (HrirGrid::kElevationMinDeg, HrirGrid::kElevationMaxDeg, elevationDeg);
+        const auto elevationPosition = (clampedElevation - HrirGrid::kElevationMinDeg) / HrirGrid::kElevationStepDeg;
+        const auto e0 = juce::jmin (static_cast<int> (elevationPosition), HrirGrid::kNumElevations - 2);
+        const auto e1 = e0 + 1;
+        const auto fe = juce::jlimit (0.0f, 1.0f, elevationPosition - static_cast<float> (e0));
+
+        const std::array<int, 4> directions {
+            HrirGrid::directionIndex (e0, a0),
+            HrirGrid::directionIndex (e0, a1),
+            HrirGrid::directionIndex (e1, a0),
+            HrirGrid::directionIndex (e1, a1)
+        };
+        const std::array<float, 4> weights {
+            (1.0f - fa) * (1.0f - fe),
+            fa * (1.0f - fe),
+            (1.0f - fa) * fe,
+            fa * fe
+        };
+
+        const auto filterFloats = activeSet->numPartitions * HrtfSet::kSpectrumFloats;
+        for (int ear = 0; ear < 2; ++ear)
+        {
+            auto& spectrum = destination[static_cast<size_t> (ear)];
+            std::fill (spectrum.begin(), spectrum.end(), 0.0f);
+            auto delay = 0.0f;
+
+            for (size_t corner = 0; corner < directions.size(); ++corner)
+            {
+                const auto weight = weights[corner];
+                const auto* source = activeSet->getSpectra (directions[corner], ear);
+                for (int i = 0; i < filterFloats; ++i)
+                    spectrum[static_cast<size_t> (i)] += weight * source[i];
+                delay += weight * activeSet->getDelay (directions[corner], ear);
+            }
+
+            delays[static_cast<size_t> (ear)] = delay;
+        }
+    }
+
+    void processPartition (SourceState& source) noexcept
+    {
+        const auto numPartitions = activeSet->numPartitions;
+        source.spectraHead = (source.spectraHead + 1) % HrtfSet::kMaxPartitions;
+
+        for (size_t ear = 0; ear < 2; ++ear)
+        {
+            std::fill (scratch.begin(), scratch.end(), 0.0f);
+            std::copy (source.inputWindow[ear].begin(), source.inputWindow[ear].end(), scratch.begin());
+            fft.performRealOnlyForwardTransform (scratch.data(), true);
+            std::copy_n (scratch.data(),
+                         HrtfSet::kSpectrumFloats,
+                         source.delayLineSpectra[ear].data() + (source.spectraHead * HrtfSet::kSpectrumFloats));
+
+            auto& output = source.output[ear];
+            convolve (source, source.filters[static_cast<size_t> (source.activeBank)][ear], ear, numPartitions, output.data());
+
+            if (source.fadePending)
+            {
+                // Old and incoming HRTFs see the same input history, so a
+                // one-partition linear blend gives a click-free transition.
+                convolve (source, source.filters[static_cast<size_t> (1 - source.activeBank)][ear], ear, numPartitions, fadeScratch.data());
+                const auto invLength = 1.0f / static_cast<float> (HrtfSet::kPartitionSize);
+                for (int i = 0; i < HrtfSet::kPartitionSize; ++i)
+                {
+                    const auto blend = static_cast<float> (i + 1) * invLength;
+                    auto& out = output[static_cast<size_t> (i)];
+                    out += (fadeScratch[static_cast<size_t> (i)] - out) * blend;
+                }
+            }
+
+            std::copy_n (source.inputWindow[ear].data() + HrtfSet::kPartitionSize,
+                         HrtfSet::kPartitionSize,
+                         source.inputWindow[ear].data());
+        }
+
+        if (source.fadePending)
+        {
+            source.activeBank = 1 - source.activeBank;
+            source.fadePending = false;
+        }
+    }
+
+    void convolve (const SourceState& source, const Spectrum& filter, size_t ear, int numPartitions, float* destination) noexcept
+    {
+        std::fill (accumulator.begin(), accumulator.end(), 0.0f);
+
+        for (int partition = 0; partition < numPartitions; ++partition)
+        {
+            const auto slot = (source.spectraHead - partition + HrtfSet::kMaxPartitions) % HrtfSet::kMaxPartitions;
+            const auto* x = source.delayLineSpectra[ear].data() + (slot * HrtfSet::kSpectrumFloats);
+            const auto* h = filter.data() + (partition * HrtfSet::kSpectrumFloats);
+
+            for (int bin = 0; bin < HrtfSet::kNumBins; ++bin)
+            {
+                const auto re = 2 * bin;
+                const auto im = re + 1;
+                accumulator[static_cast<size_t> (re)] += (x[re] * h[re]) - (x[im] * h[im]);
+                accumulator[static_cast<size_t> (im)] += (x[re] * h[im]) + (x[im] * h[re]);
+            }
+        }
+
+        std::fill (scratch.begin(), scratch.end(), 0.0f);
+        std::copy (accumulator.begin(), accumulator.end(), scratch.begin());
+        fft.performRealOnlyInverseTransform (scratch.data());
+
+        // Overlap-save: the last B samples of the 2B window are valid.
+        for (int i = 0; i < HrtfSet::kPartitionSize; ++i)
+        {
+            const auto y = scratch[static_cast<size_t> (HrtfSet::kPartitionSize + i)];
+            destination[i] = std::isfinite (y) ? y : 0.0f;
+        }
+    }
+
+    juce::dsp::FFT fft;
+    std::array<float, 2 * HrtfSet::kFftSize> scratch {};
+    std::array<float, HrtfSet::kSpectrumFloats> accumulator {};
+    std::array<float, HrtfSet::kPartitionSize> fadeScratch {};
+
+    double preparedSampleRate = 0.0;
+    std::vector<SourceState> sources;
+
+    std::shared_ptr<const HrtfSet> activeSet;                 // audio thread
+    RetainingSharedPtrPublisher<const HrtfSet> publishedSet; // message -> audio
+};
+
+} // namespace locusq::dsp
@@ -7,8 +7,8 @@
  * Keeping libmysofa out of all other TUs prevents C symbol pollution
  * in JUCE's header compilation units and avoids PCH / unity-build clashes.
  *
- * All callable surface is declared in SofaHrtfLoader.h.
- * This .cpp exists solely so the #include of <mysofa.h> is isolated.
+ * Callable surface is declared in SofaHrtfLoader.h (mysofa-facing) and
+ * HrirGrid.h (mysofa-free grid sampling used by the JUCE side).
  */
 
 // Include the header that contains all inline / template implementations.
@@ -17,14 +17,74 @@
 // mysofa.h is compiled exactly once within the LocusQ target when
 // LOCUSQ_ENABLE_SOFA=ON.
 //
-// If non-inline helpers are added in future, implement them here.
+// Non-inline helpers that need libmysofa (loadSofaHrirGrid, declared in the
+// mysofa-free HrirGrid.h) are implemented here.
 
 #include "SofaHrtfLoader.h"
+#include "HrirGrid.h"
+
+#include <algorithm>
 
-// Explicit instantiation anchor — forces the linker to pull this TU in even
-// though all current symbols are inline.  Remove if concrete symbols are added.
 namespace locusq::dsp
 {
-    // Ensure the translation unit is non-empty.
-    static constexpr int kSofaHrtfLoaderVersion = 1;
+
+bool loadSofaHrirGrid (const std::string& path, int targetSampleRate, HrirGrid& grid)
+{
+    grid = HrirGrid {};
+
+    const auto sofa = loadSofaFile (path, targetSampleRate);
+    if (! sofa.valid || sofa.firLength <= 0)
+        return false;
+
+    const auto irLength = static_cast<std::size_t> (sofa.firLength);
+    const auto numDirections = static_cast<std::size_t> (HrirGrid::kNumDirections);
+    std::vector<float> left (numDirections * irLength, 0.0f);
+    std::vector<float> right (numDirections * irLength, 0.0f);
+    std::vector<float> leftDelay (numDirections, 0.0f);
+    std::vector<float> rightDelay (numDirections, 0.0f);
+
+    for (int e = 0; e < HrirGrid::kNumElevations; ++e)
+    {
+        const auto elevationDeg = HrirGrid::kElevationMinDeg + (static_cast<float> (e) * HrirGrid::kElevationStepDeg);
+
+        for (int a = 0; a < HrirGrid::kNumAzimuths; ++a)
+        {
+            // Grid azimuth is clockwise-positive; SOFA azimuth is counter-clockwise.
+            const auto azimuthDeg = static_cast<float> (a) * HrirGrid::kAzimuthStepDeg;
+            float coords[3] = { -azimuthDeg, elevationDeg, 1.0f };
+            mysofa_s2c (coords);
+
+            const auto direction = static_cast<std::size_t> (HrirGrid::directionIndex (e, a));
+            float leftDelaySeconds = 0.0f;
+            float rightDelaySeconds = 0.0f;
+            mysofa_getfilter_float (sofa.handle.get(),
+                                    coords[0], coords[1], coords[2],
+                                    left.data() + (direction * irLength),
+                                    right.data() + (direction * irLength),
+                                    &leftDelaySeconds, &rightDelaySeconds);
+
+            leftDelay[direction] = std::max (0.0f, leftDelaySeconds * static_cast<float> (targetSampleRate));
+            rightDelay[direction] = std::max (0.0f, rightDelaySeconds * static_cast<float> (targetSampleRate));
+        }
+    }
+
+    // BL-046 invariant: ir_non_finite_count == 0.
+    const auto isFinite = [] (float v) { return std::isfinite (v); };
+    if (! std::all_of (left.begin(), left.end(), isFinite)
+        || ! std::all_of (right.begin(), right.end(), isFinite)
+        || ! std::all_of (leftDelay.begin(), leftDelay.end(), isFinite)
+        || ! std::all_of (rightDelay.begin(), rightDelay.end(), isFinite))
+    {
+        return false;
+    }
+
+    grid.sampleRate = targetSampleRate;
+    grid.irLength = sofa.firLength;
+    grid.left = std::move (left);
+    grid.right = std::move (right);
+    grid.leftDelaySamples = std::move (leftDelay);
+    grid.rightDelaySamples = std::move (rightDelay);
+    return grid.isValid();
+}
+
 } // namespace locusq::dsp
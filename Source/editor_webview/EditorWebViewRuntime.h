@@ -178,6 +178,25 @@ inline juce::WebBrowserComponent::Options withNativeBindings (
                              {
                                  completion (audioProcessor.redetectCalibrationRoutingFromUI());
                              })
+        .withNativeFunction ("locusqStartObjectExport",
+                             [&audioProcessor] (const juce::Array<juce::var>& args,
+                                                juce::WebBrowserComponent::NativeFunctionCompletion completion)
+                             {
+                                 const juce::var opt = args.isEmpty() ? juce::var() : args[0];
+                                 completion (audioProcessor.startObjectExportFromUI (opt));
+                             })
+        .withNativeFunction ("locusqStopObjectExport",
+                             [&audioProcessor] (const juce::Array<juce::var>&,
+                                                juce::WebBrowserComponent::NativeFunctionCompletion completion)
+                             {
+                                 completion (audioProcessor.stopObjectExportFromUI());
+                             })
+        .withNativeFunction ("locusqGetObjectExportStatus",
+                             [&audioProcessor] (const juce::Array<juce::var>&,
+                                                juce::WebBrowserComponent::NativeFunctionCompletion completion)
+                             {
+                                 completion (audioProcessor.getObjectExportStatusFromUI());
+                             })
         .withNativeFunction ("locusqListCalibrationProfiles",
                              [&audioProcessor] (const juce::Array<juce::var>&,
                                                 juce::WebBrowserComponent::NativeFunctionCompletion completion)
@@ -230,6 +249,24 @@ inline juce::WebBrowserComponent::Options withNativeBindings (
 
                                  completion (audioProcessor.setKeyframeTimelineFromUI (args[0]));
                              })
+        .withNativeFunction ("locusqGetChoreographyTimeline",
+                             [&audioProcessor] (const juce::Array<juce::var>&,
+                                                juce::WebBrowserComponent::NativeFunctionCompletion completion)
+                             {
+                                 completion (audioProcessor.getChoreographyTimelineForUI());
+                             })
+        .withNativeFunction ("locusqSetChoreographyTimeline",
+                             [&audioProcessor] (const juce::Array<juce::var>& args,
+                                                juce::WebBrowserComponent::NativeFunctionCompletion completion)
+                             {
+                                 if (args.isEmpty())
+                                 {
+                                     completion (false);
+                                     return;
+                                 }
+
+                                 completion (audioProcessor.setChoreographyTimelineFromUI (args[0]));
+                             })
         .withNativeFunction ("locusqSetTimelineTime",
                              [&audioProcessor] (const juce::Array<juce::var>& args,
                                                 juce::WebBrowserComponent::NativeFunctionCompletion completion)
@@ -19,7 +19,7 @@ public:
                    && maxBlockSize > 0;
 
         peqHook.prepare (sampleRate);
-        firHook.prepare (maxBlockSize);
+        firHook.prepare (maxBlockSize, HeadphoneFirHook::kMaxTaps);
         peqHook.setIdentityCurve();
         firHook.setIdentityImpulse();
         reset();
@@ -32,19 +32,26 @@ public:
         firHook.reset();
     }
 
-    void clearPeqPreset() noexcept
+    // Coefficient sets are published lock-free for the reader; processBlock()
+    // adopts them at the next block boundary with a short crossfade. publishPeqCoefficients() is for
+    // non-audio threads; the audio thread uses tryPublishPeqCoefficients(),
+    // which returns false instead of waiting on another producer.
+    void publishPeqCoefficients (const HeadphonePeqHook::CoefficientSet& coefficients) noexcept
     {
-        peqHook.setIdentityCurve();
+        peqHook.publishCoefficientSet (coefficients);
     }
 
-    void setPeqPreampDb (float db) noexcept
+    bool tryPublishPeqCoefficients (const HeadphonePeqHook::CoefficientSet& coefficients) noexcept
     {
-        peqHook.setPreampDb (db);
+        return peqHook.tryPublishCoefficientSet (coefficients);
     }
 
-    void setPeqStage (int stageIndex, const HeadphonePeqHook::Coefficients& coefficients) noexcept
+    // Non-audio thread. The tap count selects the FIR engine, so the resolved
+    // latency is refreshed (audio thread) once the IR is picked up. Returns
+    // false while a previous IR swap is still blending.
+    bool loadFirImpulseResponse (const float* taps, int tapCount) noexcept
     {
-        peqHook.setStageCoefficients (stageIndex, coefficients);
+        return firHook.loadImpulseResponse (taps, tapCount);
     }
 
     void setEnabled (bool enabled) noexcept
@@ -85,33 +92,42 @@ public:
         return resolved.activeLatencySamples;
     }
 
-    void processStereoSample (float& left, float& right) noexcept
+    void processBlock (float* left, float* right, int numSamples) noexcept
     {
-        if (! std::isfinite (left))
-            left = 0.0f;
-        if (! std::isfinite (right))
-            right = 0.0f;
+        if (left == nullptr || right == nullptr || numSamples <= 0)
+            return;
+
+        pickUpPendingCoefficients();
 
         switch (static_cast<headphone_core::CalibrationChainEngine> (resolved.activeEngineIndex))
         {
             case headphone_core::CalibrationChainEngine::ParametricEq:
-                peqHook.processStereoSample (left, right);
+                peqHook.processBlock (left, right, numSamples);
                 break;
             case headphone_core::CalibrationChainEngine::FirConvolution:
-                firHook.processStereoSample (left, right);
+                firHook.processBlock (left, right, numSamples);
                 break;
             case headphone_core::CalibrationChainEngine::Disabled:
             default:
+                for (int i = 0; i < numSamples; ++i)
+                {
+                    if (! std::isfinite (left[i]))
+                        left[i] = 0.0f;
+                    if (! std::isfinite (right[i]))
+                        right[i] = 0.0f;
+                }
                 break;
         }
-
-        if (! std::isfinite (left))
-            left = 0.0f;
-        if (! std::isfinite (right))
-            right = 0.0f;
     }
 
 private:
+    void pickUpPendingCoefficients() noexcept
+    {
+        peqHook.pickUpPendingCoefficients();
+        if (firHook.pickUpPendingImpulseResponse())
+            updateResolvedState();
+    }
+
     void updateResolvedState() noexcept
     {
         resolved = headphone_core::resolveCalibrationChainState (
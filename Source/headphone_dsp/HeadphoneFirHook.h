@@ -1,9 +1,13 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <memory>
 #include <vector>
 
 namespace locusq::headphone_dsp
@@ -18,9 +22,285 @@ public:
     static constexpr int kDirectFirTapThreshold = 256;
     static constexpr int kSwapCrossfadeSamples = 64;
 
+    static constexpr int kMinPartitionSize = 32;
+
     // BL-055 contract markers: DirectFirConvolver + PartitionedFftConvolver
     struct DirectFirConvolver {};
-    struct PartitionedFftConvolver {};
+
+    // Uniformly partitioned overlap-save convolver with a frequency-domain
+    // delay line. Partition size B = nextPow2(block size), FFT size 2B, so the
+    // engine adds exactly B samples of latency. Both ears share one set of
+    // filter spectra. Spectra are double-banked: setFilter() fills the idle
+    // bank off the audio thread and selectBank() switches at the next
+    // partition boundary, optionally blending old and incoming outputs over
+    // that partition. All buffers are sized in prepare(); nothing allocates
+    // afterwards.
+    class PartitionedFftConvolver
+    {
+    public:
+        void prepare (int blockSize, int maxTaps)
+        {
+            partitionSize = juce::nextPowerOfTwo (juce::jmax (kMinPartitionSize, blockSize));
+            fftSize = partitionSize * 2;
+            numBins = partitionSize + 1;
+
+            int fftOrder = 1;
+            while ((1 << fftOrder) < fftSize)
+                ++fftOrder;
+            fft = std::make_unique<juce::dsp::FFT> (fftOrder);
+
+            maxPartitions = juce::jmax (1, (juce::jmax (1, maxTaps) + partitionSize - 1) / partitionSize);
+            const auto spectrumSize = static_cast<size_t> (2 * numBins);
+            for (auto& bank : filterSpectra)
+                bank.assign (spectrumSize * static_cast<size_t> (maxPartitions), 0.0f);
+            bankPartitions = { 0, 0 };
+            activeBank = 0;
+            fadingBank = -1;
+            accumulator.assign (spectrumSize, 0.0f);
+            crossfadeOutput.assign (static_cast<size_t> (partitionSize), 0.0f);
+            fftScratch.assign (static_cast<size_t> (2 * fftSize), 0.0f);
+            setFilterScratch.assign (static_cast<size_t> (2 * fftSize), 0.0f);
+
+            for (auto& channel : channels)
+            {
+                channel.delayLine.assign (spectrumSize * static_cast<size_t> (maxPartitions), 0.0f);
+                channel.inputWindow.assign (static_cast<size_t> (fftSize), 0.0f);
+                channel.output.assign (static_cast<size_t> (partitionSize), 0.0f);
+            }
+
+            reset();
+        }
+
+        void reset() noexcept
+        {
+            for (auto& channel : channels)
+            {
+                std::fill (channel.delayLine.begin(), channel.delayLine.end(), 0.0f);
+                std::fill (channel.inputWindow.begin(), channel.inputWindow.end(), 0.0f);
+                std::fill (channel.output.begin(), channel.output.end(), 0.0f);
+            }
+
+            delayLineHead = 0;
+            fifoPosition = 0;
+            fadingBank = -1;
+        }
+
+        bool isPrepared() const noexcept
+        {
+            return fft != nullptr;
+        }
+
+        int getLatencySamples() const noexcept
+        {
+            return isPrepared() ? partitionSize : 0;
+        }
+
+        // Transforms taps into per-partition spectra of one bank. The bank
+        // must not be the one process() is reading (or fading from).
+        void setFilter (int bank, const float* taps, int tapCount) noexcept
+        {
+            if (! isPrepared() || bank < 0 || bank > 1)
+                return;
+
+            auto& spectra = filterSpectra[static_cast<size_t> (bank)];
+            auto& partitions = bankPartitions[static_cast<size_t> (bank)];
+            std::fill (spectra.begin(), spectra.end(), 0.0f);
+            partitions = 0;
+
+            if (taps == nullptr || tapCount <= 0)
+                return;
+
+            // Scratch is private to this call; process() uses fftScratch.
+            auto* scratch = setFilterScratch.data();
+            const auto spectrumSize = 2 * numBins;
+            partitions = juce::jmin (maxPartitions, (tapCount + partitionSize - 1) / partitionSize);
+            for (int partition = 0; partition < partitions; ++partition)
+            {
+                const auto offset = partition * partitionSize;
+                const auto count = juce::jmin (partitionSize, tapCount - offset);
+
+                std::fill (setFilterScratch.begin(), setFilterScratch.end(), 0.0f);
+                std::copy_n (taps + offset, count, scratch);
+                fft->performRealOnlyForwardTransform (scratch, true);
+                std::copy_n (scratch,
+                             spectrumSize,
+                             spectra.data() + static_cast<size_t> (partition * spectrumSize));
+            }
+        }
+
+        // Audio thread. Crossfaded switches complete at the next partition boundary.
+        void selectBank (int bank, bool crossfade) noexcept
+        {
+            if (bank < 0 || bank > 1 || bank == activeBank)
+                return;
+
+            fadingBank = crossfade ? activeBank : -1;
+            activeBank = bank;
+        }
+
+        bool isBankCrossfadePending() const noexcept
+        {
+            return fadingBank >= 0;
+        }
+
+        void cancelBankCrossfade() noexcept
+        {
+            fadingBank = -1;
+        }
+
+        // In-place stereo block processing; any numSamples, output delayed by B.
+        void process (float* left, float* right, int numSamples) noexcept
+        {
+            if (! isPrepared() || left == nullptr || right == nullptr)
+                return;
+
+            feed ({ left, right }, { left, right }, numSamples);
+        }
+
+        // Feeds input into the delay line without convolving or emitting
+        // output, so the engine stays primed while another engine is audible.
+        void pushInput (const float* left, const float* right, int numSamples) noexcept
+        {
+            if (! isPrepared() || left == nullptr || right == nullptr)
+                return;
+
+            feed ({ left, right }, { nullptr, nullptr }, numSamples);
+        }
+
+        // Audio thread. Recomputes the pending output partition from the
+        // primed delay line with the active bank, so output resumes at once
+        // after a pushInput() phase instead of after one silent partition.
+        void resumeFromPrimedInput() noexcept
+        {
+            if (! isPrepared())
+                return;
+
+            fadingBank = -1;
+            for (auto& channel : channels)
+                convolvePartition (channel, activeBank, channel.output.data());
+        }
+
+    private:
+        struct ChannelState
+        {
+            std::vector<float> delayLine;   // maxPartitions spectra, ring-indexed by delayLineHead
+            std::vector<float> inputWindow; // [previous B | current B]
+            std::vector<float> output;      // B samples emitted during the next partition
+        };
+
+        // Null outputs feed the delay line only and skip the convolution.
+        void feed (std::array<const float*, 2> input, std::array<float*, 2> output, int numSamples) noexcept
+        {
+            const bool emitOutput = output[0] != nullptr;
+            int done = 0;
+            while (done < numSamples)
+            {
+                const auto chunk = juce::jmin (numSamples - done, partitionSize - fifoPosition);
+                for (size_t ch = 0; ch < channels.size(); ++ch)
+                {
+                    auto& channel = channels[ch];
+                    std::copy_n (input[ch] + done, chunk, channel.inputWindow.data() + partitionSize + fifoPosition);
+                    if (emitOutput)
+                        std::copy_n (channel.output.data() + fifoPosition, chunk, output[ch] + done);
+                }
+
+                fifoPosition += chunk;
+                done += chunk;
+
+                if (fifoPosition == partitionSize)
+                {
+                    processPartition (emitOutput);
+                    fifoPosition = 0;
+                }
+            }
+        }
+
+        void processPartition (bool emitOutput) noexcept
+        {
+            const auto spectrumSize = 2 * numBins;
+            delayLineHead = (delayLineHead + 1) % maxPartitions;
+
+            for (auto& channel : channels)
+            {
+                std::fill (fftScratch.begin(), fftScratch.end(), 0.0f);
+                std::copy_n (channel.inputWindow.data(), fftSize, fftScratch.data());
+                fft->performRealOnlyForwardTransform (fftScratch.data(), true);
+                std::copy_n (fftScratch.data(),
+                             spectrumSize,
+                             channel.delayLine.data() + static_cast<size_t> (delayLineHead * spectrumSize));
+
+                if (emitOutput)
+                    convolvePartition (channel, activeBank, channel.output.data());
+
+                if (emitOutput && fadingBank >= 0)
+                {
+                    // The delay line is filter-independent, so the outgoing bank's
+                    // output for this partition is exact; blend it across B samples.
+                    convolvePartition (channel, fadingBank, crossfadeOutput.data());
+                    const auto invLength = 1.0f / static_cast<float> (partitionSize);
+                    for (int i = 0; i < partitionSize; ++i)
+                    {
+                        const auto blend = static_cast<float> (i + 1) * invLength;
+                        auto& out = channel.output[static_cast<size_t> (i)];
+                        const auto faded = crossfadeOutput[static_cast<size_t> (i)];
+                        out = faded + ((out - faded) * blend);
+                    }
+                }
+
+                std::copy_n (channel.inputWindow.data() + partitionSize, partitionSize, channel.inputWindow.data());
+            }
+
+            fadingBank = -1;
+        }
+
+        void convolvePartition (const ChannelState& channel, int bank, float* destination) noexcept
+        {
+            const auto spectrumSize = 2 * numBins;
+            const auto& spectra = filterSpectra[static_cast<size_t> (bank)];
+            const auto partitions = bankPartitions[static_cast<size_t> (bank)];
+
+            std::fill (accumulator.begin(), accumulator.end(), 0.0f);
+            for (int partition = 0; partition < partitions; ++partition)
+            {
+                const auto slot = (delayLineHead - partition + maxPartitions) % maxPartitions;
+                const auto* x = channel.delayLine.data() + static_cast<size_t> (slot * spectrumSize);
+                const auto* h = spectra.data() + static_cast<size_t> (partition * spectrumSize);
+                auto* acc = accumulator.data();
+
+                for (int bin = 0; bin < numBins; ++bin)
+                {
+                    const auto re = 2 * bin;
+                    const auto im = re + 1;
+                    acc[re] += (x[re] * h[re]) - (x[im] * h[im]);
+                    acc[im] += (x[re] * h[im]) + (x[im] * h[re]);
+                }
+            }
+
+            std::fill (fftScratch.begin(), fftScratch.end(), 0.0f);
+            std::copy (accumulator.begin(), accumulator.end(), fftScratch.begin());
+            fft->performRealOnlyInverseTransform (fftScratch.data());
+
+            // Overlap-save: the last B samples of the window are the valid output.
+            std::copy_n (fftScratch.data() + partitionSize, partitionSize, destination);
+        }
+
+        std::unique_ptr<juce::dsp::FFT> fft;
+        int partitionSize = kMinPartitionSize;
+        int fftSize = 2 * kMinPartitionSize;
+        int numBins = kMinPartitionSize + 1;
+        int maxPartitions = 1;
+        int delayLineHead = 0;
+        int fifoPosition = 0;
+        std::array<std::vector<float>, 2> filterSpectra;
+        std::array<int, 2> bankPartitions { 0, 0 };
+        int activeBank = 0;
+        int fadingBank = -1;
+        std::vector<float> accumulator;
+        std::vector<float> crossfadeOutput;
+        std::vector<float> fftScratch;
+        std::vector<float> setFilterScratch;
+        std::array<ChannelState, 2> channels;
+    };
 
     struct FirEngineManager
     {
@@ -45,17 +325,21 @@ public:
     {
         preparedBlockSize = juce::jmax (1, maxBlockSize);
         const auto clampedTapCount = juce::jlimit (kMinTaps, kMaxTaps, maxTaps);
-        coefficients.resize (static_cast<size_t> (clampedTapCount), 0.0f);
+        for (auto& bank : coefficientBanks)
+            bank.resize (static_cast<size_t> (clampedTapCount), 0.0f);
         historyLeft.resize (static_cast<size_t> (clampedTapCount), 0.0f);
         historyRight.resize (static_cast<size_t> (clampedTapCount), 0.0f);
 
         // BL-055 contract marker: nextPow2 partitioned latency.
         const auto nextPow2BlockSize = juce::nextPowerOfTwo (preparedBlockSize);
-        partitionedLatencySamples = juce::jmax (0, nextPow2BlockSize);
+        partitionedConvolver.prepare (nextPow2BlockSize, clampedTapCount);
+        partitionedLatencySamples = juce::jmax (0, partitionedConvolver.getLatencySamples());
 
         configuredTapCount = 1;
         writeIndex = 0;
         swapCrossfadeSamplesRemaining = 0;
+        activeBank = 0;
+        activeBankIndex.store (0, std::memory_order_release);
         setIdentityImpulse();
         reset();
         updateEngineSelection (false);
@@ -67,18 +351,26 @@ public:
         std::fill (historyLeft.begin(), historyLeft.end(), 0.0f);
         std::fill (historyRight.begin(), historyRight.end(), 0.0f);
         writeIndex = 0;
+        partitionedConvolver.reset();
     }
 
     bool isReady() const noexcept
     {
+        const auto& coefficients = coefficientBanks[0];
         return ready
                && ! coefficients.empty()
+               && coefficientBanks[1].size() == coefficients.size()
                && historyLeft.size() == coefficients.size()
                && historyRight.size() == coefficients.size();
     }
 
     void setBypassed (bool shouldBypass) noexcept
     {
+        // A bypassed hook does not feed the partitioned engine, so its delay
+        // line would resume from input that predates the bypass.
+        if (bypassed && ! shouldBypass)
+            partitionedConvolver.reset();
+
         bypassed = shouldBypass;
     }
 
@@ -98,48 +390,136 @@ public:
         return partitionedLatencySamples;
     }
 
+    // Prepare-time reset of the active bank; not concurrent with processing.
     void setIdentityImpulse() noexcept
     {
+        auto& coefficients = coefficientBanks[static_cast<size_t> (activeBank)];
         std::fill (coefficients.begin(), coefficients.end(), 0.0f);
         if (! coefficients.empty())
             coefficients[0] = 1.0f;
         configuredTapCount = 1;
+        partitionedConvolver.setFilter (activeBank, coefficients.data(), configuredTapCount);
+        partitionedConvolver.selectBank (activeBank, false);
+        fadeFromBank = -1;
+        swapState.store (SwapState::Idle, std::memory_order_release);
         updateEngineSelection (true);
     }
 
+    // Writer side (any single non-audio thread). Stages the IR in the idle
+    // bank and publishes it; the audio thread adopts it at a block boundary
+    // via pickUpPendingImpulseResponse(). Returns false without staging while
+    // a previous swap is still crossfading - the caller may retry. Invalid
+    // input stages the identity impulse and also returns false.
     bool loadImpulseResponse (const float* taps, int tapCount) noexcept
     {
         if (! isReady())
             return false;
 
-        if (taps == nullptr || tapCount <= 0)
+        auto expected = SwapState::Idle;
+        if (! swapState.compare_exchange_strong (expected, SwapState::Staging, std::memory_order_acq_rel))
         {
-            setIdentityImpulse();
-            return false;
+            expected = SwapState::Published;
+            if (! swapState.compare_exchange_strong (expected, SwapState::Staging, std::memory_order_acq_rel))
+                return false;
         }
 
-        const auto copyTapCount = juce::jlimit (kMinTaps, static_cast<int> (coefficients.size()), tapCount);
+        const auto bank = 1 - activeBankIndex.load (std::memory_order_acquire);
+        auto& coefficients = coefficientBanks[static_cast<size_t> (bank)];
         std::fill (coefficients.begin(), coefficients.end(), 0.0f);
 
+        auto copyTapCount = 0;
         bool hasFiniteTap = false;
-        for (int tapIndex = 0; tapIndex < copyTapCount; ++tapIndex)
+        if (taps != nullptr && tapCount > 0)
         {
-            const auto tap = taps[tapIndex];
-            if (std::isfinite (tap))
+            copyTapCount = juce::jlimit (kMinTaps, static_cast<int> (coefficients.size()), tapCount);
+            for (int tapIndex = 0; tapIndex < copyTapCount; ++tapIndex)
             {
-                coefficients[static_cast<size_t> (tapIndex)] = juce::jlimit (-8.0f, 8.0f, tap);
-                hasFiniteTap = true;
+                const auto tap = taps[tapIndex];
+                if (std::isfinite (tap))
+                {
+                    coefficients[static_cast<size_t> (tapIndex)] = juce::jlimit (-8.0f, 8.0f, tap);
+                    hasFiniteTap = true;
+                }
             }
         }
 
         if (! hasFiniteTap)
         {
-            setIdentityImpulse();
+            std::fill (coefficients.begin(), coefficients.end(), 0.0f);
+            coefficients[0] = 1.0f;
+            copyTapCount = 1;
+        }
+
+        stagedTapCount = copyTapCount;
+        partitionedConvolver.setFilter (bank, coefficients.data(), copyTapCount);
+        swapState.store (SwapState::Published, std::memory_order_release);
+        return hasFiniteTap;
+    }
+
+    // Audio thread, block boundary. Adopts a published IR (returns true when
+    // the tap count/engine may have changed) and retires finished swaps.
+    bool pickUpPendingImpulseResponse() noexcept
+    {
+        const auto state = swapState.load (std::memory_order_acquire);
+        if (state == SwapState::Swapping)
+        {
+            // A bypassed hook is not processed, so nothing would finish the blend.
+            if (bypassed)
+            {
+                swapCrossfadeSamplesRemaining = 0;
+                partitionedConvolver.cancelBankCrossfade();
+            }
+
+            if (swapCrossfadeSamplesRemaining <= 0 && ! partitionedConvolver.isBankCrossfadePending())
+            {
+                fadeFromBank = -1;
+                swapState.store (SwapState::Idle, std::memory_order_release);
+            }
+
             return false;
         }
 
-        configuredTapCount = copyTapCount;
-        updateEngineSelection (true);
+        auto expected = SwapState::Published;
+        if (state != SwapState::Published
+            || ! swapState.compare_exchange_strong (expected, SwapState::Swapping, std::memory_order_acq_rel))
+        {
+            return false;
+        }
+
+        const auto previousBank = activeBank;
+        const auto previousEngine = firEngineManager.activeEngine;
+        activeBank = 1 - activeBank;
+        activeBankIndex.store (activeBank, std::memory_order_release);
+        configuredTapCount = stagedTapCount;
+
+        const auto nextEngine = FirEngineManager::selectEngineForTapCount (
+            juce::jlimit (kMinTaps, kMaxTaps, configuredTapCount));
+        const bool audible = ready && ! bypassed;
+        if (nextEngine != previousEngine)
+        {
+            // Engine change: the partitioned engine was primed while the direct
+            // one ran, so it resumes with output at once. Leaving the direct
+            // engine blends from its outgoing bank; leaving the partitioned one
+            // blends from dry.
+            partitionedConvolver.selectBank (activeBank, false);
+            if (audible && previousEngine == FirEngineManager::Engine::DirectFirConvolver)
+                fadeFromBank = previousBank;
+            updateEngineSelection (audible);
+        }
+        else if (nextEngine == FirEngineManager::Engine::PartitionedFftConvolver)
+        {
+            partitionedConvolver.selectBank (activeBank, audible);
+        }
+        else
+        {
+            partitionedConvolver.selectBank (activeBank, false);
+            if (audible)
+            {
+                fadeFromBank = previousBank;
+                startSwapCrossfade();
+            }
+        }
+
         return true;
     }
 
@@ -166,20 +546,30 @@ public:
         historyLeft[static_cast<size_t> (writeIndex)] = left;
         historyRight[static_cast<size_t> (writeIndex)] = right;
 
+        // Keep the partitioned engine primed for a later engine swap.
+        if (! bypassed && firEngineManager.activeEngine == FirEngineManager::Engine::DirectFirConvolver)
+            partitionedConvolver.pushInput (&dryLeft, &dryRight, 1);
+
         const auto tapCount = juce::jlimit (kMinTaps, historySize, configuredTapCount);
         auto processedLeft = dryLeft;
         auto processedRight = dryRight;
+        auto fadeFromLeft = dryLeft;
+        auto fadeFromRight = dryRight;
 
         if (! bypassed && tapCount >= kMinTaps)
         {
+            // Same-engine IR swap on the direct path blends from the outgoing bank.
+            if (swapCrossfadeSamplesRemaining > 0 && fadeFromBank >= 0)
+                runDirectConvolver (fadeFromBank, fadeFromLeft, fadeFromRight, tapCount, historySize);
+
             runActiveConvolver (processedLeft, processedRight, tapCount, historySize);
         }
 
         left = bypassed ? dryLeft : processedLeft;
         right = bypassed ? dryRight : processedRight;
 
-        // Click-safe engine/topology swap blend.
-        applySwapCrossfade (left, right, dryLeft, dryRight);
+        // Click-safe engine/topology/coefficient swap blend.
+        applySwapCrossfade (left, right, fadeFromLeft, fadeFromRight);
 
         if (! std::isfinite (left))
             left = 0.0f;
@@ -189,17 +579,77 @@ public:
         writeIndex = (writeIndex + 1) % historySize;
     }
 
+    // Block path. The partitioned engine convolves the whole block at once;
+    // the direct engine and any in-flight swap crossfade stay per-sample.
+    void processBlock (float* left, float* right, int numSamples) noexcept
+    {
+        if (left == nullptr || right == nullptr || numSamples <= 0)
+            return;
+
+        const auto historySize = static_cast<int> (historyLeft.size());
+        const bool blockConvolve = isReady()
+                                   && ! bypassed
+                                   && historySize > 0
+                                   && swapCrossfadeSamplesRemaining <= 0
+                                   && firEngineManager.activeEngine == FirEngineManager::Engine::PartitionedFftConvolver;
+
+        if (! blockConvolve)
+        {
+            for (int i = 0; i < numSamples; ++i)
+                processStereoSample (left[i], right[i]);
+            return;
+        }
+
+        sanitizeBlock (left, right, numSamples);
+
+        // Keep the direct-engine history warm for a later engine swap.
+        if (writeIndex < 0 || writeIndex >= historySize)
+            writeIndex = 0;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            historyLeft[static_cast<size_t> (writeIndex)] = left[i];
+            historyRight[static_cast<size_t> (writeIndex)] = right[i];
+            writeIndex = (writeIndex + 1) % historySize;
+        }
+
+        partitionedConvolver.process (left, right, numSamples);
+        sanitizeBlock (left, right, numSamples);
+    }
+
 private:
+    static void sanitizeBlock (float* left, float* right, int numSamples) noexcept
+    {
+        for (int i = 0; i < numSamples; ++i)
+        {
+            left[i] = std::isfinite (left[i]) ? left[i] : 0.0f;
+            right[i] = std::isfinite (right[i]) ? right[i] : 0.0f;
+        }
+    }
+
     [[maybe_unused]] static int getIdentityLatencyMarkerSamples (int tapCount) noexcept
     {
         const auto clampedTapCount = juce::jlimit (kMinTaps, kMaxTaps, tapCount);
         return juce::jmax (0, clampedTapCount - 1);
     }
 
-    void runActiveConvolver (float& left, float& right, int tapCount, int historySize) const noexcept
+    void runActiveConvolver (float& left, float& right, int tapCount, int historySize) noexcept
     {
-        juce::ignoreUnused (DirectFirConvolver {}, PartitionedFftConvolver {});
+        if (firEngineManager.activeEngine == FirEngineManager::Engine::PartitionedFftConvolver)
+        {
+            partitionedConvolver.process (&left, &right, 1);
+            left = std::isfinite (left) ? left : 0.0f;
+            right = std::isfinite (right) ? right : 0.0f;
+            return;
+        }
 
+        runDirectConvolver (activeBank, left, right, tapCount, historySize);
+    }
+
+    void runDirectConvolver (int bank, float& left, float& right, int tapCount, int historySize) const noexcept
+    {
+        juce::ignoreUnused (DirectFirConvolver {});
+
+        const auto& coefficients = coefficientBanks[static_cast<size_t> (bank)];
         float firLeft = 0.0f;
         float firRight = 0.0f;
 
@@ -229,6 +679,11 @@ private:
         firEngineManager.previousEngine = firEngineManager.activeEngine;
         firEngineManager.activeEngine = nextEngine;
 
+        // The direct engine path keeps feeding the partitioned delay line, so
+        // only the pending output partition needs computing.
+        if (nextEngine == FirEngineManager::Engine::PartitionedFftConvolver)
+            partitionedConvolver.resumeFromPrimedInput();
+
         if (allowCrossfade)
             startSwapCrossfade();
     }
@@ -262,7 +717,22 @@ private:
     int swapCrossfadeSamplesRemaining = 0;
     int writeIndex = 0;
     FirEngineManager firEngineManager;
-    std::vector<float> coefficients;
+    PartitionedFftConvolver partitionedConvolver;
+
+    enum class SwapState : int
+    {
+        Idle = 0,
+        Staging,   // writer filling the idle bank
+        Published, // waiting for the audio thread
+        Swapping   // audio thread blending away from the outgoing bank
+    };
+
+    std::array<std::vector<float>, 2> coefficientBanks;
+    int activeBank = 0;      // audio-thread copy
+    int fadeFromBank = -1;   // direct-engine swap source while blending
+    int stagedTapCount = 1;  // written before Published, read after
+    std::atomic<int> activeBankIndex { 0 };
+    std::atomic<SwapState> swapState { SwapState::Idle };
     std::vector<float> historyLeft;
     std::vector<float> historyRight;
 };
@@ -1,9 +1,12 @@
 #pragma once
 
 #include <juce_core/juce_core.h>
+#include <juce_dsp/juce_dsp.h>
 
 #include <array>
+#include <atomic>
 #include <cmath>
+#include <thread>
 
 namespace locusq::headphone_dsp
 {
@@ -12,6 +15,7 @@ class HeadphonePeqHook
 {
 public:
     static constexpr int kMaxStages = 8;
+    static constexpr int kSwapCrossfadeSamples = 64;
 
     struct Coefficients
     {
@@ -23,6 +27,14 @@ public:
         bool active = false;
     };
 
+    // Complete preset (preamp + cascade), built off the audio thread and
+    // handed over through publishCoefficientSet().
+    struct CoefficientSet
+    {
+        float preampLinear = 1.0f;
+        std::array<Coefficients, kMaxStages> stages {};
+    };
+
     void prepare (double sampleRate) noexcept
     {
         ready = std::isfinite (sampleRate) && sampleRate > 0.0;
@@ -32,12 +44,9 @@ public:
     void reset() noexcept
     {
         for (auto& stage : stages)
-        {
-            stage.z1Left = 0.0f;
-            stage.z2Left = 0.0f;
-            stage.z1Right = 0.0f;
-            stage.z2Right = 0.0f;
-        }
+            stage.clearState();
+        for (auto& stage : fadingStages)
+            stage.clearState();
     }
 
     bool isReady() const noexcept
@@ -68,14 +77,12 @@ public:
     void setIdentityCurve() noexcept
     {
         preampLinear = 1.0f;
+        crossfadeSamplesRemaining = 0;
 
         for (auto& stage : stages)
         {
             stage.coefficients = Coefficients {};
-            stage.z1Left = 0.0f;
-            stage.z2Left = 0.0f;
-            stage.z1Right = 0.0f;
-            stage.z2Right = 0.0f;
+            stage.clearState();
         }
     }
 
@@ -87,32 +94,102 @@ public:
         stages[static_cast<size_t> (stageIndex)].coefficients = sanitizeCoefficients (coefficients);
     }
 
-    void processStereoSample (float& left, float& right) noexcept
+    //--------------------------------------------------------------------------
+    // Lock-free coefficient handoff (triple buffer: writer slot, shared slot,
+    // reader slot). The audio thread picks the latest set up at a block
+    // boundary and crossfades from the previous cascade, so the reader never
+    // blocks or sees a torn preset.
+    //
+    // The triple buffer has one writer slot, so producers on different
+    // threads serialise on writerBusy. tryPublishCoefficientSet() never waits
+    // and is the variant for the audio thread (retry on a later block when it
+    // returns false); publishCoefficientSet() yields until it gets the slot.
+    bool tryPublishCoefficientSet (const CoefficientSet& set) noexcept
+    {
+        if (writerBusy.exchange (true, std::memory_order_acquire))
+            return false;
+
+        auto& slot = coefficientSlots[static_cast<size_t> (writerSlot)];
+        slot.preampLinear = std::isfinite (set.preampLinear) ? juce::jlimit (0.0f, 16.0f, set.preampLinear) : 1.0f;
+        for (size_t i = 0; i < slot.stages.size(); ++i)
+            slot.stages[i] = sanitizeCoefficients (set.stages[i]);
+
+        writerSlot = sharedSlot.exchange (writerSlot | kSlotDirtyBit, std::memory_order_acq_rel) & kSlotIndexMask;
+        writerBusy.store (false, std::memory_order_release);
+        return true;
+    }
+
+    // Non-audio threads only.
+    void publishCoefficientSet (const CoefficientSet& set) noexcept
     {
-        if (! std::isfinite (left))
-            left = 0.0f;
-        if (! std::isfinite (right))
-            right = 0.0f;
+        while (! tryPublishCoefficientSet (set))
+            std::this_thread::yield();
+    }
+
+    // Audio thread, block boundary. Returns true when a published set was adopted.
+    bool pickUpPendingCoefficients() noexcept
+    {
+        if ((sharedSlot.load (std::memory_order_acquire) & kSlotDirtyBit) == 0)
+            return false;
+
+        readerSlot = sharedSlot.exchange (readerSlot, std::memory_order_acq_rel) & kSlotIndexMask;
+        const auto& incoming = coefficientSlots[static_cast<size_t> (readerSlot)];
+
+        // The outgoing cascade keeps running on its own state for the crossfade;
+        // the incoming one starts from the same state to avoid a cold start.
+        fadingPreampLinear = preampLinear;
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            fadingStages[i] = stages[i];
+            stages[i].coefficients = incoming.stages[i];
+        }
+
+        preampLinear = incoming.preampLinear;
+        crossfadeSamplesRemaining = (ready && ! bypassed) ? kSwapCrossfadeSamples : 0;
+        return true;
+    }
 
-        if (! ready || bypassed)
+    // Block path: each active stage runs across the whole block as one
+    // transposed direct-form II section on a paired (left, right) SIMD register,
+    // so both channels share every multiply-add and the stage state stays in
+    // registers. Finiteness is checked once per block: if any NaN/Inf got in
+    // or the recursion blew up, the block is silenced and all state reset.
+    void processBlock (float* left, float* right, int numSamples) noexcept
+    {
+        if (left == nullptr || right == nullptr || numSamples <= 0 || ! ready || bypassed)
             return;
 
-        left  *= preampLinear;
-        right *= preampLinear;
+        auto* blockLeft = left;
+        auto* blockRight = right;
+        const auto blockSamples = numSamples;
 
-        for (auto& stage : stages)
+        // Finish any coefficient-swap crossfade per-sample, then run the block path.
+        while (crossfadeSamplesRemaining > 0 && numSamples > 0)
         {
-            if (! stage.coefficients.active)
-                continue;
+            processCrossfadeSample (left[0], right[0]);
+            ++left;
+            ++right;
+            --numSamples;
+        }
 
-            left = processBiquadSample (left, stage.coefficients, stage.z1Left, stage.z2Left);
-            right = processBiquadSample (right, stage.coefficients, stage.z1Right, stage.z2Right);
+        if (preampLinear != 1.0f)
+        {
+            juce::FloatVectorOperations::multiply (left, preampLinear, numSamples);
+            juce::FloatVectorOperations::multiply (right, preampLinear, numSamples);
+        }
+
+        for (auto& stage : stages)
+        {
+            if (stage.coefficients.active)
+                processStagePaired (stage, left, right, numSamples);
         }
 
-        if (! std::isfinite (left))
-            left = 0.0f;
-        if (! std::isfinite (right))
-            right = 0.0f;
+        if (! isBlockFinite (blockLeft, blockRight, blockSamples))
+        {
+            reset();
+            juce::FloatVectorOperations::clear (blockLeft, blockSamples);
+            juce::FloatVectorOperations::clear (blockRight, blockSamples);
+        }
     }
 
     static Coefficients makePeakEQ (float fc, float gainDb, float q, float sampleRate) noexcept
@@ -176,15 +253,106 @@ public:
     }
 
 private:
+    // Lane 0 is left, lane 1 is right.
+    using StereoLanes = std::array<float, 2>;
+
     struct StageState
     {
         Coefficients coefficients {};
-        float z1Left = 0.0f;
-        float z2Left = 0.0f;
-        float z1Right = 0.0f;
-        float z2Right = 0.0f;
+        StereoLanes z1 {};
+        StereoLanes z2 {};
+
+        void clearState() noexcept
+        {
+            z1 = {};
+            z2 = {};
+        }
     };
 
+    static constexpr int kSlotIndexMask = 0x3;
+    static constexpr int kSlotDirtyBit = 0x4;
+
+    void processCrossfadeSample (float& left, float& right) noexcept
+    {
+        StereoLanes outgoing { left * fadingPreampLinear, right * fadingPreampLinear };
+        StereoLanes incoming { left * preampLinear, right * preampLinear };
+
+        for (size_t i = 0; i < stages.size(); ++i)
+        {
+            if (fadingStages[i].coefficients.active)
+                outgoing = processBiquadPair (outgoing, fadingStages[i]);
+            if (stages[i].coefficients.active)
+                incoming = processBiquadPair (incoming, stages[i]);
+        }
+
+        const auto blend = 1.0f
+            - (static_cast<float> (crossfadeSamplesRemaining)
+               / static_cast<float> (kSwapCrossfadeSamples + 1));
+        left = outgoing[0] + ((incoming[0] - outgoing[0]) * blend);
+        right = outgoing[1] + ((incoming[1] - outgoing[1]) * blend);
+        --crossfadeSamplesRemaining;
+    }
+
+    // One TDF-II step on both lanes (per-sample crossfade path).
+    static StereoLanes processBiquadPair (const StereoLanes& input, StageState& stage) noexcept
+    {
+        const auto& c = stage.coefficients;
+        StereoLanes output;
+        for (size_t lane = 0; lane < 2; ++lane)
+        {
+            output[lane] = (c.b0 * input[lane]) + stage.z1[lane];
+            stage.z1[lane] = (c.b1 * input[lane]) - (c.a1 * output[lane]) + stage.z2[lane];
+            stage.z2[lane] = (c.b2 * input[lane]) - (c.a2 * output[lane]);
+        }
+        return output;
+    }
+
+    // Block loop on a SIMD register with left in lane 0 and right in lane 1
+    // (any further lanes carry a copy of left and are ignored). The state is
+    // held in registers for the whole block.
+    static void processStagePaired (StageState& stage, float* left, float* right, int numSamples) noexcept
+    {
+        using Pair = juce::dsp::SIMDRegister<float>;
+
+        const auto& c = stage.coefficients;
+        const auto b0 = Pair::expand (c.b0);
+        const auto b1 = Pair::expand (c.b1);
+        const auto b2 = Pair::expand (c.b2);
+        const auto a1 = Pair::expand (c.a1);
+        const auto a2 = Pair::expand (c.a2);
+
+        auto z1 = Pair::expand (stage.z1[0]);
+        auto z2 = Pair::expand (stage.z2[0]);
+        z1.set (1, stage.z1[1]);
+        z2.set (1, stage.z2[1]);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto input = Pair::expand (left[i]);
+            input.set (1, right[i]);
+
+            const auto output = (b0 * input) + z1;
+            z1 = (b1 * input) - (a1 * output) + z2;
+            z2 = (b2 * input) - (a2 * output);
+
+            left[i] = output.get (0);
+            right[i] = output.get (1);
+        }
+
+        stage.z1 = { z1.get (0), z1.get (1) };
+        stage.z2 = { z2.get (0), z2.get (1) };
+    }
+
+    // NaN/Inf anywhere in the block (input or recursion) makes the sum
+    // non-finite, so one std::isfinite covers every sample.
+    static bool isBlockFinite (const float* left, const float* right, int numSamples) noexcept
+    {
+        float sum = 0.0f;
+        for (int i = 0; i < numSamples; ++i)
+            sum += (left[i] - left[i]) + (right[i] - right[i]);
+        return std::isfinite (sum);
+    }
+
     static float sanitizeFinite (float value, float fallback = 0.0f) noexcept
     {
         return std::isfinite (value) ? value : fallback;
@@ -202,32 +370,20 @@ private:
         return sanitized;
     }
 
-    static float processBiquadSample (
-        float input,
-        const Coefficients& coefficients,
-        float& z1,
-        float& z2) noexcept
-    {
-        const auto output = (coefficients.b0 * input) + z1;
-        z1 = (coefficients.b1 * input) - (coefficients.a1 * output) + z2;
-        z2 = (coefficients.b2 * input) - (coefficients.a2 * output);
-
-        if (! std::isfinite (output)
-            || ! std::isfinite (z1)
-            || ! std::isfinite (z2))
-        {
-            z1 = 0.0f;
-            z2 = 0.0f;
-            return 0.0f;
-        }
-
-        return output;
-    }
-
     bool ready = false;
     bool bypassed = true;
     float preampLinear = 1.0f;
     std::array<StageState, kMaxStages> stages {};
+
+    float fadingPreampLinear = 1.0f;
+    std::array<StageState, kMaxStages> fadingStages {};
+    int crossfadeSamplesRemaining = 0;
+
+    std::array<CoefficientSet, 3> coefficientSlots {};
+    std::atomic<bool> writerBusy { false };
+    int writerSlot = 0; // guarded by writerBusy
+    int readerSlot = 2;
+    std::atomic<int> sharedSlot { 1 };
 };
 
 } // namespace locusq::headphone_dsp
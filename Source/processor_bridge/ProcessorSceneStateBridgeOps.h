@@ -902,15 +902,27 @@ juce::String LocusQAudioProcessor::getSceneStateJSON()
         1.0f,
         apvts.getRawParameterValue ("rend_viz_diag_mix")->load());
 
-    if (outputChannels >= 13
-        && (rendererSpatialProfileActiveIndex == static_cast<int> (SpatialRenderer::SpatialOutputProfile::Surround742)
-            || rendererSpatialProfileActiveIndex == static_cast<int> (SpatialRenderer::SpatialOutputProfile::AtmosBed)))
+    if (outputChannels >= 16
+        && rendererSpatialProfileActiveIndex == static_cast<int> (SpatialRenderer::SpatialOutputProfile::AtmosBed))
+    {
+        outputChannelLabelsJson = "[\"L\",\"R\",\"C\",\"LFE\",\"Ls\",\"Rs\",\"Lrs\",\"Rrs\",\"Lw\",\"Rw\",\"Ltf\",\"Rtf\",\"Ltm\",\"Rtm\",\"Ltr\",\"Rtr\"]";
+        rendererOutputMode = rendererSpatialProfileActive;
+    }
+    else if (outputChannels >= 12
+             && rendererSpatialProfileActiveIndex == static_cast<int> (SpatialRenderer::SpatialOutputProfile::AtmosBed))
+    {
+        outputChannelLabelsJson = "[\"L\",\"R\",\"C\",\"LFE\",\"Ls\",\"Rs\",\"Lrs\",\"Rrs\",\"Ltf\",\"Rtf\",\"Ltr\",\"Rtr\"]";
+        rendererOutputMode = rendererSpatialProfileActive;
+    }
+    else if (outputChannels >= 13
+             && rendererSpatialProfileActiveIndex == static_cast<int> (SpatialRenderer::SpatialOutputProfile::Surround742))
     {
         outputChannelLabelsJson = "[\"L\",\"R\",\"C\",\"LFE1\",\"LFE2\",\"Ls\",\"Rs\",\"Lrs\",\"Rrs\",\"TopFL\",\"TopFR\",\"TopRL\",\"TopRR\"]";
         rendererOutputMode = rendererSpatialProfileActive;
     }
     else if (outputChannels >= 10
-             && rendererSpatialProfileActiveIndex == static_cast<int> (SpatialRenderer::SpatialOutputProfile::Surround721))
+             && (rendererSpatialProfileActiveIndex == static_cast<int> (SpatialRenderer::SpatialOutputProfile::Surround721)
+                 || rendererSpatialProfileActiveIndex == static_cast<int> (SpatialRenderer::SpatialOutputProfile::AtmosBed)))
     {
         outputChannelLabelsJson = "[\"L\",\"R\",\"C\",\"LFE1\",\"LFE2\",\"Ls\",\"Rs\",\"Lrs\",\"Rrs\",\"TopC\"]";
         rendererOutputMode = rendererSpatialProfileActive;
@@ -1060,14 +1072,13 @@ juce::String LocusQAudioProcessor::getSceneStateJSON()
         }
     }
 
+    // The playhead lives on the audio thread; looping follows anim_loop there.
+    timelineTime = timelinePlayheadSeconds.load (std::memory_order_relaxed);
+    timelineLooping = apvts.getRawParameterValue ("anim_loop")->load() > 0.5f;
     {
         const juce::SpinLock::ScopedTryLockType timelineLock (keyframeTimelineLock);
         if (timelineLock.isLocked())
-        {
-            timelineTime = keyframeTimeline.getCurrentTimeSeconds();
             timelineDuration = keyframeTimeline.getDurationSeconds();
-            timelineLooping = keyframeTimeline.isLooping();
-        }
     }
 
     for (int i = 0; i < SceneGraph::MAX_EMITTERS; ++i)
@@ -1195,6 +1206,7 @@ juce::String LocusQAudioProcessor::getSceneStateJSON()
           + ",\"rendererActive\":" + juce::String (sceneGraph.isRendererRegistered() ? "true" : "false")
           + ",\"rendererEligibleEmitters\":" + juce::String (spatialRenderer.getLastEligibleEmitterCount())
           + ",\"rendererProcessedEmitters\":" + juce::String (spatialRenderer.getLastProcessedEmitterCount())
+          + ",\"rendererChoreographedEmitters\":" + juce::String (spatialRenderer.getLastChoreographedEmitterCount())
           + ",\"rendererCulledBudget\":" + juce::String (spatialRenderer.getLastBudgetCulledEmitterCount())
           + ",\"rendererCulledActivity\":" + juce::String (spatialRenderer.getLastActivityCulledEmitterCount())
           + ",\"rendererGuardrailActive\":" + juce::String (spatialRenderer.wasGuardrailActiveLastBlock() ? "true" : "false")
@@ -1268,6 +1280,14 @@ juce::String LocusQAudioProcessor::getSceneStateJSON()
               + juce::String (static_cast<juce::uint64> (rendererHeadTrackingSnapshot.invalidPacketCount))
               + ",\"consumers\":"
               + juce::String (static_cast<juce::uint64> (rendererHeadTrackingConsumers))
+              + ",\"listenerId\":" + juce::String (headTrackingBridge.getListenerId())
+              + ",\"activeListenerMask\":"
+              + juce::String (static_cast<juce::uint64> (headTrackingBridge.getActiveListenerMask()))
+              + ",\"filterMode\":\""
+              + juce::String (apvts.getRawParameterValue ("rend_headtrack_filter")->load() > 0.5f
+                                  ? "predictive_kalman" : "interpolate") + "\""
+              + ",\"poseJitterMs\":" + juce::String (headPoseJitterMs.load (std::memory_order_relaxed), 3)
+              + ",\"predictionLookaheadMs\":" + juce::String (headPoseLookaheadMs.load (std::memory_order_relaxed), 3)
               + ",\"seq\":"
               + juce::String (static_cast<juce::uint64> (rendererHeadTrackingSnapshot.seq))
               + ",\"timestampMs\":"
@@ -1279,7 +1299,8 @@ juce::String LocusQAudioProcessor::getSceneStateJSON()
               + ",\"qw\":" + juce::String (rendererHeadTrackingSnapshot.qw, 6)
               + ",\"yawDeg\":" + juce::String (rendererHeadTrackingSnapshot.yawDeg, 3)
               + ",\"pitchDeg\":" + juce::String (rendererHeadTrackingSnapshot.pitchDeg, 3)
-              + ",\"rollDeg\":" + juce::String (rendererHeadTrackingSnapshot.rollDeg, 3) + "}"
+              + ",\"rollDeg\":" + juce::String (rendererHeadTrackingSnapshot.rollDeg, 3)
+              + ",\"latency\":" + headTrackingLatencyToJson (headTrackingBridge.getLatencyDiagnostics()) + "}"
           + ",\"rendererHeadphoneCalibrationSchema\":\""
               + escapeJsonString (locusq::shared_contracts::headphone_calibration::kSchemaV1) + "\""
           + ",\"rendererHeadphoneCalibrationRequested\":\""
@@ -48,6 +48,7 @@ bool LocusQAudioProcessor::startCalibrationFromUI (const juce::var& options)
     int monitoringPath = getCurrentCalibrationMonitoringPathIndex();
     int deviceProfile = getCurrentCalibrationDeviceProfileIndex();
     bool allowLimitedMapping = false;
+    auto measurementMode = CalibrationEngine::MeasurementMode::Sequential;
     int speakerCh[4] =
     {
         static_cast<int> (apvts.getRawParameterValue ("cal_spk1_out")->load()) - 1,
@@ -115,6 +116,13 @@ bool LocusQAudioProcessor::startCalibrationFromUI (const juce::var& options)
         if (obj->hasProperty ("allowLimitedMapping"))
             allowLimitedMapping = static_cast<bool> (obj->getProperty ("allowLimitedMapping"));
 
+        if (obj->hasProperty ("measurementMode"))
+        {
+            measurementMode = obj->getProperty ("measurementMode").toString().trim().equalsIgnoreCase ("simultaneous")
+                                ? CalibrationEngine::MeasurementMode::Simultaneous
+                                : CalibrationEngine::MeasurementMode::Sequential;
+        }
+
         if (obj->hasProperty ("speakerChannels"))
         {
             const auto channels = obj->getProperty ("speakerChannels");
@@ -200,7 +208,8 @@ bool LocusQAudioProcessor::startCalibrationFromUI (const juce::var& options)
                                                              sweepSecs,
                                                              tailSecs,
                                                              speakerCh,
-                                                             micChannel);
+                                                             micChannel,
+                                                             measurementMode);
 
     if (! started)
     {
@@ -498,19 +507,19 @@ juce::var LocusQAudioProcessor::getCalibrationStatus() const
 
         case CalibrationEngine::State::Playing:
             running = true;
-            completedSpeakers = speakerIndex;
+            completedSpeakers = progress.simultaneous ? 0 : speakerIndex;
             speakerPhasePercent = juce::jlimit (0.0f, 1.0f, progress.playPercent) * 0.5f;
             break;
 
         case CalibrationEngine::State::Recording:
             running = true;
-            completedSpeakers = speakerIndex;
+            completedSpeakers = progress.simultaneous ? 0 : speakerIndex;
             speakerPhasePercent = 0.5f + juce::jlimit (0.0f, 1.0f, progress.recordPercent) * 0.45f;
             break;
 
         case CalibrationEngine::State::Analyzing:
             running = true;
-            completedSpeakers = speakerIndex;
+            completedSpeakers = progress.simultaneous ? 0 : speakerIndex;
             speakerPhasePercent = 0.95f;
             break;
 
@@ -524,9 +533,12 @@ juce::var LocusQAudioProcessor::getCalibrationStatus() const
             break;
     }
 
+    // Simultaneous runs measure every speaker in one pass, so the phase is the run.
     auto overallPercent = (state == CalibrationEngine::State::Complete)
                             ? 1.0f
-                            : (static_cast<float> (completedSpeakers) + speakerPhasePercent) / 4.0f;
+                            : progress.simultaneous
+                                ? speakerPhasePercent
+                                : (static_cast<float> (completedSpeakers) + speakerPhasePercent) / 4.0f;
     overallPercent = juce::jlimit (0.0f, 1.0f, overallPercent);
 
     juce::var statusVar (new juce::DynamicObject());
@@ -538,6 +550,7 @@ juce::var LocusQAudioProcessor::getCalibrationStatus() const
     status->setProperty ("complete", state == CalibrationEngine::State::Complete);
     status->setProperty ("currentSpeaker", speakerIndex + 1);
     status->setProperty ("completedSpeakers", completedSpeakers);
+    status->setProperty ("measurementMode", progress.simultaneous ? "simultaneous" : "sequential");
     status->setProperty ("playPercent", juce::jlimit (0.0f, 1.0f, progress.playPercent));
     status->setProperty ("recordPercent", juce::jlimit (0.0f, 1.0f, progress.recordPercent));
     status->setProperty ("overallPercent", overallPercent);
@@ -639,7 +652,7 @@ juce::var LocusQAudioProcessor::getCalibrationStatus() const
         {
             level = 1.0f;
         }
-        else if (running && i == speakerIndex)
+        else if (running && (progress.simultaneous || i == speakerIndex))
         {
             if (state == CalibrationEngine::State::Playing)
                 level = juce::jlimit (0.0f, 1.0f, progress.playPercent);
@@ -709,7 +722,7 @@ juce::var LocusQAudioProcessor::serialiseKeyframeTimelineLocked() const
     timeline->setProperty ("durationSeconds", keyframeTimeline.getDurationSeconds());
     timeline->setProperty ("looping", keyframeTimeline.isLooping());
     timeline->setProperty ("playbackRate", keyframeTimeline.getPlaybackRate());
-    timeline->setProperty ("currentTimeSeconds", keyframeTimeline.getCurrentTimeSeconds());
+    timeline->setProperty ("currentTimeSeconds", timelinePlayheadSeconds.load (std::memory_order_relaxed));
 
     juce::Array<juce::var> tracks;
 
@@ -727,6 +740,10 @@ juce::var LocusQAudioProcessor::serialiseKeyframeTimelineLocked() const
             keyframeObject->setProperty ("timeSeconds", keyframe.timeSeconds);
             keyframeObject->setProperty ("value", keyframe.value);
             keyframeObject->setProperty ("curve", keyframeCurveToString (keyframe.curve));
+            if (keyframe.outHandle != 0.0f)
+                keyframeObject->setProperty ("outHandle", keyframe.outHandle);
+            if (keyframe.inHandle != 0.0f)
+                keyframeObject->setProperty ("inHandle", keyframe.inHandle);
             keyframes.add (keyframeVar);
         }
 
@@ -744,48 +761,14 @@ bool LocusQAudioProcessor::applyKeyframeTimelineLocked (const juce::var& timelin
     if (timeline == nullptr)
         return false;
 
-    auto* trackArray = timeline->getProperty ("tracks").getArray();
-    if (trackArray == nullptr)
+    const auto tracksVar = timeline->getProperty ("tracks");
+    if (! tracksVar.isArray())
         return false;
 
     keyframeTimeline.clearTracks();
 
-    for (const auto& trackValue : *trackArray)
-    {
-        auto* trackObject = trackValue.getDynamicObject();
-        if (trackObject == nullptr)
-            continue;
-
-        const auto parameterId = trackObject->getProperty ("parameterId").toString().trim();
-        if (parameterId.isEmpty())
-            continue;
-
-        std::vector<Keyframe> keyframes;
-        if (auto* keyframeArray = trackObject->getProperty ("keyframes").getArray())
-        {
-            keyframes.reserve (static_cast<size_t> (keyframeArray->size()));
-
-            for (const auto& keyframeValue : *keyframeArray)
-            {
-                auto* keyframeObject = keyframeValue.getDynamicObject();
-                if (keyframeObject == nullptr)
-                    continue;
-
-                Keyframe keyframe;
-                keyframe.timeSeconds = static_cast<double> (keyframeObject->getProperty ("timeSeconds"));
-                keyframe.value = static_cast<float> (double (keyframeObject->getProperty ("value")));
-                keyframe.curve = keyframeCurveFromVar (keyframeObject->getProperty ("curve"));
-                keyframes.push_back (keyframe);
-            }
-        }
-
-        if (! keyframes.empty())
-        {
-            KeyframeTrack track { parameterId };
-            track.setKeyframes (std::move (keyframes));
-            keyframeTimeline.addOrReplaceTrack (std::move (track));
-        }
-    }
+    for (auto& track : parseKeyframeTracks (tracksVar))
+        keyframeTimeline.addOrReplaceTrack (std::move (track));
 
     if (timeline->hasProperty ("durationSeconds"))
         keyframeTimeline.setDurationSeconds (static_cast<double> (timeline->getProperty ("durationSeconds")));
@@ -797,11 +780,15 @@ bool LocusQAudioProcessor::applyKeyframeTimelineLocked (const juce::var& timelin
         keyframeTimeline.setPlaybackRate (static_cast<float> (double (timeline->getProperty ("playbackRate"))));
 
     if (timeline->hasProperty ("currentTimeSeconds"))
+    {
         keyframeTimeline.setCurrentTimeSeconds (static_cast<double> (timeline->getProperty ("currentTimeSeconds")));
+        requestKeyframeTimelineSeek (keyframeTimeline.getCurrentTimeSeconds());
+    }
 
     if (! keyframeTimeline.hasAnyTrack())
         initialiseDefaultKeyframeTimeline();
 
+    publishKeyframeTimelineSnapshotLocked();
     return true;
 }
 
@@ -817,6 +804,80 @@ bool LocusQAudioProcessor::setKeyframeTimelineFromUI (const juce::var& timelineS
     return applyKeyframeTimelineLocked (timelineState);
 }
 
+// Scene choreography JSON:
+// { "durationSeconds", "looping", "tracks": [ { "slot", "parameterId" (pos_x|pos_y|pos_z|pos_path), "keyframes": [...] } ] }
+// pos_path keyframes carry "value", "outHandle" and "inHandle" as [x, y, z]
+// arrays in parameter axes. An empty track list clears the choreography.
+bool LocusQAudioProcessor::applyChoreographyTimelineLocked (const juce::var& choreographyState)
+{
+    auto* choreography = choreographyState.getDynamicObject();
+    if (choreography == nullptr)
+        return false;
+
+    auto* trackArray = choreography->getProperty ("tracks").getArray();
+    if (trackArray == nullptr)
+        return false;
+
+    auto timeline = std::make_shared<ChoreographyTimeline>();
+
+    for (const auto& trackValue : *trackArray)
+    {
+        auto* trackObject = trackValue.getDynamicObject();
+        if (trackObject == nullptr)
+            continue;
+
+        const auto parameterId = trackObject->getProperty ("parameterId").toString().trim();
+        const auto axis = ChoreographyTimeline::axisFromTrackId (parameterId);
+        const auto isPath = parameterId == "pos_path";
+        const auto slotValue = trackObject->getProperty ("slot");
+        if ((! axis.has_value() && ! isPath) || ! (slotValue.isInt() || slotValue.isDouble()))
+            continue;
+
+        if (isPath)
+        {
+            const auto readVec3 = [] (const juce::var& value)
+            {
+                Vec3 result;
+                if (auto* components = value.getArray(); components != nullptr && components->size() >= 3)
+                {
+                    result.x = static_cast<float> (keyframeNumberFromVar ((*components)[0]));
+                    result.y = static_cast<float> (keyframeNumberFromVar ((*components)[1]));
+                    result.z = static_cast<float> (keyframeNumberFromVar ((*components)[2]));
+                }
+                return result;
+            };
+
+            timeline->setPathTrack (static_cast<int> (slotValue),
+                                    parseKeyframeTrack<ChoreographyTimeline::PathKeyframe> (trackObject->getProperty ("keyframes"), readVec3));
+            continue;
+        }
+
+        timeline->setTrack (static_cast<int> (slotValue), *axis, parseKeyframeTrack (trackObject->getProperty ("keyframes")));
+    }
+
+    if (choreography->hasProperty ("durationSeconds"))
+        timeline->setDurationSeconds (static_cast<double> (choreography->getProperty ("durationSeconds")));
+
+    if (choreography->hasProperty ("looping"))
+        timeline->setLooping (static_cast<bool> (choreography->getProperty ("looping")));
+
+    choreographyTimelineState = timeline->empty() ? juce::var() : choreographyState;
+    spatialRenderer.setChoreographyTimeline (timeline->empty() ? nullptr : std::move (timeline));
+    return true;
+}
+
+juce::var LocusQAudioProcessor::getChoreographyTimelineForUI() const
+{
+    const juce::SpinLock::ScopedLockType timelineLock (keyframeTimelineLock);
+    return choreographyTimelineState;
+}
+
+bool LocusQAudioProcessor::setChoreographyTimelineFromUI (const juce::var& choreographyState)
+{
+    const juce::SpinLock::ScopedLockType timelineLock (keyframeTimelineLock);
+    return applyChoreographyTimelineLocked (choreographyState);
+}
+
 bool LocusQAudioProcessor::setTimelineCurrentTimeFromUI (double timeSeconds)
 {
     if (! std::isfinite (timeSeconds))
@@ -827,6 +888,7 @@ bool LocusQAudioProcessor::setTimelineCurrentTimeFromUI (double timeSeconds)
                                        juce::jmax (0.0, keyframeTimeline.getDurationSeconds()),
                                        timeSeconds);
     keyframeTimeline.setCurrentTimeSeconds (clamped);
+    requestKeyframeTimelineSeek (clamped);
     return true;
 }
 
@@ -913,6 +975,64 @@ juce::File LocusQAudioProcessor::resolveCalibrationProfileFileFromOptions (const
         [] (const juce::String& name) { return locusq::processor_bridge::sanitisePresetName (name); });
 }
 
+juce::File LocusQAudioProcessor::getObjectExportDirectory() const
+{
+    return locusq::processor_bridge::getUserDataSubdirectory ("Exports");
+}
+
+juce::var LocusQAudioProcessor::startObjectExportFromUI (const juce::var& options)
+{
+    juce::var resultVar (new juce::DynamicObject());
+    auto* result = resultVar.getDynamicObject();
+    if (result == nullptr)
+        return resultVar;
+
+    juce::String requestedName;
+    if (auto* optionsObject = options.getDynamicObject())
+        requestedName = optionsObject->getProperty ("name").toString();
+    if (requestedName.trim().isEmpty())
+        requestedName = "Objects_" + juce::String (juce::Time::getCurrentTime().toMilliseconds());
+
+    auto exportDir = getObjectExportDirectory();
+    exportDir.createDirectory();
+    const auto exportFile = exportDir.getChildFile (
+        locusq::processor_bridge::sanitisePresetName (requestedName) + ".wav");
+
+    const bool ok = spatialRenderer.startObjectExport (exportFile);
+    result->setProperty ("ok", ok);
+    result->setProperty ("path", exportFile.getFullPathName());
+    if (! ok)
+        result->setProperty ("message", "Object export needs the CodecADM or CodecIAMF profile and no export in progress.");
+
+    return resultVar;
+}
+
+juce::var LocusQAudioProcessor::stopObjectExportFromUI()
+{
+    const bool ok = spatialRenderer.stopObjectExport();
+    auto resultVar = getObjectExportStatusFromUI();
+    if (auto* result = resultVar.getDynamicObject())
+        result->setProperty ("ok", ok);
+    return resultVar;
+}
+
+juce::var LocusQAudioProcessor::getObjectExportStatusFromUI() const
+{
+    juce::var resultVar (new juce::DynamicObject());
+    auto* result = resultVar.getDynamicObject();
+    if (result == nullptr)
+        return resultVar;
+
+    const auto status = spatialRenderer.getObjectExportStatus();
+    result->setProperty ("active", status.active);
+    result->setProperty ("objectCount", status.objectCount);
+    result->setProperty ("framesCaptured", static_cast<juce::int64> (status.framesCaptured));
+    result->setProperty ("framesDropped", static_cast<juce::int64> (status.framesDropped));
+    result->setProperty ("bytesWritten", static_cast<juce::int64> (status.bytesWritten));
+    result->setProperty ("writeFailed", status.writeFailed);
+    return resultVar;
+}
+
 juce::String LocusQAudioProcessor::getSnapshotOutputLayout() const
 {
     return outputLayoutToString (getBusesLayout().getMainOutputChannelSet());
@@ -1122,27 +1242,6 @@ void LocusQAudioProcessor::migrateSnapshotLayoutIfNeeded (const juce::ValueTree&
     setIntegerParameterValueNotifyingHost ("cal_spk4_out", migratedSpeakerMap[3]);
 }
 
-juce::String LocusQAudioProcessor::keyframeCurveToString (KeyframeCurve curve)
-{
-    const auto index = static_cast<size_t> (juce::jlimit (0, static_cast<int> (kCurveNames.size()) - 1, static_cast<int> (curve)));
-    return juce::String (kCurveNames[index]);
-}
-
-KeyframeCurve LocusQAudioProcessor::keyframeCurveFromVar (const juce::var& value)
-{
-    if (value.isInt() || value.isInt64() || value.isDouble())
-        return static_cast<KeyframeCurve> (juce::jlimit (0, static_cast<int> (kCurveNames.size()) - 1, static_cast<int> (value)));
-
-    const auto text = value.toString().trim();
-    for (size_t i = 0; i < kCurveNames.size(); ++i)
-    {
-        if (text.equalsIgnoreCase (kCurveNames[i]))
-            return static_cast<KeyframeCurve> (i);
-    }
-
-    return KeyframeCurve::linear;
-}
-
 std::optional<juce::var> LocusQAudioProcessor::readJsonFromFile (const juce::File& file)
 {
     return locusq::processor_bridge::readJsonFromFile (file);
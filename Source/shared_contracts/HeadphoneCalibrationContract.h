@@ -21,6 +21,8 @@ inline constexpr const char* kSpeakers = "speakers";
 inline constexpr const char* kStereoDownmix = "stereo_downmix";
 inline constexpr const char* kSteamBinaural = "steam_binaural";
 inline constexpr const char* kVirtualBinaural = "virtual_binaural";
+inline constexpr const char* kNativeHrtfBinaural = "native_hrtf_binaural";
+inline constexpr const char* kAmbisonicBinaural = "ambisonic_binaural";
 } // namespace path
 
 namespace stage
@@ -0,0 +1,356 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include "SpatialRendererTypes.h"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Direct per-emitter higher-order ambisonic encoding (ACN channel order,
+// SN3D or N3D, orders 1..3) plus SH-domain rotation for head tracking.
+//
+// Axis convention: ambisonic X = front, Y = left, Z = up. Renderer scene
+// coordinates (x right, y up, z front) map as X = z, Y = -x, Z = y.
+namespace locusq::ambisonic_encoder
+{
+
+using AmbisonicNormalization = spatial_renderer_types::AmbisonicNormalization;
+
+inline constexpr int kMaxOrder = 3;
+inline constexpr int kMaxChannels = (kMaxOrder + 1) * (kMaxOrder + 1);
+
+using ShCoefficients = std::array<float, kMaxChannels>;
+using RotationMatrix3 = std::array<std::array<float, 3>, 3>;
+
+inline constexpr int channelCountForOrder (int order) noexcept
+{
+    return (order + 1) * (order + 1);
+}
+
+inline constexpr int orderForChannel (int acn) noexcept
+{
+    return acn < 1 ? 0 : (acn < 4 ? 1 : (acn < 9 ? 2 : 3));
+}
+
+// Real SH (ACN, SN3D, no Condon-Shortley phase) for a unit vector in ambisonic axes.
+inline void evaluateSn3d (float x, float y, float z, ShCoefficients& out) noexcept
+{
+    constexpr float sqrt3 = 1.7320508f;
+    constexpr float sqrt15 = 3.8729833f;
+    constexpr float sqrt5over8 = 0.7905694f;
+    constexpr float sqrt3over8 = 0.6123724f;
+
+    const float xx = x * x;
+    const float yy = y * y;
+    const float zz = z * z;
+
+    out[0] = 1.0f;
+
+    out[1] = y;
+    out[2] = z;
+    out[3] = x;
+
+    out[4] = sqrt3 * x * y;
+    out[5] = sqrt3 * y * z;
+    out[6] = 0.5f * ((3.0f * zz) - 1.0f);
+    out[7] = sqrt3 * x * z;
+    out[8] = 0.5f * sqrt3 * (xx - yy);
+
+    out[9] = sqrt5over8 * y * ((3.0f * xx) - yy);
+    out[10] = sqrt15 * x * y * z;
+    out[11] = sqrt3over8 * y * ((5.0f * zz) - 1.0f);
+    out[12] = 0.5f * z * ((5.0f * zz) - 3.0f);
+    out[13] = sqrt3over8 * x * ((5.0f * zz) - 1.0f);
+    out[14] = 0.5f * sqrt15 * z * (xx - yy);
+    out[15] = sqrt5over8 * x * (xx - (3.0f * yy));
+}
+
+//==============================================================================
+// SN3D coefficients tabulated over a 2 degree azimuth/elevation grid with
+// bilinear lookup, so per-block encoding avoids trig and polynomial evaluation.
+// Built once (non-RT); lookups are RT-safe.
+class SphericalHarmonicLut
+{
+public:
+    static constexpr float kStepDeg = 2.0f;
+    static constexpr int kNumAzimuths = 180;  // [0, 360)
+    static constexpr int kNumElevations = 91; // [-90, +90]
+
+    SphericalHarmonicLut()
+    {
+        constexpr float degToRad = 3.14159265358979323846f / 180.0f;
+        table.resize (static_cast<size_t> (kNumAzimuths * kNumElevations));
+
+        for (int e = 0; e < kNumElevations; ++e)
+        {
+            const float elevation = (-90.0f + (static_cast<float> (e) * kStepDeg)) * degToRad;
+            for (int a = 0; a < kNumAzimuths; ++a)
+            {
+                // Renderer azimuth is clockwise positive (towards +x / right).
+                const float azimuth = static_cast<float> (a) * kStepDeg * degToRad;
+                const float sceneX = std::sin (azimuth) * std::cos (elevation);
+                const float sceneY = std::sin (elevation);
+                const float sceneZ = std::cos (azimuth) * std::cos (elevation);
+                evaluateSn3d (sceneZ, -sceneX, sceneY, table[static_cast<size_t> ((e * kNumAzimuths) + a)]);
+            }
+        }
+    }
+
+    // azimuth/elevation in renderer degrees; scales to N3D when requested.
+    void lookup (float azimuthDeg,
+                 float elevationDeg,
+                 int order,
+                 AmbisonicNormalization normalization,
+                 ShCoefficients& out) const noexcept
+    {
+        out.fill (0.0f);
+        if (! std::isfinite (azimuthDeg) || ! std::isfinite (elevationDeg))
+            return;
+
+        auto wrappedAzimuth = std::fmod (azimuthDeg, 360.0f);
+        if (wrappedAzimuth < 0.0f)
+            wrappedAzimuth += 360.0f;
+
+        const float azimuthPosition = wrappedAzimuth / kStepDeg;
+        const int a0 = static_cast<int> (azimuthPosition) % kNumAzimuths;
+        const int a1 = (a0 + 1) % kNumAzimuths;
+        const float fa = azimuthPosition - std::floor (azimuthPosition);
+
+        const float elevationPosition = (juce::jlimit (-90.0f, 90.0f, elevationDeg) + 90.0f) / kStepDeg;
+        const int e0 = juce::jmin (static_cast<int> (elevationPosition), kNumElevations - 2);
+        const int e1 = e0 + 1;
+        const float fe = juce::jlimit (0.0f, 1.0f, elevationPosition - static_cast<float> (e0));
+
+        const auto& c00 = table[static_cast<size_t> ((e0 * kNumAzimuths) + a0)];
+        const auto& c01 = table[static_cast<size_t> ((e0 * kNumAzimuths) + a1)];
+        const auto& c10 = table[static_cast<size_t> ((e1 * kNumAzimuths) + a0)];
+        const auto& c11 = table[static_cast<size_t> ((e1 * kNumAzimuths) + a1)];
+
+        const float w00 = (1.0f - fa) * (1.0f - fe);
+        const float w01 = fa * (1.0f - fe);
+        const float w10 = (1.0f - fa) * fe;
+        const float w11 = fa * fe;
+
+        const int numChannels = channelCountForOrder (juce::jlimit (0, kMaxOrder, order));
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto idx = static_cast<size_t> (ch);
+            out[idx] = (w00 * c00[idx]) + (w01 * c01[idx]) + (w10 * c10[idx]) + (w11 * c11[idx]);
+        }
+
+        if (normalization == AmbisonicNormalization::N3D)
+            applyN3dScaling (out, numChannels);
+    }
+
+    static void applyN3dScaling (ShCoefficients& coefficients, int numChannels) noexcept
+    {
+        constexpr std::array<float, kMaxOrder + 1> kN3dScale { 1.0f, 1.7320508f, 2.2360680f, 2.6457513f };
+        for (int ch = 1; ch < numChannels; ++ch)
+            coefficients[static_cast<size_t> (ch)] *= kN3dScale[static_cast<size_t> (orderForChannel (ch))];
+    }
+
+private:
+    std::vector<ShCoefficients> table;
+};
+
+//==============================================================================
+// dest += src * gain, with gain ramped linearly from startGain to endGain over
+// the block (constant gains fall through to a vectorized multiply-add).
+inline void addWithGainRamp (float* dest, const float* src, int numSamples, float startGain, float endGain) noexcept
+{
+    if (numSamples <= 0)
+        return;
+
+    if (startGain == endGain)
+    {
+        if (endGain != 0.0f)
+            juce::FloatVectorOperations::addWithMultiply (dest, src, endGain, numSamples);
+        return;
+    }
+
+    const float step = (endGain - startGain) / static_cast<float> (numSamples);
+    float gain = startGain;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        dest[i] += src[i] * gain;
+        gain += step;
+    }
+}
+
+// Encodes one mono block into the bus, ramping every channel from
+// currentGains to targetGains; currentGains is updated to the target.
+inline void encodeBlock (float* const* bus,
+                         int numChannels,
+                         const float* mono,
+                         int numSamples,
+                         ShCoefficients& currentGains,
+                         const ShCoefficients& targetGains) noexcept
+{
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto idx = static_cast<size_t> (ch);
+        addWithGainRamp (bus[ch], mono, numSamples, currentGains[idx], targetGains[idx]);
+        currentGains[idx] = targetGains[idx];
+    }
+}
+
+//==============================================================================
+// Real-SH rotation matrices (Ivanic & Ruedenberg recursion, with the published
+// corrections) for bands 1..3. Matrices are identical for SN3D and N3D since
+// the two differ by a per-band scale. process() ramps from the previous block's
+// matrices to the current ones so head motion never steps the sound field.
+class ShRotator
+{
+public:
+    ShRotator() noexcept
+    {
+        setIdentity (current);
+        setIdentity (previous);
+    }
+
+    void reset() noexcept
+    {
+        setIdentity (current);
+        setIdentity (previous);
+    }
+
+    // rotation maps world ambisonic-axis vectors into listener ambisonic axes.
+    void setRotation (const RotationMatrix3& rotation) noexcept
+    {
+        previous = current;
+
+        // Band 1 uses the (y, z, x) ordering of ACN 1..3.
+        constexpr std::array<int, 3> kAxisForM { 1, 2, 0 };
+        auto& band1 = current[1];
+        for (int m = 0; m < 3; ++m)
+            for (int n = 0; n < 3; ++n)
+                band1[static_cast<size_t> (m)][static_cast<size_t> (n)] =
+                    rotation[static_cast<size_t> (kAxisForM[static_cast<size_t> (m)])]
+                            [static_cast<size_t> (kAxisForM[static_cast<size_t> (n)])];
+
+        for (int l = 2; l <= kMaxOrder; ++l)
+        {
+            auto& band = current[static_cast<size_t> (l)];
+            for (int m = -l; m <= l; ++m)
+                for (int n = -l; n <= l; ++n)
+                    band[static_cast<size_t> (m + l)][static_cast<size_t> (n + l)] = computeElement (l, m, n);
+        }
+    }
+
+    // Rotates channels in place (numChannels = (order + 1)^2). scratch must
+    // hold at least numChannels channels of numSamples.
+    void process (float* const* channels, float* const* scratch, int numChannels, int numSamples) noexcept
+    {
+        for (int l = 1; l <= kMaxOrder; ++l)
+        {
+            const int bandStart = l * l;
+            const int bandSize = (2 * l) + 1;
+            if (bandStart + bandSize > numChannels)
+                break;
+
+            const auto& from = previous[static_cast<size_t> (l)];
+            const auto& to = current[static_cast<size_t> (l)];
+
+            for (int m = 0; m < bandSize; ++m)
+            {
+                auto* out = scratch[bandStart + m];
+                juce::FloatVectorOperations::clear (out, numSamples);
+                for (int n = 0; n < bandSize; ++n)
+                {
+                    addWithGainRamp (out,
+                                     channels[bandStart + n],
+                                     numSamples,
+                                     from[static_cast<size_t> (m)][static_cast<size_t> (n)],
+                                     to[static_cast<size_t> (m)][static_cast<size_t> (n)]);
+                }
+            }
+
+            for (int m = 0; m < bandSize; ++m)
+                juce::FloatVectorOperations::copy (channels[bandStart + m], scratch[bandStart + m], numSamples);
+        }
+
+        previous = current;
+    }
+
+private:
+    static constexpr int kMaxBandSize = (2 * kMaxOrder) + 1;
+    using BandMatrix = std::array<std::array<float, kMaxBandSize>, kMaxBandSize>;
+
+    static void setIdentity (std::array<BandMatrix, kMaxOrder + 1>& bands) noexcept
+    {
+        for (auto& band : bands)
+            for (size_t m = 0; m < band.size(); ++m)
+                for (size_t n = 0; n < band[m].size(); ++n)
+                    band[m][n] = (m == n) ? 1.0f : 0.0f;
+    }
+
+    float band (int l, int m, int n) const noexcept
+    {
+        return current[static_cast<size_t> (l)][static_cast<size_t> (m + l)][static_cast<size_t> (n + l)];
+    }
+
+    float p (int i, int a, int b, int l) const noexcept
+    {
+        if (b == l)
+            return (band (1, i, 1) * band (l - 1, a, l - 1)) - (band (1, i, -1) * band (l - 1, a, -l + 1));
+        if (b == -l)
+            return (band (1, i, 1) * band (l - 1, a, -l + 1)) + (band (1, i, -1) * band (l - 1, a, l - 1));
+        return band (1, i, 0) * band (l - 1, a, b);
+    }
+
+    float u (int m, int n, int l) const noexcept
+    {
+        return p (0, m, n, l);
+    }
+
+    float v (int m, int n, int l) const noexcept
+    {
+        if (m == 0)
+            return p (1, 1, n, l) + p (-1, -1, n, l);
+        if (m > 0)
+        {
+            const float d = (m == 1) ? 1.0f : 0.0f;
+            return (p (1, m - 1, n, l) * std::sqrt (1.0f + d)) - (p (-1, -m + 1, n, l) * (1.0f - d));
+        }
+
+        const float d = (m == -1) ? 1.0f : 0.0f;
+        return (p (1, m + 1, n, l) * (1.0f - d)) + (p (-1, -m - 1, n, l) * std::sqrt (1.0f + d));
+    }
+
+    float w (int m, int n, int l) const noexcept
+    {
+        if (m > 0)
+            return p (1, m + 1, n, l) + p (-1, -m - 1, n, l);
+        return p (1, m - 1, n, l) - p (-1, -m + 1, n, l);
+    }
+
+    float computeElement (int l, int m, int n) const noexcept
+    {
+        const int absM = std::abs (m);
+        const float d = (m == 0) ? 1.0f : 0.0f;
+        const float denominator = (std::abs (n) == l) ? static_cast<float> ((2 * l) * ((2 * l) - 1))
+                                                       : static_cast<float> ((l + n) * (l - n));
+
+        const float uCoeff = std::sqrt (static_cast<float> ((l + m) * (l - m)) / denominator);
+        const float vCoeff = 0.5f * std::sqrt ((1.0f + d) * static_cast<float> ((l + absM - 1) * (l + absM)) / denominator)
+                             * (1.0f - (2.0f * d));
+        const float wCoeff = -0.5f * std::sqrt (static_cast<float> ((l - absM - 1) * (l - absM)) / denominator)
+                             * (1.0f - d);
+
+        float value = 0.0f;
+        if (uCoeff != 0.0f)
+            value += uCoeff * u (m, n, l);
+        if (vCoeff != 0.0f)
+            value += vCoeff * v (m, n, l);
+        if (wCoeff != 0.0f)
+            value += wCoeff * w (m, n, l);
+        return value;
+    }
+
+    std::array<BandMatrix, kMaxOrder + 1> current {};
+    std::array<BandMatrix, kMaxOrder + 1> previous {};
+};
+
+} // namespace locusq::ambisonic_encoder
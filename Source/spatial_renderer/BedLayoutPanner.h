@@ -0,0 +1,505 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+#include "../SceneGraph.h"
+#include "AmbisonicEncoder.h"
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+// Direct 3D VBAP panning onto 7.1.4 / 9.1.6 speaker beds (AtmosBed profile).
+//
+// Channel order follows the surround writers in SpatialProfileRouter.h:
+//   7.1.4: L, R, C, LFE, Ls, Rs, Lrs, Rrs, Ltf, Rtf, Ltr, Rtr
+//   9.1.6: L, R, C, LFE, Ls, Rs, Lrs, Rrs, Lw, Rw, Ltf, Rtf, Ltm, Rtm, Ltr, Rtr
+// LFE never receives panned content; the bed writer derives it from the mains.
+//
+// Every bed speaker is tagged with the quad speaker zone (FL, FR, RR, RL) it
+// inherits calibration trim/delay and room send from; LFE carries zone -1.
+namespace locusq::bed_panner
+{
+
+inline constexpr int kMaxBedChannels = 16;
+inline constexpr int kLfeChannel = 3;
+inline constexpr int kNoZone = -1;
+// LFE = sum of the mains * this; equals the 7.4.2 writer's LFE for a single source.
+inline constexpr float kLfeSendFromMains = 0.075f;
+
+using BedGains = std::array<float, kMaxBedChannels>;
+using BedZones = std::array<int, kMaxBedChannels>;
+
+enum class BedLayout : int
+{
+    Bed714 = 0,
+    Bed916 = 1
+};
+
+struct BedSpeaker
+{
+    float azimuthDeg;   // renderer convention: clockwise positive, 0 = front
+    float elevationDeg;
+    int zone;           // 0 FL, 1 FR, 2 RR, 3 RL, kNoZone for LFE
+};
+
+inline constexpr std::array<BedSpeaker, 12> kBed714Speakers
+{{
+    { -30.0f,  0.0f, 0 }, {  30.0f,  0.0f, 1 }, {   0.0f,  0.0f, 0 }, {   0.0f,  0.0f, kNoZone },
+    { -90.0f,  0.0f, 3 }, {  90.0f,  0.0f, 2 }, { -150.0f, 0.0f, 3 }, { 150.0f,  0.0f, 2 },
+    { -45.0f, 45.0f, 0 }, {  45.0f, 45.0f, 1 }, { -135.0f, 45.0f, 3 }, { 135.0f, 45.0f, 2 }
+}};
+
+inline constexpr std::array<BedSpeaker, 16> kBed916Speakers
+{{
+    { -30.0f,  0.0f, 0 }, {  30.0f,  0.0f, 1 }, {   0.0f,  0.0f, 0 }, {   0.0f,  0.0f, kNoZone },
+    { -90.0f,  0.0f, 3 }, {  90.0f,  0.0f, 2 }, { -150.0f, 0.0f, 3 }, { 150.0f,  0.0f, 2 },
+    { -60.0f,  0.0f, 0 }, {  60.0f,  0.0f, 1 },
+    { -45.0f, 45.0f, 0 }, {  45.0f, 45.0f, 1 }, {  -90.0f, 45.0f, 3 }, {  90.0f, 45.0f, 2 },
+    { -135.0f, 45.0f, 3 }, { 135.0f, 45.0f, 2 }
+}};
+
+inline constexpr int channelCountForLayout (BedLayout layout) noexcept
+{
+    return layout == BedLayout::Bed916 ? static_cast<int> (kBed916Speakers.size())
+                                       : static_cast<int> (kBed714Speakers.size());
+}
+
+// Returns false when the host cannot carry a full 7.1.4 bed.
+inline bool layoutForOutputChannels (int numOutputChannels, BedLayout& layout) noexcept
+{
+    if (numOutputChannels >= channelCountForLayout (BedLayout::Bed916))
+    {
+        layout = BedLayout::Bed916;
+        return true;
+    }
+
+    if (numOutputChannels >= channelCountForLayout (BedLayout::Bed714))
+    {
+        layout = BedLayout::Bed714;
+        return true;
+    }
+
+    return false;
+}
+
+inline const BedSpeaker* speakersForLayout (BedLayout layout) noexcept
+{
+    return layout == BedLayout::Bed916 ? kBed916Speakers.data() : kBed714Speakers.data();
+}
+
+inline BedZones zonesForLayout (BedLayout layout) noexcept
+{
+    BedZones zones {};
+    zones.fill (kNoZone);
+    const auto* speakers = speakersForLayout (layout);
+    for (int ch = 0; ch < channelCountForLayout (layout); ++ch)
+        zones[static_cast<size_t> (ch)] = speakers[ch].zone;
+    return zones;
+}
+
+//==============================================================================
+// VBAP gains for one layout, tabulated over the same 2 degree grid as
+// SphericalHarmonicLut. Triangles are the convex hull of the speaker directions
+// plus virtual nadir and zenith speakers; their gain is shared equally (power-
+// preserving) by the ear-level ring and the top layer respectively, so sources
+// below the horizon stay on the bed and overhead sources image symmetrically.
+// Built once (non-RT); lookups are RT-safe.
+class BedVbapLut
+{
+public:
+    static constexpr float kStepDeg = 2.0f;
+    static constexpr int kNumAzimuths = 180;  // [0, 360)
+    static constexpr int kNumElevations = 91; // [-90, +90]
+
+    explicit BedVbapLut (BedLayout layoutToUse)
+        : layout (layoutToUse),
+          numChannels (channelCountForLayout (layoutToUse))
+    {
+        buildTriangles();
+
+        constexpr float degToRad = 3.14159265358979323846f / 180.0f;
+        table.resize (static_cast<size_t> (kNumAzimuths * kNumElevations));
+
+        for (int e = 0; e < kNumElevations; ++e)
+        {
+            const float elevation = (-90.0f + (static_cast<float> (e) * kStepDeg)) * degToRad;
+            for (int a = 0; a < kNumAzimuths; ++a)
+            {
+                const float azimuth = static_cast<float> (a) * kStepDeg * degToRad;
+                const Direction direction { std::sin (azimuth) * std::cos (elevation),
+                                            std::sin (elevation),
+                                            std::cos (azimuth) * std::cos (elevation) };
+                evaluate (direction, table[static_cast<size_t> ((e * kNumAzimuths) + a)]);
+            }
+        }
+    }
+
+    BedLayout getLayout() const noexcept { return layout; }
+    int getNumChannels() const noexcept { return numChannels; }
+
+    // azimuth/elevation in renderer degrees; output is power-normalised.
+    void lookup (float azimuthDeg, float elevationDeg, BedGains& out) const noexcept
+    {
+        out.fill (0.0f);
+        if (! std::isfinite (azimuthDeg) || ! std::isfinite (elevationDeg))
+            return;
+
+        auto wrappedAzimuth = std::fmod (azimuthDeg, 360.0f);
+        if (wrappedAzimuth < 0.0f)
+            wrappedAzimuth += 360.0f;
+
+        const float azimuthPosition = wrappedAzimuth / kStepDeg;
+        const int a0 = static_cast<int> (azimuthPosition) % kNumAzimuths;
+        const int a1 = (a0 + 1) % kNumAzimuths;
+        const float fa = azimuthPosition - std::floor (azimuthPosition);
+
+        const float elevationPosition = (juce::jlimit (-90.0f, 90.0f, elevationDeg) + 90.0f) / kStepDeg;
+        const int e0 = juce::jmin (static_cast<int> (elevationPosition), kNumElevations - 2);
+        const int e1 = e0 + 1;
+        const float fe = juce::jlimit (0.0f, 1.0f, elevationPosition - static_cast<float> (e0));
+
+        const auto& g00 = table[static_cast<size_t> ((e0 * kNumAzimuths) + a0)];
+        const auto& g01 = table[static_cast<size_t> ((e0 * kNumAzimuths) + a1)];
+        const auto& g10 = table[static_cast<size_t> ((e1 * kNumAzimuths) + a0)];
+        const auto& g11 = table[static_cast<size_t> ((e1 * kNumAzimuths) + a1)];
+
+        const float w00 = (1.0f - fa) * (1.0f - fe);
+        const float w01 = fa * (1.0f - fe);
+        const float w10 = (1.0f - fa) * fe;
+        const float w11 = fa * fe;
+
+        float power = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            const auto idx = static_cast<size_t> (ch);
+            out[idx] = (w00 * g00[idx]) + (w01 * g01[idx]) + (w10 * g10[idx]) + (w11 * g11[idx]);
+            power += out[idx] * out[idx];
+        }
+
+        // Interpolating between triangles dips the power slightly; restore it.
+        if (power > 1.0e-12f)
+        {
+            const float norm = 1.0f / std::sqrt (power);
+            for (int ch = 0; ch < numChannels; ++ch)
+                out[static_cast<size_t> (ch)] *= norm;
+        }
+    }
+
+private:
+    struct Direction
+    {
+        float x = 0.0f;
+        float y = 0.0f;
+        float z = 0.0f;
+    };
+
+    struct Triangle
+    {
+        std::array<int, 3> vertices {};                         // index into `directions`
+        std::array<std::array<float, 3>, 3> inverse {};         // rows give vertex gains
+    };
+
+    static constexpr int kMaxVertices = kMaxBedChannels + 2;   // + virtual nadir and zenith
+    static constexpr float kTopLayerMinElevationDeg = 30.0f;
+    static constexpr float kCoplanarEpsilon = 1.0e-4f;
+    static constexpr float kInsideEpsilon = -1.0e-4f;
+
+    static Direction directionFor (float azimuthDeg, float elevationDeg) noexcept
+    {
+        constexpr float degToRad = 3.14159265358979323846f / 180.0f;
+        const float azimuth = azimuthDeg * degToRad;
+        const float elevation = elevationDeg * degToRad;
+        return { std::sin (azimuth) * std::cos (elevation),
+                 std::sin (elevation),
+                 std::cos (azimuth) * std::cos (elevation) };
+    }
+
+    static bool isEarLevel (const BedSpeaker& speaker) noexcept
+    {
+        return std::abs (speaker.elevationDeg) < 1.0f;
+    }
+
+    static bool isTopLayer (const BedSpeaker& speaker) noexcept
+    {
+        return speaker.elevationDeg >= kTopLayerMinElevationDeg;
+    }
+
+    static Direction cross (const Direction& a, const Direction& b) noexcept
+    {
+        return { (a.y * b.z) - (a.z * b.y), (a.z * b.x) - (a.x * b.z), (a.x * b.y) - (a.y * b.x) };
+    }
+
+    static Direction minus (const Direction& a, const Direction& b) noexcept
+    {
+        return { a.x - b.x, a.y - b.y, a.z - b.z };
+    }
+
+    static float dot (const Direction& a, const Direction& b) noexcept
+    {
+        return (a.x * b.x) + (a.y * b.y) + (a.z * b.z);
+    }
+
+    // Gains of `p` on triangle (a, b, c): solves p = ga*a + gb*b + gc*c.
+    static bool invertBasis (const Direction& a, const Direction& b, const Direction& c,
+                             std::array<std::array<float, 3>, 3>& inverse) noexcept
+    {
+        const auto bc = cross (b, c);
+        const float det = dot (a, bc);
+        if (std::abs (det) < 1.0e-6f)
+            return false;
+
+        const auto ca = cross (c, a);
+        const auto ab = cross (a, b);
+        const float invDet = 1.0f / det;
+        inverse[0] = { bc.x * invDet, bc.y * invDet, bc.z * invDet };
+        inverse[1] = { ca.x * invDet, ca.y * invDet, ca.z * invDet };
+        inverse[2] = { ab.x * invDet, ab.y * invDet, ab.z * invDet };
+        return true;
+    }
+
+    void buildTriangles()
+    {
+        const auto* speakers = speakersForLayout (layout);
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            if (ch == kLfeChannel)
+                continue;
+
+            vertexChannel[static_cast<size_t> (numVertices)] = ch;
+            directions[static_cast<size_t> (numVertices)] = directionFor (speakers[ch].azimuthDeg,
+                                                                          speakers[ch].elevationDeg);
+            if (isEarLevel (speakers[ch]))
+                ++numEarLevelSpeakers;
+            if (isTopLayer (speakers[ch]))
+                ++numTopSpeakers;
+            ++numVertices;
+        }
+
+        nadirVertex = numVertices;
+        vertexChannel[static_cast<size_t> (numVertices)] = -1;
+        directions[static_cast<size_t> (numVertices)] = { 0.0f, -1.0f, 0.0f };
+        ++numVertices;
+
+        zenithVertex = numVertices;
+        vertexChannel[static_cast<size_t> (numVertices)] = -1;
+        directions[static_cast<size_t> (numVertices)] = { 0.0f, 1.0f, 0.0f };
+        ++numVertices;
+
+        // Brute-force convex hull: fine for <= 18 points and only run once.
+        for (int i = 0; i < numVertices; ++i)
+        {
+            for (int j = i + 1; j < numVertices; ++j)
+            {
+                for (int k = j + 1; k < numVertices; ++k)
+                {
+                    if (isHullFace (i, j, k))
+                    {
+                        Triangle triangle;
+                        triangle.vertices = { i, j, k };
+                        if (invertBasis (directions[static_cast<size_t> (i)],
+                                         directions[static_cast<size_t> (j)],
+                                         directions[static_cast<size_t> (k)],
+                                         triangle.inverse))
+                        {
+                            triangles.push_back (triangle);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    bool isHullFace (int i, int j, int k) const noexcept
+    {
+        const auto& a = directions[static_cast<size_t> (i)];
+        const auto& b = directions[static_cast<size_t> (j)];
+        const auto& c = directions[static_cast<size_t> (k)];
+        const auto normal = cross (minus (b, a), minus (c, a));
+        if (dot (normal, normal) < 1.0e-8f)
+            return false;
+
+        const float offset = dot (normal, a);
+        bool anyAbove = false;
+        bool anyBelow = false;
+        for (int m = 0; m < numVertices; ++m)
+        {
+            if (m == i || m == j || m == k)
+                continue;
+
+            const auto& point = directions[static_cast<size_t> (m)];
+            const float side = dot (normal, point) - offset;
+            if (side > kCoplanarEpsilon)
+                anyAbove = true;
+            else if (side < -kCoplanarEpsilon)
+                anyBelow = true;
+            else if (containsCoplanarPoint (a, b, c, point))
+                return false; // a finer triangle through `point` covers this area
+
+            if (anyAbove && anyBelow)
+                return false;
+        }
+
+        return true;
+    }
+
+    static bool containsCoplanarPoint (const Direction& a, const Direction& b, const Direction& c,
+                                       const Direction& p) noexcept
+    {
+        std::array<std::array<float, 3>, 3> inverse {};
+        if (! invertBasis (a, b, c, inverse))
+            return false;
+
+        for (const auto& row : inverse)
+            if ((row[0] * p.x) + (row[1] * p.y) + (row[2] * p.z) < kInsideEpsilon)
+                return false;
+        return true;
+    }
+
+    void evaluate (const Direction& direction, BedGains& gains) const noexcept
+    {
+        gains.fill (0.0f);
+
+        for (const auto& triangle : triangles)
+        {
+            std::array<float, 3> vertexGains {};
+            bool inside = true;
+            for (size_t v = 0; v < 3; ++v)
+            {
+                const auto& row = triangle.inverse[v];
+                vertexGains[v] = (row[0] * direction.x) + (row[1] * direction.y) + (row[2] * direction.z);
+                inside = inside && vertexGains[v] >= kInsideEpsilon;
+            }
+
+            if (! inside)
+                continue;
+
+            const auto* speakers = speakersForLayout (layout);
+            for (size_t v = 0; v < 3; ++v)
+            {
+                const float gain = juce::jmax (0.0f, vertexGains[v]);
+                const int vertex = triangle.vertices[v];
+                if (vertex == nadirVertex || vertex == zenithVertex)
+                {
+                    const bool top = vertex == zenithVertex;
+                    const int layerSize = top ? numTopSpeakers : numEarLevelSpeakers;
+                    const float share = layerSize > 0 ? gain / std::sqrt (static_cast<float> (layerSize)) : 0.0f;
+                    for (int ch = 0; ch < numChannels; ++ch)
+                        if (ch != kLfeChannel && (top ? isTopLayer (speakers[ch]) : isEarLevel (speakers[ch])))
+                            gains[static_cast<size_t> (ch)] += share;
+                    continue;
+                }
+
+                gains[static_cast<size_t> (vertexChannel[static_cast<size_t> (vertex)])] += gain;
+            }
+            break;
+        }
+
+        float power = 0.0f;
+        for (const auto gain : gains)
+            power += gain * gain;
+        if (power > 1.0e-12f)
+        {
+            const float norm = 1.0f / std::sqrt (power);
+            for (auto& gain : gains)
+                gain *= norm;
+        }
+    }
+
+    BedLayout layout;
+    int numChannels = 0;
+    int numVertices = 0;
+    int nadirVertex = -1;
+    int zenithVertex = -1;
+    int numEarLevelSpeakers = 0;
+    int numTopSpeakers = 0;
+    std::array<Direction, kMaxVertices> directions {};
+    std::array<int, kMaxVertices> vertexChannel {};
+    std::vector<Triangle> triangles;
+    std::vector<BedGains> table;
+};
+
+//==============================================================================
+// Spread blends toward an equal-power distribution over the main speakers,
+// mirroring SpreadProcessor on the quad bed.
+inline void applySpread (BedGains& gains, BedLayout layout, float spread) noexcept
+{
+    const float s = juce::jlimit (0.0f, 1.0f, std::isfinite (spread) ? spread : 0.0f);
+    if (s <= 0.0f)
+        return;
+
+    const int numChannels = channelCountForLayout (layout);
+    const float diffuseGain = 1.0f / std::sqrt (static_cast<float> (numChannels - 1));
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        if (ch == kLfeChannel)
+            continue;
+
+        auto& gain = gains[static_cast<size_t> (ch)];
+        gain = (gain * (1.0f - s)) + (diffuseGain * s);
+    }
+}
+
+// Cardioid directivity towards each bed speaker, matching DirectivityFilter's
+// pattern; speakers sit on a sphere of the quad layout's nominal radius.
+inline void applyDirectivity (BedGains& gains,
+                              BedLayout layout,
+                              float directivity,
+                              const Vec3& directivityAim,
+                              const Vec3& emitterPosition) noexcept
+{
+    constexpr float kNominalSpeakerRadius = 3.4f; // |(2.5, 1.2, 2.0)|
+    constexpr float degToRad = 3.14159265358979323846f / 180.0f;
+
+    const float directivityClamped = juce::jlimit (0.0f, 1.0f, directivity);
+    if (directivityClamped <= 0.0f)
+        return;
+
+    const float aimLength = std::sqrt ((directivityAim.x * directivityAim.x)
+                                       + (directivityAim.y * directivityAim.y)
+                                       + (directivityAim.z * directivityAim.z));
+    if (! std::isfinite (aimLength) || aimLength < 1.0e-3f)
+        return;
+
+    const auto* speakers = speakersForLayout (layout);
+    for (int ch = 0; ch < channelCountForLayout (layout); ++ch)
+    {
+        if (ch == kLfeChannel)
+            continue;
+
+        const float azimuth = speakers[ch].azimuthDeg * degToRad;
+        const float elevation = speakers[ch].elevationDeg * degToRad;
+        const float dx = (kNominalSpeakerRadius * std::sin (azimuth) * std::cos (elevation)) - emitterPosition.x;
+        const float dy = (kNominalSpeakerRadius * std::sin (elevation)) - emitterPosition.y;
+        const float dz = (kNominalSpeakerRadius * std::cos (azimuth) * std::cos (elevation)) - emitterPosition.z;
+        const float length = std::sqrt ((dx * dx) + (dy * dy) + (dz * dz));
+        if (length < 1.0e-4f)
+            continue;
+
+        const float cosTheta = juce::jlimit (
+            -1.0f,
+            1.0f,
+            ((directivityAim.x * dx) + (directivityAim.y * dy) + (directivityAim.z * dz)) / (aimLength * length));
+        const float cardioid = 0.5f * (1.0f + cosTheta);
+        gains[static_cast<size_t> (ch)] *= (1.0f - directivityClamped) + (directivityClamped * cardioid);
+    }
+}
+
+// Pans one mono block onto the bed, ramping every channel from currentGains to
+// targetGains; currentGains is updated to the target.
+inline void panBlock (float* const* bed,
+                      int numChannels,
+                      const float* mono,
+                      int numSamples,
+                      BedGains& currentGains,
+                      const BedGains& targetGains) noexcept
+{
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        const auto idx = static_cast<size_t> (ch);
+        ambisonic_encoder::addWithGainRamp (bed[ch], mono, numSamples, currentGains[idx], targetGains[idx]);
+        currentGains[idx] = targetGains[idx];
+    }
+}
+
+} // namespace locusq::bed_panner
@@ -0,0 +1,801 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <juce_core/juce_core.h>
+
+#include "../SceneGraph.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Object export behind the CodecADM / CodecIAMF profiles. Every active
+// emitter is captured as its own mono track plus timestamped position
+// metadata and streamed to an ADM BW64 file (ITU-R BS.2088 container with
+// BS.2076 metadata in the chna/axml chunks).
+//
+// Threading:
+//   - Audio thread: capture() memcpys each emitter's mono block into a
+//     preallocated ring block and snapshots its position. It never allocates,
+//     locks or touches the disk; when the ring is full the frames are dropped
+//     and counted (the writer pads the gap with silence so tracks stay in sync).
+//   - Writer thread: drains the ring, appends interleaved float PCM to the
+//     data chunk and streams each track's audioBlockFormat XML to a sidecar
+//     file, so memory stays bounded however long the export runs.
+//   - Message thread: start() / stop(). stop() joins the writer and finalises
+//     the file (chna + axml, BW64/ds64 upgrade past 4 GiB).
+//
+// IAMF v1 has no object audio elements, so the IAMF profile exports the same
+// object stems; the BW64 is the interchange input for an IAMF encoder.
+namespace locusq::object_export
+{
+
+inline constexpr int kMaxObjects = 16;
+inline constexpr int kFramesPerBlock = 1024;
+inline constexpr int kRingBlocks = 64; // ~1.4 s of writer slack at 48 kHz, 4 MiB
+inline constexpr int kLabelLength = 32;
+
+// audioBlockFormat merge thresholds: smaller moves extend the current block.
+inline constexpr float kAngleThresholdDeg = 0.5f;
+inline constexpr float kDistanceThreshold = 0.005f;
+inline constexpr float kGainThreshold = 0.001f;
+
+struct ObjectMetadata
+{
+    bool active = false;
+    float x = 0.0f;
+    float y = 0.0f;
+    float z = 0.0f;
+    float gainLinear = 0.0f;
+    char label[kLabelLength] {};
+};
+
+struct CaptureBlock
+{
+    std::uint64_t startSample = 0; // export-relative
+    int numFrames = 0;
+    std::array<ObjectMetadata, kMaxObjects> objects {};
+    std::array<std::array<float, kFramesPerBlock>, kMaxObjects> audio {};
+
+    void clear() noexcept
+    {
+        for (int track = 0; track < kMaxObjects; ++track)
+        {
+            if (objects[static_cast<size_t> (track)].active)
+                std::memset (audio[static_cast<size_t> (track)].data(), 0, sizeof (float) * kFramesPerBlock);
+            objects[static_cast<size_t> (track)] = {};
+        }
+        startSample = 0;
+        numFrames = 0;
+    }
+};
+
+struct ExportStatus
+{
+    bool active = false;
+    int objectCount = 0;
+    std::uint64_t framesCaptured = 0;
+    std::uint64_t framesDropped = 0;
+    std::uint64_t bytesWritten = 0;
+    bool writeFailed = false;
+};
+
+//==============================================================================
+// Single-producer / single-consumer ring of capture blocks. Blocks are handed
+// out by pointer so neither side copies more than the audio itself.
+class CaptureRing
+{
+public:
+    void allocate()
+    {
+        if (blocks == nullptr)
+            blocks = std::make_unique<CaptureBlock[]> (static_cast<size_t> (kRingBlocks));
+
+        for (int i = 0; i < kRingBlocks; ++i)
+            blocks[static_cast<size_t> (i)].clear();
+
+        writeIndex.store (0, std::memory_order_relaxed);
+        readIndex.store (0, std::memory_order_relaxed);
+    }
+
+    CaptureBlock* acquireWrite() noexcept
+    {
+        const auto write = writeIndex.load (std::memory_order_relaxed);
+        if (write - readIndex.load (std::memory_order_acquire) >= static_cast<std::uint32_t> (kRingBlocks))
+            return nullptr;
+        return &blocks[static_cast<size_t> (write % static_cast<std::uint32_t> (kRingBlocks))];
+    }
+
+    void publishWrite() noexcept
+    {
+        writeIndex.store (writeIndex.load (std::memory_order_relaxed) + 1u, std::memory_order_release);
+    }
+
+    CaptureBlock* acquireRead() noexcept
+    {
+        const auto read = readIndex.load (std::memory_order_relaxed);
+        if (read == writeIndex.load (std::memory_order_acquire))
+            return nullptr;
+        return &blocks[static_cast<size_t> (read % static_cast<std::uint32_t> (kRingBlocks))];
+    }
+
+    void releaseRead() noexcept
+    {
+        readIndex.store (readIndex.load (std::memory_order_relaxed) + 1u, std::memory_order_release);
+    }
+
+private:
+    std::unique_ptr<CaptureBlock[]> blocks;
+    std::atomic<std::uint32_t> writeIndex { 0 };
+    std::atomic<std::uint32_t> readIndex { 0 };
+};
+
+//==============================================================================
+// Streams interleaved float32 object tracks to a BW64 file. Runs entirely on
+// the writer thread (open/append) and the message thread (finalise).
+class Bw64ObjectWriter
+{
+public:
+    static constexpr std::uint64_t kRiffSizeLimit = 0xffffffffull;
+
+    // Sizes above riffSizeLimitBytes upgrade the file to BW64/ds64. Only the
+    // DSP probe lowers it, to exercise the upgrade without a 4 GiB export.
+    explicit Bw64ObjectWriter (std::uint64_t riffSizeLimitBytes = kRiffSizeLimit) noexcept
+        : sizeLimit (riffSizeLimitBytes)
+    {
+    }
+
+    bool open (const juce::File& target, double sampleRate, float distanceScaleMetres)
+    {
+        file = target;
+        rate = sampleRate > 0.0 ? sampleRate : 48000.0;
+        distanceScale = distanceScaleMetres > 0.0f ? distanceScaleMetres : 1.0f;
+        framesWritten = 0;
+        failed = false;
+        tracks = {};
+
+        file.deleteFile();
+        stream = std::make_unique<juce::FileOutputStream> (file);
+        if (stream->failedToOpen())
+        {
+            stream.reset();
+            return false;
+        }
+
+        // RIFF header with a JUNK chunk reserved for ds64, so the file can be
+        // upgraded to BW64 in place if the data chunk outgrows 32-bit sizes.
+        stream->write ("RIFF", 4);
+        stream->writeInt (0);
+        stream->write ("WAVE", 4);
+        stream->write ("JUNK", 4);
+        stream->writeInt (kDs64BodySize);
+        for (int i = 0; i < kDs64BodySize; ++i)
+            stream->writeByte (0);
+
+        stream->write ("fmt ", 4);
+        stream->writeInt (18);
+        stream->writeShort (3); // WAVE_FORMAT_IEEE_FLOAT
+        stream->writeShort (static_cast<short> (kMaxObjects));
+        stream->writeInt (static_cast<int> (std::lround (rate)));
+        stream->writeInt (static_cast<int> (std::lround (rate)) * kMaxObjects * kBytesPerSample);
+        stream->writeShort (static_cast<short> (kMaxObjects * kBytesPerSample));
+        stream->writeShort (static_cast<short> (8 * kBytesPerSample));
+        stream->writeShort (0);
+
+        stream->write ("data", 4);
+        dataSizeOffset = stream->getPosition();
+        stream->writeInt (0);
+
+        interleaved.assign (static_cast<size_t> (kFramesPerBlock * kMaxObjects), 0.0f);
+        return true;
+    }
+
+    bool isOpen() const noexcept { return stream != nullptr; }
+    bool hasFailed() const noexcept { return failed; }
+    std::uint64_t getBytesWritten() const noexcept { return framesWritten * kMaxObjects * kBytesPerSample; }
+
+    void append (const CaptureBlock& block)
+    {
+        if (stream == nullptr || failed)
+            return;
+
+        padTo (block.startSample);
+
+        for (int track = 0; track < kMaxObjects; ++track)
+            updateTrackMetadata (track, block.objects[static_cast<size_t> (track)], block.startSample);
+
+        for (int frame = 0; frame < block.numFrames; ++frame)
+            for (int track = 0; track < kMaxObjects; ++track)
+                interleaved[static_cast<size_t> (frame * kMaxObjects + track)] =
+                    block.audio[static_cast<size_t> (track)][static_cast<size_t> (frame)];
+
+        writeFrames (block.numFrames);
+    }
+
+    // Frames the audio thread had to drop are written as silence so every
+    // track keeps its timeline.
+    void padTo (std::uint64_t sample)
+    {
+        if (stream == nullptr)
+            return;
+
+        std::fill (interleaved.begin(), interleaved.end(), 0.0f);
+        while (framesWritten < sample && ! failed)
+            writeFrames (static_cast<int> (juce::jmin<std::uint64_t> (sample - framesWritten,
+                                                                     static_cast<std::uint64_t> (kFramesPerBlock))));
+    }
+
+    int getObjectCount() const noexcept
+    {
+        int count = 0;
+        for (const auto& track : tracks)
+            count += track.used ? 1 : 0;
+        return count;
+    }
+
+    bool finalise()
+    {
+        if (stream == nullptr)
+            return false;
+
+        for (int track = 0; track < kMaxObjects; ++track)
+            closeTrackBlock (track, framesWritten);
+
+        const auto dataSize = framesWritten * static_cast<std::uint64_t> (kMaxObjects * kBytesPerSample);
+        if ((dataSize & 1u) != 0u)
+            stream->writeByte (0);
+
+        writeChnaChunk();
+        writeAxmlChunk();
+
+        for (auto& track : tracks)
+        {
+            track.sidecar.reset();
+            if (track.sidecarFile != juce::File())
+                track.sidecarFile.deleteFile();
+        }
+
+        const auto riffSize = static_cast<std::uint64_t> (stream->getPosition()) - 8u;
+        if (riffSize > sizeLimit || dataSize > sizeLimit)
+        {
+            stream->setPosition (0);
+            stream->write ("BW64", 4);
+            stream->writeInt (-1);
+            stream->setPosition (12);
+            stream->write ("ds64", 4);
+            stream->writeInt (kDs64BodySize);
+            stream->writeInt64 (static_cast<juce::int64> (riffSize));
+            stream->writeInt64 (static_cast<juce::int64> (dataSize));
+            stream->writeInt64 (static_cast<juce::int64> (framesWritten));
+            stream->writeInt (0); // no extra chunk size table
+            stream->setPosition (dataSizeOffset);
+            stream->writeInt (-1);
+        }
+        else
+        {
+            stream->setPosition (4);
+            stream->writeInt (static_cast<int> (static_cast<std::uint32_t> (riffSize)));
+            stream->setPosition (dataSizeOffset);
+            stream->writeInt (static_cast<int> (static_cast<std::uint32_t> (dataSize)));
+        }
+
+        stream->flush();
+        const bool ok = ! failed && stream->getStatus().wasOk();
+        stream.reset();
+        return ok;
+    }
+
+private:
+    static constexpr int kDs64BodySize = 28;
+    static constexpr int kBytesPerSample = 4;
+
+    struct OpenBlock
+    {
+        std::uint64_t startSample = 0;
+        float azimuthDeg = 0.0f;
+        float elevationDeg = 0.0f;
+        float distance = 0.0f;
+        float gain = 0.0f;
+    };
+
+    struct TrackState
+    {
+        bool used = false;
+        bool blockOpen = false;
+        std::uint64_t firstSample = 0;
+        int blockCount = 0;
+        OpenBlock block;
+        juce::String name;
+        juce::File sidecarFile;
+        std::unique_ptr<juce::FileOutputStream> sidecar;
+    };
+
+    void writeFrames (int numFrames)
+    {
+        if (numFrames <= 0)
+            return;
+
+        const auto bytes = static_cast<size_t> (numFrames * kMaxObjects * kBytesPerSample);
+        if (! stream->write (interleaved.data(), bytes))
+            failed = true;
+        framesWritten += static_cast<std::uint64_t> (numFrames);
+    }
+
+    void updateTrackMetadata (int trackIndex, const ObjectMetadata& meta, std::uint64_t startSample)
+    {
+        auto& track = tracks[static_cast<size_t> (trackIndex)];
+        if (! track.used)
+        {
+            if (! meta.active)
+                return;
+
+            track.used = true;
+            track.firstSample = startSample;
+            track.sidecarFile = file.getSiblingFile (file.getFileNameWithoutExtension()
+                                                     + ".adm" + juce::String (trackIndex + 1) + ".tmp");
+            track.sidecarFile.deleteFile();
+            track.sidecar = std::make_unique<juce::FileOutputStream> (track.sidecarFile);
+            if (track.sidecar->failedToOpen())
+            {
+                track.sidecar.reset();
+                failed = true;
+            }
+        }
+
+        if (meta.active && meta.label[0] != '\0')
+            track.name = juce::String::fromUTF8 (meta.label, static_cast<int> (strnlen (meta.label, kLabelLength)));
+
+        // Inactive spans keep the last position at zero gain, so every object's
+        // blocks stay contiguous from its first appearance to the end.
+        OpenBlock next = track.block;
+        next.startSample = startSample;
+        next.gain = 0.0f;
+        if (meta.active)
+        {
+            // ADM polar: azimuth counter-clockwise from front, distance
+            // normalised so 1.0 is the renderer's max distance.
+            const float horizontal = std::sqrt (meta.x * meta.x + meta.z * meta.z);
+            const float radius = std::sqrt (horizontal * horizontal + meta.y * meta.y);
+            next.azimuthDeg = radius > 1.0e-6f ? -std::atan2 (meta.x, meta.z) * (180.0f / juce::MathConstants<float>::pi) : 0.0f;
+            next.elevationDeg = radius > 1.0e-6f ? std::atan2 (meta.y, horizontal) * (180.0f / juce::MathConstants<float>::pi) : 0.0f;
+            next.distance = juce::jlimit (0.0f, 1.0f, radius / distanceScale);
+            next.gain = juce::jmax (0.0f, meta.gainLinear);
+        }
+
+        if (track.blockOpen && ! blockChanged (track.block, next))
+            return;
+
+        closeTrackBlock (trackIndex, startSample);
+        track.block = next;
+        track.blockOpen = true;
+    }
+
+    static bool blockChanged (const OpenBlock& a, const OpenBlock& b) noexcept
+    {
+        auto azimuthDelta = std::abs (a.azimuthDeg - b.azimuthDeg);
+        if (azimuthDelta > 180.0f)
+            azimuthDelta = 360.0f - azimuthDelta;
+
+        return azimuthDelta > kAngleThresholdDeg
+               || std::abs (a.elevationDeg - b.elevationDeg) > kAngleThresholdDeg
+               || std::abs (a.distance - b.distance) > kDistanceThreshold
+               || std::abs (a.gain - b.gain) > kGainThreshold;
+    }
+
+    void closeTrackBlock (int trackIndex, std::uint64_t endSample)
+    {
+        auto& track = tracks[static_cast<size_t> (trackIndex)];
+        if (! track.blockOpen)
+            return;
+
+        track.blockOpen = false;
+        if (track.sidecar == nullptr || endSample <= track.block.startSample)
+            return;
+
+        ++track.blockCount;
+        juce::String xml;
+        xml << "        <audioBlockFormat audioBlockFormatID=\"AB_" << channelFormatSuffix (trackIndex)
+            << "_" << juce::String::toHexString (track.blockCount).paddedLeft ('0', 8).toUpperCase()
+            << "\" rtime=\"" << formatTime (track.block.startSample - track.firstSample)
+            << "\" duration=\"" << formatTime (endSample - track.block.startSample) << "\">\n"
+            << "          <position coordinate=\"azimuth\">" << juce::String (track.block.azimuthDeg, 2) << "</position>\n"
+            << "          <position coordinate=\"elevation\">" << juce::String (track.block.elevationDeg, 2) << "</position>\n"
+            << "          <position coordinate=\"distance\">" << juce::String (track.block.distance, 4) << "</position>\n"
+            << "          <gain>" << juce::String (track.block.gain, 5) << "</gain>\n"
+            << "        </audioBlockFormat>\n";
+        if (! track.sidecar->writeText (xml, false, false, "\n"))
+            failed = true;
+    }
+
+    juce::String formatTime (std::uint64_t samples) const
+    {
+        const double seconds = static_cast<double> (samples) / rate;
+        const auto whole = static_cast<std::uint64_t> (seconds);
+        const auto fraction = static_cast<int> (std::lround ((seconds - static_cast<double> (whole)) * 100000.0));
+        const auto carry = fraction >= 100000 ? 1u : 0u;
+        const auto total = whole + carry;
+        return juce::String (static_cast<int> (total / 3600u)).paddedLeft ('0', 2) + ":"
+               + juce::String (static_cast<int> ((total / 60u) % 60u)).paddedLeft ('0', 2) + ":"
+               + juce::String (static_cast<int> (total % 60u)).paddedLeft ('0', 2) + "."
+               + juce::String (carry != 0u ? 0 : fraction).paddedLeft ('0', 5);
+    }
+
+    static juce::String objectSuffix (int trackIndex)
+    {
+        return juce::String::toHexString (0x1001 + trackIndex).toUpperCase();
+    }
+
+    static juce::String channelFormatSuffix (int trackIndex)
+    {
+        return "0003" + objectSuffix (trackIndex);
+    }
+
+    static juce::String trackUid (int trackIndex)
+    {
+        return "ATU_" + juce::String::toHexString (trackIndex + 1).paddedLeft ('0', 8).toUpperCase();
+    }
+
+    void writeChnaChunk()
+    {
+        const int used = getObjectCount();
+        stream->write ("chna", 4);
+        stream->writeInt (4 + 40 * used);
+        stream->writeShort (static_cast<short> (kMaxObjects));
+        stream->writeShort (static_cast<short> (used));
+
+        for (int trackIndex = 0; trackIndex < kMaxObjects; ++trackIndex)
+        {
+            if (! tracks[static_cast<size_t> (trackIndex)].used)
+                continue;
+
+            const auto uid = trackUid (trackIndex);
+            const auto trackRef = "AT_" + channelFormatSuffix (trackIndex) + "_01";
+            const auto packRef = "AP_" + channelFormatSuffix (trackIndex);
+            stream->writeShort (static_cast<short> (trackIndex + 1));
+            stream->write (uid.toRawUTF8(), 12);
+            stream->write (trackRef.toRawUTF8(), 14);
+            stream->write (packRef.toRawUTF8(), 11);
+            stream->writeByte (0);
+        }
+    }
+
+    void writeAxmlChunk()
+    {
+        // Everything except the streamed audioBlockFormats is small enough to
+        // build in memory; the block sidecars are copied straight through.
+        const auto duration = formatTime (framesWritten);
+        juce::String head;
+        head << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+             << "<ebuCoreMain xmlns=\"urn:ebu:metadata-schema:ebuCore_2016\" xml:lang=\"en\">\n"
+             << "  <coreMetadata>\n    <format>\n      <audioFormatExtended version=\"ITU-R_BS.2076-2\">\n"
+             << "      <audioProgramme audioProgrammeID=\"APR_1001\" audioProgrammeName=\"LocusQ\" start=\"00:00:00.00000\" end=\""
+             << duration << "\">\n        <audioContentIDRef>ACO_1001</audioContentIDRef>\n      </audioProgramme>\n"
+             << "      <audioContent audioContentID=\"ACO_1001\" audioContentName=\"LocusQ Objects\">\n";
+
+        for (int trackIndex = 0; trackIndex < kMaxObjects; ++trackIndex)
+            if (tracks[static_cast<size_t> (trackIndex)].used)
+                head << "        <audioObjectIDRef>AO_" << objectSuffix (trackIndex) << "</audioObjectIDRef>\n";
+        head << "      </audioContent>\n";
+
+        std::vector<juce::String> channelHeads (static_cast<size_t> (kMaxObjects));
+        juce::String tail;
+        for (int trackIndex = 0; trackIndex < kMaxObjects; ++trackIndex)
+        {
+            const auto& track = tracks[static_cast<size_t> (trackIndex)];
+            if (! track.used)
+                continue;
+
+            const auto name = (track.name.isNotEmpty() ? track.name : "Object " + juce::String (trackIndex + 1))
+                                  .replace ("&", "&amp;").replace ("<", "&lt;").replace (">", "&gt;").replace ("\"", "&quot;");
+            const auto suffix = channelFormatSuffix (trackIndex);
+            head << "      <audioObject audioObjectID=\"AO_" << objectSuffix (trackIndex) << "\" audioObjectName=\"" << name
+                 << "\" start=\"" << formatTime (track.firstSample) << "\" duration=\""
+                 << formatTime (framesWritten - track.firstSample) << "\">\n"
+                 << "        <audioPackFormatIDRef>AP_" << suffix << "</audioPackFormatIDRef>\n"
+                 << "        <audioTrackUIDRef>" << trackUid (trackIndex) << "</audioTrackUIDRef>\n"
+                 << "      </audioObject>\n"
+                 << "      <audioPackFormat audioPackFormatID=\"AP_" << suffix << "\" audioPackFormatName=\"" << name
+                 << "\" typeLabel=\"0003\" typeDefinition=\"Objects\">\n"
+                 << "        <audioChannelFormatIDRef>AC_" << suffix << "</audioChannelFormatIDRef>\n"
+                 << "      </audioPackFormat>\n";
+
+            channelHeads[static_cast<size_t> (trackIndex)]
+                << "      <audioChannelFormat audioChannelFormatID=\"AC_" << suffix << "\" audioChannelFormatName=\"" << name
+                << "\" typeLabel=\"0003\" typeDefinition=\"Objects\">\n";
+
+            tail << "      <audioStreamFormat audioStreamFormatID=\"AS_" << suffix << "\" audioStreamFormatName=\"PCM_" << name
+                 << "\" formatLabel=\"0001\" formatDefinition=\"PCM\">\n"
+                 << "        <audioChannelFormatIDRef>AC_" << suffix << "</audioChannelFormatIDRef>\n"
+                 << "        <audioTrackFormatIDRef>AT_" << suffix << "_01</audioTrackFormatIDRef>\n"
+                 << "      </audioStreamFormat>\n"
+                 << "      <audioTrackFormat audioTrackFormatID=\"AT_" << suffix << "_01\" audioTrackFormatName=\"PCM_" << name
+                 << "\" formatLabel=\"0001\" formatDefinition=\"PCM\">\n"
+                 << "        <audioStreamFormatIDRef>AS_" << suffix << "</audioStreamFormatIDRef>\n"
+                 << "      </audioTrackFormat>\n"
+                 << "      <audioTrackUID UID=\"" << trackUid (trackIndex) << "\" sampleRate=\""
+                 << static_cast<int> (std::lround (rate)) << "\" bitDepth=\"32\">\n"
+                 << "        <audioTrackFormatIDRef>AT_" << suffix << "_01</audioTrackFormatIDRef>\n"
+                 << "        <audioPackFormatIDRef>AP_" << suffix << "</audioPackFormatIDRef>\n"
+                 << "      </audioTrackUID>\n";
+        }
+        tail << "      </audioFormatExtended>\n    </format>\n  </coreMetadata>\n</ebuCoreMain>\n";
+
+        const juce::String channelTail { "      </audioChannelFormat>\n" };
+        std::uint64_t chunkSize = head.getNumBytesAsUTF8() + tail.getNumBytesAsUTF8();
+        for (int trackIndex = 0; trackIndex < kMaxObjects; ++trackIndex)
+        {
+            auto& track = tracks[static_cast<size_t> (trackIndex)];
+            if (! track.used)
+                continue;
+
+            if (track.sidecar != nullptr)
+                track.sidecar->flush();
+            chunkSize += channelHeads[static_cast<size_t> (trackIndex)].getNumBytesAsUTF8()
+                         + static_cast<std::uint64_t> (juce::jmax<juce::int64> (0, track.sidecarFile.getSize()))
+                         + channelTail.getNumBytesAsUTF8();
+        }
+
+        stream->write ("axml", 4);
+        stream->writeInt (static_cast<int> (static_cast<std::uint32_t> (chunkSize)));
+        stream->write (head.toRawUTF8(), head.getNumBytesAsUTF8());
+        for (int trackIndex = 0; trackIndex < kMaxObjects; ++trackIndex)
+        {
+            auto& track = tracks[static_cast<size_t> (trackIndex)];
+            if (! track.used)
+                continue;
+
+            const auto& channelHead = channelHeads[static_cast<size_t> (trackIndex)];
+            stream->write (channelHead.toRawUTF8(), channelHead.getNumBytesAsUTF8());
+            track.sidecar.reset();
+            juce::FileInputStream sidecarIn (track.sidecarFile);
+            if (sidecarIn.openedOk())
+                stream->writeFromInputStream (sidecarIn, -1);
+            stream->write (channelTail.toRawUTF8(), channelTail.getNumBytesAsUTF8());
+        }
+        stream->write (tail.toRawUTF8(), tail.getNumBytesAsUTF8());
+
+        if ((chunkSize & 1u) != 0u)
+            stream->writeByte (0);
+    }
+
+    std::uint64_t sizeLimit = kRiffSizeLimit;
+    juce::File file;
+    double rate = 48000.0;
+    float distanceScale = 1.0f;
+    std::unique_ptr<juce::FileOutputStream> stream;
+    juce::int64 dataSizeOffset = 0;
+    std::uint64_t framesWritten = 0;
+    bool failed = false;
+    std::array<TrackState, kMaxObjects> tracks;
+    std::vector<float> interleaved;
+};
+
+//==============================================================================
+class ObjectExportStage
+{
+public:
+    ObjectExportStage() = default;
+    ~ObjectExportStage() { stop(); }
+
+    ObjectExportStage (const ObjectExportStage&) = delete;
+    ObjectExportStage& operator= (const ObjectExportStage&) = delete;
+
+    // Message thread. Opens the file and starts the writer; capture begins on
+    // the next audio block.
+    bool start (const juce::File& target, double sampleRate, float distanceScaleMetres)
+    {
+        if (writerThread.joinable())
+            return false;
+
+        ring.allocate();
+        if (! writer.open (target, sampleRate, distanceScaleMetres))
+            return false;
+
+        slotToTrack.fill (-1);
+        nextTrack = 0;
+        currentBlock = nullptr;
+        exportCursor = 0;
+        framesCaptured.store (0, std::memory_order_relaxed);
+        framesDropped.store (0, std::memory_order_relaxed);
+        objectCount.store (0, std::memory_order_relaxed);
+        bytesWritten.store (0, std::memory_order_relaxed);
+        writeFailed.store (false, std::memory_order_relaxed);
+
+        writerRunning.store (true, std::memory_order_release);
+        writerThread = std::thread ([this] { writerLoop(); });
+        armed.store (true, std::memory_order_seq_cst);
+        return true;
+    }
+
+    // Message thread. Stops capture, drains the ring and finalises the file.
+    bool stop()
+    {
+        if (! writerThread.joinable())
+            return false;
+
+        // Dekker handshake with capture(): once armed is cleared and the audio
+        // thread is outside capture(), the partial block belongs to us.
+        armed.store (false, std::memory_order_seq_cst);
+        while (inCapture.load (std::memory_order_seq_cst))
+            std::this_thread::yield();
+
+        if (currentBlock != nullptr && currentBlock->numFrames > 0)
+            ring.publishWrite();
+        currentBlock = nullptr;
+
+        writerRunning.store (false, std::memory_order_release);
+        writerThread.join();
+
+        writer.padTo (exportCursor);
+        const bool ok = writer.finalise();
+        writeFailed.store (! ok, std::memory_order_relaxed);
+        return ok;
+    }
+
+    bool isActive() const noexcept { return armed.load (std::memory_order_relaxed); }
+
+    ExportStatus getStatus() const noexcept
+    {
+        ExportStatus status;
+        status.active = armed.load (std::memory_order_relaxed);
+        status.objectCount = objectCount.load (std::memory_order_relaxed);
+        status.framesCaptured = framesCaptured.load (std::memory_order_relaxed);
+        status.framesDropped = framesDropped.load (std::memory_order_relaxed);
+        status.bytesWritten = bytesWritten.load (std::memory_order_relaxed);
+        status.writeFailed = writeFailed.load (std::memory_order_relaxed);
+        return status;
+    }
+
+    // Audio thread. Copies every active emitter's mono block into the ring.
+    void capture (const SceneGraph& scene, int numSamples) noexcept
+    {
+        inCapture.store (true, std::memory_order_seq_cst);
+        if (! armed.load (std::memory_order_seq_cst) || numSamples <= 0)
+        {
+            inCapture.store (false, std::memory_order_release);
+            return;
+        }
+
+        int offset = 0;
+        while (offset < numSamples)
+        {
+            if (currentBlock == nullptr)
+            {
+                currentBlock = ring.acquireWrite();
+                if (currentBlock == nullptr)
+                {
+                    // Writer fell behind: drop, never block.
+                    const auto remaining = static_cast<std::uint64_t> (numSamples - offset);
+                    framesDropped.fetch_add (remaining, std::memory_order_relaxed);
+                    exportCursor += remaining;
+                    break;
+                }
+                currentBlock->startSample = exportCursor;
+                currentBlock->numFrames = 0;
+            }
+
+            const int frameOffset = currentBlock->numFrames;
+            const int chunk = juce::jmin (numSamples - offset, kFramesPerBlock - frameOffset);
+            captureChunk (scene, *currentBlock, offset, frameOffset, chunk);
+
+            currentBlock->numFrames += chunk;
+            offset += chunk;
+            exportCursor += static_cast<std::uint64_t> (chunk);
+            framesCaptured.fetch_add (static_cast<std::uint64_t> (chunk), std::memory_order_relaxed);
+
+            if (currentBlock->numFrames >= kFramesPerBlock)
+            {
+                ring.publishWrite();
+                currentBlock = nullptr;
+            }
+        }
+
+        inCapture.store (false, std::memory_order_release);
+    }
+
+private:
+    void captureChunk (const SceneGraph& scene, CaptureBlock& block, int sourceOffset, int frameOffset, int numFrames) noexcept
+    {
+        for (int slotIdx = 0; slotIdx < SceneGraph::MAX_EMITTERS; ++slotIdx)
+        {
+            if (! scene.isSlotActive (slotIdx))
+                continue;
+
+            const auto& slot = scene.getSlot (slotIdx);
+            const auto emitter = slot.read();
+            if (! emitter.active)
+                continue;
+
+            const int track = trackForSlot (slotIdx);
+            if (track < 0)
+                continue;
+
+            auto& meta = block.objects[static_cast<size_t> (track)];
+            if (! meta.active)
+            {
+                meta.active = true;
+                meta.x = emitter.position.x;
+                meta.y = emitter.position.y;
+                meta.z = emitter.position.z;
+                meta.gainLinear = emitter.muted ? 0.0f : juce::Decibels::decibelsToGain (emitter.gain, -60.0f);
+                std::memcpy (meta.label, emitter.label, sizeof (meta.label));
+                meta.label[kLabelLength - 1] = '\0';
+            }
+
+            const auto audio = slot.readAudioSnapshot();
+            const int available = juce::jmin (numFrames, audio.numSamples - sourceOffset);
+            if (audio.mono != nullptr && available > 0)
+                std::memcpy (block.audio[static_cast<size_t> (track)].data() + frameOffset,
+                             audio.mono + sourceOffset,
+                             sizeof (float) * static_cast<size_t> (available));
+        }
+    }
+
+    // Tracks are assigned on first sight and kept for the whole export, so an
+    // emitter maps to one ADM object even if it goes silent in between.
+    int trackForSlot (int slotIdx) noexcept
+    {
+        auto& track = slotToTrack[static_cast<size_t> (slotIdx)];
+        if (track < 0 && nextTrack < kMaxObjects)
+        {
+            track = nextTrack++;
+            objectCount.store (nextTrack, std::memory_order_relaxed);
+        }
+        return track;
+    }
+
+    void writerLoop()
+    {
+        for (;;)
+        {
+            const bool running = writerRunning.load (std::memory_order_acquire);
+            bool drained = true;
+
+            while (auto* block = ring.acquireRead())
+            {
+                drained = false;
+                writer.append (*block);
+                block->clear();
+                ring.releaseRead();
+            }
+
+            bytesWritten.store (writer.getBytesWritten(), std::memory_order_relaxed);
+            if (writer.hasFailed())
+                writeFailed.store (true, std::memory_order_relaxed);
+
+            if (! running)
+                break;
+
+            if (drained)
+                std::this_thread::sleep_for (std::chrono::milliseconds (5));
+        }
+    }
+
+    CaptureRing ring;
+    Bw64ObjectWriter writer;
+    std::thread writerThread;
+
+    std::atomic<bool> armed { false };
+    std::atomic<bool> inCapture { false };
+    std::atomic<bool> writerRunning { false };
+
+    // Audio-thread state while armed (message thread owns it otherwise).
+    CaptureBlock* currentBlock = nullptr;
+    std::uint64_t exportCursor = 0;
+    std::array<int, SceneGraph::MAX_EMITTERS> slotToTrack {};
+    int nextTrack = 0;
+
+    std::atomic<int> objectCount { 0 };
+    std::atomic<std::uint64_t> framesCaptured { 0 };
+    std::atomic<std::uint64_t> framesDropped { 0 };
+    std::atomic<std::uint64_t> bytesWritten { 0 };
+    std::atomic<bool> writeFailed { false };
+};
+
+} // namespace locusq::object_export
@@ -142,79 +142,114 @@ inline void decodeAmbisonicFoaProxyToStereo (float w, float x, float y, float z,
     right = 0.70710678f * w + 0.50f * x + 0.22f * y + 0.08f * z;
 }
 
-inline void writeSurround521Sample (juce::AudioBuffer<float>& outputBuffer,
-                                    int sampleIndex,
-                                    float masterGain,
-                                    float fl,
-                                    float fr,
-                                    float rr,
-                                    float rl) noexcept
+//==============================================================================
+// Block writers for the quad-derived surround layouts. `quad` is the internal
+// bed order FL, FR, RR, RL and `gain` the per-sample master gain ramp; every
+// channel is written with vector ops and channels past the layout are cleared.
+
+inline void writeGainedChannel (float* dest, const float* source, const float* gain, int numSamples) noexcept
+{
+    juce::FloatVectorOperations::multiply (dest, source, gain, numSamples);
+}
+
+// dest = ((a * weightA) + (b * weightB)) * gain
+inline void writeGainedPair (float* dest,
+                             const float* a,
+                             float weightA,
+                             const float* b,
+                             float weightB,
+                             const float* gain,
+                             int numSamples) noexcept
+{
+    juce::FloatVectorOperations::copyWithMultiply (dest, a, weightA, numSamples);
+    juce::FloatVectorOperations::addWithMultiply (dest, b, weightB, numSamples);
+    juce::FloatVectorOperations::multiply (dest, gain, numSamples);
+}
+
+// dest = mean (FL, FR, RR, RL) * scale * gain
+inline void writeGainedBed (float* dest, const float* const* quad, float scale, const float* gain, int numSamples) noexcept
+{
+    juce::FloatVectorOperations::add (dest, quad[0], quad[1], numSamples);
+    juce::FloatVectorOperations::add (dest, quad[2], numSamples);
+    juce::FloatVectorOperations::add (dest, quad[3], numSamples);
+    juce::FloatVectorOperations::multiply (dest, gain, numSamples);
+    juce::FloatVectorOperations::multiply (dest, 0.25f * scale, numSamples);
+}
+
+inline void clearChannelsFrom (juce::AudioBuffer<float>& outputBuffer, int firstChannel, int numSamples) noexcept
+{
+    for (int ch = firstChannel; ch < outputBuffer.getNumChannels(); ++ch)
+        juce::FloatVectorOperations::clear (outputBuffer.getWritePointer (ch), numSamples);
+}
+
+inline void writeSurround521Block (juce::AudioBuffer<float>& outputBuffer,
+                                   const float* const* quad,
+                                   const float* gain,
+                                   int numSamples) noexcept
 {
-    const float bed = (fl + fr + rr + rl) * 0.25f;
-
-    outputBuffer.setSample (0, sampleIndex, fl * masterGain);
-    outputBuffer.setSample (1, sampleIndex, fr * masterGain);
-    outputBuffer.setSample (2, sampleIndex, (fl + fr) * 0.70710678f * masterGain);
-    outputBuffer.setSample (3, sampleIndex, bed * 0.35f * masterGain);
-    outputBuffer.setSample (4, sampleIndex, bed * 0.35f * masterGain);
-    outputBuffer.setSample (5, sampleIndex, rl * masterGain);
-    outputBuffer.setSample (6, sampleIndex, rr * masterGain);
-    outputBuffer.setSample (7, sampleIndex, bed * 0.8f * masterGain);
+    const auto* fl = quad[0];
+    const auto* fr = quad[1];
+    const auto* rr = quad[2];
+    const auto* rl = quad[3];
+
+    writeGainedChannel (outputBuffer.getWritePointer (0), fl, gain, numSamples);
+    writeGainedChannel (outputBuffer.getWritePointer (1), fr, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (2), fl, 0.70710678f, fr, 0.70710678f, gain, numSamples);
+    writeGainedBed (outputBuffer.getWritePointer (3), quad, 0.35f, gain, numSamples);
+    juce::FloatVectorOperations::copy (outputBuffer.getWritePointer (4), outputBuffer.getReadPointer (3), numSamples);
+    writeGainedChannel (outputBuffer.getWritePointer (5), rl, gain, numSamples);
+    writeGainedChannel (outputBuffer.getWritePointer (6), rr, gain, numSamples);
+    writeGainedBed (outputBuffer.getWritePointer (7), quad, 0.8f, gain, numSamples);
+    clearChannelsFrom (outputBuffer, 8, numSamples);
 }
 
-inline void writeSurround721Sample (juce::AudioBuffer<float>& outputBuffer,
-                                    int sampleIndex,
-                                    float masterGain,
-                                    float fl,
-                                    float fr,
-                                    float rr,
-                                    float rl) noexcept
+inline void writeSurround721Block (juce::AudioBuffer<float>& outputBuffer,
+                                   const float* const* quad,
+                                   const float* gain,
+                                   int numSamples) noexcept
 {
-    const float bed = (fl + fr + rr + rl) * 0.25f;
-    const float lrs = (0.72f * rl) + (0.28f * fl);
-    const float rrs = (0.72f * rr) + (0.28f * fr);
-
-    outputBuffer.setSample (0, sampleIndex, fl * masterGain);
-    outputBuffer.setSample (1, sampleIndex, fr * masterGain);
-    outputBuffer.setSample (2, sampleIndex, (fl + fr) * 0.70710678f * masterGain);
-    outputBuffer.setSample (3, sampleIndex, bed * 0.33f * masterGain);
-    outputBuffer.setSample (4, sampleIndex, bed * 0.33f * masterGain);
-    outputBuffer.setSample (5, sampleIndex, rl * masterGain);
-    outputBuffer.setSample (6, sampleIndex, rr * masterGain);
-    outputBuffer.setSample (7, sampleIndex, lrs * masterGain);
-    outputBuffer.setSample (8, sampleIndex, rrs * masterGain);
-    outputBuffer.setSample (9, sampleIndex, bed * 0.8f * masterGain);
+    const auto* fl = quad[0];
+    const auto* fr = quad[1];
+    const auto* rr = quad[2];
+    const auto* rl = quad[3];
+
+    writeGainedChannel (outputBuffer.getWritePointer (0), fl, gain, numSamples);
+    writeGainedChannel (outputBuffer.getWritePointer (1), fr, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (2), fl, 0.70710678f, fr, 0.70710678f, gain, numSamples);
+    writeGainedBed (outputBuffer.getWritePointer (3), quad, 0.33f, gain, numSamples);
+    juce::FloatVectorOperations::copy (outputBuffer.getWritePointer (4), outputBuffer.getReadPointer (3), numSamples);
+    writeGainedChannel (outputBuffer.getWritePointer (5), rl, gain, numSamples);
+    writeGainedChannel (outputBuffer.getWritePointer (6), rr, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (7), rl, 0.72f, fl, 0.28f, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (8), rr, 0.72f, fr, 0.28f, gain, numSamples);
+    writeGainedBed (outputBuffer.getWritePointer (9), quad, 0.8f, gain, numSamples);
+    clearChannelsFrom (outputBuffer, 10, numSamples);
 }
 
-inline void writeSurround742Sample (juce::AudioBuffer<float>& outputBuffer,
-                                    int sampleIndex,
-                                    float masterGain,
-                                    float fl,
-                                    float fr,
-                                    float rr,
-                                    float rl) noexcept
+inline void writeSurround742Block (juce::AudioBuffer<float>& outputBuffer,
+                                   const float* const* quad,
+                                   const float* gain,
+                                   int numSamples) noexcept
 {
-    const float bed = (fl + fr + rr + rl) * 0.25f;
-    const float lrs = (0.72f * rl) + (0.28f * fl);
-    const float rrs = (0.72f * rr) + (0.28f * fr);
-    const float topFl = (0.70f * fl) + (0.25f * rl);
-    const float topFr = (0.70f * fr) + (0.25f * rr);
-    const float topRl = (0.78f * rl) + (0.12f * fl);
-    const float topRr = (0.78f * rr) + (0.12f * fr);
-
-    outputBuffer.setSample (0, sampleIndex, fl * masterGain);
-    outputBuffer.setSample (1, sampleIndex, fr * masterGain);
-    outputBuffer.setSample (2, sampleIndex, (fl + fr) * 0.70710678f * masterGain);
-    outputBuffer.setSample (3, sampleIndex, bed * 0.30f * masterGain);
-    outputBuffer.setSample (4, sampleIndex, bed * 0.30f * masterGain);
-    outputBuffer.setSample (5, sampleIndex, rl * masterGain);
-    outputBuffer.setSample (6, sampleIndex, rr * masterGain);
-    outputBuffer.setSample (7, sampleIndex, lrs * masterGain);
-    outputBuffer.setSample (8, sampleIndex, rrs * masterGain);
-    outputBuffer.setSample (9, sampleIndex, topFl * masterGain);
-    outputBuffer.setSample (10, sampleIndex, topFr * masterGain);
-    outputBuffer.setSample (11, sampleIndex, topRl * masterGain);
-    outputBuffer.setSample (12, sampleIndex, topRr * masterGain);
+    const auto* fl = quad[0];
+    const auto* fr = quad[1];
+    const auto* rr = quad[2];
+    const auto* rl = quad[3];
+
+    writeGainedChannel (outputBuffer.getWritePointer (0), fl, gain, numSamples);
+    writeGainedChannel (outputBuffer.getWritePointer (1), fr, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (2), fl, 0.70710678f, fr, 0.70710678f, gain, numSamples);
+    writeGainedBed (outputBuffer.getWritePointer (3), quad, 0.30f, gain, numSamples);
+    juce::FloatVectorOperations::copy (outputBuffer.getWritePointer (4), outputBuffer.getReadPointer (3), numSamples);
+    writeGainedChannel (outputBuffer.getWritePointer (5), rl, gain, numSamples);
+    writeGainedChannel (outputBuffer.getWritePointer (6), rr, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (7), rl, 0.72f, fl, 0.28f, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (8), rr, 0.72f, fr, 0.28f, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (9), fl, 0.70f, rl, 0.25f, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (10), fr, 0.70f, rr, 0.25f, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (11), rl, 0.78f, fl, 0.12f, gain, numSamples);
+    writeGainedPair (outputBuffer.getWritePointer (12), rr, 0.78f, fr, 0.12f, gain, numSamples);
+    clearChannelsFrom (outputBuffer, 13, numSamples);
 }
 
 } // namespace locusq::spatial_profile_router
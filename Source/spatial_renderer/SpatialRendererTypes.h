@@ -12,7 +12,9 @@ inline constexpr int kMaxAuditionReactiveSources = 8;
 enum class HeadphoneRenderMode : int
 {
     StereoDownmix = 0,
-    SteamBinaural = 1
+    SteamBinaural = 1,
+    NativeHrtfBinaural = 2, // active-only: SteamBinaural request served by the in-tree HRTF renderer
+    AmbisonicBinaural = 3   // active-only: ambisonic monitoring decoded with SH-domain HRTFs
 };
 
 enum class SpatialOutputProfile : int
@@ -1781,12 +1781,14 @@ function applyUiStateToControls() {
     updateMotionStatusChips();
 }
 
-function createKeyframe(timeSeconds, value, curve = "easeInOut") {
+function createKeyframe(timeSeconds, value, curve = "easeInOut", handles = null) {
     return {
         uid: `kf_${nextKeyframeUid++}`,
         timeSeconds,
         value,
         curve,
+        outHandle: Number(handles?.outHandle ?? 0.0) || 0.0,
+        inHandle: Number(handles?.inHandle ?? 0.0) || 0.0,
     };
 }
 
@@ -2305,7 +2307,7 @@ function normaliseTimelineFromNative(payload) {
                     const timeSeconds = clamp(Number(kf?.timeSeconds ?? 0.0), 0.0, state.durationSeconds);
                     const value = Number(kf?.value ?? 0.0);
                     const curve = curveOrder.includes(kf?.curve) ? kf.curve : "linear";
-                    keyframes.push(createKeyframe(timeSeconds, value, curve));
+                    keyframes.push(createKeyframe(timeSeconds, value, curve, kf));
                 });
             }
 
@@ -2343,6 +2345,8 @@ function serialiseTimelineForNative() {
             timeSeconds: clamp(Number(kf.timeSeconds), 0.0, timelineState.durationSeconds),
             value: Number(kf.value),
             curve: curveOrder.includes(kf.curve) ? kf.curve : "linear",
+            outHandle: Number(kf.outHandle) || 0.0,
+            inHandle: Number(kf.inHandle) || 0.0,
         })),
     }));
 
@@ -3227,13 +3231,15 @@ const laneRanges = {
     size: { min: 0.01, max: 20.0 },
 };
 
-const curveOrder = ["linear", "easeIn", "easeOut", "easeInOut", "step"];
+const curveOrder = ["linear", "easeIn", "easeOut", "easeInOut", "step", "catmullRom", "bezier"];
 const curveShortLabels = {
     linear: "lin",
     easeIn: "in",
     easeOut: "out",
     easeInOut: "ease",
     step: "step",
+    catmullRom: "spl",
+    bezier: "bez",
 };
 
 let nextKeyframeUid = 1;
@@ -11299,11 +11305,15 @@ function collectCalibrationOptions() {
     const allowLimitedMapping = !!document.getElementById("cal-ack-limited-check")?.checked;
     const routingOneBased = getCalibrationRoutingFromControls();
 
+    const testType = getSelectedIndex("cal-type", 0);
+
     return {
-        testType: getSelectedIndex("cal-type", 0),
+        testType,
         testLevelDb: Number.isFinite(parsedLevel) ? parsedLevel : -20.0,
         sweepSeconds: 3.0,
         tailSeconds: 1.5,
+        // Sweeps measure all speakers in one interleaved pass; noise/impulse stay sequential.
+        measurementMode: testType === 0 ? "simultaneous" : "sequential",
         micChannel: getSelectedIndex("cal-mic", 0),
         topologyProfileIndex,
         topologyProfile: getCalibrationTopologyId(topologyProfileIndex),
@@ -12076,7 +12086,7 @@ function updateEmitterMeshes(emitters) {
 
         const collisionRing = mesh.userData.collisionRing;
         if (collisionRing && collisionRing.material) {
-            const collisionDetected = (target.collisionMask & 0x7) !== 0;
+            const collisionDetected = (target.collisionMask & 0xF) !== 0;
             const collisionEnergyNorm = clamp((target.collisionEnergy || 0.0) * 0.35, 0.0, 1.0);
             const collisionPulse = collisionDetected
                 ? Math.max(0.35 + collisionEnergyNorm, Number(mesh.userData.collisionPulse) || 0.0)
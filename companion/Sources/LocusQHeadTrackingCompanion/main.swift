@@ -743,6 +743,8 @@ private final class PluginAckReceiver: @unchecked Sendable {
     private static let packetSize: Int = 48
     private static let staleWindowMs: UInt64 = 2_000
     private static let flagPoseStale: UInt32 = 1 << 1
+    private static let listenerIdShift: UInt32 = 8
+    private static let listenerIdMask: UInt32 = 0xFF
 
     init(listenPort: UInt16 = 19766, workerQoS: QualityOfService = .utility) {
         self.listenPort = listenPort
@@ -944,6 +946,11 @@ private final class PluginAckReceiver: @unchecked Sendable {
                 continue
             }
 
+            // The plugin acks every listener stream; this sender is listener 0.
+            if (entry.flags >> Self.listenerIdShift) & Self.listenerIdMask != 0 {
+                continue
+            }
+
             lock.lock()
             entries[entry.sourceToken] = entry
             packetCount += 1
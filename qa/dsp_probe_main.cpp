@@ -0,0 +1,811 @@
+// LocusQ DSP Behaviour Probe
+//
+// Deterministic checks for renderer, calibration and head-tracking paths whose
+// correctness is defined against a reference implementation rather than an
+// audio-domain QA metric.
+
+#include "Source/HeadPoseInterpolator.h"
+#include "Source/IRCapture.h"
+#include "Source/TestSignalGenerator.h"
+#include "Source/headphone_dsp/HeadphoneFirHook.h"
+#include "Source/headphone_dsp/HeadphonePeqHook.h"
+#include "Source/spatial_renderer/ObjectExportStage.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct CheckResult
+{
+    std::string id;
+    bool passed = false;
+    std::string detail;
+};
+
+// Deterministic white noise in [-1, 1) so runs are reproducible.
+std::vector<float> makeNoise (int numSamples, uint32_t seed)
+{
+    std::vector<float> noise (static_cast<size_t> (numSamples));
+    for (auto& sample : noise)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        sample = static_cast<float> (seed >> 8) / static_cast<float> (1u << 23) - 1.0f;
+    }
+    return noise;
+}
+
+// y[n] = sum_k h[k] x[n - delay - k], with x = 0 before the first sample.
+double directConvolutionSample (const std::vector<float>& x, const std::vector<float>& h, int n, int delay)
+{
+    double sum = 0.0;
+    for (int k = 0; k < static_cast<int> (h.size()); ++k)
+    {
+        const int index = n - delay - k;
+        if (index >= 0 && index < static_cast<int> (x.size()))
+            sum += static_cast<double> (h[static_cast<size_t> (k)]) * x[static_cast<size_t> (index)];
+    }
+    return sum;
+}
+
+CheckResult checkPartitionedFirMatchesDirectConvolution()
+{
+    using locusq::headphone_dsp::HeadphoneFirHook;
+
+    constexpr int blockSize = 128;
+    constexpr int numBlocks = 48;
+    constexpr int longTaps = 1500; // partitioned engine
+    constexpr int shortTaps = 200; // direct engine
+
+    std::vector<float> longIr (static_cast<size_t> (longTaps));
+    for (int i = 0; i < longTaps; ++i)
+        longIr[static_cast<size_t> (i)] = std::sin (0.07f * static_cast<float> (i)) * std::exp (-0.003f * static_cast<float> (i));
+    auto shortIr = makeNoise (shortTaps, 7u);
+    for (auto& tap : shortIr)
+        tap *= 0.1f;
+
+    HeadphoneFirHook hook;
+    hook.prepare (blockSize, HeadphoneFirHook::kMaxTaps);
+    hook.setBypassed (false);
+
+    // Drives one IR for numBlocks blocks (odd sizes exercise the FIFO) and
+    // returns the worst error against direct convolution of everything fed
+    // so far, from the end of the engine/IR swap crossfade onwards.
+    std::vector<float> fed;
+    const auto runAgainstReference = [&] (const std::vector<float>& ir, uint32_t seed, int& latency)
+    {
+        while (! hook.loadImpulseResponse (ir.data(), static_cast<int> (ir.size())))
+            hook.pickUpPendingImpulseResponse();
+
+        const auto input = makeNoise (blockSize * numBlocks, seed);
+        const int offset = static_cast<int> (fed.size());
+        fed.insert (fed.end(), input.begin(), input.end());
+
+        std::vector<float> left (input), right (input);
+        int done = 0;
+        for (int block = 0; done < static_cast<int> (input.size()); ++block)
+        {
+            hook.pickUpPendingImpulseResponse();
+            const int count = std::min (block % 3 == 0 ? blockSize - 29 : blockSize, static_cast<int> (input.size()) - done);
+            hook.processBlock (left.data() + done, right.data() + done, count);
+            done += count;
+        }
+
+        latency = hook.getLatencySamples();
+        double maxError = 0.0;
+        for (int n = HeadphoneFirHook::kSwapCrossfadeSamples; n < static_cast<int> (input.size()); ++n)
+        {
+            const auto reference = directConvolutionSample (fed, ir, offset + n, latency);
+            maxError = std::max ({ maxError,
+                                   std::abs (reference - left[static_cast<size_t> (n)]),
+                                   std::abs (reference - right[static_cast<size_t> (n)]) });
+        }
+        return maxError;
+    };
+
+    // Partitioned -> direct -> partitioned: the partitioned engine is fed while
+    // the direct one runs, so right after each switch's crossfade it must
+    // already produce the full tail instead of a silent first partition.
+    int latencyA = 0, latencyB = 0, latencyC = 0;
+    const double errorPartitioned = runAgainstReference (longIr, 11u, latencyA);
+    const double errorDirect = runAgainstReference (shortIr, 12u, latencyB);
+    const double errorRestarted = runAgainstReference (longIr, 13u, latencyC);
+
+    const bool partitionedLatency = latencyA == blockSize && latencyC == blockSize && latencyB == 0;
+    const bool matches = errorPartitioned < 1.0e-4 && errorDirect < 1.0e-4 && errorRestarted < 1.0e-4;
+
+    CheckResult result;
+    result.id = "partitioned_fir_matches_direct_convolution";
+    result.passed = partitionedLatency && matches;
+    result.detail = "max_err_partitioned=" + std::to_string (errorPartitioned)
+                  + ", max_err_direct=" + std::to_string (errorDirect)
+                  + ", max_err_after_engine_switch=" + std::to_string (errorRestarted)
+                  + ", latency=" + std::to_string (latencyA) + "/" + std::to_string (latencyB)
+                  + "/" + std::to_string (latencyC);
+    return result;
+}
+
+// Set k has every stage at b0 = 1 + k * step and a preamp that cancels the
+// cascade gain, so any complete set passes DC at exactly unity while a set
+// mixed from two publishes does not.
+locusq::headphone_dsp::HeadphonePeqHook::CoefficientSet makeUnityDcSet (int k)
+{
+    using locusq::headphone_dsp::HeadphonePeqHook;
+
+    HeadphonePeqHook::CoefficientSet set;
+    const float stageGain = 1.0f + 0.002f * static_cast<float> (k);
+    for (auto& stage : set.stages)
+    {
+        stage = HeadphonePeqHook::Coefficients {};
+        stage.b0 = stageGain;
+        stage.active = true;
+    }
+    set.preampLinear = 1.0f / std::pow (stageGain, static_cast<float> (HeadphonePeqHook::kMaxStages));
+    return set;
+}
+
+CheckResult checkPeqCoefficientPublishing()
+{
+    using locusq::headphone_dsp::HeadphonePeqHook;
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 256;
+
+    // 1) A published peaking band is adopted at the block boundary and the
+    //    steady-state gain at its centre matches |H(e^jw)| of the set.
+    HeadphonePeqHook hook;
+    hook.prepare (sampleRate);
+    hook.setBypassed (false);
+
+    HeadphonePeqHook::CoefficientSet peak;
+    peak.stages[0] = HeadphonePeqHook::makePeakEQ (1000.0f, 6.0f, 1.0f, static_cast<float> (sampleRate));
+    hook.publishCoefficientSet (peak);
+    const bool adopted = hook.pickUpPendingCoefficients();
+    const bool nothingPending = ! hook.pickUpPendingCoefficients();
+
+    std::vector<float> left (blockSize), right (blockSize);
+    float peakAmplitude = 0.0f;
+    for (int block = 0; block < 40; ++block)
+    {
+        for (int i = 0; i < blockSize; ++i)
+        {
+            const auto n = static_cast<double> (block * blockSize + i);
+            left[static_cast<size_t> (i)] = static_cast<float> (0.25 * std::sin (2.0 * 3.14159265358979323846 * 1000.0 * n / sampleRate));
+            right[static_cast<size_t> (i)] = left[static_cast<size_t> (i)];
+        }
+        hook.processBlock (left.data(), right.data(), blockSize);
+        if (block >= 20)
+            for (const auto sample : left)
+                peakAmplitude = std::max (peakAmplitude, std::abs (sample));
+    }
+    const auto& c = peak.stages[0];
+    const double w = 2.0 * 3.14159265358979323846 * 1000.0 / sampleRate;
+    const std::complex<double> z1 = std::polar (1.0, -w);
+    const std::complex<double> z2 = z1 * z1;
+    const double expectedGain = std::abs ((static_cast<double> (c.b0) + static_cast<double> (c.b1) * z1 + static_cast<double> (c.b2) * z2)
+                                          / (1.0 + static_cast<double> (c.a1) * z1 + static_cast<double> (c.a2) * z2));
+    const double gainDb = 20.0 * std::log10 (peakAmplitude / 0.25);
+    const double expectedGainDb = 20.0 * std::log10 (expectedGain);
+    const bool designedGain = expectedGainDb > 1.0 && std::abs (gainDb - expectedGainDb) < 0.05;
+
+    // 2) Of two publishes before a pickup, the newest wins.
+    hook.publishCoefficientSet (makeUnityDcSet (10));
+    hook.publishCoefficientSet (makeUnityDcSet (20));
+    hook.pickUpPendingCoefficients();
+    std::fill (left.begin(), left.end(), 1.0f);
+    std::fill (right.begin(), right.end(), 1.0f);
+    hook.processBlock (left.data(), right.data(), blockSize);
+    const bool newestWins = std::abs (left.back() - 1.0f) < 1.0e-4f && ! hook.pickUpPendingCoefficients();
+
+    // 3) Two producers (message-thread style and audio-thread try-publish)
+    //    race while the reader adopts sets; every adopted set must be whole.
+    HeadphonePeqHook raced;
+    raced.prepare (sampleRate);
+    raced.setBypassed (false);
+
+    std::atomic<bool> stop { false };
+    std::atomic<int> tryPublishRefused { 0 };
+    std::thread blockingProducer ([&]
+    {
+        for (int k = 0; ! stop.load (std::memory_order_relaxed); k = (k + 1) % 200)
+        {
+            raced.publishCoefficientSet (makeUnityDcSet (k));
+            std::this_thread::yield();
+        }
+    });
+    std::thread tryProducer ([&]
+    {
+        for (int k = 0; ! stop.load (std::memory_order_relaxed); k = (k + 1) % 200)
+        {
+            if (! raced.tryPublishCoefficientSet (makeUnityDcSet (200 + k)))
+                tryPublishRefused.fetch_add (1, std::memory_order_relaxed);
+            std::this_thread::yield();
+        }
+    });
+
+    int adoptions = 0;
+    float worstDcError = 0.0f;
+    for (int block = 0; block < 1000000 && adoptions < 500; ++block)
+    {
+        if (raced.pickUpPendingCoefficients())
+            ++adoptions;
+
+        std::fill (left.begin(), left.end(), 1.0f);
+        std::fill (right.begin(), right.end(), 1.0f);
+        raced.processBlock (left.data(), right.data(), blockSize);
+        if (block > 0)
+            worstDcError = std::max (worstDcError, std::abs (left.back() - 1.0f));
+    }
+    stop.store (true, std::memory_order_relaxed);
+    blockingProducer.join();
+    tryProducer.join();
+
+    const bool untorn = adoptions >= 500 && worstDcError < 1.0e-4f;
+
+    // 4) The paired lanes stay independent, and one NaN silences its block
+    //    and resets the state: the next block matches a fresh hook exactly.
+    HeadphonePeqHook poisoned, fresh;
+    for (auto* h : { &poisoned, &fresh })
+    {
+        h->prepare (sampleRate);
+        h->setBypassed (false);
+        h->publishCoefficientSet (peak);
+        h->pickUpPendingCoefficients();
+    }
+
+    const auto noiseLeft = makeNoise (blockSize, 21u);
+    const auto noiseRight = makeNoise (blockSize, 22u);
+    std::vector<float> poisonedLeft (noiseLeft), poisonedRight (noiseRight);
+    poisonedRight[static_cast<size_t> (blockSize / 2)] = std::numeric_limits<float>::quiet_NaN();
+    poisoned.processBlock (poisonedLeft.data(), poisonedRight.data(), blockSize);
+    const bool silenced = std::all_of (poisonedLeft.begin(), poisonedLeft.end(), [] (float x) { return x == 0.0f; })
+                          && std::all_of (poisonedRight.begin(), poisonedRight.end(), [] (float x) { return x == 0.0f; });
+
+    // A silent block lets the fresh hook finish its pickup crossfade with zero state.
+    std::vector<float> silentLeft (blockSize, 0.0f), silentRight (blockSize, 0.0f);
+    fresh.processBlock (silentLeft.data(), silentRight.data(), blockSize);
+
+    std::vector<float> recoveredLeft (noiseLeft), recoveredRight (noiseRight);
+    std::vector<float> freshLeft (noiseLeft), freshRight (noiseRight);
+    poisoned.processBlock (recoveredLeft.data(), recoveredRight.data(), blockSize);
+    fresh.processBlock (freshLeft.data(), freshRight.data(), blockSize);
+
+    // Right lane alone through a third hook: lanes must not leak.
+    HeadphonePeqHook mono;
+    mono.prepare (sampleRate);
+    mono.setBypassed (false);
+    mono.publishCoefficientSet (peak);
+    mono.pickUpPendingCoefficients();
+    mono.processBlock (silentLeft.data(), silentRight.data(), blockSize);
+    std::vector<float> monoLeft (noiseRight), monoRight (noiseRight);
+    mono.processBlock (monoLeft.data(), monoRight.data(), blockSize);
+
+    const bool recovered = recoveredLeft == freshLeft && recoveredRight == freshRight;
+    const bool lanesIndependent = freshRight == monoRight && freshLeft != freshRight;
+
+    CheckResult result;
+    result.id = "peq_coefficient_publish_adopts_whole_sets";
+    result.passed = adopted && nothingPending && designedGain && newestWins && untorn
+                    && silenced && recovered && lanesIndependent;
+    result.detail = "peak_gain_db=" + std::to_string (gainDb)
+                  + ", expected_gain_db=" + std::to_string (expectedGainDb)
+                  + ", newest_wins=" + (newestWins ? std::string ("true") : std::string ("false"))
+                  + ", raced_adoptions=" + std::to_string (adoptions)
+                  + ", try_publish_refused=" + std::to_string (tryPublishRefused.load())
+                  + ", worst_dc_error=" + std::to_string (worstDcError)
+                  + ", nan_block_silenced=" + (silenced ? std::string ("true") : std::string ("false"))
+                  + ", recovered_like_fresh=" + (recovered ? std::string ("true") : std::string ("false"))
+                  + ", lanes_independent=" + (lanesIndependent ? std::string ("true") : std::string ("false"));
+    return result;
+}
+std::uint64_t readLittleEndian (const std::vector<std::uint8_t>& bytes, size_t offset, int numBytes)
+{
+    std::uint64_t value = 0;
+    for (int i = numBytes - 1; i >= 0; --i)
+        value = (value << 8) | bytes[offset + static_cast<size_t> (i)];
+    return value;
+}
+
+std::string readFourCc (const std::vector<std::uint8_t>& bytes, size_t offset)
+{
+    return std::string (reinterpret_cast<const char*> (bytes.data() + offset), 4);
+}
+
+std::string readFixedString (const std::vector<std::uint8_t>& bytes, size_t offset, size_t length)
+{
+    std::string text (reinterpret_cast<const char*> (bytes.data() + offset), length);
+    return text.substr (0, text.find ('\0'));
+}
+
+int countOccurrences (const std::string& text, const std::string& needle)
+{
+    int count = 0;
+    for (auto at = text.find (needle); at != std::string::npos; at = text.find (needle, at + needle.size()))
+        ++count;
+    return count;
+}
+
+struct ParsedBw64
+{
+    bool valid = false;
+    std::string container;
+    std::uint64_t riffSize = 0;
+    std::uint64_t dataSize = 0;
+    std::uint64_t ds64SampleCount = 0;
+    bool hasDs64 = false;
+    int formatTag = 0;
+    int channels = 0;
+    int sampleRate = 0;
+    int bitsPerSample = 0;
+    size_t dataOffset = 0;
+    std::vector<std::string> chunkOrder;
+    std::map<std::string, std::pair<size_t, std::uint64_t>> chunks; // id -> (body offset, size)
+};
+
+// Walks the RIFF/BW64 chunk list the way a BS.2088 reader does: a 0xffffffff
+// size field defers to the ds64 chunk, and odd-sized chunks are padded.
+ParsedBw64 parseBw64 (const std::vector<std::uint8_t>& bytes)
+{
+    ParsedBw64 parsed;
+    if (bytes.size() < 12 || readFourCc (bytes, 8) != "WAVE")
+        return parsed;
+
+    parsed.container = readFourCc (bytes, 0);
+    parsed.riffSize = readLittleEndian (bytes, 4, 4);
+
+    for (size_t offset = 12; offset + 8 <= bytes.size();)
+    {
+        const auto id = readFourCc (bytes, offset);
+        std::uint64_t size = readLittleEndian (bytes, offset + 4, 4);
+        const auto body = offset + 8;
+
+        if (id == "ds64" && size >= 28 && body + 28 <= bytes.size())
+        {
+            parsed.hasDs64 = true;
+            parsed.riffSize = readLittleEndian (bytes, body, 8);
+            parsed.dataSize = readLittleEndian (bytes, body + 8, 8);
+            parsed.ds64SampleCount = readLittleEndian (bytes, body + 16, 8);
+        }
+        else if (id == "data")
+        {
+            if (size == 0xffffffffull && parsed.hasDs64)
+                size = parsed.dataSize;
+            parsed.dataSize = size;
+            parsed.dataOffset = body;
+        }
+        else if (id == "fmt " && body + 16 <= bytes.size())
+        {
+            parsed.formatTag = static_cast<int> (readLittleEndian (bytes, body, 2));
+            parsed.channels = static_cast<int> (readLittleEndian (bytes, body + 2, 2));
+            parsed.sampleRate = static_cast<int> (readLittleEndian (bytes, body + 4, 4));
+            parsed.bitsPerSample = static_cast<int> (readLittleEndian (bytes, body + 14, 2));
+        }
+
+        if (body + size > bytes.size())
+            return parsed;
+
+        parsed.chunkOrder.push_back (id);
+        parsed.chunks[id] = { body, size };
+        offset = static_cast<size_t> (body + size + (size & 1u));
+    }
+
+    parsed.valid = parsed.riffSize + 8u == bytes.size();
+    return parsed;
+}
+
+CheckResult checkBw64ObjectExportRoundTrip()
+{
+    namespace ox = locusq::object_export;
+
+    constexpr double sampleRate = 48000.0;
+    constexpr int numBlocks = 6;
+    constexpr int droppedBlock = 3; // never appended; the writer pads it
+    const std::array<int, 2> trackIndices { 0, 3 };
+
+    const auto makeBlock = [&] (int blockIndex)
+    {
+        auto block = std::make_unique<ox::CaptureBlock>();
+        block->startSample = static_cast<std::uint64_t> (blockIndex * ox::kFramesPerBlock);
+        block->numFrames = ox::kFramesPerBlock;
+        for (size_t t = 0; t < trackIndices.size(); ++t)
+        {
+            const auto track = static_cast<size_t> (trackIndices[t]);
+            auto& meta = block->objects[track];
+            meta.active = true;
+            meta.x = t == 0 ? static_cast<float> (blockIndex) * 0.5f : 0.0f; // object 1 moves, object 4 stays
+            meta.z = 2.0f;
+            meta.gainLinear = 1.0f;
+            std::snprintf (meta.label, sizeof (meta.label), "%s", t == 0 ? "Lead & Vox" : "Pad");
+            for (int frame = 0; frame < ox::kFramesPerBlock; ++frame)
+                block->audio[track][static_cast<size_t> (frame)] =
+                    static_cast<float> ((track + 1) * 100000 + static_cast<size_t> (blockIndex * ox::kFramesPerBlock + frame)) * 1.0e-6f;
+        }
+        return block;
+    };
+
+    // Writes the same capture with the given size limit and reads it back.
+    const auto writeAndRead = [&] (std::uint64_t sizeLimit, std::vector<std::uint8_t>& bytes)
+    {
+        const auto target = juce::File::getSpecialLocation (juce::File::tempDirectory)
+                                .getNonexistentChildFile ("locusq_dsp_probe_bw64", ".wav", false);
+        ox::Bw64ObjectWriter writer (sizeLimit);
+        bool ok = writer.open (target, sampleRate, 10.0f);
+        for (int blockIndex = 0; ok && blockIndex < numBlocks; ++blockIndex)
+            if (blockIndex != droppedBlock)
+                writer.append (*makeBlock (blockIndex));
+        ok = ok && writer.finalise();
+
+        std::ifstream in (target.getFullPathName().toStdString(), std::ios::binary);
+        bytes.assign (std::istreambuf_iterator<char> (in), std::istreambuf_iterator<char>());
+        in.close();
+        target.deleteFile();
+        return ok;
+    };
+
+    std::vector<std::uint8_t> riffBytes, bw64Bytes;
+    const bool riffWritten = writeAndRead (ox::Bw64ObjectWriter::kRiffSizeLimit, riffBytes);
+    const bool bw64Written = writeAndRead (1024u, bw64Bytes);
+    const auto riff = parseBw64 (riffBytes);
+    const auto bw64 = parseBw64 (bw64Bytes);
+
+    const auto totalFrames = static_cast<std::uint64_t> (numBlocks * ox::kFramesPerBlock);
+    const auto expectedDataSize = totalFrames * static_cast<std::uint64_t> (ox::kMaxObjects) * 4u;
+
+    // 1) Container: RIFF keeps the reserved JUNK chunk, BW64 turns it into ds64.
+    const std::vector<std::string> riffOrder { "JUNK", "fmt ", "data", "chna", "axml" };
+    const std::vector<std::string> bw64Order { "ds64", "fmt ", "data", "chna", "axml" };
+    const bool containers = riffWritten && bw64Written && riff.valid && bw64.valid
+                            && riff.container == "RIFF" && riff.chunkOrder == riffOrder && ! riff.hasDs64
+                            && bw64.container == "BW64" && bw64.chunkOrder == bw64Order
+                            && readLittleEndian (bw64Bytes, 4, 4) == 0xffffffffull
+                            && bw64.ds64SampleCount == totalFrames
+                            && riff.dataSize == expectedDataSize && bw64.dataSize == expectedDataSize
+                            && riff.formatTag == 3 && riff.channels == ox::kMaxObjects
+                            && riff.sampleRate == 48000 && riff.bitsPerSample == 32
+                            && std::equal (riffBytes.begin() + static_cast<std::ptrdiff_t> (riff.dataOffset),
+                                           riffBytes.begin() + static_cast<std::ptrdiff_t> (riff.dataOffset + expectedDataSize),
+                                           bw64Bytes.begin() + static_cast<std::ptrdiff_t> (bw64.dataOffset));
+
+    // 2) Interleaved PCM: each used track carries its samples, the dropped
+    //    block and unused tracks are silent.
+    bool samplesMatch = containers;
+    for (std::uint64_t frame = 0; samplesMatch && frame < totalFrames; ++frame)
+    {
+        const auto blockIndex = static_cast<int> (frame / static_cast<std::uint64_t> (ox::kFramesPerBlock));
+        for (int track = 0; track < ox::kMaxObjects; ++track)
+        {
+            float sample = 0.0f;
+            std::memcpy (&sample, riffBytes.data() + riff.dataOffset + (frame * ox::kMaxObjects + static_cast<std::uint64_t> (track)) * 4u, 4);
+            const bool used = track == trackIndices[0] || track == trackIndices[1];
+            const float expected = used && blockIndex != droppedBlock
+                                       ? static_cast<float> (static_cast<std::uint64_t> (track + 1) * 100000u + frame) * 1.0e-6f
+                                       : 0.0f;
+            samplesMatch = samplesMatch && sample == expected;
+        }
+    }
+
+    // 3) chna: one 40-byte entry per used track, referencing the axml IDs.
+    bool chnaMatches = containers && riff.chunks.count ("chna") != 0;
+    std::string chnaSummary;
+    if (chnaMatches)
+    {
+        const auto [body, size] = riff.chunks.at ("chna");
+        chnaMatches = size == 4u + 40u * trackIndices.size()
+                      && readLittleEndian (riffBytes, body, 2) == static_cast<std::uint64_t> (ox::kMaxObjects)
+                      && readLittleEndian (riffBytes, body + 2, 2) == trackIndices.size();
+        for (size_t entry = 0; chnaMatches && entry < trackIndices.size(); ++entry)
+        {
+            const auto at = body + 4 + 40 * entry;
+            const auto trackNumber = readLittleEndian (riffBytes, at, 2);
+            const auto uid = readFixedString (riffBytes, at + 2, 12);
+            const auto trackRef = readFixedString (riffBytes, at + 14, 14);
+            const auto packRef = readFixedString (riffBytes, at + 28, 11);
+            chnaSummary += (entry > 0 ? ";" : "") + std::to_string (trackNumber) + ":" + uid + ":" + trackRef + ":" + packRef;
+        }
+        chnaMatches = chnaMatches
+                      && chnaSummary == "1:ATU_00000001:AT_00031001_01:AP_00031001;4:ATU_00000004:AT_00031004_01:AP_00031004";
+    }
+
+    // 4) axml: well-formed BS.2076 document whose IDs match chna, escaped
+    //    names, and block formats that follow the moving object only.
+    bool axmlMatches = containers && riff.chunks.count ("axml") != 0;
+    int movingBlocks = 0, staticBlocks = 0;
+    if (axmlMatches)
+    {
+        const auto [body, size] = riff.chunks.at ("axml");
+        const std::string xml (reinterpret_cast<const char*> (riffBytes.data() + body), static_cast<size_t> (size));
+        const auto channelSection = [&xml] (const std::string& channelId)
+        {
+            const auto begin = xml.find ("<audioChannelFormat audioChannelFormatID=\"" + channelId + "\"");
+            const auto end = xml.find ("</audioChannelFormat>", begin);
+            return begin == std::string::npos || end == std::string::npos ? std::string() : xml.substr (begin, end - begin);
+        };
+        movingBlocks = countOccurrences (channelSection ("AC_00031001"), "<audioBlockFormat ");
+        staticBlocks = countOccurrences (channelSection ("AC_00031004"), "<audioBlockFormat ");
+
+        axmlMatches = xml.rfind ("<?xml", 0) == 0
+                      && xml.size() >= 15 && xml.compare (xml.size() - 15, 15, "</ebuCoreMain>\n") == 0
+                      && countOccurrences (xml, "<audioObject ") == 2
+                      && xml.find ("audioObjectName=\"Lead &amp; Vox\"") != std::string::npos
+                      && xml.find ("audioObjectName=\"Pad\"") != std::string::npos
+                      && xml.find ("<audioTrackUID UID=\"ATU_00000001\" sampleRate=\"48000\"") != std::string::npos
+                      && xml.find ("<audioTrackUID UID=\"ATU_00000004\" sampleRate=\"48000\"") != std::string::npos
+                      && xml.find ("audioTrackFormatID=\"AT_00031004_01\"") != std::string::npos
+                      && xml.find ("end=\"00:00:00.12800\"") != std::string::npos
+                      // Object 1 gets a block per appended move (the padded
+                      // gap extends the last one); object 4 never moves.
+                      && movingBlocks == numBlocks - 1 && staticBlocks == 1;
+    }
+
+    CheckResult result;
+    result.id = "bw64_object_export_round_trip";
+    result.passed = containers && samplesMatch && chnaMatches && axmlMatches;
+    result.detail = "riff_chunks=" + std::to_string (riff.chunkOrder.size())
+                  + ", bw64_ds64=" + (bw64.hasDs64 ? std::string ("true") : std::string ("false"))
+                  + ", data_bytes=" + std::to_string (riff.dataSize)
+                  + ", samples_match=" + (samplesMatch ? std::string ("true") : std::string ("false"))
+                  + ", chna=" + (chnaSummary.empty() ? std::string ("none") : chnaSummary)
+                  + ", block_formats=" + std::to_string (movingBlocks) + "/" + std::to_string (staticBlocks);
+    return result;
+}
+
+// Streaming overlap-save deconvolution, fed while the recording is still
+// running, must match the one-shot definition of the IR: direct convolution
+// of the whole recording with the inverse filter, windowed and peak
+// normalised. Covers one sweep and two interleaved sweeps, each through a
+// synthetic room of three taps.
+CheckResult checkStreamingDeconvolutionMatchesOneShot()
+{
+    constexpr double sampleRate = 16000.0;
+    constexpr float sweepSeconds = 0.6f;
+    constexpr float tailSeconds = 0.5f;
+    constexpr int blockSize = 256;
+    constexpr int spacing = 6000;
+
+    TestSignalGenerator generator;
+    generator.prepare (sampleRate, TestSignalGenerator::Type::LogSweep, sweepSeconds, -6.0f);
+    const auto& inverse = generator.getInverseFilter();
+    const int sweepSamples = generator.getTotalSamples();
+    const int inverseLength = static_cast<int> (inverse.size());
+
+    struct Tap { int delay; float gain; };
+    const std::array<std::array<Tap, 3>, 2> rooms {{
+        {{ { 40, 1.0f }, { 310, 0.5f }, { 1250, -0.3f } }},
+        {{ { 90, 0.8f }, { 520, -0.4f }, { 2000, 0.2f } }}
+    }};
+
+    std::vector<float> sweep (static_cast<size_t> (sweepSamples), 0.0f);
+    generator.addSweepWindow (sweep.data(), sweepSamples, 0);
+
+    double worstStreamingError = 0.0;
+    double worstOneShotError = 0.0;
+    double worstStreamingVsOneShot = 0.0;
+    int blocksStreamedEarly = 0;
+    bool peaksAtDirectPath = true;
+    std::string windowSummary;
+
+    for (int numSweeps = 1; numSweeps <= 2; ++numSweeps)
+    {
+        const int playedSamples = sweepSamples + (numSweeps - 1) * spacing;
+        const int recordingLength = playedSamples + static_cast<int> (tailSeconds * sampleRate);
+        std::vector<float> recording (static_cast<size_t> (recordingLength), 0.0f);
+        for (int s = 0; s < numSweeps; ++s)
+            for (const auto& tap : rooms[static_cast<size_t> (s)])
+                for (int n = 0; n < sweepSamples; ++n)
+                {
+                    const int index = s * spacing + tap.delay + n;
+                    if (index < recordingLength)
+                        recording[static_cast<size_t> (index)] += tap.gain * sweep[static_cast<size_t> (n)];
+                }
+
+        // Streaming: deconvolve whatever is complete after every recorded block.
+        IRCapture streaming;
+        streaming.prepare (sampleRate, tailSeconds);
+        streaming.startRecording (playedSamples, tailSeconds);
+        streaming.prepareDeconvolution (inverse, numSweeps, spacing);
+        for (int done = 0; ! streaming.isComplete(); done += blockSize)
+        {
+            streaming.recordBlock (recording.data() + done, std::min (blockSize, recordingLength - done));
+            if (! streaming.isComplete())
+                blocksStreamedEarly += streaming.processRecordedBlocks (1);
+        }
+        streaming.finishDeconvolution();
+
+        // One-shot: the whole recording deconvolved after the fact.
+        IRCapture oneShot;
+        oneShot.prepare (sampleRate, tailSeconds);
+        oneShot.startRecording (playedSamples, tailSeconds);
+        oneShot.recordBlock (recording.data(), recordingLength);
+        if (numSweeps == 1)
+            oneShot.computeIR (inverse);
+        else
+            oneShot.computeInterleavedIRs (inverse, numSweeps, spacing);
+
+        if (streaming.getNumInterleavedIRs() != numSweeps || oneShot.getNumInterleavedIRs() != numSweeps)
+        {
+            peaksAtDirectPath = false;
+            continue;
+        }
+
+        for (int w = 0; w < numSweeps; ++w)
+        {
+            const auto& streamed = streaming.getInterleavedIR (w);
+            const auto& reference = oneShot.getInterleavedIR (w);
+            const int start = inverseLength - 1 + w * spacing;
+
+            std::vector<double> direct (streamed.size());
+            double peak = 0.0;
+            for (size_t n = 0; n < direct.size(); ++n)
+            {
+                direct[n] = directConvolutionSample (recording, inverse, start + static_cast<int> (n), 0);
+                peak = std::max (peak, std::abs (direct[n]));
+            }
+
+            size_t peakIndex = 0;
+            for (size_t n = 0; n < streamed.size(); ++n)
+            {
+                const double expected = peak > 0.0 ? direct[n] / peak : 0.0;
+                worstStreamingError = std::max (worstStreamingError, std::abs (expected - streamed[n]));
+                worstOneShotError = std::max (worstOneShotError, std::abs (expected - reference[n]));
+                worstStreamingVsOneShot = std::max (worstStreamingVsOneShot,
+                                                    static_cast<double> (std::abs (streamed[n] - reference[n])));
+                if (std::abs (streamed[n]) > std::abs (streamed[peakIndex]))
+                    peakIndex = n;
+            }
+
+            const auto directPath = rooms[static_cast<size_t> (w)][0].delay;
+            peaksAtDirectPath = peaksAtDirectPath && std::abs (static_cast<int> (peakIndex) - directPath) <= 1;
+            windowSummary += (windowSummary.empty() ? "" : "/") + std::to_string (peakIndex);
+        }
+    }
+
+    CheckResult result;
+    result.id = "streaming_deconvolution_matches_one_shot";
+    result.passed = worstStreamingError < 1.0e-4 && worstOneShotError < 1.0e-4
+                    && worstStreamingVsOneShot < 1.0e-6 && blocksStreamedEarly > 0 && peaksAtDirectPath;
+    result.detail = "max_err_streaming=" + std::to_string (worstStreamingError)
+                  + ", max_err_one_shot=" + std::to_string (worstOneShotError)
+                  + ", max_streaming_vs_one_shot=" + std::to_string (worstStreamingVsOneShot)
+                  + ", blocks_streamed_while_recording=" + std::to_string (blocksStreamedEarly)
+                  + ", ir_peaks=" + windowSummary;
+    return result;
+}
+
+// Predictive head pose: a head turning at a constant rate sends 100 Hz
+// packets (with gyro rates) that arrive with 20 ms base delay plus up to
+// 15 ms of jitter, and carry orientation and gyro noise. Queried once per
+// 256-sample block with 30 ms lookahead, the Kalman mode must land on the
+// sender-clock orientation at the output time and beat holding the newest
+// packet, which lags by the packet age plus the lookahead.
+CheckResult checkKalmanHeadPosePrediction()
+{
+    constexpr double yawRateRadPerSec = 2.0;
+    constexpr double packetPeriodMs = 10.0;
+    constexpr double baseDelayMs = 20.0;
+    constexpr double maxJitterMs = 15.0;
+    constexpr double lookaheadMs = 30.0;
+    constexpr double senderToLocalOffsetMs = 1000.0;
+    constexpr double blockMs = 256.0 * 1000.0 / 48000.0;
+    constexpr double warmupMs = 500.0;
+    constexpr double durationMs = 3500.0;
+
+    uint32_t seed = 99u;
+    const auto nextUniform = [&seed] // [-1, 1)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<double> (seed >> 8) / static_cast<double> (1u << 23) - 1.0;
+    };
+
+    struct Packet { HeadTrackingPoseSnapshot pose; double arrivalMs; };
+    std::vector<Packet> packets;
+    for (double senderMs = packetPeriodMs; senderMs < durationMs; senderMs += packetPeriodMs) // 0 means unstamped
+    {
+        const double yaw = yawRateRadPerSec * senderMs / 1000.0 + 0.01 * nextUniform();
+        Packet packet;
+        packet.pose.qz = static_cast<float> (std::sin (0.5 * yaw));
+        packet.pose.qw = static_cast<float> (std::cos (0.5 * yaw));
+        packet.pose.timestampMs = static_cast<std::uint64_t> (senderMs);
+        packet.pose.seq = static_cast<std::uint32_t> (packets.size() + 1);
+        packet.pose.angVz = static_cast<float> (yawRateRadPerSec + 0.05 * nextUniform());
+        packet.pose.sensorLocationFlags = 0x4u;
+        packet.arrivalMs = senderMs + senderToLocalOffsetMs + baseDelayMs + maxJitterMs * 0.5 * (nextUniform() + 1.0);
+        packets.push_back (packet);
+    }
+
+    const auto yawError = [] (const HeadTrackingPoseSnapshot& pose, double trueYaw)
+    {
+        const double dot = std::abs (pose.qz * std::sin (0.5 * trueYaw) + pose.qw * std::cos (0.5 * trueYaw));
+        return 2.0 * std::acos (std::min (1.0, dot));
+    };
+
+    HeadPoseInterpolator interpolator;
+    interpolator.setFilterMode (HeadPoseInterpolator::FilterMode::PredictiveKalman);
+    interpolator.setPredictionLookaheadMs (lookaheadMs);
+
+    // The bridge exposes the newest packet by sequence; reordered stragglers
+    // never replace it.
+    const HeadTrackingPoseSnapshot* newest = nullptr;
+    double sumSqKalman = 0.0, sumSqHold = 0.0, worstKalman = 0.0;
+    int queries = 0;
+    for (double localMs = senderToLocalOffsetMs; localMs < senderToLocalOffsetMs + durationMs; localMs += blockMs)
+    {
+        for (const auto& packet : packets)
+            if (packet.arrivalMs <= localMs && (newest == nullptr || packet.pose.seq > newest->seq))
+                newest = &packet.pose;
+
+        if (newest == nullptr)
+            continue;
+
+        interpolator.ingest (*newest, localMs);
+        const auto predicted = interpolator.interpolatedAt (localMs);
+
+        const double outputSenderMs = localMs + lookaheadMs - senderToLocalOffsetMs - baseDelayMs;
+        if (outputSenderMs - lookaheadMs < warmupMs)
+            continue;
+
+        const double trueYaw = yawRateRadPerSec * outputSenderMs / 1000.0;
+        const double kalmanError = yawError (predicted, trueYaw);
+        const double holdError = yawError (*newest, trueYaw);
+        sumSqKalman += kalmanError * kalmanError;
+        sumSqHold += holdError * holdError;
+        worstKalman = std::max (worstKalman, kalmanError);
+        ++queries;
+    }
+
+    constexpr double radToDeg = 180.0 / 3.14159265358979323846;
+    const double rmsKalmanDeg = queries > 0 ? std::sqrt (sumSqKalman / queries) * radToDeg : 1.0e9;
+    const double rmsHoldDeg = queries > 0 ? std::sqrt (sumSqHold / queries) * radToDeg : 0.0;
+    const double jitterMs = interpolator.getEstimatedJitterMs();
+
+    CheckResult result;
+    result.id = "kalman_head_pose_prediction";
+    result.passed = queries > 0 && rmsKalmanDeg < 1.5 && rmsKalmanDeg < 0.25 * rmsHoldDeg
+                    && jitterMs > 1.0 && jitterMs < maxJitterMs;
+    result.detail = "rms_err_kalman_deg=" + std::to_string (rmsKalmanDeg)
+                  + ", max_err_kalman_deg=" + std::to_string (worstKalman * radToDeg)
+                  + ", rms_err_hold_newest_deg=" + std::to_string (rmsHoldDeg)
+                  + ", estimated_jitter_ms=" + std::to_string (jitterMs)
+                  + ", queries=" + std::to_string (queries);
+    return result;
+}
+} // namespace
+
+int main()
+{
+    const std::vector<CheckResult> checks {
+        checkPartitionedFirMatchesDirectConvolution(),
+        checkPeqCoefficientPublishing(),
+        checkBw64ObjectExportRoundTrip(),
+        checkStreamingDeconvolutionMatchesOneShot(),
+        checkKalmanHeadPosePrediction()
+    };
+
+    int passed = 0;
+    for (const auto& check : checks)
+    {
+        std::cout << "CHECK " << check.id
+                  << " : " << (check.passed ? "PASS" : "FAIL")
+                  << " | " << check.detail << "\n";
+        if (check.passed)
+            ++passed;
+    }
+
+    std::cout << "SUMMARY dsp_probe : "
+              << passed << "/" << checks.size() << " checks passed\n";
+
+    return passed == static_cast<int> (checks.size()) ? 0 : 1;
+}
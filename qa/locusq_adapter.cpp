@@ -326,6 +326,11 @@ void LocusQSpatialAdapter::applyStoredParametersToRenderer()
     apply(34, "rend_headphone_mode");
     apply(35, "rend_headphone_profile");
     apply(36, "rend_spatial_profile");
+    apply(37, "rend_air_model");
+    apply(38, "rend_air_temp");
+    apply(39, "rend_air_humidity");
+    apply(40, "rend_ambi_norm");
+    apply(41, "rend_ambi_monitor");
 }
 
 void LocusQSpatialAdapter::prepare(double sampleRate, int maxBlockSize, int numChannels)
@@ -479,6 +484,21 @@ void LocusQSpatialAdapter::setParameter(int index, ::qa::NormalizedParam value)
         case 36:
             setRendererParam     ("rend_spatial_profile", normalized);
             break;
+        case 37:
+            setRendererParam     ("rend_air_model", normalized);
+            break;
+        case 38:
+            setRendererParam     ("rend_air_temp", normalized);
+            break;
+        case 39:
+            setRendererParam     ("rend_air_humidity", normalized);
+            break;
+        case 40:
+            setRendererParam     ("rend_ambi_norm", normalized);
+            break;
+        case 41:
+            setRendererParam     ("rend_ambi_monitor", normalized);
+            break;
         default:
             break;
     }
@@ -498,7 +518,10 @@ const char* LocusQSpatialAdapter::getParameterName(int index) const
         "anim_enable", "anim_mode", "anim_loop", "anim_speed", "anim_sync",
         "qa_emitter_instances", "qa_snapshot_migration_mode", "rend_headphone_mode",
         "rend_headphone_profile",
-        "rend_spatial_profile"
+        "rend_spatial_profile",
+        "rend_air_model", "rend_air_temp", "rend_air_humidity",
+        "rend_ambi_norm",
+        "rend_ambi_monitor"
     };
     if (index >= 0 && index < kNumParameters) return names[index];
     return nullptr;
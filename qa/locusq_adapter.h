@@ -119,6 +119,11 @@ private:
  *   34: rend_headphone_mode    (choice: 0=Stereo Downmix, 1=Steam Binaural request)
  *   35: rend_headphone_profile (choice: Generic/AirPods Pro 2/Sony WH-1000XM5/Custom SOFA)
  *   36: rend_spatial_profile   (choice: Auto/Stereo/Quad/5.2.1/7.2.1/7.4.2/FOA/HOA/Atmos/Virtual3D/IAMF/ADM)
+ *   37: rend_air_model         (choice: 0=Simple, 1=ISO 9613-1)
+ *   38: rend_air_temp          (-20..+50 degrees C)
+ *   39: rend_air_humidity      (0..100 % RH)
+ *   40: rend_ambi_norm         (choice: 0=SN3D, 1=N3D; ACN order for FOA/HOA output)
+ *   41: rend_ambi_monitor      (bool: >0.5 = 3rd-order SH-domain binaural monitoring on stereo)
  */
 class LocusQSpatialAdapter : public ::qa::DspUnderTest
 {
@@ -142,7 +147,7 @@ public:
     bool loadState(const std::vector<std::uint8_t>& state);
 
 private:
-    static constexpr int kNumParameters = 37;
+    static constexpr int kNumParameters = 42;
     static constexpr int kMaxQaEmitters = 16;
 
     // Emitters + renderer sharing the same process-wide SceneGraph singleton
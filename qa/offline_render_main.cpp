@@ -0,0 +1,127 @@
+// LocusQ offline scene bounce
+//
+// Renders a saved scene (see Source/OfflineSceneRenderer.h for the JSON
+// schema) to a multichannel WAV as fast as the CPU allows, for headless
+// batch deliverables.
+//
+//   locusq_offline_render --scene scene.json --out mix.wav [--block-size 2048]
+//                         [--bit-depth 24] [--capped-budget] [--quiet]
+
+#include "Source/OfflineSceneRenderer.h"
+
+#include <juce_core/juce_core.h>
+
+#include <iostream>
+
+namespace
+{
+struct RenderArgs
+{
+    juce::File sceneFile;
+    juce::File outputFile;
+    OfflineSceneRenderer::Options options;
+    bool quiet = false;
+};
+
+void printUsage()
+{
+    std::cout << "Usage: locusq_offline_render --scene <scene.json> --out <output.wav>\n"
+              << "         [--block-size N] [--bit-depth 16|24|32] [--capped-budget] [--quiet]\n";
+}
+
+bool parseArgs (int argc, char* argv[], RenderArgs& args, juce::String& error)
+{
+    const auto cwd = juce::File::getCurrentWorkingDirectory();
+    for (int i = 1; i < argc; ++i)
+    {
+        const juce::String arg (argv[i]);
+        const auto nextValue = [&]() -> juce::String
+        {
+            return i + 1 < argc ? juce::String (argv[++i]) : juce::String();
+        };
+
+        if (arg == "--scene")
+            args.sceneFile = cwd.getChildFile (nextValue());
+        else if (arg == "--out")
+            args.outputFile = cwd.getChildFile (nextValue());
+        else if (arg == "--block-size")
+            args.options.blockSize = nextValue().getIntValue();
+        else if (arg == "--bit-depth")
+            args.options.bitDepth = nextValue().getIntValue();
+        else if (arg == "--capped-budget")
+            args.options.uncappedEmitterBudget = false;
+        else if (arg == "--quiet")
+            args.quiet = true;
+        else
+        {
+            error = "unknown argument: " + arg;
+            return false;
+        }
+    }
+
+    if (args.sceneFile == juce::File() || args.outputFile == juce::File())
+    {
+        error = "--scene and --out are required";
+        return false;
+    }
+
+    if (args.options.blockSize < 64 || args.options.blockSize > OfflineSceneRenderer::MAX_BLOCK_SIZE)
+    {
+        error = "--block-size must be in [64, " + juce::String (OfflineSceneRenderer::MAX_BLOCK_SIZE) + "]";
+        return false;
+    }
+
+    if (args.options.bitDepth != 16 && args.options.bitDepth != 24 && args.options.bitDepth != 32)
+    {
+        error = "--bit-depth must be 16, 24 or 32";
+        return false;
+    }
+
+    return true;
+}
+} // namespace
+
+int main (int argc, char* argv[])
+{
+    RenderArgs args;
+    juce::String parseError;
+    if (! parseArgs (argc, argv, args, parseError))
+    {
+        std::cerr << "ERROR: " << parseError << "\n";
+        printUsage();
+        return 2;
+    }
+
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    OfflineSceneRenderer::Scene scene;
+    juce::String loadError;
+    if (! OfflineSceneRenderer::loadScene (args.sceneFile, scene, loadError))
+    {
+        std::cerr << "ERROR: " << loadError << "\n";
+        return 2;
+    }
+
+    int lastPercent = -1;
+    OfflineSceneRenderer renderer;
+    const auto result = renderer.render (scene, args.outputFile, args.options, [&] (double fraction)
+    {
+        const auto percent = static_cast<int> (fraction * 100.0);
+        if (! args.quiet && percent / 10 != lastPercent / 10)
+            std::cout << "PROGRESS " << percent << "%\n";
+        lastPercent = percent;
+        return true;
+    });
+
+    std::cout << "RESULT " << (result.ok ? "PASS" : "FAIL")
+              << " emitters=" << scene.emitters.size()
+              << " channels=" << scene.outputChannels
+              << " samples=" << result.samplesRendered
+              << " rendered_s=" << result.renderedSeconds
+              << " wall_s=" << result.wallSeconds
+              << " realtime_x=" << result.realtimeFactor
+              << " message=" << result.message
+              << "\n";
+
+    return result.ok ? 0 : 1;
+}
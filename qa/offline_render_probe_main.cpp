@@ -0,0 +1,191 @@
+// LocusQ offline render probe
+//
+// Bounces small synthetic scenes through OfflineSceneRenderer and checks the
+// rendered WAV. Prints CHECK/SUMMARY lines and exits non-zero on any failure.
+
+#include "Source/OfflineSceneRenderer.h"
+
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_core/juce_core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+struct CheckResult
+{
+    std::string id;
+    bool passed = false;
+    std::string detail;
+};
+
+constexpr double kSampleRate = 48000.0;
+constexpr double kToneHz = 1000.0;
+constexpr double kSceneSeconds = 2.0;
+
+bool writeSineWav (const juce::File& file, double frequencyHz, double seconds)
+{
+    const int numSamples = static_cast<int> (std::ceil (seconds * kSampleRate));
+    juce::AudioBuffer<float> tone (1, numSamples);
+    auto* data = tone.getWritePointer (0);
+    for (int i = 0; i < numSamples; ++i)
+        data[i] = 0.5f * static_cast<float> (std::sin (juce::MathConstants<double>::twoPi * frequencyHz
+                                                        * static_cast<double> (i) / kSampleRate));
+
+    file.deleteFile();
+    auto stream = std::make_unique<juce::FileOutputStream> (file);
+    if (stream->failedToOpen())
+        return false;
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(), kSampleRate, 1, 32, {}, 0));
+    if (writer == nullptr)
+        return false;
+
+    stream.release(); // owned by the writer now
+    return writer->writeFromAudioSampleBuffer (tone, 0, numSamples);
+}
+
+bool readWav (const juce::File& file, juce::AudioBuffer<float>& buffer)
+{
+    juce::AudioFormatManager formatManager;
+    formatManager.registerBasicFormats();
+    std::unique_ptr<juce::AudioFormatReader> reader (formatManager.createReaderFor (file));
+    if (reader == nullptr)
+        return false;
+
+    buffer.setSize (static_cast<int> (reader->numChannels), static_cast<int> (reader->lengthInSamples));
+    return reader->read (&buffer, 0, buffer.getNumSamples(), 0, true, true);
+}
+
+// A stationary emitter has no block-to-block motion, so the rendered tone
+// must keep its pitch (no Doppler) and its level (no per-block gain ramp
+// from a stale trajectory start).
+CheckResult checkStationaryEmitterHasNoDopplerOrGainRamp()
+{
+    CheckResult result;
+    result.id = "stationary_emitter_no_doppler_or_gain_ramp";
+
+    const auto tempDir = juce::File::getSpecialLocation (juce::File::tempDirectory);
+    const auto toneFile = tempDir.getNonexistentChildFile ("locusq_probe_tone", ".wav");
+    const auto outputFile = tempDir.getNonexistentChildFile ("locusq_probe_stationary", ".wav");
+
+    if (! writeSineWav (toneFile, kToneHz, kSceneSeconds))
+    {
+        result.detail = "could not write tone fixture";
+        return result;
+    }
+
+    OfflineSceneRenderer::Scene scene;
+    scene.sampleRate = kSampleRate;
+    scene.outputChannels = 4;
+    scene.spatialProfileIndex = static_cast<int> (SpatialRenderer::SpatialOutputProfile::Quad40);
+    scene.durationSeconds = kSceneSeconds;
+    scene.renderer.dopplerEnabled = true;
+    scene.renderer.airAbsorptionEnabled = false;
+    scene.renderer.roomEnabled = false;
+
+    OfflineSceneRenderer::Emitter emitter;
+    emitter.label = "Stationary";
+    emitter.audioFile = toneFile;
+    emitter.azimuthDeg = 45.0f;
+    emitter.distance = 3.0f;
+    scene.emitters.push_back (emitter);
+
+    OfflineSceneRenderer::Options options;
+    options.blockSize = 512;
+    options.bitDepth = 32;
+
+    OfflineSceneRenderer offlineRenderer;
+    const auto render = offlineRenderer.render (scene, outputFile, options);
+
+    juce::AudioBuffer<float> rendered;
+    const bool readOk = render.ok && readWav (outputFile, rendered);
+    toneFile.deleteFile();
+    outputFile.deleteFile();
+
+    if (! readOk)
+    {
+        result.detail = "render failed: " + render.message.toStdString();
+        return result;
+    }
+
+    // Skip the first and last half second so smoother settling and the
+    // source tail stay out of the measurement. 480-sample windows hold
+    // exactly ten tone cycles, so a steady render has a flat window RMS.
+    constexpr int kWindow = 480;
+    const int start = static_cast<int> (0.5 * kSampleRate);
+    const int end = static_cast<int> (1.5 * kSampleRate);
+
+    double minWindowEnergy = 1.0e30;
+    double maxWindowEnergy = 0.0;
+    for (int window = start; window + kWindow <= end; window += kWindow)
+    {
+        double energy = 0.0;
+        for (int ch = 0; ch < rendered.getNumChannels(); ++ch)
+        {
+            const auto* data = rendered.getReadPointer (ch);
+            for (int i = window; i < window + kWindow; ++i)
+                energy += static_cast<double> (data[i]) * static_cast<double> (data[i]);
+        }
+
+        minWindowEnergy = std::min (minWindowEnergy, energy);
+        maxWindowEnergy = std::max (maxWindowEnergy, energy);
+    }
+
+    int loudestChannel = 0;
+    for (int ch = 1; ch < rendered.getNumChannels(); ++ch)
+        if (rendered.getRMSLevel (ch, start, end - start) > rendered.getRMSLevel (loudestChannel, start, end - start))
+            loudestChannel = ch;
+
+    int zeroCrossings = 0;
+    const auto* loudest = rendered.getReadPointer (loudestChannel);
+    for (int i = start + 1; i < end; ++i)
+        if ((loudest[i - 1] < 0.0f) != (loudest[i] < 0.0f))
+            ++zeroCrossings;
+
+    const double expectedCrossings = 2.0 * kToneHz * static_cast<double> (end - start) / kSampleRate;
+    const double spreadDb = minWindowEnergy > 0.0 ? 10.0 * std::log10 (maxWindowEnergy / minWindowEnergy) : 1.0e9;
+
+    const bool audible = minWindowEnergy > 1.0e-6;
+    const bool flatLevel = spreadDb < 0.05;
+    const bool steadyPitch = std::abs (static_cast<double> (zeroCrossings) - expectedCrossings) <= 2.0;
+    result.passed = audible && flatLevel && steadyPitch;
+
+    std::ostringstream detail;
+    detail << "window_level_spread_db=" << spreadDb
+           << " zero_crossings=" << zeroCrossings
+           << " expected=" << expectedCrossings
+           << " min_window_energy=" << minWindowEnergy;
+    result.detail = detail.str();
+    return result;
+}
+} // namespace
+
+int main()
+{
+    const std::vector<CheckResult> checks {
+        checkStationaryEmitterHasNoDopplerOrGainRamp()
+    };
+
+    int passed = 0;
+    for (const auto& check : checks)
+    {
+        std::cout << "CHECK " << check.id
+                  << " : " << (check.passed ? "PASS" : "FAIL")
+                  << " | " << check.detail << "\n";
+        if (check.passed)
+            ++passed;
+    }
+
+    std::cout << "SUMMARY offline_render_probe : "
+              << passed << "/" << checks.size() << " checks passed\n";
+
+    return passed == static_cast<int> (checks.size()) ? 0 : 1;
+}
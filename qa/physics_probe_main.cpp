@@ -7,7 +7,9 @@
 
 #include <chrono>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <memory>
 #include <optional>
 #include <string>
 #include <thread>
@@ -335,6 +337,270 @@ CheckResult checkZeroGDrift()
                   + ", displacement=" + std::to_string (displacement);
     return result;
 }
+CheckResult checkBatchedWorldStepsAllBodies()
+{
+    constexpr int numBodies = 64;
+    constexpr double durationSeconds = 0.5;
+
+    std::vector<std::unique_ptr<PhysicsEngine>> engines;
+    engines.reserve (numBodies);
+    for (int i = 0; i < numBodies; ++i)
+    {
+        auto engine = std::make_unique<PhysicsEngine>();
+        engine->prepare (48000.0);
+        engine->setUpdateRateIndex (3); // 240 Hz
+        engine->setPhysicsEnabled (true);
+        engine->setWallCollisionEnabled (false);
+        engine->setDrag (0.0f);
+        engine->setRestPosition ({ static_cast<float> (i) * 0.1f, 1.0f, 0.0f });
+        engines.push_back (std::move (engine));
+    }
+
+    std::this_thread::sleep_for (std::chrono::milliseconds (30));
+    for (auto& engine : engines)
+        engine->requestThrow ({ 2.0f, 0.0f, 0.0f });
+
+    auto& world = PhysicsWorld::getInstance();
+    const int registered = world.getNumBodies();
+    const auto ticksBefore = world.getTickCount();
+    std::this_thread::sleep_for (std::chrono::duration<double> (durationSeconds));
+    const auto ticks = world.getTickCount() - ticksBefore;
+
+    int moved = 0;
+    for (int i = 0; i < numBodies; ++i)
+    {
+        const auto state = engines[static_cast<size_t> (i)]->getState();
+        if (state.position.x - static_cast<float> (i) * 0.1f > 0.5f)
+            ++moved;
+    }
+
+    for (auto& engine : engines)
+        engine->shutdown();
+
+    // One scheduler wake per tick regardless of body count.
+    const double expectedTicks = 240.0 * durationSeconds;
+    const bool allMoved = moved == numBodies;
+    const bool singleCadence = ticks > expectedTicks * 0.5 && ticks < expectedTicks * 1.5;
+
+    CheckResult result;
+    result.id = "batched_world_steps_all_bodies";
+    result.passed = registered == numBodies && allMoved && singleCadence && world.getNumBodies() == 0;
+    result.detail = "bodies=" + std::to_string (registered)
+                  + ", moved=" + std::to_string (moved)
+                  + ", ticks=" + std::to_string (ticks)
+                  + ", expected_ticks=" + std::to_string (expectedTicks);
+    return result;
+}
+CheckResult checkBodyContactsBounceAndScale()
+{
+    // Head-on pair: two spheres thrown at each other must separate again.
+    PhysicsEngine left, right;
+    for (auto* engine : { &left, &right })
+    {
+        engine->prepare (48000.0);
+        engine->setUpdateRateIndex (3);
+        engine->setPhysicsEnabled (true);
+        engine->setWallCollisionEnabled (false);
+        engine->setBodyCollisionEnabled (true);
+        engine->setCollisionExtents ({ 0.4f, 0.4f, 0.4f });
+        engine->setDrag (0.0f);
+        engine->setElasticity (0.9f);
+    }
+    left.setRestPosition ({ -1.0f, 1.0f, 0.0f });
+    right.setRestPosition ({ 1.0f, 1.0f, 0.0f });
+    std::this_thread::sleep_for (std::chrono::milliseconds (30));
+    left.requestThrow ({ 3.0f, 0.0f, 0.0f });
+    right.requestThrow ({ -3.0f, 0.0f, 0.0f });
+
+    std::this_thread::sleep_for (std::chrono::seconds (1));
+    const auto leftEnd = left.getState();
+    const auto rightEnd = right.getState();
+    left.shutdown();
+    right.shutdown();
+
+    const bool reversed = leftEnd.velocity.x < -1.0f && rightEnd.velocity.x > 1.0f;
+    const bool separated = rightEnd.position.x - leftEnd.position.x > 0.4f;
+
+    // Dense scene: 256 small bodies on a lattice; broadphase pair tests
+    // must stay far below the N(N-1)/2 brute-force count.
+    constexpr int numBodies = SceneGraph::MAX_EMITTERS;
+    std::vector<std::unique_ptr<PhysicsEngine>> swarm;
+    swarm.reserve (numBodies);
+    for (int i = 0; i < numBodies; ++i)
+    {
+        auto engine = std::make_unique<PhysicsEngine>();
+        engine->prepare (48000.0);
+        engine->setPhysicsEnabled (true);
+        engine->setBodyCollisionEnabled (true);
+        engine->setCollisionExtents ({ 0.1f, 0.1f, 0.1f });
+        engine->setRoomDimensions ({ 8.0f, 8.0f, 8.0f });
+        engine->setRestPosition ({ -3.0f + static_cast<float> (i % 16) * 0.4f,
+                                   0.5f + static_cast<float> ((i / 16) % 4) * 0.4f,
+                                   -1.5f + static_cast<float> (i / 64) * 0.4f });
+        swarm.push_back (std::move (engine));
+    }
+    std::this_thread::sleep_for (std::chrono::milliseconds (100));
+    const int pairTests = PhysicsWorld::getInstance().getLastBodyPairTests();
+    for (auto& engine : swarm)
+        engine->shutdown();
+
+    const int bruteForcePairs = numBodies * (numBodies - 1) / 2;
+    const bool scales = pairTests > 0 && pairTests < bruteForcePairs / 10;
+
+    CheckResult result;
+    result.id = "body_contacts_bounce_and_scale";
+    result.passed = reversed && separated && scales;
+    result.detail = "left_vx=" + std::to_string (leftEnd.velocity.x)
+                  + ", right_vx=" + std::to_string (rightEnd.velocity.x)
+                  + ", gap=" + std::to_string (rightEnd.position.x - leftEnd.position.x)
+                  + ", pair_tests=" + std::to_string (pairTests)
+                  + ", brute_force_pairs=" + std::to_string (bruteForcePairs);
+    return result;
+}
+// The scheduler steps the world asynchronously; wait until it has caught up
+// with the posted sample clock (bounded so a stuck world fails the check).
+bool waitForSampleClock (PhysicsWorld& world)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds (2);
+    while (! world.isSampleClockSettled())
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for (std::chrono::microseconds (100));
+    }
+    return true;
+}
+
+// Drives the world from a synthetic sample clock and records the published
+// state every kReplayRecordInterval samples for a small bouncing, colliding
+// scene. The throws are written from one thread per emitter, in forward or
+// reverse emitter order, between two settled clock advances.
+constexpr uint64_t kReplayRecordInterval = 441;
+constexpr uint64_t kReplayThrowSample = 10 * kReplayRecordInterval;
+
+std::vector<PhysicsEngine::PhysicsState> runSampleClockReplay (int blockSize, int numBlocks, bool reverseWriters,
+                                                               uint64_t& stepsTaken, bool& kept)
+{
+    auto& world = PhysicsWorld::getInstance();
+    world.setSampleClockLocked (true);
+
+    constexpr int numBodies = 8;
+    std::vector<std::unique_ptr<PhysicsEngine>> engines;
+    for (int i = 0; i < numBodies; ++i)
+    {
+        auto engine = std::make_unique<PhysicsEngine>();
+        engine->setUpdateRateIndex (3);
+        engine->setPhysicsEnabled (true);
+        engine->setBodyCollisionEnabled (true);
+        engine->setCollisionExtents ({ 0.3f, 0.3f, 0.3f });
+        engine->setRoomDimensions ({ 3.0f, 3.0f, 3.0f });
+        engine->setGravity (9.8f, 0);
+        engine->setRestPosition ({ -1.0f + static_cast<float> (i) * 0.3f, 2.0f, 0.0f });
+        engine->prepare (48000.0);
+        engines.push_back (std::move (engine));
+    }
+
+    std::vector<PhysicsEngine::PhysicsState> trace;
+    uint64_t sampleClock = 0;
+    world.advanceToSampleClock (sampleClock, 48000.0);
+    kept = waitForSampleClock (world);
+    const auto ticksBefore = world.getTickCount();
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        if (sampleClock == kReplayThrowSample)
+        {
+            std::vector<std::thread> writers;
+            for (int k = 0; k < numBodies; ++k)
+            {
+                const int i = reverseWriters ? numBodies - 1 - k : k;
+                writers.emplace_back ([&engines, i]
+                {
+                    engines[static_cast<size_t> (i)]->requestThrow ({ (i % 2 == 0 ? 4.0f : -4.0f), 1.0f, 0.5f });
+                });
+            }
+            for (auto& writer : writers)
+                writer.join();
+        }
+
+        sampleClock += static_cast<uint64_t> (blockSize);
+        world.advanceToSampleClock (sampleClock, 48000.0);
+        kept = waitForSampleClock (world) && kept;
+        if (sampleClock % kReplayRecordInterval == 0)
+            for (const auto& engine : engines)
+                trace.push_back (engine->getState());
+    }
+
+    stepsTaken = world.getTickCount() - ticksBefore;
+    for (auto& engine : engines)
+        engine->shutdown();
+    world.setSampleClockLocked (false);
+    return trace;
+}
+
+CheckResult checkSampleClockDeterministicReplay()
+{
+    constexpr int blockSize = 441;
+    constexpr int numBlocks = 200;
+
+    uint64_t stepsA = 0, stepsB = 0;
+    bool keptA = false, keptB = false;
+    const auto traceA = runSampleClockReplay (blockSize, numBlocks, false, stepsA, keptA);
+    const auto traceB = runSampleClockReplay (blockSize, numBlocks, false, stepsB, keptB);
+
+    bool identical = traceA.size() == traceB.size();
+    for (size_t i = 0; identical && i < traceA.size(); ++i)
+    {
+        const auto& a = traceA[i];
+        const auto& b = traceB[i];
+        identical = std::memcmp (&a.position, &b.position, sizeof (Vec3)) == 0
+                 && std::memcmp (&a.velocity, &b.velocity, sizeof (Vec3)) == 0;
+    }
+
+    // 200 x 441 samples at 48 kHz = 1.8375 s -> 441 whole 240 Hz steps.
+    const uint64_t expectedSteps = static_cast<uint64_t> (blockSize) * numBlocks / 200;
+    const bool clockLocked = keptA && keptB && stepsA == expectedSteps && stepsB == expectedSteps;
+    const bool moved = ! traceA.empty() && std::abs (traceA.back().position.y - 2.0f) > 0.1f;
+
+    CheckResult result;
+    result.id = "sample_clock_deterministic_replay";
+    result.passed = identical && clockLocked && moved;
+    result.detail = std::string ("identical=") + (identical ? "true" : "false")
+                  + ", steps=" + std::to_string (stepsA) + "/" + std::to_string (stepsB)
+                  + ", expected_steps=" + std::to_string (expectedSteps);
+    return result;
+}
+
+// Locked stepping depends only on sample counts and on the control inputs
+// each step samples (in emitter-slot order). Splitting the clock into
+// smaller blocks, or writing the same controls from emitter threads in a
+// different order between steps, must not change a single bit.
+CheckResult checkSampleClockReplayIndependentOfBlockingAndWriterOrder()
+{
+    uint64_t stepsWhole = 0, stepsSplit = 0;
+    bool keptWhole = false, keptSplit = false;
+    const auto whole = runSampleClockReplay (441, 200, false, stepsWhole, keptWhole);
+    const auto split = runSampleClockReplay (147, 600, true, stepsSplit, keptSplit);
+
+    bool identical = ! whole.empty() && whole.size() == split.size();
+    size_t firstMismatch = whole.size();
+    for (size_t i = 0; identical && i < whole.size(); ++i)
+    {
+        identical = std::memcmp (&whole[i].position, &split[i].position, sizeof (Vec3)) == 0
+                 && std::memcmp (&whole[i].velocity, &split[i].velocity, sizeof (Vec3)) == 0;
+        if (! identical)
+            firstMismatch = i;
+    }
+
+    CheckResult result;
+    result.id = "sample_clock_replay_independent_of_blocking_and_writer_order";
+    result.passed = keptWhole && keptSplit && identical && stepsWhole == stepsSplit;
+    result.detail = std::string ("identical=") + (identical ? "true" : "false")
+                  + ", samples=" + std::to_string (whole.size()) + "/" + std::to_string (split.size())
+                  + ", first_mismatch=" + std::to_string (firstMismatch)
+                  + ", steps=" + std::to_string (stepsWhole) + "/" + std::to_string (stepsSplit);
+    return result;
+}
 } // namespace
 
 int main()
@@ -344,7 +610,11 @@ int main()
         checkGravityPullsDown(),
         checkDragSlowsMotion(),
         checkElasticityBounceRetention(),
-        checkZeroGDrift()
+        checkZeroGDrift(),
+        checkBatchedWorldStepsAllBodies(),
+        checkBodyContactsBounceAndScale(),
+        checkSampleClockDeterministicReplay(),
+        checkSampleClockReplayIndependentOfBlockingAndWriterOrder()
     };
 
     int passed = 0;
@@ -0,0 +1,546 @@
+// LocusQ timeline probe
+//
+// Deterministic checks for timeline publication and evaluation: snapshot
+// reclamation through RetainingSharedPtrPublisher, the renderer-owned
+// ChoreographyTimeline and the compiled cubic keyframe pieces. Prints
+// CHECK/SUMMARY lines and exits non-zero on any failure.
+
+#include "Source/ChoreographyTimeline.h"
+#include "Source/KeyframeTimeline.h"
+#include "Source/SharedPtrAtomicContract.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+struct CheckResult
+{
+    std::string id;
+    bool passed = false;
+    std::string detail;
+};
+
+//==============================================================================
+// Snapshot reclamation
+
+struct ReclaimStats
+{
+    std::atomic<int> destroyed { 0 };
+    std::atomic<int> destroyedOffPublisher { 0 };
+    std::thread::id publisherThread;
+};
+
+// Stand-in for a timeline snapshot: a version plus a payload the reader can
+// check for completeness, and a destructor that records the freeing thread.
+struct ProbeSnapshot
+{
+    ProbeSnapshot (ReclaimStats& statsIn, uint64_t versionIn)
+        : stats (statsIn), version (versionIn), payload (64, versionIn)
+    {
+    }
+
+    ~ProbeSnapshot()
+    {
+        stats.destroyed.fetch_add (1, std::memory_order_relaxed);
+        if (std::this_thread::get_id() != stats.publisherThread)
+            stats.destroyedOffPublisher.fetch_add (1, std::memory_order_relaxed);
+    }
+
+    bool isComplete() const noexcept
+    {
+        return std::all_of (payload.begin(), payload.end(), [this] (uint64_t value) { return value == version; });
+    }
+
+    ReclaimStats& stats;
+    uint64_t version = 0;
+    std::vector<uint64_t> payload;
+};
+
+// A snapshot the reader still holds must outlive its replacement, dropping it
+// on the reader side must not free it, and the next publish must. The value
+// being replaced is still published while retired ones are swept, so it is
+// freed one publish (or releaseRetired call) later.
+CheckResult checkSnapshotReclaimedOnlyByPublisher()
+{
+    CheckResult result;
+    result.id = "timeline_snapshot_reclaimed_only_by_publisher";
+
+    ReclaimStats stats;
+    stats.publisherThread = std::this_thread::get_id();
+
+    bool heldSurvivesReplace = false;
+    bool readerDropDoesNotFree = false;
+    bool nextPublishFrees = false;
+    bool sweepFreesReplaced = false;
+    size_t retainedAfterSweep = 0;
+    {
+        RetainingSharedPtrPublisher<const ProbeSnapshot> publisher;
+        publisher.publish (std::make_shared<ProbeSnapshot> (stats, 1));
+
+        auto readerHeld = publisher.load();
+        publisher.publish (std::make_shared<ProbeSnapshot> (stats, 2));
+        heldSurvivesReplace = stats.destroyed.load() == 0 && readerHeld->isComplete() && publisher.getNumRetained() == 2;
+
+        readerHeld.reset();
+        readerDropDoesNotFree = stats.destroyed.load() == 0;
+
+        publisher.publish (std::make_shared<ProbeSnapshot> (stats, 3));
+        nextPublishFrees = stats.destroyed.load() == 1 && publisher.load()->version == 3;
+
+        publisher.releaseRetired();
+        sweepFreesReplaced = stats.destroyed.load() == 2;
+        retainedAfterSweep = publisher.getNumRetained();
+    }
+
+    result.passed = heldSurvivesReplace && readerDropDoesNotFree && nextPublishFrees && sweepFreesReplaced
+                    && retainedAfterSweep == 1 && stats.destroyed.load() == 3;
+
+    std::ostringstream detail;
+    detail << "held_survives_replace=" << heldSurvivesReplace
+           << " reader_drop_does_not_free=" << readerDropDoesNotFree
+           << " next_publish_frees=" << nextPublishFrees
+           << " sweep_frees_replaced=" << sweepFreesReplaced
+           << " retained_after_sweep=" << retainedAfterSweep
+           << " destroyed=" << stats.destroyed.load();
+    result.detail = detail.str();
+    return result;
+}
+
+// A reader thread adopts the newest snapshot in a tight loop, the way the
+// audio thread does once per block, while the publisher replaces it. The
+// reader must always see a complete snapshot with a non-decreasing version,
+// and every free must happen on the publishing thread.
+CheckResult checkSnapshotReaderNeverFrees()
+{
+    CheckResult result;
+    result.id = "timeline_snapshot_reader_never_frees_or_tears";
+
+    constexpr uint64_t kNumVersions = 2000;
+
+    ReclaimStats stats;
+    stats.publisherThread = std::this_thread::get_id();
+
+    std::atomic<bool> stopReader { false };
+    std::atomic<int> incompleteReads { 0 };
+    std::atomic<int> versionRegressions { 0 };
+    std::atomic<uint64_t> lastVersionSeen { 0 };
+    size_t maxRetained = 0;
+
+    {
+        RetainingSharedPtrPublisher<const ProbeSnapshot> publisher;
+        publisher.publish (std::make_shared<ProbeSnapshot> (stats, 1));
+
+        std::thread reader ([&]
+        {
+            std::shared_ptr<const ProbeSnapshot> active;
+            uint64_t lastVersion = 0;
+            while (! stopReader.load (std::memory_order_acquire))
+            {
+                if (auto latest = publisher.load(); latest != active)
+                    active = std::move (latest);
+
+                if (! active->isComplete())
+                    incompleteReads.fetch_add (1, std::memory_order_relaxed);
+                if (active->version < lastVersion)
+                    versionRegressions.fetch_add (1, std::memory_order_relaxed);
+                lastVersion = active->version;
+            }
+
+            lastVersionSeen.store (lastVersion, std::memory_order_relaxed);
+        });
+
+        for (uint64_t version = 2; version <= kNumVersions; ++version)
+        {
+            publisher.publish (std::make_shared<ProbeSnapshot> (stats, version));
+            maxRetained = std::max (maxRetained, publisher.getNumRetained());
+            if (version % 64 == 0)
+                std::this_thread::sleep_for (std::chrono::microseconds (200));
+        }
+
+        std::this_thread::sleep_for (std::chrono::milliseconds (5));
+        stopReader.store (true, std::memory_order_release);
+        reader.join();
+
+        publisher.releaseRetired();
+    }
+
+    result.passed = incompleteReads.load() == 0
+                    && versionRegressions.load() == 0
+                    && stats.destroyedOffPublisher.load() == 0
+                    && stats.destroyed.load() == static_cast<int> (kNumVersions)
+                    && lastVersionSeen.load() == kNumVersions;
+
+    std::ostringstream detail;
+    detail << "versions=" << kNumVersions
+           << " last_seen=" << lastVersionSeen.load()
+           << " incomplete_reads=" << incompleteReads.load()
+           << " version_regressions=" << versionRegressions.load()
+           << " freed_off_publisher=" << stats.destroyedOffPublisher.load()
+           << " destroyed=" << stats.destroyed.load()
+           << " max_retained=" << maxRetained;
+    result.detail = detail.str();
+    return result;
+}
+
+//==============================================================================
+// Choreography evaluation
+
+Keyframe makeKeyframe (double timeSeconds, float value, KeyframeCurve curve, float outHandle = 0.0f, float inHandle = 0.0f)
+{
+    Keyframe keyframe;
+    keyframe.timeSeconds = timeSeconds;
+    keyframe.value = value;
+    keyframe.curve = curve;
+    keyframe.outHandle = outHandle;
+    keyframe.inHandle = inHandle;
+    return keyframe;
+}
+
+ChoreographyTimeline::PathKeyframe makePathKeyframe (double timeSeconds, Vec3 value, KeyframeCurve curve)
+{
+    ChoreographyTimeline::PathKeyframe keyframe;
+    keyframe.timeSeconds = timeSeconds;
+    keyframe.value = value;
+    keyframe.curve = curve;
+    keyframe.outHandle = { 0.2f, -0.1f, 0.05f };
+    keyframe.inHandle = { -0.3f, 0.1f, 0.0f };
+    return keyframe;
+}
+
+struct ReferenceTrack
+{
+    int slot = 0;
+    int sceneAxis = 0; // 0 = scene x, 1 = scene y (pos_z), 2 = scene z (pos_y)
+    KeyframeTrack track;
+};
+
+float sceneComponent (const Vec3& value, int sceneAxis) noexcept
+{
+    return sceneAxis == 0 ? value.x : (sceneAxis == 1 ? value.y : value.z);
+}
+
+// One packed evaluation per block must give every slot the value its track
+// gives on its own, with the parameter axes mapped to scene axes, across
+// forward playback, a loop wrap and a backwards seek.
+CheckResult checkChoreographyMatchesPerTrackEvaluation()
+{
+    CheckResult result;
+    result.id = "choreography_matches_per_track_evaluation";
+
+    const std::vector<Keyframe> xKeys { makeKeyframe (0.0, -2.0f, KeyframeCurve::linear),
+                                        makeKeyframe (1.0, 1.0f, KeyframeCurve::easeInOut),
+                                        makeKeyframe (2.5, 3.0f, KeyframeCurve::step),
+                                        makeKeyframe (3.0, 0.5f, KeyframeCurve::linear) };
+    const std::vector<Keyframe> yKeys { makeKeyframe (0.5, 1.0f, KeyframeCurve::catmullRom),
+                                        makeKeyframe (1.5, 4.0f, KeyframeCurve::catmullRom),
+                                        makeKeyframe (2.0, 2.0f, KeyframeCurve::catmullRom),
+                                        makeKeyframe (3.5, 5.0f, KeyframeCurve::catmullRom) };
+    const std::vector<Keyframe> zKeys { makeKeyframe (0.25, 0.0f, KeyframeCurve::bezier, 0.8f, 0.0f),
+                                        makeKeyframe (2.75, 2.0f, KeyframeCurve::easeOut, 0.0f, -0.5f),
+                                        makeKeyframe (3.25, 1.0f, KeyframeCurve::easeIn) };
+    const std::vector<ChoreographyTimeline::PathKeyframe> pathKeys {
+        makePathKeyframe (0.0, { 0.0f, 1.0f, 0.0f }, KeyframeCurve::bezier),
+        makePathKeyframe (1.2, { 2.0f, -1.0f, 0.5f }, KeyframeCurve::catmullRom),
+        makePathKeyframe (2.4, { -1.0f, 3.0f, 1.5f }, KeyframeCurve::easeInOut),
+        makePathKeyframe (3.6, { 1.0f, 0.0f, -0.5f }, KeyframeCurve::linear)
+    };
+
+    ChoreographyTimeline choreography;
+    const bool built = choreography.setTrack (0, ChoreographyTimeline::Axis::x, xKeys)
+                       && choreography.setTrack (3, ChoreographyTimeline::Axis::y, yKeys)
+                       && choreography.setTrack (5, ChoreographyTimeline::Axis::z, zKeys)
+                       && choreography.setPathTrack (7, pathKeys);
+    choreography.setLooping (true);
+
+    std::vector<ReferenceTrack> references;
+    const auto addReference = [&references] (int slot, int sceneAxis, const std::vector<Keyframe>& keyframes)
+    {
+        ReferenceTrack reference;
+        reference.slot = slot;
+        reference.sceneAxis = sceneAxis;
+        reference.track.setKeyframes (keyframes);
+        references.push_back (std::move (reference));
+    };
+
+    addReference (0, 0, xKeys);
+    addReference (3, 2, yKeys);
+    addReference (5, 1, zKeys);
+    for (int axis = 0; axis < 3; ++axis)
+    {
+        std::vector<Keyframe> axisKeys;
+        for (const auto& pathKey : pathKeys)
+        {
+            const auto pick = [axis] (const Vec3& v) { return axis == 0 ? v.x : (axis == 1 ? v.y : v.z); };
+            axisKeys.push_back (makeKeyframe (pathKey.timeSeconds, pick (pathKey.value), pathKey.curve,
+                                              pick (pathKey.outHandle), pick (pathKey.inHandle)));
+        }
+
+        addReference (7, axis == 0 ? 0 : (axis == 1 ? 2 : 1), axisKeys);
+    }
+
+    std::array<uint8_t, ChoreographyTimeline::MAX_SLOTS> expectedMask {};
+    expectedMask[0] = 0x1;
+    expectedMask[3] = 0x4;
+    expectedMask[5] = 0x2;
+    expectedMask[7] = 0x7;
+
+    ChoreographyTimeline::Playhead playhead;
+    ChoreographyTimeline::Result evaluated;
+    const double blockSeconds = 512.0 / 48000.0;
+    float maxError = 0.0f;
+    int maskMismatches = 0;
+    int blocks = 0;
+
+    const auto evaluateAndCompare = [&]
+    {
+        choreography.evaluate (playhead, evaluated);
+        for (int slot = 0; slot < ChoreographyTimeline::MAX_SLOTS; ++slot)
+            if (evaluated.sceneAxisMask[static_cast<size_t> (slot)] != expectedMask[static_cast<size_t> (slot)])
+                ++maskMismatches;
+
+        for (const auto& reference : references)
+        {
+            const auto expected = reference.track.evaluate (playhead.timeSeconds).value_or (0.0f);
+            const auto actual = sceneComponent (evaluated.positions[static_cast<size_t> (reference.slot)], reference.sceneAxis);
+            maxError = std::max (maxError, std::abs (actual - expected));
+        }
+
+        ++blocks;
+    };
+
+    // Forward playback through one and a half loops, then seeks back into the middle.
+    choreography.seek (playhead, 0.0);
+    for (double elapsed = 0.0; elapsed < choreography.getDurationSeconds() * 1.5; elapsed += blockSeconds)
+    {
+        evaluateAndCompare();
+        choreography.advance (playhead, blockSeconds);
+    }
+
+    for (const double seekSeconds : { 2.9, 0.6, 3.4, 0.05, 1.75 })
+    {
+        choreography.seek (playhead, seekSeconds);
+        evaluateAndCompare();
+    }
+
+    result.passed = built && maskMismatches == 0 && maxError <= 1.0e-5f
+                    && choreography.getNumTracks() == 4 && choreography.getNumLanes() == 6;
+
+    std::ostringstream detail;
+    detail << "built=" << built
+           << " tracks=" << choreography.getNumTracks()
+           << " lanes=" << choreography.getNumLanes()
+           << " blocks=" << blocks
+           << " max_abs_error=" << maxError
+           << " mask_mismatches=" << maskMismatches;
+    result.detail = detail.str();
+    return result;
+}
+
+// Replacing or removing one slot's tracks must leave the packed ranges of
+// every other track intact.
+CheckResult checkChoreographyEditsKeepOtherTracks()
+{
+    CheckResult result;
+    result.id = "choreography_edits_keep_other_tracks";
+
+    const std::vector<Keyframe> rampA { makeKeyframe (0.0, 0.0f, KeyframeCurve::linear),
+                                        makeKeyframe (2.0, 4.0f, KeyframeCurve::linear) };
+    const std::vector<Keyframe> rampB { makeKeyframe (0.0, 10.0f, KeyframeCurve::easeIn),
+                                        makeKeyframe (1.0, 6.0f, KeyframeCurve::easeOut),
+                                        makeKeyframe (2.0, 8.0f, KeyframeCurve::linear) };
+    const std::vector<Keyframe> rampC { makeKeyframe (0.0, -1.0f, KeyframeCurve::easeInOut),
+                                        makeKeyframe (2.0, 1.0f, KeyframeCurve::linear) };
+
+    ChoreographyTimeline choreography;
+    choreography.setLooping (false);
+    choreography.setTrack (1, ChoreographyTimeline::Axis::x, rampA);
+    choreography.setTrack (2, ChoreographyTimeline::Axis::y, rampB);
+    choreography.setTrack (2, ChoreographyTimeline::Axis::z, rampC);
+    choreography.setTrack (4, ChoreographyTimeline::Axis::x, rampB);
+
+    // Slot 2 becomes a path, slot 1 is replaced, slot 4 is cleared.
+    choreography.setPathTrack (2, { makePathKeyframe (0.0, { 1.0f, 2.0f, 3.0f }, KeyframeCurve::linear),
+                                    makePathKeyframe (2.0, { 3.0f, 4.0f, 5.0f }, KeyframeCurve::linear) });
+    choreography.setTrack (1, ChoreographyTimeline::Axis::x, rampC);
+    choreography.setTrack (4, ChoreographyTimeline::Axis::x, {});
+
+    KeyframeTrack referenceC;
+    referenceC.setKeyframes (rampC);
+
+    ChoreographyTimeline::Playhead playhead;
+    ChoreographyTimeline::Result evaluated;
+    float maxError = 0.0f;
+    bool masksOk = true;
+    for (int step = 0; step <= 40; ++step)
+    {
+        const double timeSeconds = 0.05 * step;
+        choreography.seek (playhead, timeSeconds);
+        choreography.evaluate (playhead, evaluated);
+
+        const auto u = static_cast<float> (timeSeconds / 2.0);
+        // Path (pos_x, pos_y, pos_z) maps to scene (x, z, y).
+        const auto& path = evaluated.positions[2];
+        maxError = std::max ({ maxError,
+                               std::abs (evaluated.positions[1].x - referenceC.evaluate (timeSeconds).value_or (0.0f)),
+                               std::abs (path.x - (1.0f + 2.0f * u)),
+                               std::abs (path.y - (3.0f + 2.0f * u)),
+                               std::abs (path.z - (2.0f + 2.0f * u)) });
+
+        masksOk = masksOk && evaluated.sceneAxisMask[1] == 0x1 && evaluated.sceneAxisMask[2] == 0x7
+                  && evaluated.sceneAxisMask[4] == 0;
+    }
+
+    result.passed = choreography.getNumTracks() == 2 && choreography.getNumLanes() == 4
+                    && choreography.getNumPieces() == 2 + 3 && masksOk && maxError <= 1.0e-5f;
+
+    std::ostringstream detail;
+    detail << "tracks=" << choreography.getNumTracks()
+           << " lanes=" << choreography.getNumLanes()
+           << " pieces=" << choreography.getNumPieces()
+           << " masks_ok=" << masksOk
+           << " max_abs_error=" << maxError;
+    result.detail = detail.str();
+    return result;
+}
+
+//==============================================================================
+// Compiled cubic pieces
+
+// Per-segment evaluation as KeyframeTrack did before curves were compiled:
+// find the segment, shape its local time with the easing curve, then lerp.
+float evaluateLegacyCurve (const std::vector<Keyframe>& keyframes, double timeSeconds)
+{
+    if (keyframes.size() == 1 || timeSeconds <= keyframes.front().timeSeconds)
+        return keyframes.front().value;
+
+    if (timeSeconds >= keyframes.back().timeSeconds)
+        return keyframes.back().value;
+
+    const auto upper = std::upper_bound (keyframes.begin(),
+                                         keyframes.end(),
+                                         timeSeconds,
+                                         [] (double value, const Keyframe& keyframe) { return value < keyframe.timeSeconds; });
+    const auto& right = *upper;
+    const auto& left = *std::prev (upper);
+
+    const auto segmentDuration = right.timeSeconds - left.timeSeconds;
+    if (segmentDuration <= 1.0e-9)
+        return right.value;
+
+    const auto x = std::clamp (static_cast<float> ((timeSeconds - left.timeSeconds) / segmentDuration), 0.0f, 1.0f);
+    float shaped = x;
+    switch (left.curve)
+    {
+        case KeyframeCurve::easeIn:    shaped = x * x; break;
+        case KeyframeCurve::easeOut:   shaped = 1.0f - std::pow (1.0f - x, 2.0f); break;
+        case KeyframeCurve::easeInOut: shaped = x < 0.5f ? 2.0f * x * x : 1.0f - std::pow (-2.0f * x + 2.0f, 2.0f) * 0.5f; break;
+        case KeyframeCurve::step:      shaped = 0.0f; break;
+        default: break;
+    }
+
+    return left.value + shaped * (right.value - left.value);
+}
+
+// Every pre-existing curve must evaluate through its compiled pieces to the
+// value the per-segment easing evaluation gave, both through KeyframeTrack
+// and through the cursor-cached playhead path (forward playback and seeks).
+CheckResult checkCompiledPiecesMatchLegacyCurves()
+{
+    CheckResult result;
+    result.id = "compiled_pieces_match_legacy_curves";
+
+    const std::vector<Keyframe> keyframes { makeKeyframe (0.0, 0.0f, KeyframeCurve::linear),
+                                            makeKeyframe (0.4, 6.0f, KeyframeCurve::easeIn),
+                                            makeKeyframe (1.0, -3.0f, KeyframeCurve::easeOut),
+                                            makeKeyframe (1.5, 2.5f, KeyframeCurve::easeInOut),
+                                            makeKeyframe (2.3, -8.0f, KeyframeCurve::step),
+                                            makeKeyframe (2.6, 4.0f, KeyframeCurve::easeInOut),
+                                            makeKeyframe (2.6, 1.0f, KeyframeCurve::linear),
+                                            makeKeyframe (3.2, 10.0f, KeyframeCurve::easeOut),
+                                            makeKeyframe (4.0, 5.0f, KeyframeCurve::linear) };
+
+    KeyframeTrack track ("pos_x");
+    track.setKeyframes (keyframes);
+
+    KeyframeTimeline timeline;
+    timeline.addOrReplaceTrack (track);
+    const auto handle = timeline.internTrackId ("pos_x");
+
+    constexpr float kTolerance = 1.0e-5f;
+    float maxTrackError = 0.0f;
+    float maxPlayheadError = 0.0f;
+    int samples = 0;
+
+    KeyframeTimeline::Playhead playhead;
+    std::array<float, KeyframeTimeline::maxTrackHandles> out {};
+    const auto compareAt = [&] (double timeSeconds)
+    {
+        const auto expected = evaluateLegacyCurve (keyframes, timeSeconds);
+        maxTrackError = std::max (maxTrackError, std::abs (track.evaluate (timeSeconds).value_or (0.0f) - expected));
+
+        timeline.seekPlayhead (playhead, timeSeconds, false);
+        timeline.evaluateAll (playhead, out.data());
+        maxPlayheadError = std::max (maxPlayheadError, std::abs (out[static_cast<size_t> (handle)] - expected));
+        ++samples;
+    };
+
+    for (double timeSeconds = -0.1; timeSeconds <= 4.1; timeSeconds += 1.0 / 480.0)
+        compareAt (timeSeconds);
+
+    for (const auto& keyframe : keyframes)
+        compareAt (keyframe.timeSeconds);
+
+    for (const double seekSeconds : { 3.9, 0.2, 2.45, 1.25, 2.61, 0.05 })
+        compareAt (seekSeconds);
+
+    result.passed = handle != KeyframeTimeline::invalidTrackHandle
+                    && maxTrackError <= kTolerance && maxPlayheadError <= kTolerance
+                    && track.getPieces().size() == keyframes.size() // one easeInOut split; the zero-length one is not
+                    && track.getPieceTimes().size() == track.getPieces().size() + 1;
+
+    std::ostringstream detail;
+    detail << "samples=" << samples
+           << " pieces=" << track.getPieces().size()
+           << " max_track_error=" << maxTrackError
+           << " max_playhead_error=" << maxPlayheadError
+           << " tolerance=" << kTolerance;
+    result.detail = detail.str();
+    return result;
+}
+} // namespace
+
+int main()
+{
+    const std::vector<CheckResult> checks {
+        checkSnapshotReclaimedOnlyByPublisher(),
+        checkSnapshotReaderNeverFrees(),
+        checkChoreographyMatchesPerTrackEvaluation(),
+        checkChoreographyEditsKeepOtherTracks(),
+        checkCompiledPiecesMatchLegacyCurves()
+    };
+
+    int passed = 0;
+    for (const auto& check : checks)
+    {
+        std::cout << "CHECK " << check.id
+                  << " : " << (check.passed ? "PASS" : "FAIL")
+                  << " | " << check.detail << "\n";
+        if (check.passed)
+            ++passed;
+    }
+
+    std::cout << "SUMMARY timeline_probe : "
+              << passed << "/" << checks.size() << " checks passed\n";
+
+    return passed == static_cast<int> (checks.size()) ? 0 : 1;
+}
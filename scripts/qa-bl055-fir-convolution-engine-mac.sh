@@ -169,16 +169,16 @@ else
 fi
 
 if rg -Fq 'const int calLatency = spatialRenderer.getCalibrationLatencySamples();' "$PROCESSOR_CPP" \
-   && rg -Fq 'setLatencySamples (calLatency);' "$PROCESSOR_CPP"; then
+   && rg -Fq 'setLatencySamples (hostLatency);' "$PROCESSOR_CPP"; then
   printf "host_latency_publication\tPASS\tPluginProcessor publishes calibration latency to host via setLatencySamples\t%s\n" "$PROCESSOR_CPP" \
     >> "$LATENCY_CONTRACT_TSV"
   record "BL055-C2-host_latency_publication" "PASS" \
-    "setLatencySamples(calLatency) publication path present" "$PROCESSOR_CPP"
+    "setLatencySamples(hostLatency) publication path present" "$PROCESSOR_CPP"
 else
-  printf "host_latency_publication\tFAIL\tmissing setLatencySamples(calLatency) publication markers\t%s\n" "$PROCESSOR_CPP" \
+  printf "host_latency_publication\tFAIL\tmissing setLatencySamples(hostLatency) publication markers\t%s\n" "$PROCESSOR_CPP" \
     >> "$LATENCY_CONTRACT_TSV"
   record "BL055-C2-host_latency_publication" "FAIL" \
-    "setLatencySamples(calLatency) publication markers missing" "$PROCESSOR_CPP"
+    "setLatencySamples(hostLatency) publication markers missing" "$PROCESSOR_CPP"
 fi
 
 if rg -Fq 'configuredTapCount = 1;' "$FIR_HOOK_HDR" \
@@ -196,7 +196,7 @@ else
   record "BL069-C2-preload_symbol" "FAIL" "preload helper missing" "$RENDERER_HDR"
 fi
 
-if rg -q 'const auto& preset = bundledPeqPresets' "$RENDERER_HDR"; then
+if rg -q 'const auto& cacheEntry = bundledPeqPresets' "$RENDERER_HDR"; then
   printf "cache_only_profile_load\tPASS\tloadPeqPresetForProfile consumes bundled cache\n" >> "$RT_ACCESS_AUDIT_TSV"
   record "BL069-C3-cache_only_load" "PASS" "cache-only load path present" "$RENDERER_HDR"
 else
@@ -211,7 +211,7 @@ if [[ "$MODE" == "execute" ]]; then
   else
     preset_retry_backoff_detail+="missing_memoized_last_loaded_guard;"
   fi
-  if rg -q 'const auto& preset = bundledPeqPresets\[static_cast<size_t> \(clampedProfileIndex\)\]\.preset;' "$RENDERER_HDR"; then
+  if rg -q 'const auto& cacheEntry = bundledPeqPresets\[static_cast<size_t> \(clampedProfileIndex\)\];' "$RENDERER_HDR"; then
     preset_retry_backoff_detail+="cache_only_bundle_lookup;"
   else
     preset_retry_backoff_detail+="missing_cache_only_bundle_lookup;"
@@ -251,15 +251,15 @@ if [[ "$MODE" == "execute" ]]; then
   fi
 
   profile_switch_detail=""
-  if rg -q 'profile changes are non-RT events on the message thread\.' "$RENDERER_HDR"; then
-    profile_switch_detail+="message_thread_non_rt_contract;"
+  if rg -q 'biquads are never designed here' "$RENDERER_HDR" && rg -q 'headphoneCalibrationChain\.tryPublishPeqCoefficients \(cacheEntry\.coefficients\)' "$RENDERER_HDR"; then
+    profile_switch_detail+="audio_thread_cache_only_try_publish;"
   else
-    profile_switch_detail+="missing_message_thread_non_rt_contract;"
+    profile_switch_detail+="missing_audio_thread_cache_only_try_publish;"
   fi
-  if rg -q 'headphoneCalibrationChain\.clearPeqPreset\(\);' "$RENDERER_HDR" && rg -q 'headphoneCalibrationChain\.setPeqPreampDb \(preset\.preampDb\);' "$RENDERER_HDR"; then
-    profile_switch_detail+="ordered_reset_then_preamp;"
+  if rg -q 'headphoneCalibrationChain\.publishPeqCoefficients \(' "$RENDERER_HDR" && rg -q 'coefficients\.preampLinear = std::pow \(10\.0f, preset\.preampDb / 20\.0f\);' "$RENDERER_HDR"; then
+    profile_switch_detail+="atomic_coefficient_set_publish;"
   else
-    profile_switch_detail+="missing_ordered_reset_then_preamp;"
+    profile_switch_detail+="missing_atomic_coefficient_set_publish;"
   fi
   if rg -q 'for \(int i = 0; i < maxStages; \+\+i\)' "$RENDERER_HDR"; then
     profile_switch_detail+="bounded_stage_swap_loop;"